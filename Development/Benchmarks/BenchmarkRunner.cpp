@@ -0,0 +1,216 @@
+#include "BenchmarkRunner.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <thread>
+
+namespace QwerkE {
+
+    typedef std::chrono::steady_clock Clock;
+
+    static const double s_MinSampleSeconds = 0.001; // Batch iterations until a sample takes this long
+    static const double s_WarmupSeconds = 0.1;
+
+    static volatile unsigned long long s_Sink = 0;
+
+    static double SecondsSince(Clock::time_point start)
+    {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    static double SortedPercentile(const std::vector<double>& sorted, double percentile)
+    {
+        const double index = (sorted.size() - 1) * percentile;
+        const size_t low = (size_t)index;
+        const size_t high = std::min(low + 1, sorted.size() - 1);
+        return sorted[low] + (sorted[high] - sorted[low]) * (index - low);
+    }
+
+    void BenchmarkRunner::Add(const char* name, Function iteration, double itemsPerIteration, Function setup, Function teardown)
+    {
+        Benchmark benchmark;
+        benchmark.name = name;
+        benchmark.iteration = iteration;
+        benchmark.itemsPerIteration = itemsPerIteration;
+        benchmark.setup = setup;
+        benchmark.teardown = teardown;
+        m_Benchmarks.push_back(benchmark);
+    }
+
+    void BenchmarkRunner::RunAll()
+    {
+        m_Results.clear();
+
+        for (const Benchmark& benchmark : m_Benchmarks)
+        {
+            if (!m_Filter.empty() && benchmark.name.find(m_Filter) == std::string::npos)
+                continue;
+
+            if (benchmark.setup)
+                benchmark.setup();
+
+            m_Results.push_back(Run(benchmark));
+
+            if (benchmark.teardown)
+                benchmark.teardown();
+
+            const BenchmarkResult& result = m_Results.back();
+            fprintf(stderr, "%-40s median %12.1fns [%.1f, %.1f]  mean %12.1fns  sd %10.1f  n %u  outliers %u\n",
+                result.name.c_str(), result.median, result.medianLow, result.medianHigh,
+                result.mean, result.standardDeviation, result.samples, result.outliers);
+        }
+
+        for (const std::string& failure : m_Failures)
+        {
+            fprintf(stderr, "FAILED %s\n", failure.c_str());
+        }
+    }
+
+    void BenchmarkRunner::Fail(const std::string& message)
+    {
+        fprintf(stderr, "FAILED %s\n", message.c_str());
+        m_Failures.push_back(message);
+    }
+
+    BenchmarkResult BenchmarkRunner::Run(const Benchmark& benchmark) const
+    {
+        BenchmarkResult result;
+        result.name = benchmark.name;
+        result.itemsPerIteration = benchmark.itemsPerIteration;
+
+        // Warm up caches and lazily created state, and estimate a single iteration
+        unsigned int warmupIterations = 0;
+        const Clock::time_point warmupStart = Clock::now();
+        do
+        {
+            benchmark.iteration();
+            warmupIterations++;
+        } while (SecondsSince(warmupStart) < s_WarmupSeconds || warmupIterations < 2);
+
+        const double iterationSeconds = SecondsSince(warmupStart) / warmupIterations;
+        result.iterationsPerSample = std::max(1u, (unsigned int)std::ceil(s_MinSampleSeconds / iterationSeconds));
+
+        std::vector<double> samples;
+        samples.reserve(m_MaxSamples);
+
+        const Clock::time_point runStart = Clock::now();
+        while (samples.size() < m_MaxSamples)
+        {
+            const double elapsed = SecondsSince(runStart);
+            if (samples.size() >= m_MinSamples && elapsed >= m_MinSeconds)
+                break;
+            if (samples.size() >= 3 && elapsed >= m_MaxSeconds)
+                break; // Slow benchmark. Keep the run bounded.
+
+            const Clock::time_point sampleStart = Clock::now();
+            for (unsigned int i = 0; i < result.iterationsPerSample; i++)
+            {
+                benchmark.iteration();
+            }
+            const double sampleNanoseconds = std::chrono::duration<double, std::nano>(Clock::now() - sampleStart).count();
+            samples.push_back(sampleNanoseconds / result.iterationsPerSample);
+        }
+
+        result.samples = (unsigned int)samples.size();
+
+        std::sort(samples.begin(), samples.end());
+        result.min = samples.front();
+        result.max = samples.back();
+        result.median = SortedPercentile(samples, 0.5);
+        result.p95 = SortedPercentile(samples, 0.95);
+
+        double sum = 0.0;
+        for (double sample : samples)
+        {
+            sum += sample;
+        }
+        result.mean = sum / samples.size();
+
+        double squares = 0.0;
+        for (double sample : samples)
+        {
+            squares += (sample - result.mean) * (sample - result.mean);
+        }
+        result.standardDeviation = samples.size() > 1 ? std::sqrt(squares / (samples.size() - 1)) : 0.0;
+
+        std::vector<double> deviations;
+        deviations.reserve(samples.size());
+        for (double sample : samples)
+        {
+            deviations.push_back(std::fabs(sample - result.median));
+        }
+        std::sort(deviations.begin(), deviations.end());
+        result.medianAbsoluteDeviation = SortedPercentile(deviations, 0.5);
+
+        // 1.4826 scales MAD to match a standard deviation for normal data
+        const double outlierDistance = 3.0 * 1.4826 * result.medianAbsoluteDeviation;
+        for (double sample : samples)
+        {
+            if (std::fabs(sample - result.median) > outlierDistance)
+                result.outliers++;
+        }
+
+        // Distribution free 95% interval: ranks n/2 -+ 1.96 * sqrt(n) / 2
+        const double n = (double)samples.size();
+        const double halfWidth = 1.96 * std::sqrt(n) / 2.0;
+        const long low = std::max(0L, (long)std::floor(n / 2.0 - halfWidth));
+        const long high = std::min((long)samples.size() - 1, (long)std::ceil(n / 2.0 + halfWidth));
+        result.medianLow = samples[low];
+        result.medianHigh = samples[high];
+
+        return result;
+    }
+
+    bool BenchmarkRunner::WriteJson(const char* filePath) const
+    {
+        const bool toStdout = filePath == nullptr || std::string(filePath) == "-";
+        FILE* file = toStdout ? stdout : fopen(filePath, "w");
+        if (file == nullptr)
+        {
+            fprintf(stderr, "Could not open %s for writing\n", filePath);
+            return false;
+        }
+
+        fprintf(file, "{\n\t\"hardwareThreads\": %u,\n\t\"benchmarks\": [", std::thread::hardware_concurrency());
+        for (size_t i = 0; i < m_Results.size(); i++)
+        {
+            const BenchmarkResult& r = m_Results[i];
+            fprintf(file, "%s\n\t\t{ \"name\": \"%s\", \"samples\": %u, \"iterationsPerSample\": %u, "
+                "\"medianNs\": %.3f, \"medianLowNs\": %.3f, \"medianHighNs\": %.3f, "
+                "\"meanNs\": %.3f, \"standardDeviationNs\": %.3f, \"madNs\": %.3f, "
+                "\"minNs\": %.3f, \"maxNs\": %.3f, \"p95Ns\": %.3f, \"outliers\": %u, "
+                "\"itemsPerIteration\": %.1f, \"itemsPerSecond\": %.3f }",
+                i ? "," : "", r.name.c_str(), r.samples, r.iterationsPerSample,
+                r.median, r.medianLow, r.medianHigh,
+                r.mean, r.standardDeviation, r.medianAbsoluteDeviation,
+                r.min, r.max, r.p95, r.outliers,
+                r.itemsPerIteration, r.ItemsPerSecond());
+        }
+        fprintf(file, "\n\t],\n\t\"failures\": [");
+        for (size_t i = 0; i < m_Failures.size(); i++)
+        {
+            // Messages hold file paths, which have backslashes on Windows
+            std::string escaped;
+            for (char c : m_Failures[i])
+            {
+                if (c == '"' || c == '\\')
+                    escaped += '\\';
+                escaped += c;
+            }
+            fprintf(file, "%s\n\t\t\"%s\"", i ? "," : "", escaped.c_str());
+        }
+        fprintf(file, "\n\t]\n}\n");
+
+        if (!toStdout)
+            fclose(file);
+        return true;
+    }
+
+    void BenchmarkRunner::Consume(unsigned long long value)
+    {
+        s_Sink = s_Sink + value;
+    }
+
+}
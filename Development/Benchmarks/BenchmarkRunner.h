@@ -0,0 +1,95 @@
+#ifndef _Benchmark_Runner_H_
+#define _Benchmark_Runner_H_
+
+// Runs registered benchmarks and reports robust timing statistics.
+//
+// Each benchmark is warmed up, then timed in batches long enough to
+// hide timer resolution. Samples are collected until both a minimum
+// sample count and a minimum run time are reached. Results report the
+// median with a 95% confidence interval (from order statistics, so no
+// normal distribution is assumed) alongside mean, deviation and outliers.
+//
+// Cases check that their code gives the right results once, in setup, and
+// report a mismatch with Fail(). Harnesses exit with an error after any.
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    struct BenchmarkResult
+    {
+        std::string name;
+        unsigned int samples = 0;
+        unsigned int iterationsPerSample = 0;
+        double itemsPerIteration = 1.0;
+
+        // Nanoseconds per iteration
+        double median = 0.0;
+        double medianLow = 0.0; // 95% confidence interval of the median
+        double medianHigh = 0.0;
+        double mean = 0.0;
+        double standardDeviation = 0.0;
+        double medianAbsoluteDeviation = 0.0;
+        double min = 0.0;
+        double max = 0.0;
+        double p95 = 0.0;
+        unsigned int outliers = 0; // Samples over 3 scaled MADs from the median
+
+        double ItemsPerSecond() const { return median > 0.0 ? itemsPerIteration * 1e9 / median : 0.0; }
+    };
+
+    class BenchmarkRunner
+    {
+    public:
+        typedef std::function<void()> Function;
+
+        // setup and teardown run once, outside of timing
+        void Add(const char* name, Function iteration, double itemsPerIteration = 1.0,
+            Function setup = nullptr, Function teardown = nullptr);
+
+        // Only run benchmarks with filter in their name
+        void SetFilter(const char* filter) { m_Filter = filter ? filter : ""; }
+        void SetMinSamples(unsigned int samples) { m_MinSamples = samples; }
+        void SetMinSeconds(double seconds) { m_MinSeconds = seconds; }
+
+        void RunAll();
+
+        // Reports a case whose code gave wrong results. Printed at once
+        // and after the run, and written with the results.
+        void Fail(const std::string& message);
+        bool Failed() const { return !m_Failures.empty(); }
+
+        const std::vector<BenchmarkResult>& Results() const { return m_Results; }
+
+        // Writes results as JSON. A path of "-" writes to stdout.
+        bool WriteJson(const char* filePath) const;
+
+        // Keeps the compiler from removing work whose result is unused
+        static void Consume(unsigned long long value);
+
+    private:
+        struct Benchmark
+        {
+            std::string name;
+            Function iteration;
+            double itemsPerIteration;
+            Function setup;
+            Function teardown;
+        };
+
+        BenchmarkResult Run(const Benchmark& benchmark) const;
+
+        std::vector<Benchmark> m_Benchmarks;
+        std::vector<BenchmarkResult> m_Results;
+        std::vector<std::string> m_Failures;
+        std::string m_Filter;
+        unsigned int m_MinSamples = 30;
+        unsigned int m_MaxSamples = 1000;
+        double m_MinSeconds = 1.0;
+        double m_MaxSeconds = 10.0;
+    };
+
+}
+#endif // _Benchmark_Runner_H_
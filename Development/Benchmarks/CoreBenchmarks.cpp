@@ -0,0 +1,776 @@
+#include "CoreBenchmarks.h"
+#include "BenchmarkRunner.h"
+
+#include "../../Source/Core/Math/TransformMath.h"
+#include "../../Source/Core/Entities/EntityStore.h"
+#include "../../Source/Core/Entities/RoutineBatches.h"
+#include "../../Source/Core/Entities/TransformRoutineBatch.h"
+#include "../../Source/Core/Jobs/TaskScheduler.h"
+#include "../../Source/Core/Graphics/BoundingVolumeTree.h"
+#include "../../Source/Core/Graphics/Frustum.h"
+#include "../../Source/Core/Graphics/CookedMesh.h"
+#include "../../Source/Core/Graphics/MeshCooker.h"
+#include "../../Source/Core/Graphics/MeshOptimizer.h"
+#include "../../Source/Core/Graphics/ObjImporter.h"
+#include "../../Source/Core/Scenes/CookedScene.h"
+#include "../../Source/Core/Scenes/SceneCooker.h"
+
+// Found through the include path, as in Source, so the standalone build
+// can use its own stand ins for the framework
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Libraries/assimp/Importer.hpp"
+#include "../QwerkE_Framework/Libraries/assimp/scene.h"
+#include "../QwerkE_Framework/Libraries/assimp/postprocess.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace CoreBenchmarks
+    {
+        struct ParsedObject
+        {
+            float position[3];
+            float rotation[3];
+            float scale[3];
+        };
+
+        // .qscene values are stored as "Position": [{ "PositionX": x, ... }].
+        // Missing values default as SceneCooker's do.
+        static void ReadVector(cJSON* object, const char* name, float out[3], float defaultValue)
+        {
+            cJSON* values = cJSON_GetArrayItem(cJSON_GetObjectItem(object, name), 0);
+            const char axes[3] = { 'X', 'Y', 'Z' };
+            for (int i = 0; i < 3; i++)
+            {
+                const std::string key = std::string(name) + axes[i];
+                cJSON* item = values ? cJSON_GetObjectItem(values, key.c_str()) : nullptr;
+                out[i] = item ? (float)item->valuedouble : defaultValue;
+            }
+        }
+
+        static size_t ParseScene(const std::string& filePath, std::vector<ParsedObject>& objects)
+        {
+            objects.clear();
+
+            char* fileData = LoadCompleteFile(filePath.c_str(), nullptr);
+            if (fileData == nullptr)
+                return 0;
+
+            cJSON* root = cJSON_Parse(fileData);
+            delete[] fileData;
+            if (root == nullptr)
+                return 0;
+
+            const char* lists[3] = { "ObjectList", "CameraList", "LightList" };
+            for (const char* listName : lists)
+            {
+                cJSON* list = cJSON_GetArrayItem(cJSON_GetObjectItem(root, listName), 0);
+                if (list == nullptr)
+                    continue;
+
+                for (cJSON* entry = list->child; entry; entry = entry->next)
+                {
+                    cJSON* object = cJSON_GetArrayItem(entry, 0);
+                    if (object == nullptr)
+                        continue;
+
+                    ParsedObject parsed;
+                    ReadVector(object, "Position", parsed.position, 0.0f);
+                    ReadVector(object, "Rotation", parsed.rotation, 0.0f);
+                    ReadVector(object, "Scale", parsed.scale, 1.0f);
+                    objects.push_back(parsed);
+                }
+            }
+
+            cJSON_Delete(root);
+            return objects.size();
+        }
+
+        // Same output as ParseScene(), from a cooked file
+        static size_t ReadCookedScene(const std::string& filePath, std::vector<ParsedObject>& objects)
+        {
+            objects.clear();
+
+            CookedScene cooked;
+            if (!cooked.Open(filePath.c_str()))
+                return 0;
+
+            objects.resize(cooked.EntityCount());
+            for (unsigned int i = 0; i < cooked.EntityCount(); i++)
+            {
+                const CookedEntity& entity = cooked.GetEntity(i);
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    objects[i].position[axis] = entity.position[axis];
+                    objects[i].rotation[axis] = entity.rotation[axis];
+                    objects[i].scale[axis] = entity.scale[axis];
+                }
+            }
+            return objects.size();
+        }
+
+        bool WriteGeneratedScene(const std::string& filePath, int objectCount)
+        {
+            FILE* file = fopen(filePath.c_str(), "w");
+            if (file == nullptr)
+                return false;
+
+            fprintf(file, "{\n\t\"ObjectList\": [{\n");
+            for (int i = 0; i < objectCount; i++)
+            {
+                fprintf(file,
+                    "\t\t\"Cube%d\": [{\n"
+                    "\t\t\t\"ObjectTag\": 9,\n"
+                    "\t\t\t\"Position\": [{ \"PositionX\": %d, \"PositionY\": %d, \"PositionZ\": 50 }],\n"
+                    "\t\t\t\"Rotation\": [{ \"RotationX\": 0, \"RotationY\": 0, \"RotationZ\": 0 }],\n"
+                    "\t\t\t\"Scale\": [{ \"ScaleX\": 1, \"ScaleY\": 1, \"ScaleZ\": 1 }],\n"
+                    "\t\t\t\"ComponentList\": [{ \"Render\": [{ \"ComponentName\": \"Render\", \"SchematicName\": \"None\", \"Renderables\": [{\n"
+                    "\t\t\t\t\"Cube\": [{ \"Shader\": \"null_shader.ssch\", \"Material\": \"null_material.msch\", \"MeshFile\": \"null_mesh.obj\", \"MeshName\": \"null_mesh\" }]\n"
+                    "\t\t\t}] }] }],\n"
+                    "\t\t\t\"RoutineList\": [{ \"DrawRoutines\": [{ \"0\": [{ \"RoutineName\": \"Render\" }] }] }]\n"
+                    "\t\t}]%s\n",
+                    i, i % 100, i / 100, i + 1 < objectCount ? "," : "");
+            }
+            fprintf(file, "\t}]\n}\n");
+
+            return fclose(file) == 0;
+        }
+
+        // Adds a JSON and a cooked load of the scene
+        static void AddSceneLoadCases(BenchmarkRunner& runner, const std::string& filePath, const std::string& sceneName, const std::filesystem::path& cookedDir)
+        {
+            auto objects = std::make_shared<std::vector<ParsedObject>>();
+
+            // Objects per load, for throughput
+            const size_t objectCount = ParseScene(filePath, *objects);
+
+            const std::string name = "SceneLoad/" + sceneName;
+            runner.Add(name.c_str(), [filePath, objects]()
+            {
+                BenchmarkRunner::Consume(ParseScene(filePath, *objects));
+            }, (double)std::max<size_t>(objectCount, 1));
+
+            // Cooked next to the benchmark's other files, not into Assets
+            const std::string cookedPath = (cookedDir / (sceneName + "c")).string();
+            if (!SceneCooker::Cook(filePath.c_str(), cookedPath.c_str()))
+            {
+                fprintf(stderr, "Skipping cooked %s. It could not be cooked.\n", sceneName.c_str());
+                return;
+            }
+
+            // The cooked file must load the same transforms as the JSON
+            BenchmarkRunner* failures = &runner;
+            auto verify = [failures, filePath, cookedPath, sceneName]()
+            {
+                std::vector<ParsedObject> parsed;
+                std::vector<ParsedObject> cooked;
+                ParseScene(filePath, parsed);
+                ReadCookedScene(cookedPath, cooked);
+
+                if (parsed.size() != cooked.size())
+                {
+                    failures->Fail("SceneLoad/Cooked/" + sceneName + ": " + std::to_string(cooked.size()) + " cooked objects, " + std::to_string(parsed.size()) + " in the JSON");
+                    return;
+                }
+
+                for (size_t i = 0; i < parsed.size(); i++)
+                {
+                    bool same = true;
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        same = same && parsed[i].position[axis] == cooked[i].position[axis] &&
+                            parsed[i].rotation[axis] == cooked[i].rotation[axis] &&
+                            parsed[i].scale[axis] == cooked[i].scale[axis];
+                    }
+                    if (!same)
+                    {
+                        failures->Fail("SceneLoad/Cooked/" + sceneName + ": object " + std::to_string(i) + " has a different transform than in the JSON");
+                        return;
+                    }
+                }
+            };
+
+            const std::string cookedName = "SceneLoad/Cooked/" + sceneName;
+            runner.Add(cookedName.c_str(), [cookedPath, objects]()
+            {
+                BenchmarkRunner::Consume(ReadCookedScene(cookedPath, *objects));
+            }, (double)std::max<size_t>(objectCount, 1), verify);
+        }
+
+        void AddSceneLoad(BenchmarkRunner& runner, const char* assetsDir)
+        {
+            const std::filesystem::path cookedDir = std::filesystem::temp_directory_path();
+
+            const std::filesystem::path scenesDir = std::filesystem::path(assetsDir) / "Scenes";
+            if (std::filesystem::is_directory(scenesDir))
+            {
+                for (const auto& entry : std::filesystem::directory_iterator(scenesDir))
+                {
+                    if (entry.path().extension() != ".qscene")
+                        continue;
+
+                    AddSceneLoadCases(runner, entry.path().string(), entry.path().filename().string(), cookedDir);
+                }
+            }
+            else
+            {
+                fprintf(stderr, "Skipping scene load. %s not found.\n", scenesDir.string().c_str());
+            }
+
+            const std::string generatedPath = (cookedDir / "Generated10k.qscene").string();
+            if (WriteGeneratedScene(generatedPath, 10000))
+                AddSceneLoadCases(runner, generatedPath, "Generated10k.qscene", cookedDir);
+        }
+
+        // Triangle count and the sum of every triangle corner's position.
+        // Neither depends on vertex order, so an import can be compared with
+        // its optimized, cooked mesh.
+        struct MeshChecksum
+        {
+            unsigned long long triangles = 0;
+            double sum[3] = { 0.0, 0.0, 0.0 };
+            double tolerance[3] = { 0.0, 0.0, 0.0 }; // How far sum may be off from another source's
+        };
+
+        static bool ImportChecksum(const std::string& filePath, MeshChecksum& checksum)
+        {
+            Assimp::Importer importer;
+            const aiScene* scene = importer.ReadFile(filePath, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenNormals);
+            if (scene == nullptr)
+                return false;
+
+            for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+            {
+                const aiMesh* mesh = scene->mMeshes[i];
+                for (unsigned int f = 0; f < mesh->mNumFaces; f++)
+                {
+                    const aiFace& face = mesh->mFaces[f];
+                    if (face.mNumIndices != 3)
+                        continue; // Points and lines aren't cooked
+
+                    checksum.triangles++;
+                    for (unsigned int corner = 0; corner < 3; corner++)
+                    {
+                        const aiVector3D& position = mesh->mVertices[face.mIndices[corner]];
+                        const float values[3] = { position.x, position.y, position.z };
+                        for (int axis = 0; axis < 3; axis++)
+                        {
+                            checksum.sum[axis] += values[axis];
+                            // Parsers may round the last digit differently
+                            checksum.tolerance[axis] += std::fabs(values[axis]) * 1e-6 + 1e-6;
+                        }
+                    }
+                }
+            }
+            return true;
+        }
+
+        static bool CookedChecksum(const std::string& filePath, MeshChecksum& checksum)
+        {
+            CookedMesh cooked;
+            if (!cooked.Open(filePath.c_str()))
+                return false;
+
+            std::vector<CookedMeshVertex> vertices;
+            for (unsigned int s = 0; s < cooked.SubmeshCount(); s++)
+            {
+                const CookedSubmesh& submesh = cooked.GetSubmesh(s);
+                vertices.resize(submesh.vertexCount);
+                cooked.ReadVertices(submesh, vertices.data());
+
+                const unsigned int* indices = cooked.Indices(submesh);
+                for (unsigned int i = 0; i < submesh.indexCount; i++)
+                {
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        checksum.sum[axis] += vertices[indices[i]].position[axis];
+                        // Quantized positions are within half a step of the source
+                        if (cooked.IsQuantized())
+                            checksum.tolerance[axis] += (submesh.max[axis] - submesh.min[axis]) / 65535.0;
+                    }
+                }
+                checksum.triangles += submesh.indexCount / 3;
+            }
+            return true;
+        }
+
+        void AddMeshImport(BenchmarkRunner& runner, const char* assetsDir)
+        {
+            const char* meshes[] = { "Deathwing.obj", "nanosuit.obj", "Alexstrasza.obj" };
+            for (const char* mesh : meshes)
+            {
+                const std::filesystem::path filePath = std::filesystem::path(assetsDir) / "Meshes" / mesh;
+                if (!std::filesystem::exists(filePath))
+                {
+                    fprintf(stderr, "Skipping %s. File not found.\n", filePath.string().c_str());
+                    continue;
+                }
+
+                // Throughput in bytes of .obj text
+                const double fileBytes = (double)std::filesystem::file_size(filePath);
+                const std::string path = filePath.string();
+
+                const std::string name = std::string("MeshImport/") + mesh;
+                runner.Add(name.c_str(), [path]()
+                {
+                    // Same import flags as the framework's model loading
+                    Assimp::Importer importer;
+                    const aiScene* scene = importer.ReadFile(path, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenNormals);
+
+                    unsigned long long vertices = 0;
+                    for (unsigned int i = 0; scene && i < scene->mNumMeshes; i++)
+                    {
+                        vertices += scene->mMeshes[i]->mNumVertices;
+                    }
+                    BenchmarkRunner::Consume(vertices);
+                }, fileBytes);
+
+                // Cooked next to the benchmark's other files, not into Assets.
+                // Once with float vertices and once quantized.
+                for (int quantize = 0; quantize < 2; quantize++)
+                {
+                    const std::string cookedPath = (std::filesystem::temp_directory_path() / (std::string(mesh) + (quantize ? ".packed.qmesh" : ".qmesh"))).string();
+                    if (!MeshCooker::Cook(path.c_str(), cookedPath.c_str(), nullptr, quantize != 0))
+                    {
+                        fprintf(stderr, "Skipping cooked %s. It could not be cooked.\n", mesh);
+                        break;
+                    }
+
+                    // Map the file and copy out the buffers, as an upload would.
+                    // Also per byte of .obj text, to compare with the import.
+                    auto staging = std::make_shared<std::vector<unsigned char>>();
+                    const std::string cookedName = std::string(quantize ? "MeshLoad/Quantized/" : "MeshLoad/Cooked/") + mesh;
+
+                    // The cooked mesh must hold the triangles assimp imports
+                    BenchmarkRunner* failures = &runner;
+                    auto verify = [failures, path, cookedPath, cookedName]()
+                    {
+                        MeshChecksum imported;
+                        MeshChecksum cooked;
+                        if (!ImportChecksum(path, imported) || !CookedChecksum(cookedPath, cooked))
+                        {
+                            failures->Fail(cookedName + ": could not read the mesh to check it");
+                            return;
+                        }
+
+                        if (imported.triangles != cooked.triangles)
+                        {
+                            failures->Fail(cookedName + ": " + std::to_string(cooked.triangles) + " cooked triangles, " + std::to_string(imported.triangles) + " imported");
+                            return;
+                        }
+
+                        for (int axis = 0; axis < 3; axis++)
+                        {
+                            if (std::fabs(imported.sum[axis] - cooked.sum[axis]) > imported.tolerance[axis] + cooked.tolerance[axis])
+                            {
+                                failures->Fail(cookedName + ": cooked triangles are not where the imported ones are");
+                                return;
+                            }
+                        }
+                    };
+
+                    runner.Add(cookedName.c_str(), [cookedPath, staging]()
+                    {
+                        CookedMesh cooked;
+                        if (!cooked.Open(cookedPath.c_str()))
+                            return;
+
+                        const CookedMeshHeader& header = cooked.Header();
+                        const size_t vertexBytes = (size_t)header.vertexCount * header.vertexStride;
+                        const size_t indexBytes = (size_t)header.indexCount * sizeof(unsigned int);
+                        staging->resize(vertexBytes + indexBytes);
+                        if (vertexBytes > 0)
+                            memcpy(staging->data(), cooked.VertexData(), vertexBytes);
+                        if (indexBytes > 0)
+                            memcpy(staging->data() + vertexBytes, cooked.Indices(), indexBytes);
+                        BenchmarkRunner::Consume(staging->size());
+                    }, fileBytes, verify);
+                }
+            }
+        }
+
+        void AddObjImport(BenchmarkRunner& runner, const char* assetsDir)
+        {
+            unsigned int workerCount = std::thread::hardware_concurrency();
+            workerCount = workerCount > 1 ? workerCount - 1 : 1;
+            auto scheduler = std::make_shared<TaskScheduler>(workerCount);
+
+            const char* meshes[] = { "Deathwing.obj", "nanosuit.obj", "Alexstrasza.obj" };
+            for (const char* mesh : meshes)
+            {
+                const std::filesystem::path filePath = std::filesystem::path(assetsDir) / "Meshes" / mesh;
+                if (!std::filesystem::exists(filePath))
+                {
+                    fprintf(stderr, "Skipping %s. File not found.\n", filePath.string().c_str());
+                    continue;
+                }
+
+                // Throughput in MB of .obj text per second
+                const double megabytes = (double)std::filesystem::file_size(filePath) / (1024.0 * 1024.0);
+                const std::string path = filePath.string();
+                auto model = std::make_shared<ObjModel>();
+
+                const std::string serialName = std::string("ObjImport/1Thread/") + mesh;
+                runner.Add(serialName.c_str(), [path, model]()
+                {
+                    ObjImporter::Import(path.c_str(), *model, nullptr);
+                    BenchmarkRunner::Consume(model->indices.size());
+                }, megabytes);
+
+                const std::string parallelName = std::string("ObjImport/AllThreads/") + mesh;
+                runner.Add(parallelName.c_str(), [path, model, scheduler]()
+                {
+                    ObjImporter::Import(path.c_str(), *model, scheduler.get());
+                    BenchmarkRunner::Consume(model->indices.size());
+                }, megabytes);
+            }
+
+            const char* libraries[] = { "Deathwing.mtl", "nanosuit.mtl" };
+            for (const char* library : libraries)
+            {
+                const std::filesystem::path filePath = std::filesystem::path(assetsDir) / "Meshes" / library;
+                if (!std::filesystem::exists(filePath))
+                    continue;
+
+                const double megabytes = (double)std::filesystem::file_size(filePath) / (1024.0 * 1024.0);
+                const std::string path = filePath.string();
+                auto materials = std::make_shared<std::vector<ObjMaterial>>();
+
+                const std::string name = std::string("MtlImport/") + library;
+                runner.Add(name.c_str(), [path, materials]()
+                {
+                    materials->clear();
+                    ObjImporter::ImportMaterials(path.c_str(), *materials);
+                    BenchmarkRunner::Consume(materials->size());
+                }, megabytes);
+            }
+        }
+
+        void AddMeshOptimize(BenchmarkRunner& runner, const char* assetsDir)
+        {
+            const char* meshes[] = { "Deathwing.obj", "nanosuit.obj", "Alexstrasza.obj" };
+            for (const char* mesh : meshes)
+            {
+                const std::filesystem::path filePath = std::filesystem::path(assetsDir) / "Meshes" / mesh;
+                ObjModel source;
+                if (!ObjImporter::Import(filePath.string().c_str(), source, nullptr))
+                {
+                    fprintf(stderr, "Skipping mesh optimize of %s. It could not be imported.\n", mesh);
+                    continue;
+                }
+
+                // Each iteration optimizes fresh copies of the imported groups
+                auto model = std::make_shared<ObjModel>(std::move(source));
+                auto vertices = std::make_shared<std::vector<CookedMeshVertex>>();
+                auto indices = std::make_shared<std::vector<unsigned int>>();
+                auto optimize = [model, vertices, indices](MeshOptimizerStats* totals)
+                {
+                    for (const ObjGroup& group : model->groups)
+                    {
+                        vertices->assign(model->vertices.begin() + group.firstVertex, model->vertices.begin() + group.firstVertex + group.vertexCount);
+                        indices->assign(model->indices.begin() + group.firstIndex, model->indices.begin() + group.firstIndex + group.indexCount);
+
+                        MeshOptimizerStats stats;
+                        MeshOptimizer::Optimize(*vertices, *indices, totals ? &stats : nullptr);
+                        if (totals)
+                            totals->Add(stats);
+                    }
+                };
+
+                MeshOptimizerStats stats;
+                optimize(&stats);
+                fprintf(stderr, "%s: %u vertices welded to %u. ACMR %.3f to %.3f, ATVR %.3f to %.3f\n", mesh, stats.verticesBefore, stats.verticesAfter,
+                    stats.AcmrBefore(), stats.AcmrAfter(), stats.AtvrBefore(), stats.AtvrAfter());
+
+                const std::string name = std::string("MeshOptimize/") + mesh;
+                runner.Add(name.c_str(), [optimize, indices]()
+                {
+                    optimize(nullptr);
+                    BenchmarkRunner::Consume(indices->size());
+                }, (double)stats.triangleCount);
+            }
+        }
+
+        void AddRoutineBatches(BenchmarkRunner& runner)
+        {
+            const unsigned int counts[] = { 1000, 10000, 100000 };
+            const double deltaTime = 1.0 / 60.0;
+
+            unsigned int workerCount = std::thread::hardware_concurrency();
+            workerCount = workerCount > 1 ? workerCount - 1 : 1;
+            auto scheduler = std::make_shared<TaskScheduler>(workerCount);
+
+            for (unsigned int count : counts)
+            {
+                auto store = std::make_shared<EntityStore>();
+                auto batches = std::make_shared<RoutineBatches>();
+
+                auto batchSetup = [store, batches, count]()
+                {
+                    TransformRoutineBatch* batch = new TransformRoutineBatch();
+                    batches->AddBatch(batch);
+
+                    const float positionOffset[3] = { 1.0f, 0.0f, 0.0f };
+                    const float rotationOffset[3] = { 0.0f, 90.0f, 0.0f };
+                    const float scaleOffset[3] = { 0.0f, 0.0f, 0.0f };
+                    for (unsigned int i = 0; i < count; i++)
+                    {
+                        batch->Add(store->Create(0), 0.5f, positionOffset, rotationOffset, scaleOffset);
+                    }
+                };
+
+                auto batchTeardown = [store, batches]()
+                {
+                    batches->Clear();
+                    store->Clear();
+                };
+
+                const std::string batchName = "RoutineUpdate/Batched/" + std::to_string(count);
+                runner.Add(batchName.c_str(), [store, batches, deltaTime]()
+                {
+                    batches->Update(*store, deltaTime, nullptr);
+                }, (double)count, batchSetup, batchTeardown);
+
+                const std::string threadedName = "RoutineUpdate/BatchedThreaded/" + std::to_string(count);
+                runner.Add(threadedName.c_str(), [store, batches, scheduler, deltaTime]()
+                {
+                    batches->Update(*store, deltaTime, scheduler.get());
+                }, (double)count, batchSetup, batchTeardown);
+            }
+        }
+
+        struct MathKernelData
+        {
+            std::vector<float> values[9]; // Transform arrays, then reused as x, y, z and quaternions
+            std::vector<float> outputs[4];
+            std::vector<float> matrices;
+        };
+
+        void AddMathKernels(BenchmarkRunner& runner)
+        {
+            const size_t count = 100000;
+
+            auto data = std::make_shared<MathKernelData>();
+            for (int i = 0; i < 9; i++)
+            {
+                data->values[i].resize(count);
+                for (size_t j = 0; j < count; j++)
+                {
+                    // Varied but repeatable. Scales stay positive.
+                    data->values[i][j] = (float)((j * 7919 + i * 104729) % 3600) * 0.1f - (i < 6 ? 180.0f : -0.5f);
+                }
+            }
+            for (int i = 0; i < 4; i++)
+                data->outputs[i].resize(count);
+            data->matrices.resize(count * 16);
+
+            const TransformMath::TransformArrays transforms = {
+                data->values[0].data(), data->values[1].data(), data->values[2].data(),
+                data->values[3].data(), data->values[4].data(), data->values[5].data(),
+                data->values[6].data(), data->values[7].data(), data->values[8].data() };
+
+            fprintf(stderr, "Math kernels built for %s\n", TransformMath::SimdName());
+
+            runner.Add("Math/ComposeSRT/Scalar", [data]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const float position[3] = { data->values[0][i], data->values[1][i], data->values[2][i] };
+                    const float rotation[3] = { data->values[3][i], data->values[4][i], data->values[5][i] };
+                    const float scale[3] = { data->values[6][i], data->values[7][i], data->values[8][i] };
+                    TransformMath::ComposeSRT(position, rotation, scale, &data->matrices[i * 16]);
+                }
+                BenchmarkRunner::Consume((unsigned long long)data->matrices[16]);
+            }, (double)count);
+
+            runner.Add("Math/ComposeSRT/Batch", [data, transforms]()
+            {
+                TransformMath::ComposeSRTBatch(transforms, count, data->matrices.data());
+                BenchmarkRunner::Consume((unsigned long long)data->matrices[16]);
+            }, (double)count);
+
+            // Chains of parent * local, like a hierarchy update
+            runner.Add("Math/Multiply/Scalar", [data]()
+            {
+                float result[16];
+                for (size_t i = 1; i < count; i++)
+                {
+                    TransformMath::MultiplyScalar(&data->matrices[(i - 1) * 16], &data->matrices[i * 16], result);
+                    BenchmarkRunner::Consume((unsigned long long)result[0]);
+                }
+            }, (double)(count - 1));
+
+            runner.Add("Math/Multiply/Simd", [data]()
+            {
+                float result[16];
+                for (size_t i = 1; i < count; i++)
+                {
+                    TransformMath::Multiply(&data->matrices[(i - 1) * 16], &data->matrices[i * 16], result);
+                    BenchmarkRunner::Consume((unsigned long long)result[0]);
+                }
+            }, (double)(count - 1));
+
+            runner.Add("Math/TransformPoints/Scalar", [data]()
+            {
+                const float* m = &data->matrices[0];
+                const float* x = data->values[0].data();
+                const float* y = data->values[1].data();
+                const float* z = data->values[2].data();
+                for (size_t i = 0; i < count; i++)
+                {
+                    data->outputs[0][i] = m[0] * x[i] + m[4] * y[i] + m[8] * z[i] + m[12];
+                    data->outputs[1][i] = m[1] * x[i] + m[5] * y[i] + m[9] * z[i] + m[13];
+                    data->outputs[2][i] = m[2] * x[i] + m[6] * y[i] + m[10] * z[i] + m[14];
+                }
+                BenchmarkRunner::Consume((unsigned long long)data->outputs[0][1]);
+            }, (double)count);
+
+            runner.Add("Math/TransformPoints/Batch", [data]()
+            {
+                TransformMath::TransformPointsBatch(&data->matrices[0], count,
+                    data->values[0].data(), data->values[1].data(), data->values[2].data(),
+                    data->outputs[0].data(), data->outputs[1].data(), data->outputs[2].data());
+                BenchmarkRunner::Consume((unsigned long long)data->outputs[0][1]);
+            }, (double)count);
+
+            runner.Add("Math/QuaternionMultiply/Scalar", [data]()
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    const float a[4] = { data->values[0][i], data->values[1][i], data->values[2][i], data->values[3][i] };
+                    const float b[4] = { data->values[4][i], data->values[5][i], data->values[6][i], data->values[7][i] };
+                    float result[4];
+                    TransformMath::QuaternionMultiply(a, b, result);
+                    for (int j = 0; j < 4; j++)
+                        data->outputs[j][i] = result[j];
+                }
+                BenchmarkRunner::Consume((unsigned long long)data->outputs[3][1]);
+            }, (double)count);
+
+            runner.Add("Math/QuaternionMultiply/Batch", [data]()
+            {
+                TransformMath::QuaternionMultiplyBatch(count,
+                    data->values[0].data(), data->values[1].data(), data->values[2].data(), data->values[3].data(),
+                    data->values[4].data(), data->values[5].data(), data->values[6].data(), data->values[7].data(),
+                    data->outputs[0].data(), data->outputs[1].data(), data->outputs[2].data(), data->outputs[3].data());
+                BenchmarkRunner::Consume((unsigned long long)data->outputs[3][1]);
+            }, (double)count);
+        }
+
+        struct CullingData
+        {
+            std::vector<float> boxes[6]; // Center x, y, z then extents
+            std::vector<unsigned char> visible;
+            std::vector<int> proxies;
+            std::vector<unsigned int> results;
+            BoundingVolumeTree tree;
+            Frustum frustum;
+            size_t frame = 0;
+        };
+
+        void AddCulling(BenchmarkRunner& runner)
+        {
+            const size_t count = 100000;
+            const size_t movedPerFrame = count / 10;
+
+            auto data = std::make_shared<CullingData>();
+            for (int i = 0; i < 6; i++)
+                data->boxes[i].resize(count);
+            data->visible.resize(count);
+            data->proxies.resize(count);
+
+            // Spread around a camera at the origin, so most are off screen
+            for (size_t i = 0; i < count; i++)
+            {
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    data->boxes[axis][i] = (float)((i * 7919 + axis * 104729) % 2000) - 1000.0f;
+                    data->boxes[3 + axis][i] = 0.5f + (float)((i * 31 + axis * 17) % 40) * 0.1f;
+                }
+
+                float min[3], max[3];
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    min[axis] = data->boxes[axis][i] - data->boxes[3 + axis][i];
+                    max[axis] = data->boxes[axis][i] + data->boxes[3 + axis][i];
+                }
+                data->proxies[i] = data->tree.CreateProxy(min, max, (unsigned int)i);
+            }
+
+            // 60 degree perspective looking down -z, near 0.1, far 1000
+            const float f = 1.0f / std::tan(0.5236f);
+            const float n = 0.1f, d = 1000.0f;
+            const float viewProjection[16] = {
+                f / 1.777f, 0.0f, 0.0f, 0.0f,
+                0.0f, f, 0.0f, 0.0f,
+                0.0f, 0.0f, -(d + n) / (d - n), -1.0f,
+                0.0f, 0.0f, -2.0f * d * n / (d - n), 0.0f };
+            data->frustum.SetFromMatrix(viewProjection);
+
+            runner.Add("Culling/Boxes/Scalar", [data]()
+            {
+                size_t visibleCount = 0;
+                for (size_t i = 0; i < count; i++)
+                {
+                    const float center[3] = { data->boxes[0][i], data->boxes[1][i], data->boxes[2][i] };
+                    const float extents[3] = { data->boxes[3][i], data->boxes[4][i], data->boxes[5][i] };
+                    visibleCount += data->frustum.TestBox(center, extents) != Frustum_Outside ? 1 : 0;
+                }
+                BenchmarkRunner::Consume(visibleCount);
+            }, (double)count);
+
+            runner.Add("Culling/Boxes/Batch", [data]()
+            {
+                data->frustum.TestBoxesBatch(count,
+                    data->boxes[0].data(), data->boxes[1].data(), data->boxes[2].data(),
+                    data->boxes[3].data(), data->boxes[4].data(), data->boxes[5].data(),
+                    data->visible.data());
+                BenchmarkRunner::Consume(data->visible[1]);
+            }, (double)count);
+
+            runner.Add("Culling/Tree/Static", [data]()
+            {
+                data->results.clear();
+                data->tree.QueryFrustum(data->frustum, data->results);
+                BenchmarkRunner::Consume(data->results.size());
+            }, (double)count);
+
+            // Moves a different 10% of the boxes every run, back and forth
+            runner.Add("Culling/Tree/Moving", [data]()
+            {
+                const float offset = (data->frame % 2 == 0) ? 0.3f : -0.3f;
+                const size_t begin = (data->frame / 2 * movedPerFrame) % count;
+                for (size_t j = 0; j < movedPerFrame; j++)
+                {
+                    const size_t i = (begin + j) % count;
+                    data->boxes[0][i] += offset;
+
+                    float min[3], max[3];
+                    for (int axis = 0; axis < 3; axis++)
+                    {
+                        min[axis] = data->boxes[axis][i] - data->boxes[3 + axis][i];
+                        max[axis] = data->boxes[axis][i] + data->boxes[3 + axis][i];
+                    }
+                    data->tree.MoveProxy(data->proxies[i], min, max);
+                }
+                data->frame++;
+
+                data->results.clear();
+                data->tree.QueryFrustum(data->frustum, data->results);
+                BenchmarkRunner::Consume(data->results.size());
+            }, (double)count);
+        }
+    }
+
+}
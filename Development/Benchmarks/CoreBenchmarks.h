@@ -0,0 +1,51 @@
+#ifndef _Core_Benchmarks_H_
+#define _Core_Benchmarks_H_
+
+// Benchmark cases for engine code that doesn't use the framework at run
+// time, so they run without Framework::Startup, a window or a display.
+// Built by Benchmarks.vcxproj with the engine cases, and on its own by
+// CMakeLists.txt (see CoreMain.cpp).
+
+#include <string>
+
+namespace QwerkE {
+
+    class BenchmarkRunner;
+
+    namespace CoreBenchmarks
+    {
+        // Read and parse every .qscene in assetsDir/Scenes/ and a generated
+        // 10k object scene, as JSON and as cooked binary files
+        void AddSceneLoad(BenchmarkRunner& runner, const char* assetsDir);
+
+        // Import the large .obj meshes in assetsDir/Meshes/, and load
+        // their cooked binary versions, with float and quantized vertices
+        void AddMeshImport(BenchmarkRunner& runner, const char* assetsDir);
+
+        // Parse the large .obj meshes in assetsDir/Meshes/ with ObjImporter
+        // on 1 and all threads, and their .mtl libraries, in MB per second
+        void AddObjImport(BenchmarkRunner& runner, const char* assetsDir);
+
+        // Run MeshOptimizer on the large .obj meshes in assetsDir/Meshes/,
+        // in triangles per second. Prints their ACMR before and after.
+        void AddMeshOptimize(BenchmarkRunner& runner, const char* assetsDir);
+
+        // Transform routines on 1k, 10k and 100k entities as a routine
+        // batch, on 1 and all threads of a TaskScheduler
+        void AddRoutineBatches(BenchmarkRunner& runner);
+
+        // Scalar and SIMD (SSE2 or AVX, whichever the build targets)
+        // versions of the transform math kernels
+        void AddMathKernels(BenchmarkRunner& runner);
+
+        // Frustum culling of 100k boxes, tested 1 by 1, in SIMD batches and
+        // through a bounding volume tree, with and without objects moving
+        void AddCulling(BenchmarkRunner& runner);
+
+        // Writes a .qscene of objectCount objects in a grid, as the
+        // framework saves them
+        bool WriteGeneratedScene(const std::string& filePath, int objectCount);
+    }
+
+}
+#endif // _Core_Benchmarks_H_
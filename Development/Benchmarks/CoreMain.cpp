@@ -0,0 +1,56 @@
+// Standalone harness for the core benchmarks. It doesn't start the
+// framework, so it runs on machines without a display, and builds on Linux
+// through CMakeLists.txt. Benchmarks.exe runs these cases as well.
+//
+// CoreBenchmarks -output results.json -filter Culling -minSeconds 2 -assetsDir Assets/
+//
+// Results are written as JSON to -output, or stdout if not given.
+// Progress and a readable summary go to stderr. Exits with 1 when a case's
+// results were wrong.
+
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+using namespace QwerkE;
+
+// Arguments are "-key value" pairs, as the framework's ProgramArgs reads them
+static const char* FindArgument(int argc, char** argv, const char* key)
+{
+    for (int i = 1; i + 1 < argc; i++)
+    {
+        if (strcmp(argv[i], key) == 0)
+            return argv[i + 1];
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    const char* output = FindArgument(argc, argv, "-output");
+    const char* filter = FindArgument(argc, argv, "-filter");
+    const char* minSeconds = FindArgument(argc, argv, "-minSeconds");
+    const char* assetsDir = FindArgument(argc, argv, "-assetsDir");
+    if (assetsDir == nullptr)
+        assetsDir = "Assets/";
+
+    BenchmarkRunner runner;
+    runner.SetFilter(filter);
+    if (minSeconds)
+        runner.SetMinSeconds(atof(minSeconds));
+
+    CoreBenchmarks::AddSceneLoad(runner, assetsDir);
+    CoreBenchmarks::AddMeshImport(runner, assetsDir);
+    CoreBenchmarks::AddObjImport(runner, assetsDir);
+    CoreBenchmarks::AddMeshOptimize(runner, assetsDir);
+    CoreBenchmarks::AddRoutineBatches(runner);
+    CoreBenchmarks::AddMathKernels(runner);
+    CoreBenchmarks::AddCulling(runner);
+
+    runner.RunAll();
+    const bool written = runner.WriteJson(output ? output : "-");
+    return written && !runner.Failed() ? 0 : 1;
+}
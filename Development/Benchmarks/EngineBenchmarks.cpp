@@ -0,0 +1,473 @@
+#include "EngineBenchmarks.h"
+#include "CoreBenchmarks.h"
+#include "BenchmarkRunner.h"
+
+#include "../../Source/Core/Math/TransformMath.h"
+#include "../../Source/Core/Entities/EntityStore.h"
+#include "../../Source/Core/Entities/ObjectHandles.h"
+#include "../../Source/Core/Scenes/SceneJournal.h"
+#include "../../Source/Core/Scenes/Prefabs.h"
+
+#include "../../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../../QwerkE_Framework/Source/Core/Resources/Resources.h"
+#include "../../QwerkE_Framework/Source/Core/Scenes/Scenes.h"
+#include "../../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace EngineBenchmarks
+    {
+        void AddSceneSave(BenchmarkRunner& runner)
+        {
+            const std::filesystem::path tempDir = std::filesystem::temp_directory_path();
+            const std::string scenePath = (tempDir / "SaveGenerated10k.qscene").string();
+            if (!CoreBenchmarks::WriteGeneratedScene(scenePath, 10000))
+            {
+                fprintf(stderr, "Skipping scene save. Could not write %s.\n", scenePath.c_str());
+                return;
+            }
+
+            auto snapshot = std::make_shared<SceneSnapshot>();
+            SceneJournal::ReadScene(scenePath.c_str(), *snapshot);
+
+            char* fileData = LoadCompleteFile(scenePath.c_str(), nullptr);
+            std::shared_ptr<cJSON> root(cJSON_Parse(fileData), cJSON_Delete);
+            delete[] fileData;
+
+            // Move 1% of the objects, in the snapshot and in the parsed file
+            auto moved = std::make_shared<std::vector<const EntitySnapshot*>>();
+            for (size_t i = 0; i < snapshot->entities.size(); i += 100)
+            {
+                EntitySnapshot& entity = snapshot->entities[i];
+                entity.position[1] += 1.0f;
+                moved->push_back(&entity);
+
+                cJSON* object = cJSON_GetArrayItem(cJSON_GetObjectItem(cJSON_GetArrayItem(cJSON_GetObjectItem(root.get(), "ObjectList"), 0), entity.name.c_str()), 0);
+                cJSON* y = cJSON_GetObjectItem(cJSON_GetArrayItem(cJSON_GetObjectItem(object, "Position"), 0), "PositionY");
+                if (y)
+                {
+                    y->valuedouble = entity.position[1];
+                    y->valueint = (int)y->valuedouble;
+                }
+            }
+
+            // What the editor's Save used to write: every object
+            const std::string fullPath = (tempDir / "SaveGenerated10k.full.qscene").string();
+            auto writeFull = [root, fullPath]()
+            {
+                char* text = cJSON_Print(root.get());
+                FILE* file = fopen(fullPath.c_str(), "wb");
+                if (file && text)
+                {
+                    BenchmarkRunner::Consume(fwrite(text, 1, strlen(text), file));
+                }
+                if (file)
+                    fclose(file);
+                free(text);
+            };
+            runner.Add("SceneSave/Full/10k", writeFull, (double)snapshot->entities.size());
+
+            // The journal, compacted into a copy of the scene, must read back
+            // as the full save does
+            BenchmarkRunner* failures = &runner;
+            const std::string compactedPath = (tempDir / "SaveGenerated10k.compacted.qscene").string();
+            auto verify = [failures, scenePath, compactedPath, fullPath, moved, writeFull]()
+            {
+                std::error_code error;
+                std::filesystem::copy_file(scenePath, compactedPath, std::filesystem::copy_options::overwrite_existing, error);
+                remove(SceneJournal::JournalPath(compactedPath.c_str()).c_str());
+                writeFull();
+
+                SceneSnapshot full;
+                SceneSnapshot compacted;
+                if (error || !SceneJournal::Append(compactedPath.c_str(), *moved, std::vector<const EntitySnapshot*>()) ||
+                    !SceneJournal::Compact(compactedPath.c_str()) ||
+                    !SceneJournal::ReadScene(fullPath.c_str(), full) || !SceneJournal::ReadScene(compactedPath.c_str(), compacted))
+                {
+                    failures->Fail("SceneSave/Journal/10k_1%: could not write and compact the journal to check it");
+                    return;
+                }
+
+                std::map<std::string, const EntitySnapshot*> fullEntities;
+                for (const EntitySnapshot& entity : full.entities)
+                {
+                    fullEntities[entity.Key()] = &entity;
+                }
+
+                if (fullEntities.size() != compacted.entities.size())
+                {
+                    failures->Fail("SceneSave/Journal/10k_1%: " + std::to_string(compacted.entities.size()) + " entities after compacting, " + std::to_string(fullEntities.size()) + " in the full save");
+                    return;
+                }
+
+                for (const EntitySnapshot& entity : compacted.entities)
+                {
+                    auto it = fullEntities.find(entity.Key());
+                    if (it == fullEntities.end() || *it->second != entity)
+                    {
+                        failures->Fail("SceneSave/Journal/10k_1%: " + entity.name + " compacted differs from the full save");
+                        return;
+                    }
+                }
+                remove(compactedPath.c_str());
+            };
+
+            // What it writes now
+            runner.Add("SceneSave/Journal/10k_1%", [scenePath, snapshot, moved]()
+            {
+                BenchmarkRunner::Consume(SceneJournal::Append(scenePath.c_str(), *moved, std::vector<const EntitySnapshot*>()));
+                remove(SceneJournal::JournalPath(scenePath.c_str()).c_str()); // Keep the journal from growing
+            }, (double)snapshot->entities.size(), verify);
+        }
+
+        void AddEntityUpdate(BenchmarkRunner& runner)
+        {
+            const unsigned int counts[] = { 1000, 10000, 100000 };
+            for (unsigned int count : counts)
+            {
+                auto objects = std::make_shared<std::vector<GameObject*>>();
+
+                // The per object work of a simulated frame. Read and write the
+                // transform like an update routine, then build the world matrix
+                // like render snapshots do.
+                auto update = [objects]()
+                {
+                    const float deltaTime = 1.0f / 60.0f;
+                    float matrix[16];
+                    float checksum = 0.0f;
+                    for (GameObject* object : *objects)
+                    {
+                        vec3 position = object->GetPosition();
+                        vec3 rotation = object->GetRotation();
+                        position.x += deltaTime;
+                        rotation.y += 90.0f * deltaTime;
+                        object->SetPosition(position);
+                        object->SetRotation(rotation);
+
+                        const vec3 scale = object->GetScale();
+                        const float pos[3] = { position.x, position.y, position.z };
+                        const float rot[3] = { rotation.x, rotation.y, rotation.z };
+                        const float scl[3] = { scale.x, scale.y, scale.z };
+                        TransformMath::ComposeSRT(pos, rot, scl, matrix);
+                        checksum += matrix[12];
+                    }
+                    BenchmarkRunner::Consume((unsigned long long)checksum);
+                };
+
+                auto setup = [objects, count]()
+                {
+                    Scene* scene = Scenes::GetCurrentScene();
+                    objects->reserve(count);
+                    for (unsigned int i = 0; i < count; i++)
+                    {
+                        GameObject* object = new GameObject(scene);
+                        object->SetPosition(vec3((float)(i % 100), (float)(i / 100 % 100), (float)(i / 10000)));
+                        objects->push_back(object);
+                    }
+                };
+
+                auto teardown = [objects]()
+                {
+                    for (GameObject* object : *objects)
+                    {
+                        delete object;
+                    }
+                    objects->clear();
+                };
+
+                const std::string name = "EntityUpdate/" + std::to_string(count);
+                runner.Add(name.c_str(), update, (double)count, setup, teardown);
+
+                // The same frame over EntityStore arrays
+                auto store = std::make_shared<EntityStore>();
+
+                auto storeUpdate = [store]()
+                {
+                    const float deltaTime = 1.0f / 60.0f;
+                    float checksum = 0.0f;
+                    for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+                    {
+                        EntityArchetype& archetype = store->GetArchetype(i);
+                        const size_t size = archetype.Size();
+                        float* positionX = archetype.positionX.data();
+                        float* rotationY = archetype.rotationY.data();
+                        unsigned char* dirty = archetype.transformDirty.data();
+                        for (size_t row = 0; row < size; row++)
+                        {
+                            positionX[row] += deltaTime;
+                            rotationY[row] += 90.0f * deltaTime;
+                            dirty[row] = 1;
+                        }
+                    }
+
+                    store->UpdateWorldMatrices();
+
+                    for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+                    {
+                        const EntityArchetype& archetype = store->GetArchetype(i);
+                        for (size_t row = 0; row < archetype.Size(); row++)
+                        {
+                            checksum += archetype.worldMatrices[row * 16 + 12];
+                        }
+                    }
+                    BenchmarkRunner::Consume((unsigned long long)checksum);
+                };
+
+                auto storeSetup = [store, count]()
+                {
+                    const float rotation[3] = { 0.0f, 0.0f, 0.0f };
+                    const float scale[3] = { 1.0f, 1.0f, 1.0f };
+                    for (unsigned int i = 0; i < count; i++)
+                    {
+                        const float position[3] = { (float)(i % 100), (float)(i / 100 % 100), (float)(i / 10000) };
+                        const EntityHandle entity = store->Create(EntityComponent_Render);
+                        store->SetTransform(entity, position, rotation, scale);
+                    }
+                };
+
+                auto storeTeardown = [store]()
+                {
+                    store->Clear();
+                };
+
+                const std::string storeName = "EntityUpdate/Store/" + std::to_string(count);
+                runner.Add(storeName.c_str(), storeUpdate, (double)count, storeSetup, storeTeardown);
+            }
+        }
+
+        // Stand in for a framework routine. One heap object and one virtual
+        // call per object, like Routine::Update().
+        class VirtualRoutine
+        {
+        public:
+            virtual ~VirtualRoutine() {}
+            virtual void Update(double deltaTime) = 0;
+        };
+
+        class VirtualTransformRoutine : public VirtualRoutine
+        {
+        public:
+            VirtualTransformRoutine(GameObject* parent) : m_Parent(parent) {}
+
+            void Update(double deltaTime) override
+            {
+                const float step = m_Speed * (float)deltaTime;
+                vec3 position = m_Parent->GetPosition();
+                vec3 rotation = m_Parent->GetRotation();
+                position.x += m_PositionOffset * step;
+                rotation.y += m_RotationOffset * step;
+                m_Parent->SetPosition(position);
+                m_Parent->SetRotation(rotation);
+            }
+
+        private:
+            GameObject* m_Parent;
+            float m_Speed = 0.5f;
+            float m_PositionOffset = 1.0f;
+            float m_RotationOffset = 90.0f;
+        };
+
+        void AddRoutineUpdate(BenchmarkRunner& runner)
+        {
+            const unsigned int counts[] = { 1000, 10000, 100000 };
+            const double deltaTime = 1.0 / 60.0;
+
+            for (unsigned int count : counts)
+            {
+                auto objects = std::make_shared<std::vector<GameObject*>>();
+                auto routines = std::make_shared<std::vector<VirtualRoutine*>>();
+
+                auto virtualSetup = [objects, routines, count]()
+                {
+                    Scene* scene = Scenes::GetCurrentScene();
+                    for (unsigned int i = 0; i < count; i++)
+                    {
+                        GameObject* object = new GameObject(scene);
+                        objects->push_back(object);
+                        routines->push_back(new VirtualTransformRoutine(object));
+                    }
+                };
+
+                auto virtualTeardown = [objects, routines]()
+                {
+                    for (VirtualRoutine* routine : *routines)
+                        delete routine;
+                    for (GameObject* object : *objects)
+                        delete object;
+                    routines->clear();
+                    objects->clear();
+                };
+
+                const std::string virtualName = "RoutineUpdate/Virtual/" + std::to_string(count);
+                runner.Add(virtualName.c_str(), [routines, deltaTime]()
+                {
+                    for (VirtualRoutine* routine : *routines)
+                    {
+                        routine->Update(deltaTime);
+                    }
+                }, (double)count, virtualSetup, virtualTeardown);
+            }
+        }
+
+        void AddResourceLookup(BenchmarkRunner& runner)
+        {
+            // Only names that are already loaded. A miss would start a load.
+            auto meshNames = std::make_shared<std::vector<std::string>>();
+            auto materialNames = std::make_shared<std::vector<std::string>>();
+            auto shaderNames = std::make_shared<std::vector<std::string>>();
+
+            for (const auto& p : *Resources::SeeMeshes())
+                meshNames->push_back(p.first);
+            for (const auto& p : *Resources::SeeMaterials())
+                materialNames->push_back(p.first);
+            for (const auto& p : *Resources::SeeShaderPrograms())
+                shaderNames->push_back(p.first);
+
+            const size_t lookups = meshNames->size() + materialNames->size() + shaderNames->size();
+            if (lookups == 0)
+            {
+                fprintf(stderr, "Skipping resource lookup. No resources are loaded.\n");
+                return;
+            }
+
+            runner.Add("ResourceLookup/ByName", [meshNames, materialNames, shaderNames]()
+            {
+                unsigned long long found = 0;
+                for (const std::string& name : *meshNames)
+                    found += Resources::GetMesh(name.c_str()) != nullptr;
+                for (const std::string& name : *materialNames)
+                    found += Resources::GetMaterial(name.c_str()) != nullptr;
+                for (const std::string& name : *shaderNames)
+                    found += Resources::GetShaderProgram(name.c_str()) != nullptr;
+                BenchmarkRunner::Consume(found);
+            }, (double)lookups);
+        }
+
+        void AddEntityLookup(BenchmarkRunner& runner)
+        {
+            const size_t count = 10000;
+
+            // Lookups never dereference the objects, so any unique address will do
+            auto objectMemory = std::make_shared<std::vector<char>>(count);
+            auto names = std::make_shared<std::map<std::string, GameObject*>>(); // As Scene keys its objects
+            auto nameOrder = std::make_shared<std::vector<std::string>>();
+            auto handles = std::make_shared<ObjectHandleTable>();
+            auto handleOrder = std::make_shared<std::vector<ObjectHandle>>();
+
+            for (size_t i = 0; i < count; i++)
+            {
+                GameObject* object = (GameObject*)&(*objectMemory)[i];
+                const std::string name = "Object" + std::to_string(i);
+                (*names)[name] = object;
+                nameOrder->push_back(name);
+                handleOrder->push_back(handles->Create(object));
+            }
+
+            // Shuffled, as editor and gameplay lookups don't follow storage order
+            std::srand(1);
+            for (size_t i = count - 1; i > 0; i--)
+            {
+                const size_t j = (size_t)std::rand() % (i + 1);
+                std::swap((*nameOrder)[i], (*nameOrder)[j]);
+                std::swap((*handleOrder)[i], (*handleOrder)[j]);
+            }
+
+            runner.Add("EntityLookup/ByName/10k", [names, nameOrder]()
+            {
+                unsigned long long found = 0;
+                for (const std::string& name : *nameOrder)
+                    found += names->find(name) != names->end();
+                BenchmarkRunner::Consume(found);
+            }, (double)count);
+
+            // Names as they are usually given, built from a char* each time
+            runner.Add("EntityLookup/ByNameString/10k", [names, nameOrder]()
+            {
+                unsigned long long found = 0;
+                for (const std::string& name : *nameOrder)
+                    found += names->find(std::string(name.c_str())) != names->end();
+                BenchmarkRunner::Consume(found);
+            }, (double)count);
+
+            runner.Add("EntityLookup/ByHandle/10k", [handles, handleOrder]()
+            {
+                unsigned long long found = 0;
+                for (const ObjectHandle handle : *handleOrder)
+                    found += handles->Resolve(handle) != nullptr;
+                BenchmarkRunner::Consume(found);
+            }, (double)count);
+        }
+
+        void AddPrefabInstantiate(BenchmarkRunner& runner)
+        {
+            const unsigned int count = 10000;
+
+            // Null resources, which are there without a renderer
+            const std::string schematicPath = (std::filesystem::temp_directory_path() / "BenchmarkProp.osch").string();
+            FILE* file = fopen(schematicPath.c_str(), "w");
+            if (file == nullptr)
+            {
+                fprintf(stderr, "Skipping prefab instantiate. %s could not be written.\n", schematicPath.c_str());
+                return;
+            }
+            fprintf(file,
+                "{\n\t\"Name\": \"BenchmarkProp.osch\",\n\t\"Renderables\": [{\n"
+                "\t\t\"Prop\": [{ \"Shader\": \"null_shader.ssch\", \"Material\": \"null_material.msch\", \"MeshFile\": \"null_mesh.obj\", \"MeshName\": \"null_mesh\" }]\n"
+                "\t}]\n}\n");
+            fclose(file);
+
+            auto transforms = std::make_shared<std::vector<PrefabTransform>>(count);
+            for (unsigned int i = 0; i < count; i++)
+            {
+                PrefabTransform& transform = (*transforms)[i];
+                transform = { { (float)(i % 100), (float)(i / 100), 50.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+            }
+
+            // Each iteration also deletes the last one's instances, which
+            // costs the same for both cases
+            auto instances = std::make_shared<std::vector<GameObject*>>();
+            auto teardown = [instances]()
+            {
+                for (GameObject* object : *instances)
+                {
+                    delete object;
+                }
+                instances->clear();
+            };
+
+            // As spawning through Factory helpers did, every instance parses
+            // the schematic and looks up its resources again
+            runner.Add("Prefab/CompileEach/10k", [schematicPath, transforms, instances, teardown]()
+            {
+                teardown();
+                Scene* scene = Scenes::GetCurrentScene();
+                for (unsigned int i = 0; i < count; i++)
+                {
+                    Prefabs::Clear();
+                    PrefabTemplate* prefab = Prefabs::Load(schematicPath.c_str());
+                    Prefabs::Instantiate(*prefab, scene, 1, &(*transforms)[i], *instances);
+                }
+                BenchmarkRunner::Consume(instances->size());
+            }, (double)count, nullptr, teardown);
+
+            runner.Add("Prefab/Instantiate/10k", [schematicPath, transforms, instances, teardown]()
+            {
+                teardown();
+                PrefabTemplate* prefab = Prefabs::Load(schematicPath.c_str());
+                Prefabs::Instantiate(*prefab, Scenes::GetCurrentScene(), count, transforms->data(), *instances);
+                BenchmarkRunner::Consume(instances->size());
+            }, (double)count, nullptr, teardown);
+        }
+    }
+
+}
@@ -0,0 +1,41 @@
+#ifndef _Engine_Benchmarks_H_
+#define _Engine_Benchmarks_H_
+
+// Benchmark cases for engine systems that work on framework objects, like
+// GameObjects, scenes and resources. They need Framework::Startup, which
+// opens a window, so they only run where there is a display. Cases that
+// don't are in CoreBenchmarks.h.
+
+namespace QwerkE {
+
+    class BenchmarkRunner;
+
+    namespace EngineBenchmarks
+    {
+        // Write a generated 10k object scene in full, and as a journal of
+        // the 1% of objects that moved
+        void AddSceneSave(BenchmarkRunner& runner);
+
+        // Integrate and compose transforms for 1k, 10k and 100k objects,
+        // as GameObjects and as EntityStore entities
+        void AddEntityUpdate(BenchmarkRunner& runner);
+
+        // Transform routines on 1k, 10k and 100k objects as per object
+        // virtual calls. CoreBenchmarks::AddRoutineBatches() runs the same
+        // work as a routine batch.
+        void AddRoutineUpdate(BenchmarkRunner& runner);
+
+        // Look up every loaded resource by name
+        void AddResourceLookup(BenchmarkRunner& runner);
+
+        // Find 10k objects in a random order by name, as the scene's object
+        // map does, and through ObjectHandles
+        void AddEntityLookup(BenchmarkRunner& runner);
+
+        // Instantiate 10k props from a compiled prefab template, and with
+        // the schematic compiled again for every prop
+        void AddPrefabInstantiate(BenchmarkRunner& runner);
+    }
+
+}
+#endif // _Engine_Benchmarks_H_
@@ -0,0 +1,84 @@
+// Engine benchmark harness. Runs without the renderer, audio or physics.
+// Framework::Startup still opens a window, so a display is needed. The
+// harness only builds through Benchmarks.vcxproj, as the framework ships
+// Visual Studio projects only. CoreMain.cpp runs the cases that don't need
+// the framework, without a display and on Linux.
+//
+// Benchmarks.exe -output results.json -filter EntityUpdate -minSeconds 2 -assetsDir Assets/
+//
+// Results are written as JSON to -output, or stdout if not given.
+// Progress and a readable summary go to stderr. Exits with 1 when a case's
+// results were wrong.
+
+#include "BenchmarkRunner.h"
+#include "CoreBenchmarks.h"
+#include "EngineBenchmarks.h"
+
+#include "../../QwerkE_Framework/Source/Framework.h"
+#include "../../QwerkE_Framework/Source/Utilities/ProgramArgs.h"
+#include "../../QwerkE_Framework/Source/Core/Scenes/Scenes.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <map>
+
+using namespace QwerkE;
+
+static const char* FindArgument(const std::map<const char*, const char*>& args, const char* key)
+{
+    for (const auto& p : args)
+    {
+        if (p.first && strcmp(p.first, key) == 0)
+            return p.second;
+    }
+    return nullptr;
+}
+
+int main(int argc, char** argv)
+{
+    const std::map<const char*, const char*> args = ArgumentKeyValuePairs(argc, argv);
+
+    const char* output = FindArgument(args, "-output");
+    const char* filter = FindArgument(args, "-filter");
+    const char* minSeconds = FindArgument(args, "-minSeconds");
+    const char* assetsDir = FindArgument(args, "-assetsDir");
+    if (assetsDir == nullptr)
+        assetsDir = "Assets/";
+
+    // Same setup as the engine's -headless mode. The window is still created.
+    std::uint_fast8_t flags = 0;
+    flags &= ~Flag_Physics;
+    flags &= ~Flag_Renderer;
+    flags &= ~Flag_Audio;
+
+    if (Framework::Startup(ConfigsFolderPath("preferences.qpref"), flags) == eEngineMessage::_QFailure)
+    {
+        fprintf(stderr, "Qwerk Framework failed to load\n");
+        return 1;
+    }
+
+    BenchmarkRunner runner;
+    runner.SetFilter(filter);
+    if (minSeconds)
+        runner.SetMinSeconds(atof(minSeconds));
+
+    CoreBenchmarks::AddSceneLoad(runner, assetsDir);
+    EngineBenchmarks::AddSceneSave(runner);
+    CoreBenchmarks::AddMeshImport(runner, assetsDir);
+    CoreBenchmarks::AddObjImport(runner, assetsDir);
+    CoreBenchmarks::AddMeshOptimize(runner, assetsDir);
+    EngineBenchmarks::AddEntityUpdate(runner);
+    EngineBenchmarks::AddRoutineUpdate(runner);
+    CoreBenchmarks::AddRoutineBatches(runner);
+    CoreBenchmarks::AddMathKernels(runner);
+    CoreBenchmarks::AddCulling(runner);
+    EngineBenchmarks::AddResourceLookup(runner);
+    EngineBenchmarks::AddEntityLookup(runner);
+    EngineBenchmarks::AddPrefabInstantiate(runner);
+
+    runner.RunAll();
+    const bool written = runner.WriteJson(output ? output : "-");
+
+    Framework::TearDown();
+    return written && !runner.Failed() ? 0 : 1;
+}
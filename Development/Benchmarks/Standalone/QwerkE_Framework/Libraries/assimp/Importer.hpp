@@ -0,0 +1,2 @@
+// The standalone benchmark build uses the system's assimp
+#include <assimp/Importer.hpp>
@@ -0,0 +1,34 @@
+#ifndef _Standalone_Log_H_
+#define _Standalone_Log_H_
+
+// Stands in for the framework's Log.h in the standalone benchmark build.
+// Writes to stderr, replacing {0}, {1}... with the arguments.
+
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace StandaloneLog
+    {
+        void Write(const char* level, const char* format, const std::vector<std::string>& args);
+
+        // Arguments by value, so static const members passed in need no
+        // definition, as with MSVC
+        template <typename... Args>
+        void Log(const char* level, const char* format, Args... args)
+        {
+            std::vector<std::string> strings;
+            ((strings.push_back((std::ostringstream() << args).str())), ...);
+            Write(level, format, strings);
+        }
+    }
+
+}
+
+#define LOG_INFO(...) QwerkE::StandaloneLog::Log("info", __VA_ARGS__)
+#define LOG_WARN(...) QwerkE::StandaloneLog::Log("warn", __VA_ARGS__)
+#define LOG_ERROR(...) QwerkE::StandaloneLog::Log("error", __VA_ARGS__)
+
+#endif // _Standalone_Log_H_
@@ -0,0 +1,15 @@
+#ifndef _Standalone_Profiler_H_
+#define _Standalone_Profiler_H_
+
+// Stands in for the framework's Profiler.h in the standalone benchmark
+// build. Scopes record nothing unless TraceRecorder is enabled.
+
+class InstrumentationTimer
+{
+public:
+    InstrumentationTimer(const char*) {}
+};
+
+#define PROFILE_SCOPE(name)
+
+#endif // _Standalone_Profiler_H_
@@ -0,0 +1,10 @@
+#ifndef _Standalone_File_Utilities_H_
+#define _Standalone_File_Utilities_H_
+
+// Stands in for the framework's FileUtilities.h in the standalone benchmark
+// build. Only what the core benchmarks use.
+
+// Null terminated, free with delete[]. Null if the file can't be read.
+char* LoadCompleteFile(const char* filename, long* length);
+
+#endif // _Standalone_File_Utilities_H_
@@ -0,0 +1,57 @@
+// What the standalone benchmark build uses of the framework. See the
+// headers in ../QwerkE_Framework/.
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+
+#include <cstdio>
+
+namespace QwerkE {
+
+    namespace StandaloneLog
+    {
+        void Write(const char* level, const char* format, const std::vector<std::string>& args)
+        {
+            std::string message;
+            for (const char* c = format; *c; c++)
+            {
+                size_t index = 0;
+                const char* end = c + 1;
+                while (*c == '{' && *end >= '0' && *end <= '9')
+                    index = index * 10 + (size_t)(*end++ - '0');
+
+                if (*c == '{' && end > c + 1 && *end == '}' && index < args.size())
+                {
+                    message += args[index];
+                    c = end;
+                }
+                else
+                {
+                    message += *c;
+                }
+            }
+            fprintf(stderr, "[%s] %s\n", level, message.c_str());
+        }
+    }
+
+}
+
+char* LoadCompleteFile(const char* filename, long* length)
+{
+    FILE* file = fopen(filename, "rb");
+    if (file == nullptr)
+        return nullptr;
+
+    fseek(file, 0, SEEK_END);
+    const long size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    char* data = new char[size + 1];
+    const size_t read = fread(data, 1, (size_t)size, file);
+    fclose(file);
+    data[read] = '\0';
+
+    if (length)
+        *length = (long)read;
+    return data;
+}
@@ -0,0 +1,117 @@
+#include "EngineSettings.h"
+
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <thread>
+
+namespace QwerkE {
+
+    namespace EngineSettingsLoader
+    {
+        // .qpref sections are stored as "Section": [{ "Key": value, ... }]
+        static cJSON* GetSectionValue(cJSON* section, const char* key)
+        {
+            if (section == nullptr)
+                return nullptr;
+
+            cJSON* values = cJSON_GetArrayItem(section, 0);
+            if (values == nullptr)
+                return nullptr;
+
+            cJSON* item = cJSON_GetObjectItem(values, key);
+            if (item == nullptr || !cJSON_IsNumber(item))
+                return nullptr;
+
+            return item;
+        }
+
+        static void ReadBool(cJSON* section, const char* key, bool& value)
+        {
+            if (cJSON* item = GetSectionValue(section, key))
+                value = item->valueint != 0;
+        }
+
+        template <class T>
+        static void ReadUnsigned(cJSON* section, const char* key, T& value, T minValue)
+        {
+            if (cJSON* item = GetSectionValue(section, key))
+            {
+                if (item->valueint >= (int)minValue)
+                    value = (T)item->valueint;
+                else
+                    LOG_WARN("EngineSettings: {0} value {1} is below minimum {2}", key, item->valueint, (int)minValue);
+            }
+        }
+
+        EngineSettings Load(const char* preferencesFilePath)
+        {
+            EngineSettings settings;
+
+            if (!FileExists(preferencesFilePath))
+            {
+                LOG_WARN("EngineSettings: Could not find {0}. Using defaults.", preferencesFilePath);
+                return settings;
+            }
+
+            char* fileData = LoadCompleteFile(preferencesFilePath, nullptr);
+            cJSON* root = cJSON_Parse(fileData);
+            delete[] fileData;
+
+            if (root == nullptr)
+            {
+                LOG_ERROR("EngineSettings: Error parsing {0}. Using defaults.", preferencesFilePath);
+                return settings;
+            }
+
+            cJSON* engine = cJSON_GetObjectItem(root, "Engine");
+
+            ReadBool(engine, "FixedTimestepEnabled", settings.FixedTimestepEnabled);
+            ReadUnsigned(engine, "SimulationTickRate", settings.SimulationTickRate, (unsigned short)1);
+            ReadUnsigned(engine, "MaxSimulationStepsPerFrame", settings.MaxSimulationStepsPerFrame, (unsigned char)1);
+            ReadBool(engine, "RenderInterpolationEnabled", settings.RenderInterpolationEnabled);
+
+            ReadBool(engine, "FramePacingEnabled", settings.FramePacingEnabled);
+            ReadUnsigned(engine, "FPS_Max", settings.FPS_Max, (unsigned short)1);
+            ReadUnsigned(engine, "FramePacingSpinMicroseconds", settings.FramePacingSpinMicroseconds, (unsigned short)0);
+
+            ReadBool(engine, "PipelinedFramesEnabled", settings.PipelinedFramesEnabled);
+            ReadBool(engine, "FrameGraphEnabled", settings.FrameGraphEnabled);
+            ReadBool(engine, "ParallelSceneUpdatesEnabled", settings.ParallelSceneUpdatesEnabled);
+
+            ReadBool(engine, "TraceRecorderEnabled", settings.TraceRecorderEnabled);
+
+            ReadBool(engine, "CookedScenesEnabled", settings.CookedScenesEnabled);
+
+            ReadBool(engine, "AsyncMeshLoadingEnabled", settings.AsyncMeshLoadingEnabled);
+            ReadUnsigned(engine, "MeshUploadBudgetMicroseconds", settings.MeshUploadBudgetMicroseconds, (unsigned short)0);
+            ReadBool(engine, "CookedMeshesEnabled", settings.CookedMeshesEnabled);
+            ReadBool(engine, "QuantizedMeshesEnabled", settings.QuantizedMeshesEnabled);
+
+            cJSON* scenes = cJSON_GetArrayItem(cJSON_GetObjectItem(root, "Scenes"), 0);
+            cJSON* startupScene = scenes ? cJSON_GetObjectItem(scenes, "0") : nullptr;
+            if (startupScene && cJSON_IsString(startupScene))
+                settings.StartupSceneFile = startupScene->valuestring;
+
+            bool multiThreaded = false;
+            ReadBool(cJSON_GetObjectItem(root, "Systems"), "JobManagerMultiThreadedEnabled", multiThreaded);
+            if (multiThreaded)
+            {
+                unsigned short maxThreads = 1;
+                ReadUnsigned(cJSON_GetObjectItem(root, "Framework"), "MaxConcurrentThreadCount", maxThreads, (unsigned short)1);
+
+                unsigned int hardwareThreads = std::thread::hardware_concurrency();
+                if (hardwareThreads > 0 && maxThreads > hardwareThreads)
+                    maxThreads = (unsigned short)hardwareThreads;
+
+                // The main thread counts towards the limit
+                settings.WorkerThreadCount = (unsigned char)(maxThreads - 1 > 255 ? 255 : maxThreads - 1);
+            }
+
+            cJSON_Delete(root);
+            return settings;
+        }
+    }
+
+}
@@ -0,0 +1,74 @@
+#ifndef _Engine_Settings_H_
+#define _Engine_Settings_H_
+
+// Engine specific values read from the "Engine" section of a
+// preferences (.qpref) file. The framework ignores this section
+// so the same file can be shared by both.
+
+#include <string>
+
+namespace QwerkE {
+
+    struct EngineSettings
+    {
+        // Simulation
+        bool FixedTimestepEnabled = true;
+        unsigned short SimulationTickRate = 60; // Ticks per second
+        unsigned char MaxSimulationStepsPerFrame = 5; // Limit catch up after a stall
+        bool RenderInterpolationEnabled = true;
+
+        // Frame pacing
+        bool FramePacingEnabled = true;
+        unsigned short FPS_Max = 144;
+        unsigned short FramePacingSpinMicroseconds = 1500; // Busy wait window at the end of a frame
+
+        // Draw frame N on a render thread while frame N + 1 is simulated.
+        // Refused with an error for now, as the editor and mesh streaming
+        // don't work with it yet.
+        bool PipelinedFramesEnabled = false;
+
+        // Jobs
+        // Read from the framework's "MaxConcurrentThreadCount" and
+        // "JobManagerMultiThreadedEnabled" values. Excludes the main thread.
+        unsigned char WorkerThreadCount = 0;
+        // Run per frame systems through a FrameGraph. Off, as physics, audio
+        // and networking all run inside Framework::Update and the editor
+        // update is empty, so only PrepareDraw overlaps anything.
+        bool FrameGraphEnabled = false;
+        bool ParallelSceneUpdatesEnabled = true; // Enabled scenes update as separate tasks. See SceneUpdater.h.
+
+        // Profiling
+        // Record engine PROFILE_SCOPEs to per thread ring buffers and a binary
+        // .qtrace file instead of the Instrumentor's JSON. See TraceRecorder.h.
+        bool TraceRecorderEnabled = true;
+
+        // Scenes
+        // Load scenes from cooked binary files, cooking them when missing
+        // or stale. See SceneLoader.h.
+        bool CookedScenesEnabled = true;
+        // First file of the framework's "Scenes" list, loaded as the current scene
+        std::string StartupSceneFile;
+
+        // Resources
+        // Read and decode meshes of cooked scenes on worker threads, with a
+        // placeholder until they are uploaded. See MeshStreamer.h.
+        bool AsyncMeshLoadingEnabled = true;
+        unsigned short MeshUploadBudgetMicroseconds = 2000; // GPU upload time per frame
+        // Streamed meshes load from cooked binary files, cooking them when
+        // missing or stale. See CookedMesh.h.
+        bool CookedMeshesEnabled = true;
+        // Cook meshes with quantized positions, octahedral normals and half
+        // float UVs, half the size on disk. See VertexQuantization.h. They
+        // are unpacked to floats for the framework's meshes, so this only
+        // costs precision once loaded.
+        bool QuantizedMeshesEnabled = false;
+    };
+
+    namespace EngineSettingsLoader
+    {
+        // Returns default values for any missing or invalid entries
+        EngineSettings Load(const char* preferencesFilePath);
+    }
+
+}
+#endif // _Engine_Settings_H_
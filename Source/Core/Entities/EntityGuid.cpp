@@ -0,0 +1,65 @@
+#include "EntityGuid.h"
+
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <random>
+
+namespace QwerkE {
+
+    namespace EntityGuids
+    {
+        static std::mutex s_GeneratorMutex;
+
+        EntityGuid Create()
+        {
+            std::lock_guard<std::mutex> lock(s_GeneratorMutex);
+
+            // random_device alone can be deterministic on some platforms
+            static std::mt19937_64 s_Generator(((unsigned long long)std::random_device()() << 32) ^
+                (unsigned long long)std::chrono::high_resolution_clock::now().time_since_epoch().count());
+
+            EntityGuid guid;
+            do
+            {
+                guid = s_Generator();
+            } while (guid == 0);
+            return guid;
+        }
+
+        std::string ToString(EntityGuid guid)
+        {
+            char text[17];
+            snprintf(text, sizeof(text), "%016llx", guid);
+            return text;
+        }
+
+        EntityGuid Parse(const char* value)
+        {
+            if (value == nullptr)
+                return 0;
+
+            EntityGuid guid = 0;
+            int digits = 0;
+            for (; value[digits] != '\0'; digits++)
+            {
+                const char c = value[digits];
+                unsigned int digit;
+                if (c >= '0' && c <= '9')
+                    digit = c - '0';
+                else if (c >= 'a' && c <= 'f')
+                    digit = c - 'a' + 10;
+                else if (c >= 'A' && c <= 'F')
+                    digit = c - 'A' + 10;
+                else
+                    return 0;
+
+                if (digits == 16)
+                    return 0;
+                guid = (guid << 4) | digit;
+            }
+            return digits == 16 ? guid : 0;
+        }
+    }
+
+}
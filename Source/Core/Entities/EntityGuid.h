@@ -0,0 +1,26 @@
+#ifndef _Entity_Guid_H_
+#define _Entity_Guid_H_
+
+// 64 bit ids that identify an entity across saves and loads. Scene files
+// store them so references don't depend on names, which can collide or
+// change. At runtime, look objects up through ObjectHandles instead.
+
+#include <string>
+
+namespace QwerkE {
+
+    typedef unsigned long long EntityGuid; // 0 is never valid
+
+    namespace EntityGuids
+    {
+        // Random, never 0. Safe to call from any thread.
+        EntityGuid Create();
+
+        // 16 hex digits, as stored in scene files
+        std::string ToString(EntityGuid guid);
+        // 0 when value isn't a GUID
+        EntityGuid Parse(const char* value);
+    }
+
+}
+#endif // _Entity_Guid_H_
@@ -0,0 +1,475 @@
+#include "EntityStore.h"
+#include "../Math/TransformMath.h"
+
+namespace QwerkE {
+
+    // Moves the last row into row, then shrinks the array
+    template <class T>
+    static void SwapRemove(std::vector<T>& values, size_t row)
+    {
+        if (values.empty())
+            return;
+
+        values[row] = values.back();
+        values.pop_back();
+    }
+
+    EntityHandle EntityStore::Create(unsigned char componentMask, GameObject* gameObject)
+    {
+        componentMask &= EntityComponent_ArchetypeCount - 1;
+
+        unsigned int index;
+        if (!m_FreeSlots.empty())
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            index = (unsigned int)m_Slots.size();
+            m_Slots.push_back(Slot());
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.generation++;
+        if (slot.generation == 0)
+            slot.generation = 1; // Wrapped. 0 marks null handles.
+
+        EntityHandle entity;
+        entity.index = index;
+        entity.generation = slot.generation;
+
+        EntityArchetype& archetype = m_Archetypes[componentMask];
+        archetype.componentMask = componentMask;
+
+        slot.archetype = componentMask;
+        slot.row = (unsigned int)archetype.Size();
+
+        archetype.entities.push_back(entity);
+        archetype.positionX.push_back(0.0f);
+        archetype.positionY.push_back(0.0f);
+        archetype.positionZ.push_back(0.0f);
+        archetype.rotationX.push_back(0.0f);
+        archetype.rotationY.push_back(0.0f);
+        archetype.rotationZ.push_back(0.0f);
+        archetype.scaleX.push_back(1.0f);
+        archetype.scaleY.push_back(1.0f);
+        archetype.scaleZ.push_back(1.0f);
+
+        archetype.worldMatrices.resize(archetype.worldMatrices.size() + 16);
+        TransformMath::Identity(&archetype.worldMatrices[archetype.worldMatrices.size() - 16]);
+        archetype.transformDirty.push_back(1);
+        archetype.transformWritten.push_back(0);
+        archetype.worldMatrixChanged.push_back(1);
+
+        if (componentMask & EntityComponent_Render)
+        {
+            archetype.renderComponents.push_back(nullptr);
+            archetype.localBounds.insert(archetype.localBounds.end(), { 0.0f, 0.0f, 0.0f, -1.0f, -1.0f, -1.0f });
+            archetype.cullProxies.push_back(-1);
+            archetype.visible.push_back(1);
+        }
+        if (componentMask & EntityComponent_Physics)
+            archetype.physicsComponents.push_back(nullptr);
+
+        archetype.gameObjects.push_back(gameObject);
+
+        slot.parent = EntityHandle();
+        m_HierarchyChanged = true;
+
+        m_Count++;
+        return entity;
+    }
+
+    void EntityStore::Destroy(EntityHandle entity)
+    {
+        if (!IsValid(entity))
+            return;
+
+        Slot& slot = m_Slots[entity.index];
+        EntityArchetype& archetype = m_Archetypes[slot.archetype];
+        const size_t row = slot.row;
+        const size_t last = archetype.Size() - 1;
+
+        // The last entity takes over the removed row
+        if (row != last)
+            m_Slots[archetype.entities[last].index].row = (unsigned int)row;
+
+        SwapRemove(archetype.entities, row);
+        SwapRemove(archetype.positionX, row);
+        SwapRemove(archetype.positionY, row);
+        SwapRemove(archetype.positionZ, row);
+        SwapRemove(archetype.rotationX, row);
+        SwapRemove(archetype.rotationY, row);
+        SwapRemove(archetype.rotationZ, row);
+        SwapRemove(archetype.scaleX, row);
+        SwapRemove(archetype.scaleY, row);
+        SwapRemove(archetype.scaleZ, row);
+        SwapRemove(archetype.transformDirty, row);
+        SwapRemove(archetype.transformWritten, row);
+        SwapRemove(archetype.worldMatrixChanged, row);
+        SwapRemove(archetype.renderComponents, row);
+        SwapRemove(archetype.cullProxies, row);
+        SwapRemove(archetype.visible, row);
+        SwapRemove(archetype.physicsComponents, row);
+        SwapRemove(archetype.gameObjects, row);
+
+        for (int i = 0; i < 16; i++)
+        {
+            archetype.worldMatrices[row * 16 + i] = archetype.worldMatrices[last * 16 + i];
+        }
+        archetype.worldMatrices.resize(last * 16);
+
+        if (!archetype.localBounds.empty())
+        {
+            for (int i = 0; i < 6; i++)
+            {
+                archetype.localBounds[row * 6 + i] = archetype.localBounds[last * 6 + i];
+            }
+            archetype.localBounds.resize(last * 6);
+        }
+
+        slot.generation++; // Invalidates outstanding handles
+        if (slot.generation == 0)
+            slot.generation = 1;
+        slot.parent = EntityHandle();
+        m_FreeSlots.push_back(entity.index);
+        m_HierarchyChanged = true; // Children become roots on the next update
+        m_Count--;
+    }
+
+    void EntityStore::Clear()
+    {
+        for (EntityArchetype& archetype : m_Archetypes)
+        {
+            const unsigned char componentMask = archetype.componentMask;
+            archetype = EntityArchetype();
+            archetype.componentMask = componentMask;
+        }
+
+        // Keep generations so old handles stay invalid
+        m_FreeSlots.clear();
+        for (unsigned int i = 0; i < (unsigned int)m_Slots.size(); i++)
+        {
+            m_Slots[i].generation++;
+            if (m_Slots[i].generation == 0)
+                m_Slots[i].generation = 1;
+            m_Slots[i].parent = EntityHandle();
+            m_FreeSlots.push_back(i);
+        }
+        m_Count = 0;
+
+        m_HierarchySlots.clear();
+        m_HierarchyParents.clear();
+        m_HierarchyDirty.clear();
+        m_HierarchyChanged = false;
+        m_HasParents = false;
+    }
+
+    const EntityStore::Slot* EntityStore::FindSlot(EntityHandle entity) const
+    {
+        if (entity.generation == 0 || entity.index >= m_Slots.size())
+            return nullptr;
+
+        const Slot& slot = m_Slots[entity.index];
+        if (slot.generation != entity.generation)
+            return nullptr;
+
+        return &slot;
+    }
+
+    bool EntityStore::IsValid(EntityHandle entity) const
+    {
+        const Slot* slot = FindSlot(entity);
+        return slot && slot->row < m_Archetypes[slot->archetype].Size() &&
+            m_Archetypes[slot->archetype].entities[slot->row] == entity;
+    }
+
+    EntityArchetype* EntityStore::Find(EntityHandle entity, size_t& row)
+    {
+        if (!IsValid(entity))
+            return nullptr;
+
+        const Slot& slot = m_Slots[entity.index];
+        row = slot.row;
+        return &m_Archetypes[slot.archetype];
+    }
+
+    void EntityStore::SetTransform(EntityHandle entity, const float position[3], const float rotation[3], const float scale[3])
+    {
+        size_t row;
+        EntityArchetype* archetype = Find(entity, row);
+        if (archetype == nullptr)
+            return;
+
+        archetype->positionX[row] = position[0];
+        archetype->positionY[row] = position[1];
+        archetype->positionZ[row] = position[2];
+        archetype->rotationX[row] = rotation[0];
+        archetype->rotationY[row] = rotation[1];
+        archetype->rotationZ[row] = rotation[2];
+        archetype->scaleX[row] = scale[0];
+        archetype->scaleY[row] = scale[1];
+        archetype->scaleZ[row] = scale[2];
+        archetype->transformDirty[row] = 1;
+        archetype->transformWritten[row] = 1;
+    }
+
+    void EntityStore::GetTransform(EntityHandle entity, float position[3], float rotation[3], float scale[3]) const
+    {
+        if (!IsValid(entity))
+            return;
+
+        const Slot& slot = m_Slots[entity.index];
+        const EntityArchetype& archetype = m_Archetypes[slot.archetype];
+        const size_t row = slot.row;
+
+        position[0] = archetype.positionX[row];
+        position[1] = archetype.positionY[row];
+        position[2] = archetype.positionZ[row];
+        rotation[0] = archetype.rotationX[row];
+        rotation[1] = archetype.rotationY[row];
+        rotation[2] = archetype.rotationZ[row];
+        scale[0] = archetype.scaleX[row];
+        scale[1] = archetype.scaleY[row];
+        scale[2] = archetype.scaleZ[row];
+    }
+
+    const float* EntityStore::GetWorldMatrix(EntityHandle entity) const
+    {
+        if (!IsValid(entity))
+            return nullptr;
+
+        const Slot& slot = m_Slots[entity.index];
+        return &m_Archetypes[slot.archetype].worldMatrices[slot.row * 16];
+    }
+
+    void EntityStore::SetRenderComponent(EntityHandle entity, RenderComponent* component)
+    {
+        size_t row;
+        EntityArchetype* archetype = Find(entity, row);
+        if (archetype && (archetype->componentMask & EntityComponent_Render))
+            archetype->renderComponents[row] = component;
+    }
+
+    void EntityStore::SetPhysicsComponent(EntityHandle entity, PhysicsComponent* component)
+    {
+        size_t row;
+        EntityArchetype* archetype = Find(entity, row);
+        if (archetype && (archetype->componentMask & EntityComponent_Physics))
+            archetype->physicsComponents[row] = component;
+    }
+
+    void EntityStore::SetLocalBounds(EntityHandle entity, const float center[3], const float extents[3])
+    {
+        size_t row;
+        EntityArchetype* archetype = Find(entity, row);
+        if (archetype == nullptr || (archetype->componentMask & EntityComponent_Render) == 0)
+            return;
+
+        for (int i = 0; i < 3; i++)
+        {
+            archetype->localBounds[row * 6 + i] = center[i];
+            archetype->localBounds[row * 6 + 3 + i] = extents[i];
+        }
+        archetype->worldMatrixChanged[row] = 1; // World bounds need updating
+    }
+
+    GameObject* EntityStore::GetGameObject(EntityHandle entity) const
+    {
+        if (!IsValid(entity))
+            return nullptr;
+
+        const Slot& slot = m_Slots[entity.index];
+        return m_Archetypes[slot.archetype].gameObjects[slot.row];
+    }
+
+    bool EntityStore::SetParent(EntityHandle entity, EntityHandle parent)
+    {
+        if (!IsValid(entity))
+            return false;
+
+        if (!parent.IsNull())
+        {
+            if (!IsValid(parent))
+                return false;
+
+            // Parenting to a descendant would make a loop
+            for (EntityHandle ancestor = parent; !ancestor.IsNull(); ancestor = GetParent(ancestor))
+            {
+                if (ancestor == entity)
+                    return false;
+            }
+        }
+
+        Slot& slot = m_Slots[entity.index];
+        if (slot.parent == parent)
+            return true;
+
+        slot.parent = parent;
+        m_Archetypes[slot.archetype].transformDirty[slot.row] = 1;
+        m_HierarchyChanged = true;
+        return true;
+    }
+
+    EntityHandle EntityStore::GetParent(EntityHandle entity) const
+    {
+        if (!IsValid(entity))
+            return EntityHandle();
+
+        const EntityHandle parent = m_Slots[entity.index].parent;
+        return IsValid(parent) ? parent : EntityHandle();
+    }
+
+    void EntityStore::MarkTransformDirty(EntityHandle entity)
+    {
+        size_t row;
+        EntityArchetype* archetype = Find(entity, row);
+        if (archetype)
+            archetype->transformDirty[row] = 1;
+    }
+
+    void EntityStore::RebuildHierarchyOrder()
+    {
+        // Child lists, indexed by slot
+        std::vector<int> firstChild(m_Slots.size(), -1);
+        std::vector<int> nextSibling(m_Slots.size(), -1);
+
+        m_HierarchySlots.clear();
+        m_HierarchyParents.clear();
+        m_HierarchySlots.reserve(m_Count);
+        m_HierarchyParents.reserve(m_Count);
+
+        for (EntityArchetype& archetype : m_Archetypes)
+        {
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                const unsigned int index = archetype.entities[row].index;
+                Slot& slot = m_Slots[index];
+
+                if (!slot.parent.IsNull() && !IsValid(slot.parent))
+                {
+                    // Parent was destroyed
+                    slot.parent = EntityHandle();
+                    archetype.transformDirty[row] = 1;
+                }
+
+                if (slot.parent.IsNull())
+                {
+                    m_HierarchySlots.push_back(index);
+                    m_HierarchyParents.push_back(-1);
+                }
+                else
+                {
+                    nextSibling[index] = firstChild[slot.parent.index];
+                    firstChild[slot.parent.index] = (int)index;
+                }
+            }
+        }
+
+        m_HasParents = m_HierarchySlots.size() != m_Count;
+
+        // Roots are in, now append each node's children as it is reached
+        for (size_t i = 0; i < m_HierarchySlots.size(); i++)
+        {
+            for (int child = firstChild[m_HierarchySlots[i]]; child != -1; child = nextSibling[child])
+            {
+                m_HierarchySlots.push_back((unsigned int)child);
+                m_HierarchyParents.push_back((int)i);
+            }
+        }
+
+        m_HierarchyDirty.resize(m_HierarchySlots.size());
+    }
+
+    void EntityStore::UpdateRootWorldMatrices()
+    {
+        for (EntityArchetype& archetype : m_Archetypes)
+        {
+            const size_t count = archetype.Size();
+            size_t row = 0;
+            while (row < count)
+            {
+                // Compose each run of dirty rows in 1 batch
+                while (row < count && !archetype.transformDirty[row])
+                    row++;
+
+                const size_t begin = row;
+                while (row < count && archetype.transformDirty[row])
+                {
+                    archetype.transformDirty[row] = 0;
+                    archetype.worldMatrixChanged[row] = 1;
+                    row++;
+                }
+
+                if (row == begin)
+                    continue;
+
+                TransformMath::TransformArrays transforms;
+                transforms.positionX = &archetype.positionX[begin];
+                transforms.positionY = &archetype.positionY[begin];
+                transforms.positionZ = &archetype.positionZ[begin];
+                transforms.rotationX = &archetype.rotationX[begin];
+                transforms.rotationY = &archetype.rotationY[begin];
+                transforms.rotationZ = &archetype.rotationZ[begin];
+                transforms.scaleX = &archetype.scaleX[begin];
+                transforms.scaleY = &archetype.scaleY[begin];
+                transforms.scaleZ = &archetype.scaleZ[begin];
+                TransformMath::ComposeSRTBatch(transforms, row - begin, &archetype.worldMatrices[begin * 16]);
+            }
+        }
+    }
+
+    void EntityStore::UpdateWorldMatrices()
+    {
+        if (m_HierarchyChanged)
+        {
+            RebuildHierarchyOrder();
+            m_HierarchyChanged = false;
+        }
+
+        if (!m_HasParents)
+        {
+            UpdateRootWorldMatrices();
+            return;
+        }
+
+        const size_t count = m_HierarchySlots.size();
+        for (size_t i = 0; i < count; i++)
+        {
+            const Slot& slot = m_Slots[m_HierarchySlots[i]];
+            EntityArchetype& archetype = m_Archetypes[slot.archetype];
+            const size_t row = slot.row;
+            const int parent = m_HierarchyParents[i];
+
+            // Parents come first, so their flag for this update is already set
+            const bool dirty = archetype.transformDirty[row] || (parent >= 0 && m_HierarchyDirty[parent]);
+            m_HierarchyDirty[i] = dirty;
+            if (!dirty)
+                continue;
+
+            archetype.transformDirty[row] = 0;
+            archetype.worldMatrixChanged[row] = 1;
+
+            const float position[3] = { archetype.positionX[row], archetype.positionY[row], archetype.positionZ[row] };
+            const float rotation[3] = { archetype.rotationX[row], archetype.rotationY[row], archetype.rotationZ[row] };
+            const float scale[3] = { archetype.scaleX[row], archetype.scaleY[row], archetype.scaleZ[row] };
+            float* worldMatrix = &archetype.worldMatrices[row * 16];
+
+            if (parent < 0)
+            {
+                TransformMath::ComposeSRT(position, rotation, scale, worldMatrix);
+            }
+            else
+            {
+                float localMatrix[16];
+                TransformMath::ComposeSRT(position, rotation, scale, localMatrix);
+
+                const Slot& parentSlot = m_Slots[m_HierarchySlots[parent]];
+                const float* parentMatrix = &m_Archetypes[parentSlot.archetype].worldMatrices[parentSlot.row * 16];
+                TransformMath::Multiply(parentMatrix, localMatrix, worldMatrix);
+            }
+        }
+    }
+
+}
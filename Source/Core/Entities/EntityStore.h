@@ -0,0 +1,152 @@
+#ifndef _Entity_Store_H_
+#define _Entity_Store_H_
+
+// Data oriented entity storage. Entities with the same set of components
+// share an archetype, and each archetype keeps every component in its
+// own contiguous array (structure of arrays). Systems loop over the
+// arrays of each archetype instead of walking GameObject pointers.
+//
+// Every entity has a transform. Render and physics components are links
+// to the framework's components until those move into the store too.
+//
+// Entities are referred to by EntityHandle. A handle stops being valid
+// when its entity is destroyed, even if the slot is reused later.
+//
+// Entities may have a parent, in which case their transform is relative
+// to the parent's world matrix. World matrices are only rebuilt for
+// entities whose transform is marked dirty, and for their descendants.
+
+#include <cstddef>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+    class RenderComponent;
+    class PhysicsComponent;
+
+    enum eEntityComponents : unsigned char
+    {
+        EntityComponent_Render = 1 << 0,
+        EntityComponent_Physics = 1 << 1,
+
+        EntityComponent_ArchetypeCount = 1 << 2 // Every combination of the above
+    };
+
+    struct EntityHandle
+    {
+        unsigned int index = 0;
+        unsigned int generation = 0; // 0 is never valid
+
+        bool IsNull() const { return generation == 0; }
+        bool operator==(const EntityHandle& other) const { return index == other.index && generation == other.generation; }
+        bool operator!=(const EntityHandle& other) const { return !(*this == other); }
+    };
+
+    struct EntityArchetype
+    {
+        size_t Size() const { return entities.size(); }
+
+        unsigned char componentMask = 0;
+        std::vector<EntityHandle> entities;
+
+        // Transform. One array per axis so passes over them vectorise.
+        std::vector<float> positionX, positionY, positionZ;
+        std::vector<float> rotationX, rotationY, rotationZ; // Degrees
+        std::vector<float> scaleX, scaleY, scaleZ;
+        std::vector<float> worldMatrices; // 16 floats per entity, column major
+
+        // Non zero when the transform changed since the last world matrix
+        // update. Code writing the transform arrays directly must set it.
+        std::vector<unsigned char> transformDirty;
+
+        // Non zero when a system like a routine wrote the transform, and it
+        // wasn't copied back to the GameObject yet. Also set by writers of
+        // the transform arrays. Cleared by SceneEntities.
+        std::vector<unsigned char> transformWritten;
+
+        // Set when UpdateWorldMatrices() rebuilt the world matrix. Cleared
+        // by the code consuming it, like culling.
+        std::vector<unsigned char> worldMatrixChanged;
+
+        // Only filled for archetypes with the component
+        std::vector<RenderComponent*> renderComponents;
+        std::vector<PhysicsComponent*> physicsComponents;
+
+        // Render archetypes only. Object space box as a center and half
+        // extents, 6 floats per entity. Negative extents mean the bounds
+        // are unknown and the entity is never culled.
+        std::vector<float> localBounds;
+        std::vector<int> cullProxies; // BoundingVolumeTree proxy, or -1
+        std::vector<unsigned char> visible; // Result of the last cull
+
+        // GameObject the entity mirrors, or null. See SceneEntities.
+        std::vector<GameObject*> gameObjects;
+    };
+
+    class EntityStore
+    {
+    public:
+        EntityHandle Create(unsigned char componentMask, GameObject* gameObject = nullptr);
+        void Destroy(EntityHandle entity);
+        void Clear();
+
+        bool IsValid(EntityHandle entity) const;
+        size_t Count() const { return m_Count; }
+
+        // Direct access to an entity's row. The pointer and row are valid
+        // until the next Create() or Destroy().
+        EntityArchetype* Find(EntityHandle entity, size_t& row);
+
+        // Transforms are local to the parent, if there is one
+        void SetTransform(EntityHandle entity, const float position[3], const float rotation[3], const float scale[3]);
+        void GetTransform(EntityHandle entity, float position[3], float rotation[3], float scale[3]) const;
+        const float* GetWorldMatrix(EntityHandle entity) const;
+
+        void SetRenderComponent(EntityHandle entity, RenderComponent* component);
+        void SetPhysicsComponent(EntityHandle entity, PhysicsComponent* component);
+        void SetLocalBounds(EntityHandle entity, const float center[3], const float extents[3]);
+        GameObject* GetGameObject(EntityHandle entity) const;
+
+        // A null parent makes entity a root. Fails if parent is entity or
+        // one of its descendants. Children of a destroyed entity become roots.
+        bool SetParent(EntityHandle entity, EntityHandle parent);
+        EntityHandle GetParent(EntityHandle entity) const;
+
+        void MarkTransformDirty(EntityHandle entity);
+
+        // Rebuilds world matrices of dirty entities and their descendants
+        void UpdateWorldMatrices();
+
+        EntityArchetype& GetArchetype(unsigned char componentMask) { return m_Archetypes[componentMask]; }
+        const EntityArchetype& GetArchetype(unsigned char componentMask) const { return m_Archetypes[componentMask]; }
+
+    private:
+        struct Slot
+        {
+            unsigned int generation = 0;
+            unsigned char archetype = 0;
+            unsigned int row = 0;
+            EntityHandle parent;
+        };
+
+        const Slot* FindSlot(EntityHandle entity) const;
+        void RebuildHierarchyOrder();
+        void UpdateRootWorldMatrices();
+
+        EntityArchetype m_Archetypes[EntityComponent_ArchetypeCount];
+        std::vector<Slot> m_Slots;
+        std::vector<unsigned int> m_FreeSlots;
+        size_t m_Count = 0;
+
+        // Every entity in breadth first order, so parents come before their
+        // children. Rebuilt when parents change or entities are added or removed.
+        std::vector<unsigned int> m_HierarchySlots;
+        std::vector<int> m_HierarchyParents; // Index into m_HierarchySlots, -1 for roots
+        std::vector<unsigned char> m_HierarchyDirty;
+        bool m_HierarchyChanged = false;
+        bool m_HasParents = false; // Otherwise matrices are built per archetype in batches
+    };
+
+}
+#endif // _Entity_Store_H_
@@ -0,0 +1,64 @@
+#include "ObjectHandles.h"
+
+namespace QwerkE {
+
+    static unsigned int NextGeneration(unsigned int generation)
+    {
+        // 0 marks null handles
+        return generation >= ObjectHandle::s_MaxGeneration ? 1 : generation + 1;
+    }
+
+    ObjectHandle ObjectHandleTable::Create(GameObject* object)
+    {
+        unsigned int index;
+        if (!m_FreeSlots.empty())
+        {
+            index = m_FreeSlots.back();
+            m_FreeSlots.pop_back();
+        }
+        else
+        {
+            if (m_Slots.size() > ObjectHandle::s_IndexMask)
+                return ObjectHandle();
+
+            index = (unsigned int)m_Slots.size();
+            m_Slots.push_back(Slot());
+        }
+
+        Slot& slot = m_Slots[index];
+        slot.object = object;
+        slot.generation = NextGeneration(slot.generation);
+
+        ObjectHandle handle;
+        handle.value = (slot.generation << ObjectHandle::s_IndexBits) | index;
+        return handle;
+    }
+
+    void ObjectHandleTable::Release(ObjectHandle handle)
+    {
+        if (Resolve(handle) == nullptr)
+            return;
+
+        Slot& slot = m_Slots[handle.Index()];
+        slot.object = nullptr;
+        slot.generation = NextGeneration(slot.generation); // Invalidates outstanding handles
+        m_FreeSlots.push_back(handle.Index());
+    }
+
+    void ObjectHandleTable::Clear()
+    {
+        // Keep generations so old handles stay invalid
+        m_FreeSlots.clear();
+        for (unsigned int i = (unsigned int)m_Slots.size(); i > 0; i--)
+        {
+            Slot& slot = m_Slots[i - 1];
+            if (slot.object)
+            {
+                slot.object = nullptr;
+                slot.generation = NextGeneration(slot.generation);
+            }
+            m_FreeSlots.push_back(i - 1);
+        }
+    }
+
+}
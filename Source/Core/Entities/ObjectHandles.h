@@ -0,0 +1,68 @@
+#ifndef _Object_Handles_H_
+#define _Object_Handles_H_
+
+// 32 bit generational handles to GameObjects, resolved through a slot map
+// in constant time. Unlike EntityHandles they survive rebuilds of the
+// EntityStore, so editor selections and other references held across
+// frames use them instead of GameObject pointers or names.
+//
+// A handle is 20 bits of slot index and 12 of generation. Releasing a
+// slot bumps its generation, so a handle to a destroyed object resolves
+// to null rather than to whatever reuses the slot. Generations wrap after
+// 4095 reuses of a slot.
+
+#include <cstddef>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+
+    struct ObjectHandle
+    {
+        static const unsigned int s_IndexBits = 20;
+        static const unsigned int s_IndexMask = (1u << s_IndexBits) - 1;
+        static const unsigned int s_MaxGeneration = (1u << (32 - s_IndexBits)) - 1;
+
+        unsigned int value = 0; // 0 is never valid
+
+        unsigned int Index() const { return value & s_IndexMask; }
+        unsigned int Generation() const { return value >> s_IndexBits; }
+
+        bool IsNull() const { return value == 0; }
+        bool operator==(const ObjectHandle& other) const { return value == other.value; }
+        bool operator!=(const ObjectHandle& other) const { return value != other.value; }
+    };
+
+    class ObjectHandleTable
+    {
+    public:
+        // Null when every slot is in use
+        ObjectHandle Create(GameObject* object);
+        void Release(ObjectHandle handle);
+        void Clear();
+
+        // Null for released handles
+        GameObject* Resolve(ObjectHandle handle) const
+        {
+            const unsigned int index = handle.Index();
+            if (index >= m_Slots.size() || m_Slots[index].generation != handle.Generation())
+                return nullptr;
+            return m_Slots[index].object;
+        }
+
+        size_t Count() const { return m_Slots.size() - m_FreeSlots.size(); }
+
+    private:
+        struct Slot
+        {
+            GameObject* object = nullptr;
+            unsigned int generation = 0;
+        };
+
+        std::vector<Slot> m_Slots;
+        std::vector<unsigned int> m_FreeSlots;
+    };
+
+}
+#endif // _Object_Handles_H_
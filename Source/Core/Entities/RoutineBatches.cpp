@@ -0,0 +1,138 @@
+#include "RoutineBatches.h"
+#include "../Jobs/TaskScheduler.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <atomic>
+#include <thread>
+
+namespace QwerkE {
+
+    // Smaller ranges cost more in scheduling than they save
+    static const size_t s_MinRoutinesPerTask = 2048;
+
+    struct RoutineRangeTask
+    {
+        RoutineBatch* batch;
+        EntityStore* store;
+        size_t begin;
+        size_t end;
+        double deltaTime;
+        std::atomic<unsigned int>* remaining;
+    };
+
+    static void RunRoutineRange(void* data)
+    {
+        RoutineRangeTask* task = (RoutineRangeTask*)data;
+        task->batch->Update(*task->store, task->begin, task->end, task->deltaTime);
+        task->remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    RoutineBatches::~RoutineBatches()
+    {
+        for (RoutineBatch* batch : m_Batches)
+        {
+            delete batch;
+        }
+    }
+
+    void RoutineBatches::AddBatch(RoutineBatch* batch)
+    {
+        for (RoutineBatch*& existing : m_Batches)
+        {
+            if (existing->Type() == batch->Type())
+            {
+                delete existing;
+                existing = batch;
+                return;
+            }
+        }
+        m_Batches.push_back(batch);
+    }
+
+    RoutineBatch* RoutineBatches::GetBatch(eRoutineTypes type) const
+    {
+        for (RoutineBatch* batch : m_Batches)
+        {
+            if (batch->Type() == type)
+                return batch;
+        }
+        return nullptr;
+    }
+
+    void RoutineBatches::Update(EntityStore& store, double deltaTime, TaskScheduler* scheduler)
+    {
+        PROFILE_SCOPE("Routine Batches Update");
+
+        for (RoutineBatch* batch : m_Batches)
+        {
+            const size_t count = batch->Count();
+            if (count == 0)
+                continue;
+
+            const unsigned int threadCount = scheduler ? scheduler->WorkerCount() + 1 : 1;
+            if (!batch->IsStateless() || threadCount == 1 || count < s_MinRoutinesPerTask * 2)
+            {
+                batch->Update(store, 0, count, deltaTime);
+                continue;
+            }
+
+            size_t taskCount = count / s_MinRoutinesPerTask;
+            if (taskCount > threadCount)
+                taskCount = threadCount;
+            const size_t rangeSize = (count + taskCount - 1) / taskCount;
+
+            std::vector<RoutineRangeTask> tasks(taskCount);
+            std::atomic<unsigned int> remaining((unsigned int)taskCount - 1);
+
+            for (size_t i = 0; i < taskCount; i++)
+            {
+                RoutineRangeTask& task = tasks[i];
+                task.batch = batch;
+                task.store = &store;
+                task.begin = i * rangeSize;
+                task.end = task.begin + rangeSize < count ? task.begin + rangeSize : count;
+                task.deltaTime = deltaTime;
+                task.remaining = &remaining;
+
+                // The calling thread takes the first range itself
+                if (i > 0)
+                    scheduler->Schedule(RunRoutineRange, &task);
+            }
+
+            batch->Update(store, tasks[0].begin, tasks[0].end, deltaTime);
+
+            while (remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!scheduler->RunPendingTask())
+                    std::this_thread::yield();
+            }
+        }
+    }
+
+    void RoutineBatches::RemoveInvalid(const EntityStore& store)
+    {
+        for (RoutineBatch* batch : m_Batches)
+        {
+            batch->RemoveInvalid(store);
+        }
+    }
+
+    void RoutineBatches::Clear()
+    {
+        for (RoutineBatch* batch : m_Batches)
+        {
+            batch->Clear();
+        }
+    }
+
+    size_t RoutineBatches::Count() const
+    {
+        size_t count = 0;
+        for (const RoutineBatch* batch : m_Batches)
+        {
+            count += batch->Count();
+        }
+        return count;
+    }
+
+}
@@ -0,0 +1,62 @@
+#ifndef _Routine_Batches_H_
+#define _Routine_Batches_H_
+
+// Routines that run as one loop per routine type instead of one virtual
+// Update() per object. Each batch keeps the data of every routine of its
+// type in arrays and updates them all over an EntityStore.
+//
+// Stateless batches only write to the entity each routine is attached
+// to, so their routines can be split into ranges and updated on
+// TaskScheduler workers.
+
+#include "EntityStore.h"
+
+#include "../QwerkE_Framework/Source/Headers/QwerkE_Enums.h"
+
+#include <vector>
+
+namespace QwerkE {
+
+    class TaskScheduler;
+
+    class RoutineBatch
+    {
+    public:
+        virtual ~RoutineBatch() {}
+
+        virtual eRoutineTypes Type() const = 0;
+        virtual bool IsStateless() const = 0;
+        virtual size_t Count() const = 0;
+
+        // Updates routines [begin, end). Called from workers for stateless batches.
+        virtual void Update(EntityStore& store, size_t begin, size_t end, double deltaTime) = 0;
+
+        // Drops routines whose entity was destroyed
+        virtual void RemoveInvalid(const EntityStore& store) = 0;
+
+        virtual void Clear() = 0;
+    };
+
+    class RoutineBatches
+    {
+    public:
+        ~RoutineBatches();
+
+        // Takes ownership. Replaces any batch of the same type.
+        void AddBatch(RoutineBatch* batch);
+        RoutineBatch* GetBatch(eRoutineTypes type) const;
+
+        // A null scheduler updates everything on the calling thread
+        void Update(EntityStore& store, double deltaTime, TaskScheduler* scheduler);
+
+        void RemoveInvalid(const EntityStore& store);
+        void Clear();
+
+        size_t Count() const;
+
+    private:
+        std::vector<RoutineBatch*> m_Batches;
+    };
+
+}
+#endif // _Routine_Batches_H_
@@ -0,0 +1,753 @@
+#include "SceneEntities.h"
+#include "TransformRoutineBatch.h"
+#include "../Graphics/Frustum.h"
+#include "../Graphics/MeshBounds.h"
+#include "../Math/TransformMath.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/PhysicsComponent.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <string>
+
+namespace QwerkE {
+
+    SceneEntities::SceneEntities()
+    {
+        m_TransformRoutineBatch = new TransformRoutineBatch();
+        m_RoutineBatches.AddBatch(m_TransformRoutineBatch);
+    }
+
+    void SceneEntities::Sync(Scene* scene)
+    {
+        PROFILE_SCOPE("Scene Entities Sync");
+
+        if (scene == nullptr)
+        {
+            Clear();
+            return;
+        }
+
+        if (IsStale(scene))
+        {
+            Rebuild(scene);
+            UpdateChildTransforms();
+            return;
+        }
+
+        PullMarkedTransforms();
+        for (const EntityHandle entity : m_MovedByFramework)
+        {
+            PullTransform(entity);
+        }
+        UpdateChildTransforms();
+
+        if (ObjectIdsChanged(scene))
+            UpdateObjectIds(scene);
+    }
+
+    void SceneEntities::SyncMarked(Scene* scene)
+    {
+        if (scene == nullptr)
+        {
+            Clear();
+            return;
+        }
+
+        if (IsStale(scene))
+            Rebuild(scene);
+        else
+            PullMarkedTransforms();
+    }
+
+    bool SceneEntities::IsStale(Scene* scene) const
+    {
+        // Count only, so a frame without edits doesn't walk the object list
+        return scene != m_Scene || scene->GetObjectList().size() != m_ObjectCount;
+    }
+
+    void SceneEntities::Clear()
+    {
+        m_Store.Clear();
+        m_RoutineBatches.Clear();
+        m_CullTree.Clear();
+        m_CullEntities.clear();
+        m_Handles.clear();
+        m_Scene = nullptr;
+        m_ObjectCount = 0;
+        m_MarkedObjects.clear();
+        m_MovedByFramework.clear();
+    }
+
+    void SceneEntities::Reset()
+    {
+        Clear();
+        m_Parents.clear();
+        m_ParentOrder.clear();
+        m_TransformRoutines.clear();
+        m_ObjectHandles.Clear();
+        m_ObjectIds.clear();
+        m_GuidObjects.clear();
+        m_IdsCount = 0;
+        m_Cameras.clear();
+        m_Lights.clear();
+    }
+
+    // Union of the bounds of every mesh. False if any mesh has none.
+    static bool RenderBounds(RenderComponent* rComp, float center[3], float extents[3])
+    {
+        std::vector<Renderable>* renderables = (std::vector<Renderable>*)rComp->LookAtRenderableList();
+        if (renderables->empty())
+            return false;
+
+        float min[3] = { INFINITY, INFINITY, INFINITY };
+        float max[3] = { -INFINITY, -INFINITY, -INFINITY };
+        for (Renderable& renderable : *renderables)
+        {
+            float meshMin[3], meshMax[3];
+            if (!MeshBounds::Get(renderable.GetMesh(), meshMin, meshMax))
+                return false;
+
+            for (int i = 0; i < 3; i++)
+            {
+                min[i] = std::min(min[i], meshMin[i]);
+                max[i] = std::max(max[i], meshMax[i]);
+            }
+        }
+
+        for (int i = 0; i < 3; i++)
+        {
+            center[i] = (min[i] + max[i]) * 0.5f;
+            extents[i] = (max[i] - min[i]) * 0.5f;
+        }
+        return true;
+    }
+
+    bool SceneEntities::ObjectIdsChanged(Scene* scene) const
+    {
+        // Ids handed out since, as to objects not in the scene, or
+        // cameras and lights that came or went
+        return m_ObjectIds.size() != m_IdsCount || scene->GetCameraList() != m_Cameras || scene->GetLightList() != m_Lights;
+    }
+
+    // Marks the row dirty when a value changed
+    static bool PullValue(EntityArchetype& archetype, std::vector<float>& values, size_t row, float value)
+    {
+        if (values[row] == value)
+            return false;
+
+        values[row] = value;
+        archetype.transformDirty[row] = 1;
+        return true;
+    }
+
+    // True when the transform changed
+    static bool PullRow(EntityArchetype& archetype, size_t row)
+    {
+        const GameObject* object = archetype.gameObjects[row];
+        const vec3 position = object->GetPosition();
+        const vec3 rotation = object->GetRotation();
+        const vec3 scale = object->GetScale();
+
+        // Unchanged objects keep their world matrix
+        bool changed = PullValue(archetype, archetype.positionX, row, position.x);
+        changed |= PullValue(archetype, archetype.positionY, row, position.y);
+        changed |= PullValue(archetype, archetype.positionZ, row, position.z);
+        changed |= PullValue(archetype, archetype.rotationX, row, rotation.x);
+        changed |= PullValue(archetype, archetype.rotationY, row, rotation.y);
+        changed |= PullValue(archetype, archetype.rotationZ, row, rotation.z);
+        changed |= PullValue(archetype, archetype.scaleX, row, scale.x);
+        changed |= PullValue(archetype, archetype.scaleY, row, scale.y);
+        changed |= PullValue(archetype, archetype.scaleZ, row, scale.z);
+        return changed;
+    }
+
+    void SceneEntities::Rebuild(Scene* scene)
+    {
+        for (const GameObject* object : m_MarkedObjects)
+        {
+            MarkChanged(object);
+        }
+        Clear();
+
+        // First, so objects replaced at the same address lose their links
+        UpdateObjectIds(scene);
+
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        m_Handles.reserve(objects.size());
+
+        for (const auto& p : objects)
+        {
+            GameObject* object = p.second;
+            RenderComponent* rComp = (RenderComponent*)object->GetComponent(Component_Render);
+            PhysicsComponent* pComp = (PhysicsComponent*)object->GetComponent(Component_Physics);
+
+            unsigned char componentMask = 0;
+            if (rComp)
+                componentMask |= EntityComponent_Render;
+            if (pComp)
+                componentMask |= EntityComponent_Physics;
+
+            const EntityHandle entity = m_Store.Create(componentMask, object);
+            m_Store.SetRenderComponent(entity, rComp);
+            m_Store.SetPhysicsComponent(entity, pComp);
+            m_Handles[object] = entity;
+
+            if (pComp || object->GetFirstUpdateRoutineOfType(Routine_Transform))
+                m_MovedByFramework.push_back(entity);
+
+            float center[3], extents[3];
+            if (rComp && RenderBounds(rComp, center, extents))
+                m_Store.SetLocalBounds(entity, center, extents);
+        }
+
+        for (auto it = m_Parents.begin(); it != m_Parents.end();)
+        {
+            // Objects that left the scene lose their link
+            if (Find(it->first).IsNull() || Find(it->second.parent).IsNull())
+            {
+                MarkChanged(it->first);
+                it = m_Parents.erase(it);
+                m_ParentOrderChanged = true;
+            }
+            else
+            {
+                ++it;
+            }
+        }
+
+        for (auto it = m_TransformRoutines.begin(); it != m_TransformRoutines.end();)
+        {
+            const EntityHandle entity = Find(it->first);
+            if (entity.IsNull())
+            {
+                it = m_TransformRoutines.erase(it);
+                continue;
+            }
+
+            const TransformRoutineData& data = it->second;
+            m_TransformRoutineBatch->Add(entity, data.speed, data.positionOffset, data.rotationOffset, data.scaleOffset);
+            ++it;
+        }
+
+        m_Scene = scene;
+        m_ObjectCount = objects.size();
+
+        // New rows take every transform, but only marked objects and the
+        // ones the framework moves can have changed
+        for (const EntityHandle entity : m_MovedByFramework)
+        {
+            MarkChanged(GetGameObject(entity));
+        }
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                PullRow(archetype, row);
+            }
+        }
+    }
+
+    SceneEntities::ObjectIds& SceneEntities::Register(GameObject* object)
+    {
+        ObjectIds& ids = m_ObjectIds[object];
+        if (ids.handle.IsNull())
+        {
+            ids.handle = m_ObjectHandles.Create(object);
+
+            EntityGuid guid;
+            do
+            {
+                guid = EntityGuids::Create();
+            } while (m_GuidObjects.find(guid) != m_GuidObjects.end());
+
+            ids.guid = guid;
+            ids.name = object->GetName();
+            ids.changed = ++m_ChangeCount;
+            m_GuidObjects[guid] = object;
+        }
+        return ids;
+    }
+
+    void SceneEntities::Forget(const GameObject* object)
+    {
+        auto it = m_ObjectIds.find(object);
+        if (it != m_ObjectIds.end())
+        {
+            m_ObjectHandles.Release(it->second.handle);
+            m_GuidObjects.erase(it->second.guid);
+            m_ObjectIds.erase(it);
+        }
+
+        m_TransformRoutines.erase(object);
+        for (auto parent = m_Parents.begin(); parent != m_Parents.end();)
+        {
+            if (parent->first == object || parent->second.parent == object)
+            {
+                MarkChanged(parent->first);
+                parent = m_Parents.erase(parent);
+                m_ParentOrderChanged = true;
+            }
+            else
+            {
+                ++parent;
+            }
+        }
+    }
+
+    void SceneEntities::UpdateObjectIds(Scene* scene)
+    {
+        const unsigned int epoch = ++m_IdsEpoch;
+
+        auto see = [this, epoch](GameObject* object)
+        {
+            // A different object now lives at a freed object's address
+            auto it = m_ObjectIds.find(object);
+            if (it != m_ObjectIds.end() && it->second.name != object->GetName())
+                Forget(object);
+
+            Register(object).seen = epoch;
+        };
+
+        for (const auto& p : scene->GetObjectList())
+        {
+            see(p.second);
+        }
+        for (GameObject* camera : scene->GetCameraList())
+        {
+            see(camera);
+        }
+        for (GameObject* light : scene->GetLightList())
+        {
+            see(light);
+        }
+
+        // Objects that left the scene
+        for (auto it = m_ObjectIds.begin(); it != m_ObjectIds.end();)
+        {
+            if (it->second.seen == epoch)
+            {
+                ++it;
+                continue;
+            }
+
+            m_ObjectHandles.Release(it->second.handle);
+            m_GuidObjects.erase(it->second.guid);
+            it = m_ObjectIds.erase(it);
+        }
+
+        m_IdsCount = m_ObjectIds.size();
+        m_Cameras = scene->GetCameraList();
+        m_Lights = scene->GetLightList();
+    }
+
+    void SceneEntities::PullTransform(EntityHandle entity)
+    {
+        size_t row;
+        EntityArchetype* archetype = m_Store.Find(entity, row);
+        if (archetype && PullRow(*archetype, row))
+            MarkChanged(archetype->gameObjects[row]);
+    }
+
+    void SceneEntities::MarkTransformChanged(const GameObject* object)
+    {
+        if (object)
+            m_MarkedObjects.push_back(object);
+    }
+
+    void SceneEntities::MarkChanged(const GameObject* object)
+    {
+        auto it = m_ObjectIds.find(object);
+        if (it != m_ObjectIds.end())
+            it->second.changed = ++m_ChangeCount;
+    }
+
+    bool SceneEntities::ChangedSince(const GameObject* object, unsigned long long changeCount) const
+    {
+        if (m_AllChangedAt > changeCount)
+            return true;
+
+        // Objects without ids are new, or were replaced
+        auto it = m_ObjectIds.find(object);
+        return it == m_ObjectIds.end() || it->second.changed > changeCount;
+    }
+
+    void SceneEntities::PullMarkedTransforms()
+    {
+        // Marked objects not in the store yet are pulled when it is rebuilt
+        for (const GameObject* object : m_MarkedObjects)
+        {
+            const EntityHandle entity = Find(object);
+            if (!entity.IsNull())
+                PullTransform(entity);
+        }
+        m_MarkedObjects.clear();
+    }
+
+    void SceneEntities::PullTransforms()
+    {
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                if (PullRow(archetype, row))
+                    MarkChanged(archetype.gameObjects[row]);
+            }
+        }
+        m_MarkedObjects.clear();
+    }
+
+    void SceneEntities::PushTransforms()
+    {
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                GameObject* object = archetype.gameObjects[row];
+                object->SetPosition(vec3(archetype.positionX[row], archetype.positionY[row], archetype.positionZ[row]));
+                object->SetRotation(vec3(archetype.rotationX[row], archetype.rotationY[row], archetype.rotationZ[row]));
+                object->SetScale(vec3(archetype.scaleX[row], archetype.scaleY[row], archetype.scaleZ[row]));
+            }
+        }
+    }
+
+    void SceneEntities::PushWrittenTransforms()
+    {
+        // Rows only pulled from their GameObject already match it
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                if (!archetype.transformWritten[row])
+                    continue;
+                archetype.transformWritten[row] = 0;
+
+                GameObject* object = archetype.gameObjects[row];
+                object->SetPosition(vec3(archetype.positionX[row], archetype.positionY[row], archetype.positionZ[row]));
+                object->SetRotation(vec3(archetype.rotationX[row], archetype.rotationY[row], archetype.rotationZ[row]));
+                object->SetScale(vec3(archetype.scaleX[row], archetype.scaleY[row], archetype.scaleZ[row]));
+                MarkChanged(object);
+            }
+        }
+    }
+
+    void SceneEntities::AddTransformRoutine(GameObject* object, float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3])
+    {
+        TransformRoutineData& data = m_TransformRoutines[object];
+        data.speed = speed;
+        for (int i = 0; i < 3; i++)
+        {
+            data.positionOffset[i] = positionOffset[i];
+            data.rotationOffset[i] = rotationOffset[i];
+            data.scaleOffset[i] = scaleOffset[i];
+        }
+
+        MarkChanged(object);
+
+        // Objects not in the store yet are picked up by the next rebuild
+        const EntityHandle entity = Find(object);
+        if (!entity.IsNull())
+            m_TransformRoutineBatch->Add(entity, speed, positionOffset, rotationOffset, scaleOffset);
+    }
+
+    void SceneEntities::RemoveTransformRoutine(GameObject* object)
+    {
+        if (m_TransformRoutines.erase(object) > 0)
+            MarkChanged(object);
+
+        const EntityHandle entity = Find(object);
+        if (!entity.IsNull())
+            m_TransformRoutineBatch->Remove(entity);
+    }
+
+    bool SceneEntities::GetTransformRoutine(const GameObject* object, float& speed, float positionOffset[3], float rotationOffset[3], float scaleOffset[3]) const
+    {
+        auto it = m_TransformRoutines.find(object);
+        if (it == m_TransformRoutines.end())
+            return false;
+
+        const TransformRoutineData& data = it->second;
+        speed = data.speed;
+        for (int i = 0; i < 3; i++)
+        {
+            positionOffset[i] = data.positionOffset[i];
+            rotationOffset[i] = data.rotationOffset[i];
+            scaleOffset[i] = data.scaleOffset[i];
+        }
+        return true;
+    }
+
+    void SceneEntities::UpdateRoutines(double deltaTime, TaskScheduler* scheduler)
+    {
+        PROFILE_SCOPE("Scene Entities Routines");
+
+        if (m_RoutineBatches.Count() == 0)
+            return;
+
+        m_RoutineBatches.Update(m_Store, deltaTime, scheduler);
+        PushWrittenTransforms();
+    }
+
+    void SceneEntities::UpdateCullProxies()
+    {
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            if ((i & EntityComponent_Render) == 0)
+                continue;
+
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                if (!archetype.worldMatrixChanged[row])
+                    continue;
+                archetype.worldMatrixChanged[row] = 0;
+
+                const float* bounds = &archetype.localBounds[row * 6];
+                if (bounds[3] < 0.0f)
+                    continue; // Unknown bounds
+
+                // World box around the transformed local box
+                const float* m = &archetype.worldMatrices[row * 16];
+                float min[3], max[3];
+                for (int axis = 0; axis < 3; axis++)
+                {
+                    const float center = m[axis] * bounds[0] + m[4 + axis] * bounds[1] + m[8 + axis] * bounds[2] + m[12 + axis];
+                    const float extent = std::fabs(m[axis]) * bounds[3] + std::fabs(m[4 + axis]) * bounds[4] + std::fabs(m[8 + axis]) * bounds[5];
+                    min[axis] = center - extent;
+                    max[axis] = center + extent;
+                }
+
+                int& proxy = archetype.cullProxies[row];
+                if (proxy < 0)
+                {
+                    proxy = m_CullTree.CreateProxy(min, max, (unsigned int)m_CullEntities.size());
+                    m_CullEntities.push_back(archetype.entities[row]);
+                }
+                else
+                {
+                    m_CullTree.MoveProxy(proxy, min, max);
+                }
+            }
+        }
+    }
+
+    void SceneEntities::Cull(const float viewProjection[16])
+    {
+        PROFILE_SCOPE("Scene Entities Cull");
+
+        UpdateCullProxies();
+
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            if ((i & EntityComponent_Render) == 0)
+                continue;
+
+            // Entities outside the tree are always drawn
+            EntityArchetype& archetype = m_Store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                archetype.visible[row] = archetype.cullProxies[row] < 0 ? 1 : 0;
+            }
+        }
+
+        Frustum frustum;
+        frustum.SetFromMatrix(viewProjection);
+
+        m_CullResults.clear();
+        m_CullTree.QueryFrustum(frustum, m_CullResults);
+
+        for (const unsigned int result : m_CullResults)
+        {
+            size_t row;
+            EntityArchetype* archetype = m_Store.Find(m_CullEntities[result], row);
+            if (archetype)
+                archetype->visible[row] = 1;
+        }
+    }
+
+    static void WorldMatrix(const GameObject* object, float out[16])
+    {
+        const vec3 position = object->GetPosition();
+        const vec3 rotation = object->GetRotation();
+        const vec3 scale = object->GetScale();
+        const float p[3] = { position.x, position.y, position.z };
+        const float r[3] = { rotation.x, rotation.y, rotation.z };
+        const float s[3] = { scale.x, scale.y, scale.z };
+        TransformMath::ComposeSRT(p, r, s, out);
+    }
+
+    // The child's world matrix relative to the parent's
+    static void TakeOffset(const GameObject* object, const GameObject* parent, float offset[16])
+    {
+        float world[16], parentWorld[16], inverseParent[16];
+        WorldMatrix(object, world);
+        WorldMatrix(parent, parentWorld);
+        TransformMath::InvertAffine(parentWorld, inverseParent);
+        TransformMath::Multiply(inverseParent, world, offset);
+    }
+
+    bool SceneEntities::SetParent(GameObject* object, GameObject* parent)
+    {
+        if (object == nullptr || object == parent)
+            return false;
+
+        if (parent == nullptr)
+        {
+            if (m_Parents.erase(object) > 0)
+            {
+                m_ParentOrderChanged = true;
+                MarkChanged(object);
+            }
+            return true;
+        }
+
+        // No descendant of object can become its parent
+        for (const GameObject* ancestor = parent; ancestor; ancestor = GetParent(ancestor))
+        {
+            if (ancestor == object)
+                return false;
+        }
+
+        ParentLink& link = m_Parents[object];
+        link.parent = parent;
+        TakeOffset(object, parent, link.offset);
+        m_ParentOrderChanged = true;
+        MarkChanged(object);
+        return true;
+    }
+
+    GameObject* SceneEntities::GetParent(const GameObject* object) const
+    {
+        auto it = m_Parents.find(object);
+        if (it == m_Parents.end())
+            return nullptr;
+        return it->second.parent;
+    }
+
+    void SceneEntities::UpdateChildTransforms()
+    {
+        if (m_Parents.empty())
+            return;
+
+        PROFILE_SCOPE("Scene Entities Children");
+
+        if (m_ParentOrderChanged)
+        {
+            // Sorted by depth, so a parent has its final transform before its children read it
+            std::vector<std::pair<unsigned int, const GameObject*>> depths;
+            depths.reserve(m_Parents.size());
+            for (const auto& p : m_Parents)
+            {
+                unsigned int depth = 0;
+                for (const GameObject* ancestor = p.second.parent; ancestor; ancestor = GetParent(ancestor))
+                {
+                    depth++;
+                }
+                depths.push_back(std::make_pair(depth, p.first));
+            }
+            std::sort(depths.begin(), depths.end());
+
+            m_ParentOrder.clear();
+            for (const auto& depth : depths)
+            {
+                m_ParentOrder.push_back(depth.second);
+            }
+            m_ParentOrderChanged = false;
+        }
+
+        for (const GameObject* child : m_ParentOrder)
+        {
+            ParentLink& link = m_Parents[child];
+
+            size_t row, parentRow;
+            EntityArchetype* archetype = m_Store.Find(Find(child), row);
+            EntityArchetype* parentArchetype = m_Store.Find(Find(link.parent), parentRow);
+            if (archetype == nullptr || parentArchetype == nullptr)
+                continue; // Picked up when the store is rebuilt
+
+            // Dirty rows changed since world matrices were last updated
+            if (archetype->transformDirty[row])
+            {
+                TakeOffset(child, link.parent, link.offset);
+            }
+            else if (parentArchetype->transformDirty[parentRow])
+            {
+                float parentWorld[16], world[16];
+                WorldMatrix(link.parent, parentWorld);
+                TransformMath::Multiply(parentWorld, link.offset, world);
+
+                float position[3], rotation[3], scale[3];
+                TransformMath::DecomposeSRT(world, position, rotation, scale);
+
+                GameObject* object = archetype->gameObjects[row];
+                object->SetPosition(vec3(position[0], position[1], position[2]));
+                object->SetRotation(vec3(rotation[0], rotation[1], rotation[2]));
+                object->SetScale(vec3(scale[0], scale[1], scale[2]));
+                if (PullRow(*archetype, row))
+                    MarkChanged(object);
+            }
+        }
+    }
+
+    ObjectHandle SceneEntities::GetHandle(GameObject* object)
+    {
+        if (object == nullptr)
+            return ObjectHandle();
+
+        return Register(object).handle;
+    }
+
+    EntityGuid SceneEntities::GetGuid(const GameObject* object) const
+    {
+        auto it = m_ObjectIds.find(object);
+        return it == m_ObjectIds.end() ? 0 : it->second.guid;
+    }
+
+    void SceneEntities::SetGuid(GameObject* object, EntityGuid guid)
+    {
+        if (object == nullptr || guid == 0)
+            return;
+
+        ObjectIds& ids = Register(object);
+        if (ids.guid == guid)
+            return;
+
+        auto existing = m_GuidObjects.find(guid);
+        if (existing != m_GuidObjects.end())
+        {
+            LOG_WARN("SceneEntities: {0} has the GUID of {1}. It keeps a new one.", object->GetName().c_str(), existing->second->GetName().c_str());
+            return;
+        }
+
+        m_GuidObjects.erase(ids.guid);
+        ids.guid = guid;
+        ids.changed = ++m_ChangeCount;
+        m_GuidObjects[guid] = object;
+    }
+
+    GameObject* SceneEntities::FindByGuid(EntityGuid guid) const
+    {
+        auto it = m_GuidObjects.find(guid);
+        return it == m_GuidObjects.end() ? nullptr : it->second;
+    }
+
+    EntityHandle SceneEntities::Find(const GameObject* object) const
+    {
+        auto it = m_Handles.find(object);
+        if (it == m_Handles.end())
+            return EntityHandle();
+        return it->second;
+    }
+
+}
@@ -0,0 +1,197 @@
+#ifndef _Scene_Entities_H_
+#define _Scene_Entities_H_
+
+// Keeps an EntityStore in step with a framework Scene so engine systems
+// can loop over contiguous arrays while editor and game code keep using
+// GameObjects.
+//
+// GameObjects stay the source of truth, but Sync() doesn't walk them all.
+// It copies in the transforms of objects marked with MarkTransformChanged()
+// and of objects the framework moves itself, those with a physics
+// component or a framework transform routine. Code that moves other
+// GameObjects marks them, or calls PullTransforms() after moving many.
+// PushTransforms() writes back anything a store based system changed.
+//
+// The store is rebuilt when objects join or leave the scene. Code that
+// replaces an object's components, or changes mesh bounds, calls
+// Invalidate() to force a rebuild.
+//
+// GameObject transforms stay in world space, as the framework uses them.
+// A parent set here keeps its children's offsets from it, and Sync() moves
+// the children's GameObjects whenever the parent moved. A child that moved
+// itself keeps its new place, and its offset is taken again. Loaders,
+// savers and SceneImage store parents by GUID.
+//
+// Batched routines are attached to GameObjects here as well, and are
+// re-attached to the new entities whenever the store is rebuilt.
+//
+// Render entities with known mesh bounds (see MeshBounds) are kept in a
+// bounding volume tree for frustum culling.
+//
+// Changes to what a SceneSnapshot saves are counted per object, so savers
+// only capture the objects changed since their last save. Transforms,
+// parents, GUIDs and batched routines are counted here. Code that changes
+// anything else an object saves, like its renderables, calls MarkChanged().
+//
+// Every object in the scene, cameras and lights included, is given an
+// ObjectHandle and an EntityGuid when the store is rebuilt. Both are kept
+// across rebuilds. Sync() drops them once the object leaves the scene, or
+// when another object took its address, so call it every frame that
+// handles are resolved.
+
+#include "EntityGuid.h"
+#include "EntityStore.h"
+#include "ObjectHandles.h"
+#include "RoutineBatches.h"
+#include "../Graphics/BoundingVolumeTree.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QwerkE {
+
+    class Scene;
+    class TaskScheduler;
+    class TransformRoutineBatch;
+
+    class SceneEntities
+    {
+    public:
+        SceneEntities();
+
+        // Rebuilds the store when the scene changed, otherwise pulls changed
+        // transforms. Once a frame.
+        void Sync(Scene* scene);
+        // The part of Sync() batched routines need between frames. Rebuilds
+        // when objects joined or left, and pulls marked transforms only.
+        void SyncMarked(Scene* scene);
+        bool IsStale(Scene* scene) const;
+        // Also counts every object as changed
+        void Invalidate() { m_Scene = nullptr; m_AllChangedAt = ++m_ChangeCount; }
+        void Clear();
+        // Clear(), and drops parents and routines. For when the scene's
+        // objects are replaced, as new objects can reuse old addresses.
+        // Loaders set the new objects' parents again from their files.
+        void Reset();
+        // Drops the ids, parent links and routines of an object about to be
+        // removed from the scene, so a replacement can take its GUID
+        void Remove(const GameObject* object) { Forget(object); Invalidate(); }
+
+        // Pulls the object's transform at the next sync
+        void MarkTransformChanged(const GameObject* object);
+        void PullTransforms();
+        void PushTransforms();
+
+        void MarkChanged(const GameObject* object);
+        unsigned long long GetChangeCount() const { return m_ChangeCount; }
+        // True when the object may have changed since GetChangeCount()
+        // returned changeCount, or is new
+        bool ChangedSince(const GameObject* object, unsigned long long changeCount) const;
+
+        // Pass a null parent to detach. The object keeps its world transform.
+        // Kept across scene rebuilds. False if it would make a loop.
+        bool SetParent(GameObject* object, GameObject* parent);
+        GameObject* GetParent(const GameObject* object) const;
+
+        // Offsets are applied per second, times speed
+        void AddTransformRoutine(GameObject* object, float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3]);
+        void RemoveTransformRoutine(GameObject* object);
+        // False when the object has none
+        bool GetTransformRoutine(const GameObject* object, float& speed, float positionOffset[3], float rotationOffset[3], float scaleOffset[3]) const;
+
+        // Runs every batched routine, then writes changed transforms back
+        // to their GameObjects. Call after Sync().
+        void UpdateRoutines(double deltaTime, TaskScheduler* scheduler);
+        bool HasRoutines() const { return !m_TransformRoutines.empty(); }
+
+        // Sets the visible flags of render archetypes. Moved entities are
+        // refitted in the tree first, so call after UpdateWorldMatrices().
+        void Cull(const float viewProjection[16]);
+
+        // Gives object a handle and GUID if it has none yet
+        ObjectHandle GetHandle(GameObject* object);
+        GameObject* Resolve(ObjectHandle handle) const { return m_ObjectHandles.Resolve(handle); }
+
+        // 0 if the object has none yet
+        EntityGuid GetGuid(const GameObject* object) const;
+        // For objects loaded from files. A GUID already in use is replaced by
+        // a new one, so copied entities don't share it.
+        void SetGuid(GameObject* object, EntityGuid guid);
+        GameObject* FindByGuid(EntityGuid guid) const;
+
+        EntityHandle Find(const GameObject* object) const;
+        GameObject* GetGameObject(EntityHandle entity) const { return m_Store.GetGameObject(entity); }
+
+        EntityStore& GetStore() { return m_Store; }
+        const EntityStore& GetStore() const { return m_Store; }
+        Scene* GetScene() const { return m_Scene; }
+
+    private:
+        struct TransformRoutineData
+        {
+            float speed;
+            float positionOffset[3];
+            float rotationOffset[3];
+            float scaleOffset[3];
+        };
+
+        struct ObjectIds
+        {
+            ObjectHandle handle;
+            EntityGuid guid = 0;
+            unsigned int seen = 0; // Last m_IdsEpoch the object was in the scene
+            std::string name; // To notice a new object at the same address
+            unsigned long long changed = 0; // m_ChangeCount of the last change
+        };
+
+        bool ObjectIdsChanged(Scene* scene) const;
+        void Rebuild(Scene* scene);
+        ObjectIds& Register(GameObject* object);
+        void UpdateObjectIds(Scene* scene);
+        // Drops the ids, parent links and routines of an object that is gone
+        void Forget(const GameObject* object);
+        void UpdateChildTransforms();
+        void PullTransform(EntityHandle entity);
+        void PullMarkedTransforms();
+        void PushWrittenTransforms();
+        void UpdateCullProxies();
+
+        EntityStore m_Store;
+        std::unordered_map<const GameObject*, EntityHandle> m_Handles;
+
+        struct ParentLink
+        {
+            GameObject* parent;
+            float offset[16]; // The child's world matrix relative to the parent's
+        };
+        std::unordered_map<const GameObject*, ParentLink> m_Parents;
+        std::vector<const GameObject*> m_ParentOrder; // Children, parents before their own children
+        bool m_ParentOrderChanged = false;
+
+        RoutineBatches m_RoutineBatches;
+        TransformRoutineBatch* m_TransformRoutineBatch = nullptr; // Owned by m_RoutineBatches
+        std::unordered_map<const GameObject*, TransformRoutineData> m_TransformRoutines;
+
+        BoundingVolumeTree m_CullTree;
+        std::vector<EntityHandle> m_CullEntities; // Indexed by proxy user data
+        std::vector<unsigned int> m_CullResults;
+
+        ObjectHandleTable m_ObjectHandles;
+        std::unordered_map<const GameObject*, ObjectIds> m_ObjectIds;
+        std::unordered_map<EntityGuid, GameObject*> m_GuidObjects;
+        unsigned int m_IdsEpoch = 0;
+        size_t m_IdsCount = 0; // m_ObjectIds.size() after UpdateObjectIds()
+        std::vector<GameObject*> m_Cameras; // Scene lists as of UpdateObjectIds()
+        std::vector<GameObject*> m_Lights;
+        unsigned long long m_ChangeCount = 0;
+        unsigned long long m_AllChangedAt = 0; // Changes up to here count for every object
+
+        Scene* m_Scene = nullptr;
+        size_t m_ObjectCount = 0; // Scene objects when the store was built
+        std::vector<const GameObject*> m_MarkedObjects;
+        std::vector<EntityHandle> m_MovedByFramework; // Pulled every Sync()
+    };
+
+}
+#endif // _Scene_Entities_H_
@@ -0,0 +1,110 @@
+#include "TransformRoutineBatch.h"
+
+namespace QwerkE {
+
+    template <class T>
+    static void SwapRemove(std::vector<T>& values, size_t index)
+    {
+        values[index] = values.back();
+        values.pop_back();
+    }
+
+    void TransformRoutineBatch::Add(EntityHandle entity, float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3])
+    {
+        auto it = m_Indices.find(entity.index);
+        if (it != m_Indices.end())
+            RemoveAt(it->second);
+
+        m_Indices[entity.index] = m_Entities.size();
+        m_Entities.push_back(entity);
+        m_Speed.push_back(speed);
+        m_PositionX.push_back(positionOffset[0]);
+        m_PositionY.push_back(positionOffset[1]);
+        m_PositionZ.push_back(positionOffset[2]);
+        m_RotationX.push_back(rotationOffset[0]);
+        m_RotationY.push_back(rotationOffset[1]);
+        m_RotationZ.push_back(rotationOffset[2]);
+        m_ScaleX.push_back(scaleOffset[0]);
+        m_ScaleY.push_back(scaleOffset[1]);
+        m_ScaleZ.push_back(scaleOffset[2]);
+    }
+
+    void TransformRoutineBatch::Remove(EntityHandle entity)
+    {
+        auto it = m_Indices.find(entity.index);
+        if (it != m_Indices.end() && m_Entities[it->second] == entity)
+            RemoveAt(it->second);
+    }
+
+    void TransformRoutineBatch::RemoveAt(size_t index)
+    {
+        m_Indices.erase(m_Entities[index].index);
+        if (index != m_Entities.size() - 1)
+            m_Indices[m_Entities.back().index] = index;
+
+        SwapRemove(m_Entities, index);
+        SwapRemove(m_Speed, index);
+        SwapRemove(m_PositionX, index);
+        SwapRemove(m_PositionY, index);
+        SwapRemove(m_PositionZ, index);
+        SwapRemove(m_RotationX, index);
+        SwapRemove(m_RotationY, index);
+        SwapRemove(m_RotationZ, index);
+        SwapRemove(m_ScaleX, index);
+        SwapRemove(m_ScaleY, index);
+        SwapRemove(m_ScaleZ, index);
+    }
+
+    void TransformRoutineBatch::Update(EntityStore& store, size_t begin, size_t end, double deltaTime)
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            size_t row;
+            EntityArchetype* archetype = store.Find(m_Entities[i], row);
+            if (archetype == nullptr)
+                continue; // Removed by RemoveInvalid()
+
+            const float step = m_Speed[i] * (float)deltaTime;
+            archetype->positionX[row] += m_PositionX[i] * step;
+            archetype->positionY[row] += m_PositionY[i] * step;
+            archetype->positionZ[row] += m_PositionZ[i] * step;
+            archetype->rotationX[row] += m_RotationX[i] * step;
+            archetype->rotationY[row] += m_RotationY[i] * step;
+            archetype->rotationZ[row] += m_RotationZ[i] * step;
+            archetype->scaleX[row] += m_ScaleX[i] * step;
+            archetype->scaleY[row] += m_ScaleY[i] * step;
+            archetype->scaleZ[row] += m_ScaleZ[i] * step;
+            archetype->transformDirty[row] = 1;
+            archetype->transformWritten[row] = 1;
+        }
+    }
+
+    void TransformRoutineBatch::RemoveInvalid(const EntityStore& store)
+    {
+        size_t i = 0;
+        while (i < m_Entities.size())
+        {
+            if (store.IsValid(m_Entities[i]))
+                i++;
+            else
+                RemoveAt(i); // Moves the last routine into i
+        }
+    }
+
+    void TransformRoutineBatch::Clear()
+    {
+        m_Entities.clear();
+        m_Speed.clear();
+        m_PositionX.clear();
+        m_PositionY.clear();
+        m_PositionZ.clear();
+        m_RotationX.clear();
+        m_RotationY.clear();
+        m_RotationZ.clear();
+        m_ScaleX.clear();
+        m_ScaleY.clear();
+        m_ScaleZ.clear();
+        m_Indices.clear();
+    }
+
+}
@@ -0,0 +1,42 @@
+#ifndef _Transform_Routine_Batch_H_
+#define _Transform_Routine_Batch_H_
+
+// Batched version of the framework's Transform routine. Moves, rotates
+// and scales an entity by its offsets, times speed, every second.
+// An entity can have 1 transform routine.
+
+#include "RoutineBatches.h"
+
+#include <unordered_map>
+
+namespace QwerkE {
+
+    class TransformRoutineBatch : public RoutineBatch
+    {
+    public:
+        eRoutineTypes Type() const override { return Routine_Transform; }
+        bool IsStateless() const override { return true; }
+        size_t Count() const override { return m_Entities.size(); }
+
+        // Replaces the entity's routine if it already has one
+        void Add(EntityHandle entity, float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3]);
+        void Remove(EntityHandle entity);
+
+        void Update(EntityStore& store, size_t begin, size_t end, double deltaTime) override;
+        void RemoveInvalid(const EntityStore& store) override;
+        void Clear() override;
+
+    private:
+        void RemoveAt(size_t index);
+
+        std::vector<EntityHandle> m_Entities;
+        std::vector<float> m_Speed;
+        std::vector<float> m_PositionX, m_PositionY, m_PositionZ;
+        std::vector<float> m_RotationX, m_RotationY, m_RotationZ;
+        std::vector<float> m_ScaleX, m_ScaleY, m_ScaleZ;
+
+        std::unordered_map<unsigned int, size_t> m_Indices; // Entity slot to routine index
+    };
+
+}
+#endif // _Transform_Routine_Batch_H_
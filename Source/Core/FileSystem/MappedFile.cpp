@@ -0,0 +1,107 @@
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+namespace QwerkE {
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+#ifdef _WIN32
+    bool MappedFile::Open(const char* filePath)
+    {
+        Close();
+
+        HANDLE file = CreateFileA(filePath, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+            return false;
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file, &size) || size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping == nullptr)
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (data == nullptr)
+        {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            return false;
+        }
+
+        m_File = file;
+        m_Mapping = mapping;
+        m_Data = (const unsigned char*)data;
+        m_Size = (size_t)size.QuadPart;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            UnmapViewOfFile(m_Data);
+        if (m_Mapping)
+            CloseHandle((HANDLE)m_Mapping);
+        if (m_File)
+            CloseHandle((HANDLE)m_File);
+
+        m_Data = nullptr;
+        m_Size = 0;
+        m_Mapping = nullptr;
+        m_File = nullptr;
+    }
+#else
+    bool MappedFile::Open(const char* filePath)
+    {
+        Close();
+
+        const int file = open(filePath, O_RDONLY);
+        if (file < 0)
+            return false;
+
+        struct stat info;
+        if (fstat(file, &info) != 0 || info.st_size == 0)
+        {
+            close(file);
+            return false;
+        }
+
+        void* data = mmap(nullptr, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, file, 0);
+        close(file); // The mapping keeps the file open
+        if (data == MAP_FAILED)
+            return false;
+
+        m_Data = (const unsigned char*)data;
+        m_Size = (size_t)info.st_size;
+        return true;
+    }
+
+    void MappedFile::Close()
+    {
+        if (m_Data)
+            munmap((void*)m_Data, m_Size);
+
+        m_Data = nullptr;
+        m_Size = 0;
+    }
+#endif // _WIN32
+
+}
@@ -0,0 +1,38 @@
+#ifndef _Mapped_File_H_
+#define _Mapped_File_H_
+
+// Read only view of a whole file mapped into memory. Pages are read by
+// the OS as they are touched, so nothing is copied or parsed up front.
+
+#include <cstddef>
+
+namespace QwerkE {
+
+    class MappedFile
+    {
+    public:
+        MappedFile() {}
+        ~MappedFile();
+
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        bool Open(const char* filePath);
+        void Close();
+
+        bool IsOpen() const { return m_Data != nullptr; }
+        const unsigned char* Data() const { return m_Data; }
+        size_t Size() const { return m_Size; }
+
+    private:
+        const unsigned char* m_Data = nullptr;
+        size_t m_Size = 0;
+
+#ifdef _WIN32
+        void* m_File = nullptr;
+        void* m_Mapping = nullptr;
+#endif // _WIN32
+    };
+
+}
+#endif // _Mapped_File_H_
@@ -0,0 +1,416 @@
+#include "BoundingVolumeTree.h"
+#include "Frustum.h"
+
+#include <algorithm>
+
+namespace QwerkE {
+
+    // Leaves are grown by this part of their size, plus a minimum
+    static const float s_MarginScale = 0.1f;
+    static const float s_MinMargin = 0.05f;
+
+    static float SurfaceArea(const float min[3], const float max[3])
+    {
+        const float x = max[0] - min[0];
+        const float y = max[1] - min[1];
+        const float z = max[2] - min[2];
+        return 2.0f * (x * y + y * z + z * x);
+    }
+
+    static void Combine(const float minA[3], const float maxA[3], const float minB[3], const float maxB[3], float outMin[3], float outMax[3])
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            outMin[i] = std::min(minA[i], minB[i]);
+            outMax[i] = std::max(maxA[i], maxB[i]);
+        }
+    }
+
+    static bool Contains(const float outerMin[3], const float outerMax[3], const float min[3], const float max[3])
+    {
+        for (int i = 0; i < 3; i++)
+        {
+            if (min[i] < outerMin[i] || max[i] > outerMax[i])
+                return false;
+        }
+        return true;
+    }
+
+    int BoundingVolumeTree::AllocateNode()
+    {
+        if (m_FreeList == s_NullNode)
+        {
+            m_Nodes.push_back(Node());
+            m_Nodes.back().parent = s_NullNode;
+            m_FreeList = (int)m_Nodes.size() - 1;
+        }
+
+        const int node = m_FreeList;
+        m_FreeList = m_Nodes[node].parent;
+
+        Node& n = m_Nodes[node];
+        n.parent = s_NullNode;
+        n.child1 = s_NullNode;
+        n.child2 = s_NullNode;
+        n.height = 0;
+        n.userData = 0;
+        return node;
+    }
+
+    void BoundingVolumeTree::FreeNode(int node)
+    {
+        m_Nodes[node].parent = m_FreeList;
+        m_Nodes[node].height = -1;
+        m_FreeList = node;
+    }
+
+    int BoundingVolumeTree::CreateProxy(const float min[3], const float max[3], unsigned int userData)
+    {
+        const int proxy = AllocateNode();
+        Node& node = m_Nodes[proxy];
+        for (int i = 0; i < 3; i++)
+        {
+            const float margin = std::max((max[i] - min[i]) * s_MarginScale, s_MinMargin);
+            node.min[i] = min[i] - margin;
+            node.max[i] = max[i] + margin;
+        }
+        node.userData = userData;
+
+        InsertLeaf(proxy);
+        m_ProxyCount++;
+        return proxy;
+    }
+
+    void BoundingVolumeTree::DestroyProxy(int proxy)
+    {
+        RemoveLeaf(proxy);
+        FreeNode(proxy);
+        m_ProxyCount--;
+    }
+
+    bool BoundingVolumeTree::MoveProxy(int proxy, const float min[3], const float max[3])
+    {
+        Node& node = m_Nodes[proxy];
+        if (Contains(node.min, node.max, min, max))
+            return false;
+
+        RemoveLeaf(proxy);
+
+        Node& moved = m_Nodes[proxy];
+        for (int i = 0; i < 3; i++)
+        {
+            const float margin = std::max((max[i] - min[i]) * s_MarginScale, s_MinMargin);
+            moved.min[i] = min[i] - margin;
+            moved.max[i] = max[i] + margin;
+        }
+
+        InsertLeaf(proxy);
+        return true;
+    }
+
+    void BoundingVolumeTree::InsertLeaf(int leaf)
+    {
+        if (m_Root == s_NullNode)
+        {
+            m_Root = leaf;
+            m_Nodes[leaf].parent = s_NullNode;
+            return;
+        }
+
+        const float* leafMin = m_Nodes[leaf].min;
+        const float* leafMax = m_Nodes[leaf].max;
+
+        // Walk down to the cheapest sibling. Costs are surface area added.
+        int index = m_Root;
+        while (!m_Nodes[index].IsLeaf())
+        {
+            const Node& node = m_Nodes[index];
+            const float area = SurfaceArea(node.min, node.max);
+
+            float combinedMin[3], combinedMax[3];
+            Combine(node.min, node.max, leafMin, leafMax, combinedMin, combinedMax);
+            const float combinedArea = SurfaceArea(combinedMin, combinedMax);
+
+            // Cost of making a new parent for this node and the leaf
+            const float cost = 2.0f * combinedArea;
+            // Cost pushed down to children
+            const float inheritanceCost = 2.0f * (combinedArea - area);
+
+            float childCosts[2];
+            const int children[2] = { node.child1, node.child2 };
+            for (int i = 0; i < 2; i++)
+            {
+                const Node& child = m_Nodes[children[i]];
+                float min[3], max[3];
+                Combine(child.min, child.max, leafMin, leafMax, min, max);
+                if (child.IsLeaf())
+                    childCosts[i] = SurfaceArea(min, max) + inheritanceCost;
+                else
+                    childCosts[i] = SurfaceArea(min, max) - SurfaceArea(child.min, child.max) + inheritanceCost;
+            }
+
+            if (cost < childCosts[0] && cost < childCosts[1])
+                break;
+
+            index = childCosts[0] < childCosts[1] ? node.child1 : node.child2;
+        }
+
+        const int sibling = index;
+        const int oldParent = m_Nodes[sibling].parent;
+        const int newParent = AllocateNode(); // May move m_Nodes
+
+        Node& parent = m_Nodes[newParent];
+        parent.parent = oldParent;
+        Combine(m_Nodes[sibling].min, m_Nodes[sibling].max, m_Nodes[leaf].min, m_Nodes[leaf].max, parent.min, parent.max);
+        parent.height = m_Nodes[sibling].height + 1;
+        parent.child1 = sibling;
+        parent.child2 = leaf;
+        m_Nodes[sibling].parent = newParent;
+        m_Nodes[leaf].parent = newParent;
+
+        if (oldParent == s_NullNode)
+        {
+            m_Root = newParent;
+        }
+        else if (m_Nodes[oldParent].child1 == sibling)
+        {
+            m_Nodes[oldParent].child1 = newParent;
+        }
+        else
+        {
+            m_Nodes[oldParent].child2 = newParent;
+        }
+
+        Refit(m_Nodes[leaf].parent);
+    }
+
+    void BoundingVolumeTree::RemoveLeaf(int leaf)
+    {
+        if (leaf == m_Root)
+        {
+            m_Root = s_NullNode;
+            return;
+        }
+
+        const int parent = m_Nodes[leaf].parent;
+        const int grandParent = m_Nodes[parent].parent;
+        const int sibling = m_Nodes[parent].child1 == leaf ? m_Nodes[parent].child2 : m_Nodes[parent].child1;
+
+        if (grandParent == s_NullNode)
+        {
+            m_Root = sibling;
+            m_Nodes[sibling].parent = s_NullNode;
+            FreeNode(parent);
+            return;
+        }
+
+        // The sibling takes the parent's place
+        if (m_Nodes[grandParent].child1 == parent)
+            m_Nodes[grandParent].child1 = sibling;
+        else
+            m_Nodes[grandParent].child2 = sibling;
+        m_Nodes[sibling].parent = grandParent;
+        FreeNode(parent);
+
+        Refit(grandParent);
+    }
+
+    void BoundingVolumeTree::Refit(int index)
+    {
+        // Fix boxes and heights up to the root, balancing on the way
+        while (index != s_NullNode)
+        {
+            index = Balance(index);
+
+            Node& node = m_Nodes[index];
+            const Node& child1 = m_Nodes[node.child1];
+            const Node& child2 = m_Nodes[node.child2];
+            node.height = 1 + std::max(child1.height, child2.height);
+            Combine(child1.min, child1.max, child2.min, child2.max, node.min, node.max);
+
+            index = node.parent;
+        }
+    }
+
+    // Rotates the taller child up when children differ in height by more
+    // than 1. Returns the node now in this position.
+    int BoundingVolumeTree::Balance(int a)
+    {
+        Node& nodeA = m_Nodes[a];
+        if (nodeA.IsLeaf() || nodeA.height < 2)
+            return a;
+
+        const int b = nodeA.child1;
+        const int c = nodeA.child2;
+        const int balance = m_Nodes[c].height - m_Nodes[b].height;
+
+        if (balance > 1)
+        {
+            // Rotate c up
+            const int f = m_Nodes[c].child1;
+            const int g = m_Nodes[c].child2;
+            Node& nodeC = m_Nodes[c];
+
+            nodeC.child1 = a;
+            nodeC.parent = nodeA.parent;
+            nodeA.parent = c;
+
+            if (nodeC.parent == s_NullNode)
+                m_Root = c;
+            else if (m_Nodes[nodeC.parent].child1 == a)
+                m_Nodes[nodeC.parent].child1 = c;
+            else
+                m_Nodes[nodeC.parent].child2 = c;
+
+            // The taller grandchild stays under c
+            const bool fTaller = m_Nodes[f].height > m_Nodes[g].height;
+            const int keep = fTaller ? f : g;
+            const int give = fTaller ? g : f;
+
+            nodeC.child2 = keep;
+            nodeA.child2 = give;
+            m_Nodes[give].parent = a;
+
+            Combine(m_Nodes[b].min, m_Nodes[b].max, m_Nodes[give].min, m_Nodes[give].max, nodeA.min, nodeA.max);
+            Combine(nodeA.min, nodeA.max, m_Nodes[keep].min, m_Nodes[keep].max, nodeC.min, nodeC.max);
+            nodeA.height = 1 + std::max(m_Nodes[b].height, m_Nodes[give].height);
+            nodeC.height = 1 + std::max(nodeA.height, m_Nodes[keep].height);
+            return c;
+        }
+
+        if (balance < -1)
+        {
+            // Rotate b up
+            const int d = m_Nodes[b].child1;
+            const int e = m_Nodes[b].child2;
+            Node& nodeB = m_Nodes[b];
+
+            nodeB.child1 = a;
+            nodeB.parent = nodeA.parent;
+            nodeA.parent = b;
+
+            if (nodeB.parent == s_NullNode)
+                m_Root = b;
+            else if (m_Nodes[nodeB.parent].child1 == a)
+                m_Nodes[nodeB.parent].child1 = b;
+            else
+                m_Nodes[nodeB.parent].child2 = b;
+
+            const bool dTaller = m_Nodes[d].height > m_Nodes[e].height;
+            const int keep = dTaller ? d : e;
+            const int give = dTaller ? e : d;
+
+            nodeB.child2 = keep;
+            nodeA.child1 = give;
+            m_Nodes[give].parent = a;
+
+            Combine(m_Nodes[c].min, m_Nodes[c].max, m_Nodes[give].min, m_Nodes[give].max, nodeA.min, nodeA.max);
+            Combine(nodeA.min, nodeA.max, m_Nodes[keep].min, m_Nodes[keep].max, nodeB.min, nodeB.max);
+            nodeA.height = 1 + std::max(m_Nodes[c].height, m_Nodes[give].height);
+            nodeB.height = 1 + std::max(nodeA.height, m_Nodes[keep].height);
+            return b;
+        }
+
+        return a;
+    }
+
+    void BoundingVolumeTree::CollectLeaves(int node, std::vector<unsigned int>& results) const
+    {
+        // Shares the query stack, so only pops what it pushed
+        const size_t base = m_Stack.size();
+        m_Stack.push_back(node);
+        while (m_Stack.size() > base)
+        {
+            const Node& n = m_Nodes[m_Stack.back()];
+            m_Stack.pop_back();
+
+            if (n.IsLeaf())
+            {
+                results.push_back(n.userData);
+                continue;
+            }
+            m_Stack.push_back(n.child1);
+            m_Stack.push_back(n.child2);
+        }
+    }
+
+    void BoundingVolumeTree::QueryFrustum(const Frustum& frustum, std::vector<unsigned int>& results) const
+    {
+        if (m_Root == s_NullNode)
+            return;
+
+        // Inner nodes are tested 1 at a time. Leaves of partly visible
+        // nodes are gathered and tested together.
+        m_Candidates.clear();
+        m_Stack.clear();
+        m_Stack.push_back(m_Root);
+        while (!m_Stack.empty())
+        {
+            const int index = m_Stack.back();
+            m_Stack.pop_back();
+            const Node& node = m_Nodes[index];
+
+            if (node.IsLeaf())
+            {
+                m_Candidates.push_back(index);
+                continue;
+            }
+
+            float center[3], extents[3];
+            for (int i = 0; i < 3; i++)
+            {
+                center[i] = (node.min[i] + node.max[i]) * 0.5f;
+                extents[i] = (node.max[i] - node.min[i]) * 0.5f;
+            }
+
+            const eFrustumResult result = frustum.TestBox(center, extents);
+            if (result == Frustum_Outside)
+                continue;
+
+            if (result == Frustum_Inside)
+            {
+                // Whole subtree is visible
+                CollectLeaves(index, results);
+                continue;
+            }
+
+            m_Stack.push_back(node.child1);
+            m_Stack.push_back(node.child2);
+        }
+
+        const size_t count = m_Candidates.size();
+        for (std::vector<float>& values : m_CandidateBoxes)
+            values.resize(count);
+        m_CandidateVisible.resize(count);
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const Node& node = m_Nodes[m_Candidates[i]];
+            for (int axis = 0; axis < 3; axis++)
+            {
+                m_CandidateBoxes[axis][i] = (node.min[axis] + node.max[axis]) * 0.5f;
+                m_CandidateBoxes[3 + axis][i] = (node.max[axis] - node.min[axis]) * 0.5f;
+            }
+        }
+
+        frustum.TestBoxesBatch(count,
+            m_CandidateBoxes[0].data(), m_CandidateBoxes[1].data(), m_CandidateBoxes[2].data(),
+            m_CandidateBoxes[3].data(), m_CandidateBoxes[4].data(), m_CandidateBoxes[5].data(),
+            m_CandidateVisible.data());
+
+        for (size_t i = 0; i < count; i++)
+        {
+            if (m_CandidateVisible[i])
+                results.push_back(m_Nodes[m_Candidates[i]].userData);
+        }
+    }
+
+    void BoundingVolumeTree::Clear()
+    {
+        m_Nodes.clear();
+        m_Root = s_NullNode;
+        m_FreeList = s_NullNode;
+        m_ProxyCount = 0;
+    }
+
+}
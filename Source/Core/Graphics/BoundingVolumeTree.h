@@ -0,0 +1,76 @@
+#ifndef _Bounding_Volume_Tree_H_
+#define _Bounding_Volume_Tree_H_
+
+// Dynamic bounding volume hierarchy of axis aligned boxes. Each proxy is
+// a leaf holding a box grown by a margin, so small movements only need
+// the box checked. A proxy is only removed and reinserted once its object
+// leaves the grown box. Insertion picks the sibling that adds the least
+// surface area, and rotations keep the tree balanced.
+
+#include <cstddef>
+#include <vector>
+
+namespace QwerkE {
+
+    class Frustum;
+
+    class BoundingVolumeTree
+    {
+    public:
+        // Returns a proxy id, stable until the proxy is destroyed
+        int CreateProxy(const float min[3], const float max[3], unsigned int userData);
+        void DestroyProxy(int proxy);
+
+        // Returns true when the proxy had to be reinserted
+        bool MoveProxy(int proxy, const float min[3], const float max[3]);
+
+        unsigned int GetUserData(int proxy) const { return m_Nodes[proxy].userData; }
+
+        // Appends the user data of every proxy that may be visible
+        void QueryFrustum(const Frustum& frustum, std::vector<unsigned int>& results) const;
+
+        void Clear();
+
+        size_t ProxyCount() const { return m_ProxyCount; }
+        int Height() const { return m_Root == s_NullNode ? 0 : m_Nodes[m_Root].height; }
+
+    private:
+        static const int s_NullNode = -1;
+
+        struct Node
+        {
+            float min[3];
+            float max[3];
+            int parent; // Next free node while on the free list
+            int child1;
+            int child2;
+            int height; // Leaves are 0, free nodes -1
+            unsigned int userData;
+
+            bool IsLeaf() const { return child1 == s_NullNode; }
+        };
+
+        int AllocateNode();
+        void FreeNode(int node);
+
+        void InsertLeaf(int leaf);
+        void RemoveLeaf(int leaf);
+        int Balance(int node);
+        void Refit(int node);
+
+        void CollectLeaves(int node, std::vector<unsigned int>& results) const;
+
+        std::vector<Node> m_Nodes;
+        int m_Root = s_NullNode;
+        int m_FreeList = s_NullNode;
+        size_t m_ProxyCount = 0;
+
+        // Scratch for QueryFrustum
+        mutable std::vector<int> m_Stack;
+        mutable std::vector<int> m_Candidates;
+        mutable std::vector<float> m_CandidateBoxes[6];
+        mutable std::vector<unsigned char> m_CandidateVisible;
+    };
+
+}
+#endif // _Bounding_Volume_Tree_H_
@@ -0,0 +1,145 @@
+#include "CookedMesh.h"
+#include "VertexQuantization.h"
+#include "../Scenes/CookedScene.h"
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <cstring>
+
+namespace QwerkE {
+
+    const char CookedMesh::s_Magic[4] = { 'Q', 'M', 'S', 'H' };
+
+    static bool InBounds(unsigned long long offset, unsigned long long size, size_t fileSize)
+    {
+        return offset % 4 == 0 && offset <= fileSize && size <= fileSize - offset;
+    }
+
+    bool CookedMesh::Open(const char* filePath)
+    {
+        Close();
+
+        if (!m_File.Open(filePath))
+            return false;
+
+        const unsigned char* data = m_File.Data();
+        const size_t size = m_File.Size();
+        const CookedMeshHeader* header = (const CookedMeshHeader*)data;
+
+        if (size < sizeof(CookedMeshHeader) ||
+            memcmp(header->magic, s_Magic, sizeof(s_Magic)) != 0 ||
+            header->version != s_Version ||
+            header->vertexStride != VertexStride(header->flags))
+        {
+            LOG_ERROR("CookedMesh: {0} is not a version {1} cooked mesh", filePath, s_Version);
+            Close();
+            return false;
+        }
+
+        if (!InBounds(header->submeshesOffset, (unsigned long long)header->submeshCount * sizeof(CookedSubmesh), size) ||
+            !InBounds(header->verticesOffset, (unsigned long long)header->vertexCount * header->vertexStride, size) ||
+            !InBounds(header->indicesOffset, (unsigned long long)header->indexCount * sizeof(unsigned int), size) ||
+            !InBounds(header->stringsOffset, header->stringsSize, size) ||
+            header->stringsSize == 0 || data[header->stringsOffset + header->stringsSize - 1] != '\0')
+        {
+            LOG_ERROR("CookedMesh: {0} is truncated or corrupt", filePath);
+            Close();
+            return false;
+        }
+
+        // Out of range indices would read past the GPU's vertex buffer
+        const CookedSubmesh* submeshes = (const CookedSubmesh*)(data + header->submeshesOffset);
+        const unsigned int* indices = (const unsigned int*)(data + header->indicesOffset);
+        for (unsigned int i = 0; i < header->submeshCount; i++)
+        {
+            const CookedSubmesh& submesh = submeshes[i];
+            bool valid = submesh.firstVertex <= header->vertexCount &&
+                submesh.vertexCount <= header->vertexCount - submesh.firstVertex &&
+                submesh.firstIndex <= header->indexCount &&
+                submesh.indexCount <= header->indexCount - submesh.firstIndex;
+
+            for (unsigned int j = 0; valid && j < submesh.indexCount; j++)
+            {
+                valid = indices[submesh.firstIndex + j] < submesh.vertexCount;
+            }
+
+            if (!valid)
+            {
+                LOG_ERROR("CookedMesh: {0} has an invalid submesh {1}", filePath, i);
+                Close();
+                return false;
+            }
+        }
+
+        m_Header = header;
+        m_Submeshes = submeshes;
+        m_VertexData = data + header->verticesOffset;
+        m_Indices = indices;
+        m_Strings = (const char*)(data + header->stringsOffset);
+        return true;
+    }
+
+    void CookedMesh::Close()
+    {
+        m_File.Close();
+        m_Header = nullptr;
+        m_Submeshes = nullptr;
+        m_VertexData = nullptr;
+        m_Indices = nullptr;
+        m_Strings = nullptr;
+    }
+
+    unsigned int CookedMesh::VertexStride(unsigned int flags)
+    {
+        return (flags & CookedMeshFlag_Quantized) ? sizeof(CookedMeshPackedVertex) : sizeof(CookedMeshVertex);
+    }
+
+    const CookedMeshVertex* CookedMesh::Vertices(const CookedSubmesh& submesh) const
+    {
+        return IsQuantized() ? nullptr : (const CookedMeshVertex*)m_VertexData + submesh.firstVertex;
+    }
+
+    const CookedMeshPackedVertex* CookedMesh::PackedVertices(const CookedSubmesh& submesh) const
+    {
+        return IsQuantized() ? (const CookedMeshPackedVertex*)m_VertexData + submesh.firstVertex : nullptr;
+    }
+
+    void CookedMesh::ReadVertices(const CookedSubmesh& submesh, CookedMeshVertex* out) const
+    {
+        if (!IsQuantized())
+        {
+            if (submesh.vertexCount > 0)
+                memcpy(out, Vertices(submesh), submesh.vertexCount * sizeof(CookedMeshVertex));
+            return;
+        }
+
+        const CookedMeshPackedVertex* packed = PackedVertices(submesh);
+        for (unsigned int i = 0; i < submesh.vertexCount; i++)
+        {
+            VertexQuantization::Unpack(packed[i], submesh.min, submesh.max, out[i]);
+        }
+    }
+
+    bool CookedMesh::IsUpToDate(const char* sourceFilePath) const
+    {
+        unsigned long long size;
+        long long writeTime;
+        if (!CookedScene::SourceFileInfo(sourceFilePath, size, writeTime))
+            return true;
+
+        return size == m_Header->sourceSize && writeTime == m_Header->sourceWriteTime;
+    }
+
+    const char* CookedMesh::GetString(unsigned int offset) const
+    {
+        if (offset >= m_Header->stringsSize)
+            return "";
+        return m_Strings + offset;
+    }
+
+    std::string CookedMesh::CookedPath(const char* sourceFilePath)
+    {
+        return std::string(sourceFilePath) + ".qmesh";
+    }
+
+}
@@ -0,0 +1,141 @@
+#ifndef _Cooked_Mesh_H_
+#define _Cooked_Mesh_H_
+
+// Binary mesh format made by MeshCooker from a model file such as an .obj.
+// A cooked file is memory mapped and its vertex and index buffers are
+// handed to the GPU as they are, so loading does no parsing, triangulation
+// or vertex welding.
+//
+// Every mesh of the source file is a submesh. Vertices are interleaved and
+// indexed. Each submesh's vertices and indices are 1 contiguous range of
+// the shared buffers, and its indices count from its first vertex.
+// MeshCooker orders both for the vertex caches, see MeshOptimizer.h.
+//
+// File layout, little endian. Offsets are bytes from the start of the
+// file, and every section starts on a 4 byte boundary.
+//   Header    { CookedMeshHeader }
+//   Submeshes { CookedSubmesh submeshes[submeshCount] }
+//   Vertices  { CookedMeshVertex vertices[vertexCount] }, or
+//             { CookedMeshPackedVertex vertices[vertexCount] } when quantized
+//   Indices   { unsigned int indices[indexCount] }
+//   Strings   { Null terminated UTF-8 strings. Offset 0 is "". }
+
+#include "../FileSystem/MappedFile.h"
+
+#include <string>
+
+namespace QwerkE {
+
+    enum eCookedMeshFlags : unsigned int
+    {
+        CookedMeshFlag_Normals = 1 << 0, // The source had or generated normals. Otherwise they are 0.
+        CookedMeshFlag_UVs = 1 << 1, // The source had texture coordinates. Otherwise they are 0.
+        CookedMeshFlag_Quantized = 1 << 2 // Vertices are CookedMeshPackedVertex, see VertexQuantization.h
+    };
+
+    struct CookedMeshHeader
+    {
+        char magic[4]; // "QMSH"
+        unsigned short version;
+        unsigned short reserved;
+
+        // Source model file the mesh was cooked from, to detect stale files
+        unsigned long long sourceSize;
+        long long sourceWriteTime;
+
+        unsigned int flags; // eCookedMeshFlags
+        unsigned int vertexStride; // sizeof(CookedMeshVertex) or sizeof(CookedMeshPackedVertex)
+        unsigned int submeshCount;
+        unsigned int submeshesOffset;
+        unsigned int vertexCount;
+        unsigned int verticesOffset;
+        unsigned int indexCount;
+        unsigned int indicesOffset;
+        unsigned int stringsOffset;
+        unsigned int stringsSize;
+
+        // Bounds of every submesh
+        float min[3];
+        float max[3];
+    };
+
+    struct CookedMeshVertex
+    {
+        float position[3];
+        float normal[3];
+        float uv[2];
+    };
+
+    // Half the size of CookedMeshVertex
+    struct CookedMeshPackedVertex
+    {
+        unsigned short position[4]; // Unsigned normalized across the submesh's bounds. w is padding.
+        short normal[2]; // Octahedral, signed normalized
+        unsigned short uv[2]; // Half floats
+    };
+
+    struct CookedSubmesh
+    {
+        unsigned int name; // String offset
+        unsigned int firstVertex;
+        unsigned int vertexCount;
+        unsigned int firstIndex;
+        unsigned int indexCount;
+        float min[3];
+        float max[3];
+    };
+
+    class CookedMesh
+    {
+    public:
+        static const char s_Magic[4];
+        static const unsigned short s_Version = 2; // 2: Optimized vertex and index order
+
+        // sizeof the vertex type flags (eCookedMeshFlags) cook to
+        static unsigned int VertexStride(unsigned int flags);
+
+        // Maps the file and checks that every section and index is in bounds
+        bool Open(const char* filePath);
+        void Close();
+        bool IsOpen() const { return m_Header != nullptr; }
+
+        // False when the source file changed since the mesh was cooked.
+        // A missing source file is fine, as in builds that only ship cooked meshes.
+        bool IsUpToDate(const char* sourceFilePath) const;
+
+        const CookedMeshHeader& Header() const { return *m_Header; }
+        unsigned int SubmeshCount() const { return m_Header->submeshCount; }
+        const CookedSubmesh& GetSubmesh(unsigned int index) const { return m_Submeshes[index]; }
+
+        bool IsQuantized() const { return (m_Header->flags & CookedMeshFlag_Quantized) != 0; }
+
+        // The shared buffers, vertexCount and indexCount long, for uploading
+        // in 1 go. Vertices are vertexStride apart.
+        const void* VertexData() const { return m_VertexData; }
+        const unsigned int* Indices() const { return m_Indices; }
+        // A submesh's ranges of the shared buffers. Vertices() is null when
+        // the mesh is quantized, and PackedVertices() when it isn't.
+        const CookedMeshVertex* Vertices(const CookedSubmesh& submesh) const;
+        const CookedMeshPackedVertex* PackedVertices(const CookedSubmesh& submesh) const;
+        const unsigned int* Indices(const CookedSubmesh& submesh) const { return m_Indices + submesh.firstIndex; }
+
+        // Copies a submesh's vertices to out, vertexCount long, unpacking quantized ones
+        void ReadVertices(const CookedSubmesh& submesh, CookedMeshVertex* out) const;
+
+        // Out of range offsets give ""
+        const char* GetString(unsigned int offset) const;
+
+        // The path a model file is cooked to. "Cube.obj" gives "Cube.obj.qmesh".
+        static std::string CookedPath(const char* sourceFilePath);
+
+    private:
+        MappedFile m_File;
+        const CookedMeshHeader* m_Header = nullptr;
+        const CookedSubmesh* m_Submeshes = nullptr;
+        const unsigned char* m_VertexData = nullptr;
+        const unsigned int* m_Indices = nullptr;
+        const char* m_Strings = nullptr;
+    };
+
+}
+#endif // _Cooked_Mesh_H_
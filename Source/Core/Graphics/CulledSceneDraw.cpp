@@ -0,0 +1,58 @@
+#include "CulledSceneDraw.h"
+#include "../Entities/SceneEntities.h"
+#include "../Math/TransformMath.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/Camera/CameraComponent.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstring>
+
+namespace QwerkE {
+
+    namespace CulledSceneDraw
+    {
+        void Draw(Scene* scene, SceneEntities& entities)
+        {
+            PROFILE_SCOPE("Culled Scene Draw");
+
+            if (scene == nullptr || scene->GetCameraList().empty())
+                return;
+
+            GameObject* cameraObject = scene->GetCameraList().at(0);
+            CameraComponent* camera = (CameraComponent*)cameraObject->GetComponent(Component_Camera);
+            if (camera == nullptr)
+                return;
+
+            float view[16], projection[16], viewProjection[16];
+            memcpy(view, camera->GetViewMatrix(), sizeof(view));
+            memcpy(projection, camera->GetProjectionMatrix(), sizeof(projection));
+            TransformMath::Multiply(projection, view, viewProjection);
+            entities.Cull(viewProjection);
+
+            const EntityStore& store = entities.GetStore();
+            for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+            {
+                // Entities without a render component can't be culled, but
+                // may still have draw routines
+                const bool cullable = (i & EntityComponent_Render) != 0;
+
+                const EntityArchetype& archetype = store.GetArchetype(i);
+                for (size_t row = 0; row < archetype.Size(); row++)
+                {
+                    if (cullable && !archetype.visible[row])
+                        continue;
+
+                    archetype.gameObjects[row]->Draw(cameraObject);
+                }
+            }
+
+            for (GameObject* light : scene->GetLightList())
+            {
+                light->Draw(cameraObject);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,21 @@
+#ifndef _Culled_Scene_Draw_H_
+#define _Culled_Scene_Draw_H_
+
+// Draws a scene through the framework's draw routines, like
+// Scene::Draw(), but skips render entities outside the camera's frustum.
+// The routines set every uniform their shaders need, lights and all
+// material maps included. The store must have up to date world matrices.
+
+namespace QwerkE {
+
+    class Scene;
+    class SceneEntities;
+
+    namespace CulledSceneDraw
+    {
+        // Draws nothing for scenes without a camera, as Scene::Draw() does
+        void Draw(Scene* scene, SceneEntities& entities);
+    }
+
+}
+#endif // _Culled_Scene_Draw_H_
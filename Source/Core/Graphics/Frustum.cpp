@@ -0,0 +1,99 @@
+#include "Frustum.h"
+#include "../Math/SimdFloat.h"
+
+#include <cmath>
+
+namespace QwerkE {
+
+    void Frustum::SetFromMatrix(const float m[16])
+    {
+        // Each plane is the last row of the matrix plus or minus another row
+        for (int i = 0; i < 6; i++)
+        {
+            const int row = i / 2;
+            const float sign = (i % 2 == 0) ? 1.0f : -1.0f;
+
+            float x = m[3] + sign * m[row];
+            float y = m[7] + sign * m[4 + row];
+            float z = m[11] + sign * m[8 + row];
+            float d = m[15] + sign * m[12 + row];
+
+            const float length = std::sqrt(x * x + y * y + z * z);
+            if (length > 0.0f)
+            {
+                const float inverseLength = 1.0f / length;
+                x *= inverseLength;
+                y *= inverseLength;
+                z *= inverseLength;
+                d *= inverseLength;
+            }
+
+            m_NormalX[i] = x;
+            m_NormalY[i] = y;
+            m_NormalZ[i] = z;
+            m_Distance[i] = d;
+        }
+    }
+
+    eFrustumResult Frustum::TestBox(const float center[3], const float extents[3]) const
+    {
+        eFrustumResult result = Frustum_Inside;
+        for (int i = 0; i < 6; i++)
+        {
+            const float distance = m_NormalX[i] * center[0] + m_NormalY[i] * center[1] + m_NormalZ[i] * center[2] + m_Distance[i];
+            const float radius = std::fabs(m_NormalX[i]) * extents[0] + std::fabs(m_NormalY[i]) * extents[1] + std::fabs(m_NormalZ[i]) * extents[2];
+
+            if (distance + radius < 0.0f)
+                return Frustum_Outside;
+            if (distance - radius < 0.0f)
+                result = Frustum_Intersects;
+        }
+        return result;
+    }
+
+    void Frustum::TestBoxesBatch(size_t count,
+        const float* centerX, const float* centerY, const float* centerZ,
+        const float* extentX, const float* extentY, const float* extentZ,
+        unsigned char* visible) const
+    {
+        const Simd::Float zero = Simd::Set(0.0f);
+
+        size_t i = 0;
+        for (; i + Simd::Width <= count; i += Simd::Width)
+        {
+            const Simd::Float cx = Simd::Load(centerX + i);
+            const Simd::Float cy = Simd::Load(centerY + i);
+            const Simd::Float cz = Simd::Load(centerZ + i);
+            const Simd::Float ex = Simd::Load(extentX + i);
+            const Simd::Float ey = Simd::Load(extentY + i);
+            const Simd::Float ez = Simd::Load(extentZ + i);
+
+            // A box is outside if it is fully behind any plane
+            Simd::Float outside = Simd::Less(Simd::Set(1.0f), zero); // All false
+            for (int plane = 0; plane < 6; plane++)
+            {
+                const Simd::Float nx = Simd::Set(m_NormalX[plane]);
+                const Simd::Float ny = Simd::Set(m_NormalY[plane]);
+                const Simd::Float nz = Simd::Set(m_NormalZ[plane]);
+
+                const Simd::Float distance = Simd::MulAdd(nx, cx, Simd::MulAdd(ny, cy, Simd::MulAdd(nz, cz, Simd::Set(m_Distance[plane]))));
+                const Simd::Float radius = Simd::MulAdd(Simd::Abs(nx), ex, Simd::MulAdd(Simd::Abs(ny), ey, Simd::Mul(Simd::Abs(nz), ez)));
+                outside = Simd::Or(outside, Simd::Less(Simd::Add(distance, radius), zero));
+            }
+
+            const int outsideBits = Simd::MaskBits(outside);
+            for (int lane = 0; lane < Simd::Width; lane++)
+            {
+                visible[i + lane] = (outsideBits & (1 << lane)) ? 0 : 1;
+            }
+        }
+
+        for (; i < count; i++)
+        {
+            const float center[3] = { centerX[i], centerY[i], centerZ[i] };
+            const float extents[3] = { extentX[i], extentY[i], extentZ[i] };
+            visible[i] = TestBox(center, extents) != Frustum_Outside ? 1 : 0;
+        }
+    }
+
+}
@@ -0,0 +1,42 @@
+#ifndef _Frustum_H_
+#define _Frustum_H_
+
+// View frustum planes for visibility tests against axis aligned boxes.
+// Boxes are given as a center and half extents.
+
+#include <cstddef>
+
+namespace QwerkE {
+
+    enum eFrustumResult
+    {
+        Frustum_Outside = 0,
+        Frustum_Intersects,
+        Frustum_Inside
+    };
+
+    class Frustum
+    {
+    public:
+        // From a column major projection * view matrix, as OpenGL uses
+        void SetFromMatrix(const float viewProjection[16]);
+
+        eFrustumResult TestBox(const float center[3], const float extents[3]) const;
+
+        // Tests count boxes stored as arrays. Writes 1 to visible[i] for
+        // boxes that are at least partly inside, and 0 for the rest.
+        void TestBoxesBatch(size_t count,
+            const float* centerX, const float* centerY, const float* centerZ,
+            const float* extentX, const float* extentY, const float* extentZ,
+            unsigned char* visible) const;
+
+    private:
+        // Normals point inwards. Left, right, bottom, top, near, far.
+        float m_NormalX[6];
+        float m_NormalY[6];
+        float m_NormalZ[6];
+        float m_Distance[6];
+    };
+
+}
+#endif // _Frustum_H_
@@ -0,0 +1,87 @@
+#include "MeshBounds.h"
+
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
+namespace QwerkE {
+
+    namespace MeshBounds
+    {
+        struct Box
+        {
+            float min[3];
+            float max[3];
+        };
+
+        static std::mutex s_Mutex;
+        static std::unordered_map<const Mesh*, Box> s_Bounds;
+
+        void Set(const Mesh* mesh, const float min[3], const float max[3])
+        {
+            if (mesh == nullptr)
+                return;
+
+            Box box;
+            for (int i = 0; i < 3; i++)
+            {
+                box.min[i] = min[i];
+                box.max[i] = max[i];
+            }
+
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Bounds[mesh] = box;
+        }
+
+        bool Get(const Mesh* mesh, float min[3], float max[3])
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            auto it = s_Bounds.find(mesh);
+            if (it == s_Bounds.end())
+                return false;
+
+            for (int i = 0; i < 3; i++)
+            {
+                min[i] = it->second.min[i];
+                max[i] = it->second.max[i];
+            }
+            return true;
+        }
+
+        void Remove(const Mesh* mesh)
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Bounds.erase(mesh);
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_Bounds.clear();
+        }
+
+        bool FromPositions(const float* positions, size_t count, size_t strideFloats, float min[3], float max[3])
+        {
+            if (positions == nullptr || count == 0)
+                return false;
+
+            for (int i = 0; i < 3; i++)
+            {
+                min[i] = positions[i];
+                max[i] = positions[i];
+            }
+
+            for (size_t v = 1; v < count; v++)
+            {
+                const float* position = positions + v * strideFloats;
+                for (int i = 0; i < 3; i++)
+                {
+                    min[i] = std::min(min[i], position[i]);
+                    max[i] = std::max(max[i], position[i]);
+                }
+            }
+            return true;
+        }
+    }
+
+}
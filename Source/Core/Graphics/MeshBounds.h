@@ -0,0 +1,28 @@
+#ifndef _Mesh_Bounds_H_
+#define _Mesh_Bounds_H_
+
+// Object space bounding boxes of meshes, used for culling. The framework's
+// Mesh only keeps GPU buffers, so loaders that see the vertex data
+// register the bounds here. Meshes without bounds are never culled.
+// Safe to use from loader threads.
+
+#include <cstddef>
+
+namespace QwerkE {
+
+    class Mesh;
+
+    namespace MeshBounds
+    {
+        void Set(const Mesh* mesh, const float min[3], const float max[3]);
+        // Returns false when the mesh has no bounds
+        bool Get(const Mesh* mesh, float min[3], float max[3]);
+        void Remove(const Mesh* mesh);
+        void Clear();
+
+        // Box around count positions, strideFloats apart. Returns false for no positions.
+        bool FromPositions(const float* positions, size_t count, size_t strideFloats, float min[3], float max[3]);
+    }
+
+}
+#endif // _Mesh_Bounds_H_
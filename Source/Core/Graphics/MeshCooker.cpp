@@ -0,0 +1,316 @@
+#include "MeshCooker.h"
+#include "MeshBounds.h"
+#include "MeshOptimizer.h"
+#include "ObjImporter.h"
+#include "VertexQuantization.h"
+#include "../Scenes/CookedScene.h"
+
+#include "../QwerkE_Framework/Libraries/assimp/Importer.hpp"
+#include "../QwerkE_Framework/Libraries/assimp/scene.h"
+#include "../QwerkE_Framework/Libraries/assimp/postprocess.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cctype>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+
+namespace QwerkE {
+
+    static_assert(sizeof(CookedMeshHeader) == 88, "Cooked mesh header layout changed");
+    static_assert(sizeof(CookedMeshVertex) == 32, "Cooked mesh vertex layout changed");
+    static_assert(sizeof(CookedSubmesh) == 44, "Cooked submesh layout changed");
+    static_assert(sizeof(CookedMeshPackedVertex) == 16, "Cooked packed vertex layout changed");
+
+    CookedMeshWriter::CookedMeshWriter()
+    {
+        memset(&m_Header, 0, sizeof(m_Header));
+        memcpy(m_Header.magic, CookedMesh::s_Magic, sizeof(m_Header.magic));
+        m_Header.version = CookedMesh::s_Version;
+        m_Header.vertexStride = sizeof(CookedMeshVertex);
+
+        m_Strings.push_back('\0'); // Offset 0 is ""
+        m_StringOffsets[""] = 0;
+    }
+
+    void CookedMeshWriter::SetSource(unsigned long long size, long long writeTime)
+    {
+        m_Header.sourceSize = size;
+        m_Header.sourceWriteTime = writeTime;
+    }
+
+    void CookedMeshWriter::SetFlags(unsigned int flags)
+    {
+        m_Header.flags = flags & ~(unsigned int)CookedMeshFlag_Quantized;
+    }
+
+    void CookedMeshWriter::SetQuantized(bool quantized)
+    {
+        m_Quantized = quantized;
+    }
+
+    unsigned int CookedMeshWriter::AddString(const char* value)
+    {
+        if (value == nullptr)
+            return 0;
+
+        auto it = m_StringOffsets.find(value);
+        if (it != m_StringOffsets.end())
+            return it->second;
+
+        const unsigned int offset = (unsigned int)m_Strings.size();
+        m_Strings.insert(m_Strings.end(), value, value + strlen(value) + 1);
+        m_StringOffsets[value] = offset;
+        return offset;
+    }
+
+    bool CookedMeshWriter::AddSubmesh(const char* name, const CookedMeshVertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount)
+    {
+        for (unsigned int i = 0; i < indexCount; i++)
+        {
+            if (indices[i] >= vertexCount)
+                return false;
+        }
+
+        CookedSubmesh submesh;
+        submesh.name = AddString(name);
+        submesh.firstVertex = (unsigned int)m_Vertices.size();
+        submesh.vertexCount = vertexCount;
+        submesh.firstIndex = (unsigned int)m_Indices.size();
+        submesh.indexCount = indexCount;
+        if (!MeshBounds::FromPositions(vertexCount ? vertices->position : nullptr, vertexCount, sizeof(CookedMeshVertex) / sizeof(float), submesh.min, submesh.max))
+        {
+            memset(submesh.min, 0, sizeof(submesh.min));
+            memset(submesh.max, 0, sizeof(submesh.max));
+        }
+
+        m_Submeshes.push_back(submesh);
+        m_Vertices.insert(m_Vertices.end(), vertices, vertices + vertexCount);
+        m_Indices.insert(m_Indices.end(), indices, indices + indexCount);
+        return true;
+    }
+
+    static size_t AlignTo4(size_t value)
+    {
+        return (value + 3) & ~(size_t)3;
+    }
+
+    void CookedMeshWriter::Write(std::vector<unsigned char>& out) const
+    {
+        CookedMeshHeader header = m_Header;
+        if (m_Quantized)
+            header.flags |= CookedMeshFlag_Quantized;
+        header.vertexStride = CookedMesh::VertexStride(header.flags);
+        header.submeshCount = (unsigned int)m_Submeshes.size();
+        header.submeshesOffset = sizeof(CookedMeshHeader);
+        header.vertexCount = (unsigned int)m_Vertices.size();
+        header.verticesOffset = (unsigned int)(header.submeshesOffset + m_Submeshes.size() * sizeof(CookedSubmesh));
+        header.indexCount = (unsigned int)m_Indices.size();
+        header.indicesOffset = (unsigned int)(header.verticesOffset + m_Vertices.size() * header.vertexStride);
+        header.stringsOffset = (unsigned int)(header.indicesOffset + m_Indices.size() * sizeof(unsigned int));
+        header.stringsSize = (unsigned int)m_Strings.size();
+
+        for (int i = 0; i < 3; i++)
+        {
+            header.min[i] = m_Submeshes.empty() ? 0.0f : FLT_MAX;
+            header.max[i] = m_Submeshes.empty() ? 0.0f : -FLT_MAX;
+        }
+        for (const CookedSubmesh& submesh : m_Submeshes)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                if (submesh.min[i] < header.min[i]) header.min[i] = submesh.min[i];
+                if (submesh.max[i] > header.max[i]) header.max[i] = submesh.max[i];
+            }
+        }
+
+        out.assign(AlignTo4(header.stringsOffset + m_Strings.size()), 0);
+        memcpy(&out[0], &header, sizeof(header));
+        if (!m_Submeshes.empty())
+            memcpy(&out[header.submeshesOffset], m_Submeshes.data(), m_Submeshes.size() * sizeof(CookedSubmesh));
+        if (m_Quantized)
+        {
+            // Positions are quantized across their own submesh's bounds
+            CookedMeshPackedVertex* packed = (CookedMeshPackedVertex*)&out[header.verticesOffset];
+            for (const CookedSubmesh& submesh : m_Submeshes)
+            {
+                for (unsigned int i = submesh.firstVertex; i < submesh.firstVertex + submesh.vertexCount; i++)
+                {
+                    VertexQuantization::Pack(m_Vertices[i], submesh.min, submesh.max, packed[i]);
+                }
+            }
+        }
+        else if (!m_Vertices.empty())
+        {
+            memcpy(&out[header.verticesOffset], m_Vertices.data(), m_Vertices.size() * sizeof(CookedMeshVertex));
+        }
+        if (!m_Indices.empty())
+            memcpy(&out[header.indicesOffset], m_Indices.data(), m_Indices.size() * sizeof(unsigned int));
+        memcpy(&out[header.stringsOffset], m_Strings.data(), m_Strings.size());
+    }
+
+    bool CookedMeshWriter::WriteFile(const char* filePath) const
+    {
+        std::vector<unsigned char> data;
+        Write(data);
+
+        FILE* file = fopen(filePath, "wb");
+        if (file == nullptr)
+        {
+            LOG_ERROR("CookedMeshWriter: Could not open {0} for writing", filePath);
+            return false;
+        }
+
+        const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+
+        if (!written)
+        {
+            LOG_ERROR("CookedMeshWriter: Could not write {0}", filePath);
+            remove(filePath);
+        }
+        return written;
+    }
+
+    namespace MeshCooker
+    {
+        static bool IsObjFile(const char* filePath)
+        {
+            const size_t length = strlen(filePath);
+            if (length < 4 || filePath[length - 4] != '.')
+                return false;
+
+            const char* extension = filePath + length - 3;
+            return tolower(extension[0]) == 'o' && tolower(extension[1]) == 'b' && tolower(extension[2]) == 'j';
+        }
+
+        // Optimizes a copy of the submesh's buffers before adding it
+        static bool AddOptimizedSubmesh(CookedMeshWriter& writer, const char* name, std::vector<CookedMeshVertex>& vertices, std::vector<unsigned int>& indices, MeshOptimizerStats& totals)
+        {
+            for (unsigned int index : indices)
+            {
+                if (index >= vertices.size())
+                    return false;
+            }
+
+            MeshOptimizerStats stats;
+            MeshOptimizer::Optimize(vertices, indices, &stats);
+            totals.Add(stats);
+            return writer.AddSubmesh(name, vertices.data(), (unsigned int)vertices.size(), indices.data(), (unsigned int)indices.size());
+        }
+
+        static bool AddObjModel(const char* sourceFilePath, CookedMeshWriter& writer, TaskScheduler* scheduler, MeshOptimizerStats& stats)
+        {
+            ObjModel model;
+            if (!ObjImporter::Import(sourceFilePath, model, scheduler))
+                return false;
+
+            // Generated normals are still normals
+            writer.SetFlags(CookedMeshFlag_Normals | (model.hasUVs ? (unsigned int)CookedMeshFlag_UVs : 0u));
+            std::vector<CookedMeshVertex> vertices;
+            std::vector<unsigned int> indices;
+            for (const ObjGroup& group : model.groups)
+            {
+                vertices.assign(model.vertices.begin() + group.firstVertex, model.vertices.begin() + group.firstVertex + group.vertexCount);
+                indices.assign(model.indices.begin() + group.firstIndex, model.indices.begin() + group.firstIndex + group.indexCount);
+                AddOptimizedSubmesh(writer, group.name.c_str(), vertices, indices, stats);
+            }
+            return true;
+        }
+
+        static bool AddAssimpModel(const char* sourceFilePath, CookedMeshWriter& writer, MeshOptimizerStats& stats)
+        {
+            // Welding here is what lets the cooked vertices be indexed
+            Assimp::Importer importer;
+            const aiScene* scene = importer.ReadFile(sourceFilePath, aiProcess_Triangulate | aiProcess_JoinIdenticalVertices | aiProcess_GenNormals | aiProcess_FlipUVs);
+            if (scene == nullptr)
+            {
+                LOG_ERROR("MeshCooker: Error importing {0}. {1}", sourceFilePath, importer.GetErrorString());
+                return false;
+            }
+
+            unsigned int flags = CookedMeshFlag_Normals | CookedMeshFlag_UVs;
+            std::vector<CookedMeshVertex> vertices;
+            std::vector<unsigned int> indices;
+            for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+            {
+                const aiMesh* source = scene->mMeshes[i];
+                const bool hasNormals = source->HasNormals();
+                const bool hasUVs = source->HasTextureCoords(0);
+                if (!hasNormals) flags &= ~CookedMeshFlag_Normals;
+                if (!hasUVs) flags &= ~CookedMeshFlag_UVs;
+
+                vertices.resize(source->mNumVertices);
+                for (unsigned int v = 0; v < source->mNumVertices; v++)
+                {
+                    CookedMeshVertex& vertex = vertices[v];
+                    memset(&vertex, 0, sizeof(vertex));
+                    memcpy(vertex.position, &source->mVertices[v].x, sizeof(vertex.position));
+                    if (hasNormals)
+                        memcpy(vertex.normal, &source->mNormals[v].x, sizeof(vertex.normal));
+                    if (hasUVs)
+                        memcpy(vertex.uv, &source->mTextureCoords[0][v].x, sizeof(vertex.uv));
+                }
+
+                // Points and lines left over by triangulation are dropped
+                indices.clear();
+                indices.reserve(source->mNumFaces * 3);
+                for (unsigned int f = 0; f < source->mNumFaces; f++)
+                {
+                    const aiFace& face = source->mFaces[f];
+                    if (face.mNumIndices == 3)
+                        indices.insert(indices.end(), face.mIndices, face.mIndices + 3);
+                }
+
+                if (!AddOptimizedSubmesh(writer, source->mName.C_Str(), vertices, indices, stats))
+                {
+                    LOG_ERROR("MeshCooker: {0} has out of range indices in {1}", sourceFilePath, source->mName.C_Str());
+                    return false;
+                }
+            }
+            writer.SetFlags(flags);
+            return true;
+        }
+
+        bool Cook(const char* sourceFilePath, const char* cookedFilePath, TaskScheduler* scheduler, bool quantize)
+        {
+            PROFILE_SCOPE("Mesh Cook");
+
+            unsigned long long sourceSize = 0;
+            long long sourceWriteTime = 0;
+            if (!CookedScene::SourceFileInfo(sourceFilePath, sourceSize, sourceWriteTime))
+            {
+                LOG_ERROR("MeshCooker: Could not find {0}", sourceFilePath);
+                return false;
+            }
+
+            CookedMeshWriter writer;
+            writer.SetSource(sourceSize, sourceWriteTime);
+            writer.SetQuantized(quantize);
+
+            MeshOptimizerStats stats;
+            const bool imported = IsObjFile(sourceFilePath) ? AddObjModel(sourceFilePath, writer, scheduler, stats) : AddAssimpModel(sourceFilePath, writer, stats);
+            if (!imported || !writer.WriteFile(cookedFilePath))
+                return false;
+
+            LOG_INFO("MeshCooker: Cooked {0} meshes with {1} vertices from {2} to {3}", writer.SubmeshCount(), writer.VertexCount(), sourceFilePath, cookedFilePath);
+            LOG_INFO("MeshCooker: {0} vertices welded to {1}. ACMR {2} to {3}, ATVR {4} to {5}", stats.verticesBefore, stats.verticesAfter,
+                stats.AcmrBefore(), stats.AcmrAfter(), stats.AtvrBefore(), stats.AtvrAfter());
+            return true;
+        }
+
+        bool CookIfStale(const char* sourceFilePath, TaskScheduler* scheduler, bool quantize)
+        {
+            const std::string cookedPath = CookedMesh::CookedPath(sourceFilePath);
+
+            CookedMesh cooked;
+            if (cooked.Open(cookedPath.c_str()) && cooked.IsUpToDate(sourceFilePath) && cooked.IsQuantized() == quantize)
+                return true;
+            cooked.Close(); // Release the mapping before writing over it
+
+            return Cook(sourceFilePath, cookedPath.c_str(), scheduler, quantize);
+        }
+    }
+
+}
@@ -0,0 +1,64 @@
+#ifndef _Mesh_Cooker_H_
+#define _Mesh_Cooker_H_
+
+// Converts model files to the cooked binary format in CookedMesh.h.
+// CookedMeshWriter builds the binary from any source, one submesh at a time.
+
+#include "CookedMesh.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QwerkE {
+
+    class TaskScheduler;
+
+    class CookedMeshWriter
+    {
+    public:
+        CookedMeshWriter();
+
+        void SetSource(unsigned long long size, long long writeTime);
+        void SetFlags(unsigned int flags); // eCookedMeshFlags, except CookedMeshFlag_Quantized
+        // Writes CookedMeshPackedVertex instead of CookedMeshVertex
+        void SetQuantized(bool quantized);
+
+        // indices count from the submesh's first vertex. Returns false,
+        // adding nothing, when an index is out of range.
+        bool AddSubmesh(const char* name, const CookedMeshVertex* vertices, unsigned int vertexCount, const unsigned int* indices, unsigned int indexCount);
+
+        size_t SubmeshCount() const { return m_Submeshes.size(); }
+        size_t VertexCount() const { return m_Vertices.size(); }
+
+        void Write(std::vector<unsigned char>& out) const;
+        bool WriteFile(const char* filePath) const;
+
+    private:
+        unsigned int AddString(const char* value);
+
+        CookedMeshHeader m_Header;
+        std::vector<CookedSubmesh> m_Submeshes;
+        std::vector<CookedMeshVertex> m_Vertices;
+        std::vector<unsigned int> m_Indices;
+        std::vector<char> m_Strings;
+        std::unordered_map<std::string, unsigned int> m_StringOffsets;
+        bool m_Quantized = false;
+    };
+
+    namespace MeshCooker
+    {
+        // Imports the model and writes every mesh in it as a submesh.
+        // Returns false, writing nothing, when the model can't be read.
+        // .obj files are parsed by ObjImporter, on scheduler's workers when
+        // there is one. Other formats go through assimp. quantize writes the
+        // compact vertex layout, see VertexQuantization.h.
+        bool Cook(const char* sourceFilePath, const char* cookedFilePath, TaskScheduler* scheduler = nullptr, bool quantize = false);
+
+        // Cooks when the cooked file is missing, older than the source or
+        // in the other vertex layout
+        bool CookIfStale(const char* sourceFilePath, TaskScheduler* scheduler = nullptr, bool quantize = false);
+    }
+
+}
+#endif // _Mesh_Cooker_H_
@@ -0,0 +1,460 @@
+#include "MeshOptimizer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <unordered_map>
+
+namespace QwerkE {
+
+    void MeshOptimizerStats::Add(const MeshOptimizerStats& other)
+    {
+        triangleCount += other.triangleCount;
+        verticesBefore += other.verticesBefore;
+        verticesAfter += other.verticesAfter;
+        cacheMissesBefore += other.cacheMissesBefore;
+        cacheMissesAfter += other.cacheMissesAfter;
+    }
+
+    namespace MeshOptimizer
+    {
+        // LRU cache modelled by the vertex cache scores. Larger than most
+        // hardware caches, which costs little and suits FIFO caches as well.
+        static const unsigned int s_ScoringCacheSize = 32;
+        static const unsigned int s_ValenceTableSize = 64;
+
+        static const unsigned int s_Unused = ~0u;
+
+        struct VertexHash
+        {
+            size_t operator()(const CookedMeshVertex& vertex) const
+            {
+                unsigned int words[sizeof(CookedMeshVertex) / 4];
+                memcpy(words, &vertex, sizeof(words));
+
+                size_t hash = 2166136261u;
+                for (unsigned int word : words)
+                {
+                    hash = (hash ^ word) * 16777619u;
+                }
+                return hash;
+            }
+        };
+
+        struct VertexEqual
+        {
+            bool operator()(const CookedMeshVertex& a, const CookedMeshVertex& b) const
+            {
+                return memcmp(&a, &b, sizeof(CookedMeshVertex)) == 0;
+            }
+        };
+
+        unsigned int CountCacheMisses(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize)
+        {
+            // A vertex is cached while fewer than cacheSize misses came after its own
+            std::vector<unsigned int> timestamps(vertexCount, 0);
+            unsigned int time = cacheSize + 1;
+            unsigned int misses = 0;
+
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                const unsigned int vertex = indices[i];
+                if (time - timestamps[vertex] > cacheSize)
+                {
+                    timestamps[vertex] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        size_t WeldVertices(CookedMeshVertex* vertices, size_t vertexCount, unsigned int* indices, size_t indexCount)
+        {
+            std::unordered_map<CookedMeshVertex, unsigned int, VertexHash, VertexEqual> unique;
+            unique.reserve(vertexCount);
+
+            std::vector<unsigned int> remap(vertexCount);
+            unsigned int uniqueCount = 0;
+            for (size_t i = 0; i < vertexCount; i++)
+            {
+                auto inserted = unique.emplace(vertices[i], uniqueCount);
+                if (inserted.second)
+                {
+                    vertices[uniqueCount] = vertices[i];
+                    uniqueCount++;
+                }
+                remap[i] = inserted.first->second;
+            }
+
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                indices[i] = remap[indices[i]];
+            }
+            return uniqueCount;
+        }
+
+        struct VertexScoreTables
+        {
+            float cache[s_ScoringCacheSize];
+            float valence[s_ValenceTableSize];
+
+            VertexScoreTables()
+            {
+                // The last triangle's vertices score the same, so it isn't
+                // simply drawn again from a slightly different corner
+                for (unsigned int i = 0; i < s_ScoringCacheSize; i++)
+                {
+                    cache[i] = i < 3 ? 0.75f : powf(1.0f - (float)(i - 3) / (s_ScoringCacheSize - 3), 1.5f);
+                }
+
+                // Vertices with few triangles left are finished first
+                valence[0] = 0.0f;
+                for (unsigned int i = 1; i < s_ValenceTableSize; i++)
+                {
+                    valence[i] = 2.0f / sqrtf((float)i);
+                }
+            }
+        };
+
+        static float VertexScore(const VertexScoreTables& tables, int cachePosition, unsigned int remaining)
+        {
+            if (remaining == 0)
+                return -1.0f;
+
+            float score = cachePosition >= 0 ? tables.cache[cachePosition] : 0.0f;
+            score += remaining < s_ValenceTableSize ? tables.valence[remaining] : 2.0f / sqrtf((float)remaining);
+            return score;
+        }
+
+        void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount)
+        {
+            static const VertexScoreTables s_Tables;
+
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount < 2)
+                return;
+
+            // Triangles of each vertex. The first remaining[v] are not drawn yet.
+            std::vector<unsigned int> offsets(vertexCount + 1, 0);
+            for (size_t i = 0; i < triangleCount * 3; i++)
+            {
+                offsets[indices[i] + 1]++;
+            }
+            std::vector<unsigned int> remaining(vertexCount);
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                remaining[v] = offsets[v + 1];
+                offsets[v + 1] += offsets[v];
+            }
+
+            std::vector<unsigned int> adjacency(triangleCount * 3);
+            {
+                std::vector<unsigned int> fill(offsets.begin(), offsets.end() - 1);
+                for (size_t i = 0; i < triangleCount * 3; i++)
+                {
+                    adjacency[fill[indices[i]]++] = (unsigned int)(i / 3);
+                }
+            }
+
+            std::vector<int> cachePositions(vertexCount, -1);
+            std::vector<float> vertexScores(vertexCount);
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                vertexScores[v] = VertexScore(s_Tables, -1, remaining[v]);
+            }
+
+            std::vector<float> triangleScores(triangleCount);
+            size_t best = 0;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                const unsigned int* triangle = indices + t * 3;
+                triangleScores[t] = vertexScores[triangle[0]] + vertexScores[triangle[1]] + vertexScores[triangle[2]];
+                if (triangleScores[t] > triangleScores[best])
+                    best = t;
+            }
+
+            std::vector<unsigned char> drawn(triangleCount, 0);
+            std::vector<unsigned int> output;
+            output.reserve(triangleCount * 3);
+
+            unsigned int cache[s_ScoringCacheSize + 3];
+            unsigned int newCache[s_ScoringCacheSize + 3];
+            unsigned int cacheCount = 0;
+            size_t cursor = 0;
+
+            for (size_t drawnCount = 0; drawnCount < triangleCount; drawnCount++)
+            {
+                // Nothing in the cache has triangles left. Take the next in input order.
+                if (best == s_Unused)
+                {
+                    while (drawn[cursor])
+                        cursor++;
+                    best = cursor;
+                }
+
+                const unsigned int* triangle = indices + best * 3;
+                output.insert(output.end(), triangle, triangle + 3);
+                drawn[best] = 1;
+
+                unsigned int newCount = 0;
+                for (int corner = 0; corner < 3; corner++)
+                {
+                    const unsigned int vertex = triangle[corner];
+
+                    unsigned int* triangles = &adjacency[offsets[vertex]];
+                    for (unsigned int i = 0; i < remaining[vertex]; i++)
+                    {
+                        if (triangles[i] == best)
+                        {
+                            triangles[i] = triangles[remaining[vertex] - 1];
+                            break;
+                        }
+                    }
+                    remaining[vertex]--;
+
+                    // Degenerate triangles repeat vertices
+                    if (std::find(newCache, newCache + newCount, vertex) == newCache + newCount)
+                        newCache[newCount++] = vertex;
+                }
+
+                for (unsigned int i = 0; i < cacheCount; i++)
+                {
+                    const unsigned int vertex = cache[i];
+                    if (vertex != triangle[0] && vertex != triangle[1] && vertex != triangle[2])
+                        newCache[newCount++] = vertex;
+                }
+
+                // Rescore everything that moved in or out of the cache
+                for (unsigned int i = 0; i < newCount; i++)
+                {
+                    const unsigned int vertex = newCache[i];
+                    const int position = i < s_ScoringCacheSize ? (int)i : -1;
+                    cachePositions[vertex] = position;
+
+                    const float score = VertexScore(s_Tables, position, remaining[vertex]);
+                    const float change = score - vertexScores[vertex];
+                    vertexScores[vertex] = score;
+
+                    const unsigned int* triangles = &adjacency[offsets[vertex]];
+                    for (unsigned int j = 0; j < remaining[vertex]; j++)
+                    {
+                        triangleScores[triangles[j]] += change;
+                    }
+                }
+
+                cacheCount = newCount < s_ScoringCacheSize ? newCount : s_ScoringCacheSize;
+                memcpy(cache, newCache, cacheCount * sizeof(unsigned int));
+
+                best = s_Unused;
+                float bestScore = -1.0f;
+                for (unsigned int i = 0; i < cacheCount; i++)
+                {
+                    const unsigned int vertex = cache[i];
+                    const unsigned int* triangles = &adjacency[offsets[vertex]];
+                    for (unsigned int j = 0; j < remaining[vertex]; j++)
+                    {
+                        if (triangleScores[triangles[j]] > bestScore)
+                        {
+                            bestScore = triangleScores[triangles[j]];
+                            best = triangles[j];
+                        }
+                    }
+                }
+            }
+
+            memcpy(indices, output.data(), output.size() * sizeof(unsigned int));
+        }
+
+        // Misses of 1 triangle, updating the FIFO cache in timestamps
+        static unsigned int TriangleCacheMisses(const unsigned int* triangle, std::vector<unsigned int>& timestamps, unsigned int& time)
+        {
+            unsigned int misses = 0;
+            for (int corner = 0; corner < 3; corner++)
+            {
+                const unsigned int vertex = triangle[corner];
+                if (time - timestamps[vertex] > s_AnalysisCacheSize)
+                {
+                    timestamps[vertex] = time++;
+                    misses++;
+                }
+            }
+            return misses;
+        }
+
+        void OptimizeOverdraw(unsigned int* indices, size_t indexCount, const CookedMeshVertex* vertices, size_t vertexCount, float threshold)
+        {
+            const size_t triangleCount = indexCount / 3;
+            if (triangleCount < 2)
+                return;
+
+            std::vector<unsigned int> timestamps(vertexCount, 0);
+            unsigned int time = s_AnalysisCacheSize + 1;
+
+            // Hard boundaries where a triangle shares nothing with the cache.
+            // Moving what comes after them costs no extra transforms.
+            std::vector<size_t> hardClusters;
+            for (size_t t = 0; t < triangleCount; t++)
+            {
+                if (TriangleCacheMisses(indices + t * 3, timestamps, time) == 3)
+                    hardClusters.push_back(t);
+            }
+            if (hardClusters.empty() || hardClusters[0] != 0)
+                hardClusters.insert(hardClusters.begin(), 0);
+
+            // Soft boundaries wherever the cluster so far is almost as cache
+            // efficient as its whole hard cluster
+            std::vector<size_t> clusters;
+            for (size_t h = 0; h < hardClusters.size(); h++)
+            {
+                const size_t start = hardClusters[h];
+                const size_t end = h + 1 < hardClusters.size() ? hardClusters[h + 1] : triangleCount;
+
+                time += s_AnalysisCacheSize + 1; // Empty cache
+                unsigned int hardMisses = 0;
+                for (size_t t = start; t < end; t++)
+                {
+                    hardMisses += TriangleCacheMisses(indices + t * 3, timestamps, time);
+                }
+                const float clusterThreshold = threshold * hardMisses / (end - start);
+
+                time += s_AnalysisCacheSize + 1;
+                clusters.push_back(start);
+                size_t clusterStart = start;
+                unsigned int misses = 0;
+                for (size_t t = start; t < end; t++)
+                {
+                    misses += TriangleCacheMisses(indices + t * 3, timestamps, time);
+                    if (t + 1 < end && (float)misses / (t - clusterStart + 1) <= clusterThreshold)
+                    {
+                        clusters.push_back(t + 1);
+                        clusterStart = t + 1;
+                        misses = 0;
+                        time += s_AnalysisCacheSize + 1;
+                    }
+                }
+            }
+
+            // Area weighted centroids and normals
+            float meshCentroid[3] = { 0.0f, 0.0f, 0.0f };
+            float meshArea = 0.0f;
+            std::vector<float> clusterData(clusters.size() * 7, 0.0f); // Centroid, normal, area
+            for (size_t c = 0; c < clusters.size(); c++)
+            {
+                const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+                float* data = &clusterData[c * 7];
+
+                for (size_t t = clusters[c]; t < end; t++)
+                {
+                    const float* a = vertices[indices[t * 3 + 0]].position;
+                    const float* b = vertices[indices[t * 3 + 1]].position;
+                    const float* p = vertices[indices[t * 3 + 2]].position;
+
+                    const float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                    const float ap[3] = { p[0] - a[0], p[1] - a[1], p[2] - a[2] };
+                    const float normal[3] = {
+                        ab[1] * ap[2] - ab[2] * ap[1],
+                        ab[2] * ap[0] - ab[0] * ap[2],
+                        ab[0] * ap[1] - ab[1] * ap[0]
+                    };
+                    const float area = sqrtf(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+
+                    for (int i = 0; i < 3; i++)
+                    {
+                        const float centroid = (a[i] + b[i] + p[i]) / 3.0f;
+                        data[i] += centroid * area;
+                        data[3 + i] += normal[i];
+                        meshCentroid[i] += centroid * area;
+                    }
+                    data[6] += area;
+                    meshArea += area;
+                }
+            }
+
+            if (meshArea > 0.0f)
+            {
+                for (int i = 0; i < 3; i++)
+                {
+                    meshCentroid[i] /= meshArea;
+                }
+            }
+
+            // Clusters facing away from the middle of the mesh are likely in
+            // front of the rest, so they are drawn first
+            std::vector<float> sortKeys(clusters.size(), 0.0f);
+            for (size_t c = 0; c < clusters.size(); c++)
+            {
+                const float* data = &clusterData[c * 7];
+                const float normalLength = sqrtf(data[3] * data[3] + data[4] * data[4] + data[5] * data[5]);
+                if (data[6] <= 0.0f || normalLength <= 0.0f)
+                    continue;
+
+                for (int i = 0; i < 3; i++)
+                {
+                    sortKeys[c] += (data[i] / data[6] - meshCentroid[i]) * data[3 + i] / normalLength;
+                }
+            }
+
+            std::vector<size_t> order(clusters.size());
+            for (size_t c = 0; c < order.size(); c++)
+            {
+                order[c] = c;
+            }
+            std::stable_sort(order.begin(), order.end(), [&sortKeys](size_t a, size_t b) { return sortKeys[a] > sortKeys[b]; });
+
+            std::vector<unsigned int> output;
+            output.reserve(triangleCount * 3);
+            for (size_t c : order)
+            {
+                const size_t end = c + 1 < clusters.size() ? clusters[c + 1] : triangleCount;
+                output.insert(output.end(), indices + clusters[c] * 3, indices + end * 3);
+            }
+            memcpy(indices, output.data(), output.size() * sizeof(unsigned int));
+        }
+
+        size_t OptimizeVertexFetch(CookedMeshVertex* vertices, size_t vertexCount, unsigned int* indices, size_t indexCount)
+        {
+            std::vector<unsigned int> remap(vertexCount, s_Unused);
+            unsigned int usedCount = 0;
+            for (size_t i = 0; i < indexCount; i++)
+            {
+                unsigned int& newIndex = remap[indices[i]];
+                if (newIndex == s_Unused)
+                    newIndex = usedCount++;
+                indices[i] = newIndex;
+            }
+
+            std::vector<CookedMeshVertex> reordered(usedCount);
+            for (size_t v = 0; v < vertexCount; v++)
+            {
+                if (remap[v] != s_Unused)
+                    reordered[remap[v]] = vertices[v];
+            }
+
+            if (usedCount > 0)
+                memcpy(vertices, reordered.data(), usedCount * sizeof(CookedMeshVertex));
+            return usedCount;
+        }
+
+        void Optimize(std::vector<CookedMeshVertex>& vertices, std::vector<unsigned int>& indices, MeshOptimizerStats* stats)
+        {
+            if (stats)
+            {
+                stats->triangleCount = (unsigned int)(indices.size() / 3);
+                stats->verticesBefore = (unsigned int)vertices.size();
+                stats->cacheMissesBefore = CountCacheMisses(indices.data(), indices.size(), vertices.size());
+            }
+
+            vertices.resize(WeldVertices(vertices.data(), vertices.size(), indices.data(), indices.size()));
+            OptimizeVertexCache(indices.data(), indices.size(), vertices.size());
+            OptimizeOverdraw(indices.data(), indices.size(), vertices.data(), vertices.size());
+            vertices.resize(OptimizeVertexFetch(vertices.data(), vertices.size(), indices.data(), indices.size()));
+
+            if (stats)
+            {
+                stats->verticesAfter = (unsigned int)vertices.size();
+                stats->cacheMissesAfter = CountCacheMisses(indices.data(), indices.size(), vertices.size());
+            }
+        }
+    }
+
+}
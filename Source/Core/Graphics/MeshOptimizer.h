@@ -0,0 +1,75 @@
+#ifndef _Mesh_Optimizer_H_
+#define _Mesh_Optimizer_H_
+
+// Reorders indexed triangle meshes so the GPU transforms and fetches fewer
+// vertices. Meant to run once at import time. MeshCooker runs Optimize()
+// on every submesh it cooks.
+//
+// Optimize() runs the passes in this order:
+//   WeldVertices()        Merges vertices with identical values. Exporters
+//                         often write 1 vertex per triangle corner.
+//   OptimizeVertexCache() Orders triangles for the post-transform vertex
+//                         cache (Forsyth, "Linear-Speed Vertex Cache
+//                         Optimisation").
+//   OptimizeOverdraw()    Splits that order into clusters at cache flushes
+//                         and draws outward facing clusters first, as in
+//                         Sander et al. "Fast Triangle Reordering for
+//                         Vertex Locality and Reduced Overdraw".
+//   OptimizeVertexFetch() Orders vertices by first use so fetches read
+//                         memory in order.
+//
+// ACMR is the average cache miss ratio, vertices transformed per triangle.
+// 0.5 is the best possible for large regular meshes and 3 the worst. ATVR
+// is vertices transformed per unique vertex, where 1 is the best possible.
+
+#include "CookedMesh.h"
+
+#include <cstddef>
+#include <vector>
+
+namespace QwerkE {
+
+    struct MeshOptimizerStats
+    {
+        unsigned int triangleCount = 0;
+        unsigned int verticesBefore = 0;
+        unsigned int verticesAfter = 0;
+        // Of a simulated FIFO post-transform cache
+        unsigned int cacheMissesBefore = 0;
+        unsigned int cacheMissesAfter = 0;
+
+        float AcmrBefore() const { return triangleCount ? (float)cacheMissesBefore / triangleCount : 0.0f; }
+        float AcmrAfter() const { return triangleCount ? (float)cacheMissesAfter / triangleCount : 0.0f; }
+        float AtvrBefore() const { return verticesBefore ? (float)cacheMissesBefore / verticesBefore : 0.0f; }
+        float AtvrAfter() const { return verticesAfter ? (float)cacheMissesAfter / verticesAfter : 0.0f; }
+
+        // Totals of several meshes
+        void Add(const MeshOptimizerStats& other);
+    };
+
+    namespace MeshOptimizer
+    {
+        // Entries of the FIFO cache simulated by CountCacheMisses(), a common post-transform cache size
+        const unsigned int s_AnalysisCacheSize = 16;
+
+        // Runs every pass. stats can be null.
+        void Optimize(std::vector<CookedMeshVertex>& vertices, std::vector<unsigned int>& indices, MeshOptimizerStats* stats);
+
+        // Returns the new vertex count. Vertices past it are left unused.
+        size_t WeldVertices(CookedMeshVertex* vertices, size_t vertexCount, unsigned int* indices, size_t indexCount);
+
+        void OptimizeVertexCache(unsigned int* indices, size_t indexCount, size_t vertexCount);
+
+        // indices should already be cache optimized. Clusters may cost up to
+        // threshold times the ACMR of the order they were split from.
+        void OptimizeOverdraw(unsigned int* indices, size_t indexCount, const CookedMeshVertex* vertices, size_t vertexCount, float threshold = 1.05f);
+
+        // Returns the new vertex count. Unused vertices are dropped.
+        size_t OptimizeVertexFetch(CookedMeshVertex* vertices, size_t vertexCount, unsigned int* indices, size_t indexCount);
+
+        // Vertices transformed by a FIFO post-transform cache of cacheSize entries
+        unsigned int CountCacheMisses(const unsigned int* indices, size_t indexCount, size_t vertexCount, unsigned int cacheSize = s_AnalysisCacheSize);
+    }
+
+}
+#endif // _Mesh_Optimizer_H_
@@ -0,0 +1,381 @@
+#include "MeshStreamer.h"
+#include "MeshBounds.h"
+#include "MeshCooker.h"
+#include "../Entities/SceneEntities.h"
+#include "../Jobs/TaskScheduler.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/Mesh/Mesh.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/Mesh/MeshData.h"
+#include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
+#include "../QwerkE_Framework/Source/Headers/QwerkE_Directory_Defines.h"
+#include "../QwerkE_Framework/Libraries/assimp/Importer.hpp"
+#include "../QwerkE_Framework/Libraries/assimp/scene.h"
+#include "../QwerkE_Framework/Libraries/assimp/postprocess.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace MeshStreamer
+    {
+        struct DecodedMesh
+        {
+            std::string name;
+            MeshData data;
+            float min[3];
+            float max[3];
+            bool hasBounds = false;
+        };
+
+        // A renderable waiting for its mesh
+        struct Binding
+        {
+            std::string meshName;
+            SceneEntities* entities;
+            ObjectHandle handle;
+            GameObject* object; // Handles don't survive SceneEntities::Reset(), so the address is checked too
+            unsigned int renderableIndex;
+        };
+
+        struct FileLoad
+        {
+            std::string file;
+            std::string path;
+
+            // Written by the decode task before decoded is set
+            std::vector<DecodedMesh> meshes;
+            std::string error;
+            std::atomic<bool> decoded{ false };
+
+            // Main thread
+            size_t uploadedCount = 0;
+            std::vector<Binding> bindings;
+        };
+
+        static TaskScheduler* s_Scheduler = nullptr;
+        static bool s_CookedMeshesEnabled = true;
+        static bool s_QuantizedMeshesEnabled = false;
+        static std::vector<std::unique_ptr<FileLoad>> s_Loads; // In request order
+
+        // The cooked buffers are already indexed and welded, so this is
+        // only copies out of the mapping. Quantized vertices are unpacked,
+        // as the framework's meshes take float attributes.
+        static bool DecodeCooked(FileLoad* load)
+        {
+            if (!MeshCooker::CookIfStale(load->path.c_str(), s_Scheduler, s_QuantizedMeshesEnabled))
+                return false;
+
+            CookedMesh cooked;
+            if (!cooked.Open(CookedMesh::CookedPath(load->path.c_str()).c_str()))
+                return false;
+
+            const unsigned int flags = cooked.Header().flags;
+            std::vector<CookedMeshVertex> vertices;
+            load->meshes.resize(cooked.SubmeshCount());
+            for (unsigned int i = 0; i < cooked.SubmeshCount(); i++)
+            {
+                const CookedSubmesh& submesh = cooked.GetSubmesh(i);
+                vertices.resize(submesh.vertexCount);
+                cooked.ReadVertices(submesh, vertices.data());
+                DecodedMesh& mesh = load->meshes[i];
+                mesh.name = cooked.GetString(submesh.name);
+
+                MeshData& meshData = mesh.data;
+                meshData.positions.reserve(submesh.vertexCount);
+                if (flags & CookedMeshFlag_Normals)
+                    meshData.normals.reserve(submesh.vertexCount);
+                if (flags & CookedMeshFlag_UVs)
+                    meshData.UVs.reserve(submesh.vertexCount);
+                for (unsigned int v = 0; v < submesh.vertexCount; v++)
+                {
+                    const CookedMeshVertex& vertex = vertices[v];
+                    meshData.positions.push_back(vec3(vertex.position[0], vertex.position[1], vertex.position[2]));
+                    if (flags & CookedMeshFlag_Normals)
+                        meshData.normals.push_back(vec3(vertex.normal[0], vertex.normal[1], vertex.normal[2]));
+                    if (flags & CookedMeshFlag_UVs)
+                        meshData.UVs.push_back(vec2(vertex.uv[0], vertex.uv[1]));
+                }
+
+                const unsigned int* indices = cooked.Indices(submesh);
+                meshData.indices.assign(indices, indices + submesh.indexCount);
+
+                memcpy(mesh.min, submesh.min, sizeof(mesh.min));
+                memcpy(mesh.max, submesh.max, sizeof(mesh.max));
+                mesh.hasBounds = submesh.vertexCount > 0;
+            }
+            return true;
+        }
+
+        static void DecodeImported(FileLoad* load)
+        {
+            Assimp::Importer importer;
+            const aiScene* scene = importer.ReadFile(load->path, aiProcess_Triangulate | aiProcess_FlipUVs | aiProcess_GenNormals);
+            if (scene == nullptr)
+            {
+                load->error = importer.GetErrorString();
+            }
+            else
+            {
+                load->meshes.resize(scene->mNumMeshes);
+                for (unsigned int i = 0; i < scene->mNumMeshes; i++)
+                {
+                    const aiMesh* source = scene->mMeshes[i];
+                    DecodedMesh& mesh = load->meshes[i];
+                    mesh.name = source->mName.C_Str();
+
+                    MeshData& meshData = mesh.data;
+                    meshData.positions.reserve(source->mNumVertices);
+                    meshData.normals.reserve(source->mNumVertices);
+                    meshData.UVs.reserve(source->mNumVertices);
+                    for (unsigned int v = 0; v < source->mNumVertices; v++)
+                    {
+                        const aiVector3D& position = source->mVertices[v];
+                        meshData.positions.push_back(vec3(position.x, position.y, position.z));
+
+                        if (source->HasNormals())
+                        {
+                            const aiVector3D& normal = source->mNormals[v];
+                            meshData.normals.push_back(vec3(normal.x, normal.y, normal.z));
+                        }
+                        if (source->HasTextureCoords(0))
+                        {
+                            const aiVector3D& uv = source->mTextureCoords[0][v];
+                            meshData.UVs.push_back(vec2(uv.x, uv.y));
+                        }
+                    }
+
+                    meshData.indices.reserve(source->mNumFaces * 3);
+                    for (unsigned int f = 0; f < source->mNumFaces; f++)
+                    {
+                        const aiFace& face = source->mFaces[f];
+                        for (unsigned int j = 0; j < face.mNumIndices; j++)
+                        {
+                            meshData.indices.push_back(face.mIndices[j]);
+                        }
+                    }
+
+                    mesh.hasBounds = MeshBounds::FromPositions(&source->mVertices[0].x, source->mNumVertices, 3, mesh.min, mesh.max);
+                }
+            }
+        }
+
+        static void DecodeFile(void* data)
+        {
+            FileLoad* load = (FileLoad*)data;
+            {
+                PROFILE_SCOPE("Mesh Streamer Decode");
+
+                if (!s_CookedMeshesEnabled || !DecodeCooked(load))
+                {
+                    load->meshes.clear();
+                    DecodeImported(load);
+                }
+            }
+
+            load->decoded.store(true, std::memory_order_release);
+        }
+
+        static Mesh* FindResident(const std::string& meshName)
+        {
+            const auto* meshes = Resources::SeeMeshes();
+            auto it = meshes->find(meshName);
+            return it != meshes->end() ? it->second : nullptr;
+        }
+
+        void Initialize(TaskScheduler* scheduler)
+        {
+            s_Scheduler = scheduler;
+        }
+
+        void Shutdown()
+        {
+            for (const std::unique_ptr<FileLoad>& load : s_Loads)
+            {
+                while (!load->decoded.load(std::memory_order_acquire))
+                {
+                    if (!s_Scheduler->RunPendingTask())
+                        std::this_thread::yield();
+                }
+            }
+            s_Loads.clear();
+            s_Scheduler = nullptr;
+        }
+
+        bool IsEnabled()
+        {
+            return s_Scheduler != nullptr;
+        }
+
+        void SetCookedMeshesEnabled(bool enabled)
+        {
+            s_CookedMeshesEnabled = enabled;
+        }
+
+        void SetQuantizedMeshesEnabled(bool enabled)
+        {
+            s_QuantizedMeshesEnabled = enabled;
+        }
+
+        Mesh* Request(const char* meshFile, const char* meshName, SceneEntities& entities, GameObject* object, unsigned int renderableIndex)
+        {
+            if (s_Scheduler == nullptr)
+                return Resources::GetMeshFromFile(meshFile, meshName);
+
+            if (Mesh* mesh = FindResident(meshName))
+                return mesh;
+
+            FileLoad* load = nullptr;
+            for (const std::unique_ptr<FileLoad>& existing : s_Loads)
+            {
+                if (existing->file == meshFile)
+                {
+                    load = existing.get();
+                    break;
+                }
+            }
+
+            if (load == nullptr)
+            {
+                s_Loads.emplace_back(new FileLoad());
+                load = s_Loads.back().get();
+                load->file = meshFile;
+                load->path = MeshFolderPath(meshFile);
+                s_Scheduler->ScheduleBackground(DecodeFile, load);
+            }
+
+            Binding binding;
+            binding.meshName = meshName;
+            binding.entities = &entities;
+            binding.handle = entities.GetHandle(object);
+            binding.object = object;
+            binding.renderableIndex = renderableIndex;
+            load->bindings.push_back(binding);
+
+            return Resources::GetMesh(null_mesh);
+        }
+
+        void Forget(const SceneEntities& entities)
+        {
+            for (const std::unique_ptr<FileLoad>& load : s_Loads)
+            {
+                std::vector<Binding>& bindings = load->bindings;
+                for (size_t i = 0; i < bindings.size();)
+                {
+                    if (bindings[i].entities == &entities)
+                    {
+                        bindings[i] = bindings.back();
+                        bindings.pop_back();
+                    }
+                    else
+                    {
+                        i++;
+                    }
+                }
+            }
+        }
+
+        static void Upload(const FileLoad& load, DecodedMesh& decoded)
+        {
+            // Another file or a synchronous load can get there first
+            if (FindResident(decoded.name) == nullptr)
+            {
+                PROFILE_SCOPE("Mesh Streamer Upload");
+
+                Mesh* mesh = new Mesh();
+                mesh->SetName(decoded.name);
+                mesh->SetFileName(load.file);
+                mesh->BufferMeshData(&decoded.data);
+                Resources::AddMesh(decoded.name.c_str(), mesh);
+
+                if (decoded.hasBounds)
+                    MeshBounds::Set(mesh, decoded.min, decoded.max);
+            }
+
+            decoded.data = MeshData(); // Free the CPU copy
+        }
+
+        static void Bind(const FileLoad& load)
+        {
+            Mesh* placeholder = Resources::GetMesh(null_mesh);
+
+            for (const Binding& binding : load.bindings)
+            {
+                Mesh* mesh = FindResident(binding.meshName);
+                if (mesh == nullptr)
+                {
+                    LOG_WARN("MeshStreamer: {0} has no mesh named {1}", load.file, binding.meshName);
+                    continue;
+                }
+
+                // Gone, or edited since the request
+                GameObject* object = binding.entities->Resolve(binding.handle);
+                RenderComponent* rComp = object == binding.object ? (RenderComponent*)object->GetComponent(Component_Render) : nullptr;
+                if (rComp == nullptr)
+                    continue;
+
+                std::vector<Renderable>* renderables = (std::vector<Renderable>*)rComp->LookAtRenderableList();
+                if (binding.renderableIndex >= renderables->size() || renderables->at(binding.renderableIndex).GetMesh() != placeholder)
+                    continue;
+
+                rComp->SetMeshAtIndex(binding.renderableIndex, mesh);
+                binding.entities->Invalidate(); // Picks up the mesh's bounds
+            }
+        }
+
+        void Update(unsigned int budgetMicroseconds)
+        {
+            if (s_Loads.empty())
+                return;
+
+            PROFILE_SCOPE("Mesh Streamer Update");
+
+            const auto start = std::chrono::steady_clock::now();
+            const std::chrono::microseconds budget(budgetMicroseconds);
+            bool uploaded = false;
+
+            for (auto it = s_Loads.begin(); it != s_Loads.end();)
+            {
+                FileLoad& load = **it;
+                if (!load.decoded.load(std::memory_order_acquire))
+                {
+                    ++it;
+                    continue;
+                }
+
+                while (load.uploadedCount < load.meshes.size())
+                {
+                    if (uploaded && std::chrono::steady_clock::now() - start >= budget)
+                        return;
+
+                    Upload(load, load.meshes[load.uploadedCount++]);
+                    uploaded = true;
+                }
+
+                if (!load.error.empty())
+                    LOG_ERROR("MeshStreamer: Could not load {0}. {1}", load.path, load.error);
+                else
+                    LOG_INFO("MeshStreamer: Loaded {0} meshes from {1}", load.meshes.size(), load.file);
+
+                Bind(load);
+                it = s_Loads.erase(it);
+            }
+        }
+
+        unsigned int PendingCount()
+        {
+            return (unsigned int)s_Loads.size();
+        }
+    }
+
+}
@@ -0,0 +1,61 @@
+#ifndef _Mesh_Streamer_H_
+#define _Mesh_Streamer_H_
+
+// Loads mesh files in the background so the first reference to a large
+// model doesn't stall a frame. Files are read and decoded as TaskScheduler
+// background tasks, so the main thread never picks one up while it waits
+// on other tasks. The decoded meshes are then uploaded to the GPU by
+// Update() on the thread that owns the GL context, a few per frame under a
+// time budget. A single mesh is never split across frames, so 1 very large mesh
+// can still go over the budget.
+//
+// Workers read the cooked version of a file (see CookedMesh.h), cooking it
+// first when it is missing or stale. When cooking fails, or cooked meshes
+// are disabled, the file is imported directly.
+//
+// Requests return the null_mesh placeholder right away. Once the file is
+// uploaded the real mesh replaces the placeholder in every renderable that
+// asked for it, unless the object left its scene or the renderable was
+// given another mesh in the meantime.
+//
+// Without Initialize(), as in headless and pipelined runs, requests load
+// on the calling thread through Resources.
+
+namespace QwerkE {
+
+    class GameObject;
+    class Mesh;
+    class SceneEntities;
+    class TaskScheduler;
+
+    namespace MeshStreamer
+    {
+        void Initialize(TaskScheduler* scheduler);
+        // Waits for decodes in flight and drops everything not uploaded yet
+        void Shutdown();
+        bool IsEnabled();
+        // Call before the first request
+        void SetCookedMeshesEnabled(bool enabled);
+        // Cook meshes in the compact vertex layout, off by default. Call before
+        // the first request.
+        void SetQuantizedMeshesEnabled(bool enabled);
+
+        // The resident mesh, or the placeholder while meshFile loads. object
+        // is a member of entities' scene and renderableIndex the renderable
+        // of its RenderComponent that gets the loaded mesh.
+        Mesh* Request(const char* meshFile, const char* meshName, SceneEntities& entities, GameObject* object, unsigned int renderableIndex);
+
+        // Drops the requests made for entities' objects. Call before
+        // entities is destroyed.
+        void Forget(const SceneEntities& entities);
+
+        // GL thread, once a frame. Uploads decoded meshes until
+        // budgetMicroseconds have passed, at least 1 per call.
+        void Update(unsigned int budgetMicroseconds);
+
+        // Files requested and not uploaded yet
+        unsigned int PendingCount();
+    }
+
+}
+#endif // _Mesh_Streamer_H_
@@ -0,0 +1,957 @@
+#include "ObjImporter.h"
+#include "../FileSystem/MappedFile.h"
+#include "../Jobs/TaskScheduler.h"
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <sys/stat.h>
+#include <thread>
+#include <unordered_map>
+
+namespace QwerkE {
+
+    namespace ObjImporter
+    {
+        // Smaller chunks cost more in scheduling than they save
+        static const size_t s_MinBytesPerChunk = 256 * 1024;
+
+        static const int s_NoIndex = -1;
+
+        // Powers of 10 that are exact as doubles
+        static const double s_Pow10[] = {
+            1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+            1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+        };
+
+        // 0 based indices into the model's attributes
+        struct ObjCorner
+        {
+            int position;
+            int uv;
+            int normal;
+
+            bool operator==(const ObjCorner& other) const
+            {
+                return position == other.position && uv == other.uv && normal == other.normal;
+            }
+        };
+
+        struct ObjCornerHash
+        {
+            size_t operator()(const ObjCorner& corner) const
+            {
+                return (size_t)corner.position * 73856093u ^ (size_t)corner.uv * 19349663u ^ (size_t)corner.normal * 83492791u;
+            }
+        };
+
+        enum eObjStatements : unsigned char
+        {
+            ObjStatement_Group = 0, // "o" or "g"
+            ObjStatement_Material, // "usemtl"
+            ObjStatement_Library // "mtllib"
+        };
+
+        struct ObjStatement
+        {
+            eObjStatements type;
+            size_t corner; // The chunk's corner count when it was read
+            std::string value;
+        };
+
+        struct ObjChunk
+        {
+            const char* begin;
+            const char* end;
+
+            std::vector<float> positions; // 3 per vertex
+            std::vector<float> uvs; // 2 per vertex
+            std::vector<float> normals; // 3 per vertex
+            std::vector<ObjCorner> corners; // 3 per triangle
+            std::vector<ObjStatement> statements;
+
+            // Corners with negative indices, as corner * 3 + attribute. They
+            // count back from the chunk's own vertices until the merge.
+            std::vector<unsigned int> relativeCorners;
+
+            const char* malformedLine = nullptr;
+        };
+
+        struct ObjAttributes
+        {
+            std::vector<float> positions;
+            std::vector<float> uvs;
+            std::vector<float> normals;
+        };
+
+        // A group's triangles, which can span chunks
+        struct ObjRun
+        {
+            std::string name;
+            std::string material;
+            std::vector<std::pair<const ObjCorner*, size_t>> segments; // Corners and their count
+            size_t cornerCount = 0;
+            const ObjAttributes* attributes = nullptr;
+
+            // Written by the weld task
+            std::vector<CookedMeshVertex> vertices;
+            std::vector<unsigned int> indices;
+            bool missingUVs = false;
+            bool generatedNormals = false;
+            bool outOfRange = false;
+        };
+
+        struct MaterialLoad
+        {
+            std::string path;
+            std::vector<ObjMaterial> materials;
+            bool loaded = false;
+        };
+
+        struct ObjTask
+        {
+            TaskScheduler::TaskFunction function;
+            void* data;
+            std::atomic<unsigned int>* remaining;
+        };
+
+        static void RunObjTask(void* data)
+        {
+            ObjTask* task = (ObjTask*)data;
+            task->function(task->data);
+            task->remaining->fetch_sub(1, std::memory_order_release);
+        }
+
+        // The calling thread takes the first task itself, then helps with the rest
+        static void RunTasks(std::vector<ObjTask>& tasks, TaskScheduler* scheduler)
+        {
+            if (tasks.empty())
+                return;
+
+            if (scheduler == nullptr)
+            {
+                for (const ObjTask& task : tasks)
+                {
+                    task.function(task.data);
+                }
+                return;
+            }
+
+            std::atomic<unsigned int> remaining((unsigned int)tasks.size() - 1);
+            for (size_t i = 1; i < tasks.size(); i++)
+            {
+                tasks[i].remaining = &remaining;
+                scheduler->Schedule(RunObjTask, &tasks[i]);
+            }
+
+            tasks[0].function(tasks[0].data);
+
+            while (remaining.load(std::memory_order_acquire) != 0)
+            {
+                if (!scheduler->RunPendingTask())
+                    std::this_thread::yield();
+            }
+        }
+
+        static bool IsSpace(char c)
+        {
+            return c == ' ' || c == '\t' || c == '\r';
+        }
+
+        static bool IsDigit(char c)
+        {
+            return c >= '0' && c <= '9';
+        }
+
+        static const char* SkipSpaces(const char* text, const char* end)
+        {
+            while (text < end && IsSpace(*text))
+                text++;
+            return text;
+        }
+
+        static const char* SkipToken(const char* text, const char* end)
+        {
+            while (text < end && !IsSpace(*text))
+                text++;
+            return text;
+        }
+
+        static bool IsKeyword(const char* keyword, size_t length, const char* expected)
+        {
+            return strlen(expected) == length && memcmp(keyword, expected, length) == 0;
+        }
+
+        // The rest of the line without surrounding spaces
+        static std::string ReadRest(const char* text, const char* lineEnd)
+        {
+            text = SkipSpaces(text, lineEnd);
+            while (lineEnd > text && IsSpace(lineEnd[-1]))
+                lineEnd--;
+            return std::string(text, lineEnd);
+        }
+
+        const char* ParseFloat(const char* text, const char* end, float& value)
+        {
+            const char* p = text;
+            bool negative = false;
+            if (p < end && (*p == '-' || *p == '+'))
+            {
+                negative = *p == '-';
+                p++;
+            }
+
+            // Up to 19 significant digits fit in the mantissa
+            unsigned long long mantissa = 0;
+            int significantDigits = 0;
+            int exponent = 0;
+            bool hasDigits = false;
+            bool truncated = false;
+
+            for (; p < end && IsDigit(*p); p++)
+            {
+                hasDigits = true;
+                if (significantDigits < 19)
+                {
+                    mantissa = mantissa * 10 + (*p - '0');
+                    if (mantissa != 0)
+                        significantDigits++;
+                }
+                else
+                {
+                    exponent++;
+                    truncated = true;
+                }
+            }
+
+            if (p < end && *p == '.')
+            {
+                for (p++; p < end && IsDigit(*p); p++)
+                {
+                    hasDigits = true;
+                    if (significantDigits < 19)
+                    {
+                        mantissa = mantissa * 10 + (*p - '0');
+                        exponent--;
+                        if (mantissa != 0)
+                            significantDigits++;
+                    }
+                    else
+                    {
+                        truncated = true;
+                    }
+                }
+            }
+
+            if (!hasDigits)
+                return nullptr;
+
+            if (p < end && (*p == 'e' || *p == 'E'))
+            {
+                const char* e = p + 1;
+                bool negativeExponent = false;
+                if (e < end && (*e == '-' || *e == '+'))
+                {
+                    negativeExponent = *e == '-';
+                    e++;
+                }
+
+                if (e < end && IsDigit(*e))
+                {
+                    int written = 0;
+                    for (; e < end && IsDigit(*e); e++)
+                    {
+                        if (written < 10000)
+                            written = written * 10 + (*e - '0');
+                    }
+                    exponent += negativeExponent ? -written : written;
+                    p = e;
+                }
+            }
+
+            // Exact when the mantissa and the power of 10 are both exact doubles
+            if (!truncated && mantissa <= (1ull << 53) && exponent >= -22 && exponent <= 22)
+            {
+                double result = (double)mantissa;
+                result = exponent < 0 ? result / s_Pow10[-exponent] : result * s_Pow10[exponent];
+                value = (float)(negative ? -result : result);
+                return p;
+            }
+
+            // Rare in model files. strtod needs a terminated copy.
+            char buffer[64];
+            size_t length = (size_t)(p - text);
+            if (length >= sizeof(buffer))
+                length = sizeof(buffer) - 1;
+            memcpy(buffer, text, length);
+            buffer[length] = '\0';
+            value = (float)strtod(buffer, nullptr);
+            return p;
+        }
+
+        static const char* ParseIndex(const char* text, const char* end, int& value)
+        {
+            bool negative = false;
+            if (text < end && *text == '-')
+            {
+                negative = true;
+                text++;
+            }
+
+            if (text >= end || !IsDigit(*text))
+                return nullptr;
+
+            long long result = 0;
+            for (; text < end && IsDigit(*text); text++)
+            {
+                if (result <= 0x7fffffff)
+                    result = result * 10 + (*text - '0');
+            }
+            if (result > 0x7fffffff)
+                return nullptr;
+
+            value = negative ? -(int)result : (int)result;
+            return text;
+        }
+
+        // Parses up to count floats. Returns how many were read.
+        static int ParseFloats(const char* text, const char* lineEnd, float* values, int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                text = SkipSpaces(text, lineEnd);
+                const char* next = ParseFloat(text, lineEnd, values[i]);
+                if (next == nullptr)
+                    return i;
+                text = next;
+            }
+            return count;
+        }
+
+        // "f v v/vt v//vn v/vt/vn ...". Returns false if malformed.
+        static bool ParseFace(const char* text, const char* lineEnd, ObjChunk& chunk, std::vector<ObjCorner>& face, std::vector<unsigned char>& relative)
+        {
+            const int counts[3] = {
+                (int)(chunk.positions.size() / 3),
+                (int)(chunk.uvs.size() / 2),
+                (int)(chunk.normals.size() / 3)
+            };
+
+            face.clear();
+            relative.clear();
+            for (text = SkipSpaces(text, lineEnd); text < lineEnd; text = SkipSpaces(text, lineEnd))
+            {
+                ObjCorner corner = { s_NoIndex, s_NoIndex, s_NoIndex };
+                int* fields[3] = { &corner.position, &corner.uv, &corner.normal };
+                unsigned char relativeFields = 0;
+
+                for (int attribute = 0; attribute < 3; attribute++)
+                {
+                    if (attribute > 0)
+                    {
+                        if (text >= lineEnd || *text != '/')
+                            break;
+                        text++;
+                        if (attribute == 1 && text < lineEnd && *text == '/')
+                            continue; // "v//vn"
+                    }
+
+                    int index;
+                    const char* next = ParseIndex(text, lineEnd, index);
+                    if (next == nullptr || index == 0)
+                        return false;
+                    text = next;
+
+                    if (index > 0)
+                    {
+                        *fields[attribute] = index - 1;
+                    }
+                    else
+                    {
+                        *fields[attribute] = counts[attribute] + index;
+                        relativeFields |= 1 << attribute;
+                    }
+                }
+
+                if (text < lineEnd && !IsSpace(*text))
+                    return false;
+
+                face.push_back(corner);
+                relative.push_back(relativeFields);
+            }
+
+            // Fan. Points and lines have no triangles.
+            for (size_t i = 1; i + 1 < face.size(); i++)
+            {
+                const size_t triangle[3] = { 0, i, i + 1 };
+                for (size_t corner : triangle)
+                {
+                    for (unsigned int attribute = 0; attribute < 3; attribute++)
+                    {
+                        if (relative[corner] & (1 << attribute))
+                            chunk.relativeCorners.push_back((unsigned int)chunk.corners.size() * 3 + attribute);
+                    }
+                    chunk.corners.push_back(face[corner]);
+                }
+            }
+            return true;
+        }
+
+        static void ParseChunk(void* data)
+        {
+            PROFILE_SCOPE("Obj Parse Chunk");
+
+            ObjChunk* chunk = (ObjChunk*)data;
+            std::vector<ObjCorner> face;
+            std::vector<unsigned char> relative;
+
+            const char* end = chunk->end;
+            for (const char* line = chunk->begin; line < end;)
+            {
+                const char* lineEnd = (const char*)memchr(line, '\n', (size_t)(end - line));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                const char* keyword = SkipSpaces(line, lineEnd);
+                const char* text = SkipToken(keyword, lineEnd);
+                const size_t length = (size_t)(text - keyword);
+
+                bool valid = true;
+                if (length == 0 || keyword[0] == '#')
+                {
+                }
+                else if (IsKeyword(keyword, length, "v"))
+                {
+                    float position[3];
+                    valid = ParseFloats(text, lineEnd, position, 3) == 3;
+                    chunk->positions.insert(chunk->positions.end(), position, position + 3);
+                }
+                else if (IsKeyword(keyword, length, "vt"))
+                {
+                    float uv[2] = { 0.0f, 0.0f };
+                    valid = ParseFloats(text, lineEnd, uv, 2) >= 1;
+                    chunk->uvs.push_back(uv[0]);
+                    chunk->uvs.push_back(1.0f - uv[1]);
+                }
+                else if (IsKeyword(keyword, length, "vn"))
+                {
+                    float normal[3];
+                    valid = ParseFloats(text, lineEnd, normal, 3) == 3;
+                    chunk->normals.insert(chunk->normals.end(), normal, normal + 3);
+                }
+                else if (IsKeyword(keyword, length, "f"))
+                {
+                    valid = ParseFace(text, lineEnd, *chunk, face, relative);
+                }
+                else if (IsKeyword(keyword, length, "o") || IsKeyword(keyword, length, "g"))
+                {
+                    chunk->statements.push_back({ ObjStatement_Group, chunk->corners.size(), ReadRest(text, lineEnd) });
+                }
+                else if (IsKeyword(keyword, length, "usemtl"))
+                {
+                    chunk->statements.push_back({ ObjStatement_Material, chunk->corners.size(), ReadRest(text, lineEnd) });
+                }
+                else if (IsKeyword(keyword, length, "mtllib"))
+                {
+                    for (text = SkipSpaces(text, lineEnd); text < lineEnd; text = SkipSpaces(text, lineEnd))
+                    {
+                        const char* name = text;
+                        text = SkipToken(text, lineEnd);
+                        chunk->statements.push_back({ ObjStatement_Library, chunk->corners.size(), std::string(name, text) });
+                    }
+                }
+
+                if (!valid)
+                {
+                    chunk->malformedLine = line;
+                    return;
+                }
+                line = lineEnd + 1;
+            }
+        }
+
+        static void Normalize(float vector[3])
+        {
+            const float length = sqrtf(vector[0] * vector[0] + vector[1] * vector[1] + vector[2] * vector[2]);
+            if (length > 0.0f)
+            {
+                vector[0] /= length;
+                vector[1] /= length;
+                vector[2] /= length;
+            }
+        }
+
+        static void WeldRun(void* data)
+        {
+            PROFILE_SCOPE("Obj Weld Group");
+
+            ObjRun* run = (ObjRun*)data;
+            const ObjAttributes& attributes = *run->attributes;
+            const int positionCount = (int)(attributes.positions.size() / 3);
+            const int uvCount = (int)(attributes.uvs.size() / 2);
+            const int normalCount = (int)(attributes.normals.size() / 3);
+
+            std::unordered_map<ObjCorner, unsigned int, ObjCornerHash> welded;
+            welded.reserve(run->cornerCount);
+            run->vertices.reserve(run->cornerCount / 2);
+            run->indices.reserve(run->cornerCount);
+
+            int triangleNumber = 0;
+            for (const auto& segment : run->segments)
+            {
+                for (size_t i = 0; i + 3 <= segment.second; i += 3, triangleNumber++)
+                {
+                    const ObjCorner* triangle = segment.first + i;
+                    for (int c = 0; c < 3; c++)
+                    {
+                        const ObjCorner& corner = triangle[c];
+                        if (corner.position < 0 || corner.position >= positionCount ||
+                            corner.uv < s_NoIndex || corner.uv >= uvCount ||
+                            corner.normal < s_NoIndex || corner.normal >= normalCount)
+                        {
+                            run->outOfRange = true;
+                            return;
+                        }
+                    }
+
+                    float flatNormal[3] = { 0.0f, 0.0f, 0.0f };
+                    if (triangle[0].normal == s_NoIndex || triangle[1].normal == s_NoIndex || triangle[2].normal == s_NoIndex)
+                    {
+                        const float* a = &attributes.positions[triangle[0].position * 3];
+                        const float* b = &attributes.positions[triangle[1].position * 3];
+                        const float* c = &attributes.positions[triangle[2].position * 3];
+                        const float ab[3] = { b[0] - a[0], b[1] - a[1], b[2] - a[2] };
+                        const float ac[3] = { c[0] - a[0], c[1] - a[1], c[2] - a[2] };
+                        flatNormal[0] = ab[1] * ac[2] - ab[2] * ac[1];
+                        flatNormal[1] = ab[2] * ac[0] - ab[0] * ac[2];
+                        flatNormal[2] = ab[0] * ac[1] - ab[1] * ac[0];
+                        Normalize(flatNormal);
+                    }
+
+                    for (int c = 0; c < 3; c++)
+                    {
+                        // Generated normals belong to 1 triangle, so their corners only weld within it
+                        ObjCorner key = triangle[c];
+                        if (key.normal == s_NoIndex)
+                        {
+                            key.normal = -2 - triangleNumber;
+                            run->generatedNormals = true;
+                        }
+                        if (key.uv == s_NoIndex)
+                            run->missingUVs = true;
+
+                        auto inserted = welded.emplace(key, (unsigned int)run->vertices.size());
+                        if (inserted.second)
+                        {
+                            CookedMeshVertex vertex;
+                            memcpy(vertex.position, &attributes.positions[key.position * 3], sizeof(vertex.position));
+                            if (key.normal >= 0)
+                                memcpy(vertex.normal, &attributes.normals[key.normal * 3], sizeof(vertex.normal));
+                            else
+                                memcpy(vertex.normal, flatNormal, sizeof(vertex.normal));
+                            if (key.uv >= 0)
+                                memcpy(vertex.uv, &attributes.uvs[key.uv * 2], sizeof(vertex.uv));
+                            else
+                                vertex.uv[0] = vertex.uv[1] = 0.0f;
+                            run->vertices.push_back(vertex);
+                        }
+                        run->indices.push_back(inserted.first->second);
+                    }
+                }
+            }
+        }
+
+        static void LoadMaterialLibrary(void* data)
+        {
+            MaterialLoad* load = (MaterialLoad*)data;
+            load->loaded = ImportMaterials(load->path.c_str(), load->materials);
+        }
+
+        static bool FileExists(const std::string& filePath)
+        {
+            struct stat info;
+            return stat(filePath.c_str(), &info) == 0;
+        }
+
+        // Libraries named before the first vertex, so they can load while the rest is parsed
+        static void FindLeadingLibraries(const char* text, const char* end, std::vector<std::string>& libraries)
+        {
+            for (const char* line = text; line < end;)
+            {
+                const char* lineEnd = (const char*)memchr(line, '\n', (size_t)(end - line));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                const char* keyword = SkipSpaces(line, lineEnd);
+                const char* rest = SkipToken(keyword, lineEnd);
+                const size_t length = (size_t)(rest - keyword);
+                if (IsKeyword(keyword, length, "mtllib"))
+                {
+                    for (rest = SkipSpaces(rest, lineEnd); rest < lineEnd; rest = SkipSpaces(rest, lineEnd))
+                    {
+                        const char* name = rest;
+                        rest = SkipToken(rest, lineEnd);
+                        libraries.push_back(std::string(name, rest));
+                    }
+                }
+                else if (length > 0 && keyword[0] != '#' && !IsKeyword(keyword, length, "o") && !IsKeyword(keyword, length, "g"))
+                {
+                    return;
+                }
+                line = lineEnd + 1;
+            }
+        }
+
+        bool Import(const char* filePath, ObjModel& model, TaskScheduler* scheduler)
+        {
+            PROFILE_SCOPE("Obj Import");
+
+            model = ObjModel();
+
+            MappedFile file;
+            if (!file.Open(filePath))
+            {
+                LOG_ERROR("ObjImporter: Could not read {0}", filePath);
+                return false;
+            }
+
+            const char* text = (const char*)file.Data();
+            const char* end = text + file.Size();
+
+            std::string directory = filePath;
+            const size_t slash = directory.find_last_of("/\\");
+            directory.erase(slash == std::string::npos ? 0 : slash + 1);
+
+            // Material libraries load alongside the chunks
+            std::vector<std::string> libraries;
+            FindLeadingLibraries(text, end, libraries);
+
+            std::vector<std::unique_ptr<MaterialLoad>> materialLoads;
+            for (const std::string& library : libraries)
+            {
+                materialLoads.emplace_back(new MaterialLoad());
+                materialLoads.back()->path = directory + library;
+            }
+
+            bool fallbackLibrary = false;
+            if (libraries.empty())
+            {
+                std::string sameName = filePath;
+                const size_t dot = sameName.find_last_of('.');
+                if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+                    sameName.erase(dot);
+                sameName += ".mtl";
+
+                if (FileExists(sameName))
+                {
+                    materialLoads.emplace_back(new MaterialLoad());
+                    materialLoads.back()->path = sameName;
+                    fallbackLibrary = true;
+                }
+            }
+
+            const size_t fileSize = file.Size();
+            const size_t threadCount = scheduler ? scheduler->WorkerCount() + 1 : 1;
+            size_t chunkCount = fileSize / s_MinBytesPerChunk;
+            if (chunkCount > threadCount)
+                chunkCount = threadCount;
+            if (chunkCount == 0)
+                chunkCount = 1;
+
+            // Chunks start after a line break
+            std::vector<ObjChunk> chunks(chunkCount);
+            const char* chunkBegin = text;
+            for (size_t i = 0; i < chunkCount; i++)
+            {
+                const char* chunkEnd = end;
+                if (i + 1 < chunkCount)
+                {
+                    chunkEnd = text + fileSize * (i + 1) / chunkCount;
+                    if (chunkEnd < chunkBegin)
+                        chunkEnd = chunkBegin;
+                    const char* lineBreak = (const char*)memchr(chunkEnd, '\n', (size_t)(end - chunkEnd));
+                    chunkEnd = lineBreak ? lineBreak + 1 : end;
+                }
+
+                chunks[i].begin = chunkBegin;
+                chunks[i].end = chunkEnd;
+                chunkBegin = chunkEnd;
+            }
+
+            std::vector<ObjTask> tasks;
+            for (ObjChunk& chunk : chunks)
+            {
+                tasks.push_back({ ParseChunk, &chunk, nullptr });
+            }
+            for (const std::unique_ptr<MaterialLoad>& load : materialLoads)
+            {
+                tasks.push_back({ LoadMaterialLibrary, load.get(), nullptr });
+            }
+            RunTasks(tasks, scheduler);
+
+            for (const ObjChunk& chunk : chunks)
+            {
+                if (chunk.malformedLine)
+                {
+                    const char* lineEnd = (const char*)memchr(chunk.malformedLine, '\n', (size_t)(end - chunk.malformedLine));
+                    LOG_ERROR("ObjImporter: {0} has a malformed line \"{1}\"", filePath, ReadRest(chunk.malformedLine, lineEnd ? lineEnd : end));
+                    return false;
+                }
+            }
+
+            // Merge the chunks' attributes and resolve negative indices
+            ObjAttributes attributes;
+            {
+                PROFILE_SCOPE("Obj Merge");
+
+                size_t sizes[3] = { 0, 0, 0 };
+                for (const ObjChunk& chunk : chunks)
+                {
+                    sizes[0] += chunk.positions.size();
+                    sizes[1] += chunk.uvs.size();
+                    sizes[2] += chunk.normals.size();
+                }
+                attributes.positions.reserve(sizes[0]);
+                attributes.uvs.reserve(sizes[1]);
+                attributes.normals.reserve(sizes[2]);
+
+                for (ObjChunk& chunk : chunks)
+                {
+                    const int bases[3] = {
+                        (int)(attributes.positions.size() / 3),
+                        (int)(attributes.uvs.size() / 2),
+                        (int)(attributes.normals.size() / 3)
+                    };
+
+                    for (unsigned int relative : chunk.relativeCorners)
+                    {
+                        ObjCorner& corner = chunk.corners[relative / 3];
+                        int* fields[3] = { &corner.position, &corner.uv, &corner.normal };
+                        *fields[relative % 3] += bases[relative % 3];
+                    }
+
+                    attributes.positions.insert(attributes.positions.end(), chunk.positions.begin(), chunk.positions.end());
+                    attributes.uvs.insert(attributes.uvs.end(), chunk.uvs.begin(), chunk.uvs.end());
+                    attributes.normals.insert(attributes.normals.end(), chunk.normals.begin(), chunk.normals.end());
+                    std::vector<float>().swap(chunk.positions);
+                    std::vector<float>().swap(chunk.uvs);
+                    std::vector<float>().swap(chunk.normals);
+                }
+            }
+
+            // Split the triangles into groups
+            std::vector<std::unique_ptr<ObjRun>> runs;
+            {
+                std::string name = "defaultobject";
+                std::string material;
+                ObjRun* open = nullptr;
+
+                auto addCorners = [&](const ObjChunk& chunk, size_t first, size_t last)
+                {
+                    if (first == last)
+                        return;
+                    if (open == nullptr)
+                    {
+                        runs.emplace_back(new ObjRun());
+                        open = runs.back().get();
+                        open->name = name;
+                        open->material = material;
+                        open->attributes = &attributes;
+                    }
+                    open->segments.push_back(std::make_pair(chunk.corners.data() + first, last - first));
+                    open->cornerCount += last - first;
+                };
+
+                for (const ObjChunk& chunk : chunks)
+                {
+                    size_t cursor = 0;
+                    for (const ObjStatement& statement : chunk.statements)
+                    {
+                        addCorners(chunk, cursor, statement.corner);
+                        cursor = statement.corner;
+
+                        if (statement.type == ObjStatement_Group)
+                        {
+                            name = statement.value;
+                            open = nullptr;
+                        }
+                        else if (statement.type == ObjStatement_Material)
+                        {
+                            material = statement.value;
+                            open = nullptr;
+                        }
+                        else if (std::find(libraries.begin(), libraries.end(), statement.value) == libraries.end())
+                        {
+                            // Named after the first vertex. Read now instead of alongside.
+                            libraries.push_back(statement.value);
+                            materialLoads.emplace_back(new MaterialLoad());
+                            materialLoads.back()->path = directory + statement.value;
+                            LoadMaterialLibrary(materialLoads.back().get());
+                        }
+                    }
+                    addCorners(chunk, cursor, chunk.corners.size());
+                }
+            }
+
+            tasks.clear();
+            for (const std::unique_ptr<ObjRun>& run : runs)
+            {
+                tasks.push_back({ WeldRun, run.get(), nullptr });
+            }
+            RunTasks(tasks, scheduler);
+
+            size_t vertexCount = 0;
+            size_t indexCount = 0;
+            for (const std::unique_ptr<ObjRun>& run : runs)
+            {
+                if (run->outOfRange)
+                {
+                    LOG_ERROR("ObjImporter: {0} has a face in {1} with an out of range index", filePath, run->name);
+                    model = ObjModel();
+                    return false;
+                }
+                vertexCount += run->vertices.size();
+                indexCount += run->indices.size();
+            }
+
+            model.vertices.reserve(vertexCount);
+            model.indices.reserve(indexCount);
+            model.hasUVs = true;
+            model.hasNormals = true;
+            for (const std::unique_ptr<ObjRun>& run : runs)
+            {
+                ObjGroup group;
+                group.name = run->name;
+                group.material = run->material;
+                group.firstVertex = (unsigned int)model.vertices.size();
+                group.vertexCount = (unsigned int)run->vertices.size();
+                group.firstIndex = (unsigned int)model.indices.size();
+                group.indexCount = (unsigned int)run->indices.size();
+                model.groups.push_back(group);
+
+                model.vertices.insert(model.vertices.end(), run->vertices.begin(), run->vertices.end());
+                model.indices.insert(model.indices.end(), run->indices.begin(), run->indices.end());
+                model.hasUVs = model.hasUVs && !run->missingUVs;
+                model.hasNormals = model.hasNormals && !run->generatedNormals;
+            }
+
+            // A same named library only stands in for libraries the file doesn't name
+            for (size_t i = 0; i < materialLoads.size(); i++)
+            {
+                const MaterialLoad& load = *materialLoads[i];
+                if (i == 0 && fallbackLibrary && materialLoads.size() > 1)
+                    continue;
+
+                if (!load.loaded)
+                    LOG_WARN("ObjImporter: Could not read material library {0}", load.path);
+                model.materials.insert(model.materials.end(), load.materials.begin(), load.materials.end());
+            }
+            return true;
+        }
+
+        // "map_Kd -bm 1.0 file.png" is file.png
+        static std::string ReadMapFile(const char* text, const char* lineEnd)
+        {
+            while (lineEnd > text && IsSpace(lineEnd[-1]))
+                lineEnd--;
+            const char* name = lineEnd;
+            while (name > text && !IsSpace(name[-1]))
+                name--;
+            return std::string(name, lineEnd);
+        }
+
+        static void ReadColor(const char* text, const char* lineEnd, float color[3])
+        {
+            // "Kd 0.5" sets every channel
+            const int count = ParseFloats(text, lineEnd, color, 3);
+            if (count == 1)
+                color[1] = color[2] = color[0];
+        }
+
+        bool ImportMaterials(const char* filePath, std::vector<ObjMaterial>& materials)
+        {
+            PROFILE_SCOPE("Mtl Import");
+
+            MappedFile file;
+            if (!file.Open(filePath))
+                return false;
+
+            const char* end = (const char*)file.Data() + file.Size();
+            ObjMaterial* material = nullptr;
+
+            for (const char* line = (const char*)file.Data(); line < end;)
+            {
+                const char* lineEnd = (const char*)memchr(line, '\n', (size_t)(end - line));
+                if (lineEnd == nullptr)
+                    lineEnd = end;
+
+                const char* keyword = SkipSpaces(line, lineEnd);
+                const char* text = SkipToken(keyword, lineEnd);
+                const size_t length = (size_t)(text - keyword);
+
+                if (IsKeyword(keyword, length, "newmtl"))
+                {
+                    materials.emplace_back();
+                    material = &materials.back();
+                    material->name = ReadRest(text, lineEnd);
+                }
+                else if (material == nullptr)
+                {
+                }
+                else if (IsKeyword(keyword, length, "Ka"))
+                {
+                    ReadColor(text, lineEnd, material->ambient);
+                }
+                else if (IsKeyword(keyword, length, "Kd"))
+                {
+                    ReadColor(text, lineEnd, material->diffuse);
+                }
+                else if (IsKeyword(keyword, length, "Ks"))
+                {
+                    ReadColor(text, lineEnd, material->specular);
+                }
+                else if (IsKeyword(keyword, length, "Ke"))
+                {
+                    ReadColor(text, lineEnd, material->emissive);
+                }
+                else if (IsKeyword(keyword, length, "Ns"))
+                {
+                    ParseFloats(text, lineEnd, &material->shininess, 1);
+                }
+                else if (IsKeyword(keyword, length, "d"))
+                {
+                    ParseFloats(text, lineEnd, &material->opacity, 1);
+                }
+                else if (IsKeyword(keyword, length, "Tr"))
+                {
+                    float transparency;
+                    if (ParseFloats(text, lineEnd, &transparency, 1) == 1)
+                        material->opacity = 1.0f - transparency;
+                }
+                else if (IsKeyword(keyword, length, "map_Kd"))
+                {
+                    material->diffuseMap = ReadMapFile(text, lineEnd);
+                }
+                else if (IsKeyword(keyword, length, "map_Ks"))
+                {
+                    material->specularMap = ReadMapFile(text, lineEnd);
+                }
+                else if (IsKeyword(keyword, length, "map_Bump") || IsKeyword(keyword, length, "map_bump") ||
+                    IsKeyword(keyword, length, "bump") || IsKeyword(keyword, length, "norm"))
+                {
+                    material->normalMap = ReadMapFile(text, lineEnd);
+                }
+
+                line = lineEnd + 1;
+            }
+            return true;
+        }
+    }
+
+}
@@ -0,0 +1,80 @@
+#ifndef _Obj_Importer_H_
+#define _Obj_Importer_H_
+
+// Wavefront .obj and .mtl reader for models that haven't been cooked yet.
+// The file is memory mapped and split into chunks at line boundaries.
+// Chunks are parsed on TaskScheduler workers, and the material libraries
+// the file names are parsed alongside them. The results are then merged,
+// and each group's vertices are welded in its own task.
+//
+// Faces are fan triangulated. Vertices are welded by their position,
+// texture coordinate and normal indices, so each group gets an indexed
+// vertex buffer in the cooked layout. Texture coordinates are flipped
+// vertically, as with aiProcess_FlipUVs. Corners without a normal get
+// the flat normal of their triangle.
+//
+// A new group starts at every "o", "g" or "usemtl" line that is followed
+// by faces. When the file names no material library, the .mtl next to it
+// with the same name is read if there is one.
+
+#include "CookedMesh.h"
+
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    class TaskScheduler;
+
+    struct ObjMaterial
+    {
+        std::string name;
+        float ambient[3] = { 0.0f, 0.0f, 0.0f }; // Ka
+        float diffuse[3] = { 1.0f, 1.0f, 1.0f }; // Kd
+        float specular[3] = { 0.0f, 0.0f, 0.0f }; // Ks
+        float emissive[3] = { 0.0f, 0.0f, 0.0f }; // Ke
+        float shininess = 0.0f; // Ns
+        float opacity = 1.0f; // d
+        std::string diffuseMap; // map_Kd
+        std::string specularMap; // map_Ks
+        std::string normalMap; // map_Bump, bump or norm
+    };
+
+    // Ranges of ObjModel's buffers, like a CookedSubmesh
+    struct ObjGroup
+    {
+        std::string name;
+        std::string material;
+        unsigned int firstVertex;
+        unsigned int vertexCount;
+        unsigned int firstIndex;
+        unsigned int indexCount; // Counting from firstVertex
+    };
+
+    struct ObjModel
+    {
+        std::vector<CookedMeshVertex> vertices;
+        std::vector<unsigned int> indices;
+        std::vector<ObjGroup> groups;
+        std::vector<ObjMaterial> materials; // In library order
+        bool hasUVs = false; // Every corner had a texture coordinate
+        bool hasNormals = false; // Every corner had a normal, none were generated
+    };
+
+    namespace ObjImporter
+    {
+        // Replaces model's contents. A null scheduler parses on the calling
+        // thread. Returns false when the file can't be read or refers to
+        // vertices it doesn't have.
+        bool Import(const char* filePath, ObjModel& model, TaskScheduler* scheduler);
+
+        // Appends the materials of a .mtl file
+        bool ImportMaterials(const char* filePath, std::vector<ObjMaterial>& materials);
+
+        // Parses a decimal float at text, not reading past end. Returns the
+        // character after it, or null when there is no number.
+        const char* ParseFloat(const char* text, const char* end, float& value);
+    }
+
+}
+#endif // _Obj_Importer_H_
@@ -0,0 +1,110 @@
+#include "RenderSnapshot.h"
+#include "../Entities/SceneEntities.h"
+#include "../Math/TransformMath.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/Camera/CameraComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/LightComponent.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstring>
+
+namespace QwerkE {
+
+    void RenderSnapshot::Capture(Scene* scene, SceneEntities& entities, unsigned long long frame)
+    {
+        PROFILE_SCOPE("Render Snapshot Capture");
+
+        items.clear(); // Keeps capacity
+        frameIndex = frame;
+        hasCamera = false;
+        hasLight = false;
+
+        if (scene == nullptr)
+            return;
+
+        const std::vector<GameObject*>& cameras = scene->GetCameraList();
+        if (!cameras.empty())
+        {
+            GameObject* cameraObject = cameras.at(0);
+            CameraComponent* camera = (CameraComponent*)cameraObject->GetComponent(Component_Camera);
+            if (camera)
+            {
+                memcpy(viewMatrix, camera->GetViewMatrix(), sizeof(viewMatrix));
+                memcpy(projectionMatrix, camera->GetProjectionMatrix(), sizeof(projectionMatrix));
+                const vec3 position = cameraObject->GetPosition();
+                cameraPosition[0] = position.x;
+                cameraPosition[1] = position.y;
+                cameraPosition[2] = position.z;
+                hasCamera = true;
+            }
+        }
+
+        const std::vector<GameObject*>& lights = scene->GetLightList();
+        if (!lights.empty())
+        {
+            GameObject* lightObject = lights.at(0);
+            LightComponent* light = (LightComponent*)lightObject->GetComponent(Component_Light);
+            if (light)
+            {
+                const vec3 position = lightObject->GetPosition();
+                const vec3 colour = light->GetColour();
+                lightPosition[0] = position.x;
+                lightPosition[1] = position.y;
+                lightPosition[2] = position.z;
+                lightColour[0] = colour.x;
+                lightColour[1] = colour.y;
+                lightColour[2] = colour.z;
+                hasLight = true;
+            }
+        }
+
+        if (hasCamera)
+        {
+            float viewProjection[16];
+            TransformMath::Multiply(projectionMatrix, viewMatrix, viewProjection);
+            entities.Cull(viewProjection);
+        }
+
+        const EntityStore& store = entities.GetStore();
+
+        for (unsigned char i = 0; i < EntityComponent_ArchetypeCount; i++)
+        {
+            if ((i & EntityComponent_Render) == 0)
+                continue;
+
+            const EntityArchetype& archetype = store.GetArchetype(i);
+            for (size_t row = 0; row < archetype.Size(); row++)
+            {
+                if (hasCamera && !archetype.visible[row])
+                    continue;
+
+                RenderComponent* rComp = archetype.renderComponents[row];
+                const float* worldMatrix = &archetype.worldMatrices[row * 16];
+
+                std::vector<Renderable>* renderables = (std::vector<Renderable>*)rComp->LookAtRenderableList();
+                for (Renderable& renderable : *renderables)
+                {
+                    RenderItem item;
+                    memcpy(item.worldMatrix, worldMatrix, sizeof(item.worldMatrix));
+                    item.shader = renderable.GetShaderSchematic();
+                    item.material = renderable.GetMaterialSchematic();
+                    item.mesh = renderable.GetMesh();
+                    items.push_back(item);
+                }
+            }
+        }
+    }
+
+    void RenderSnapshot::Clear()
+    {
+        items.clear();
+        hasCamera = false;
+        hasLight = false;
+        frameIndex = 0;
+    }
+
+}
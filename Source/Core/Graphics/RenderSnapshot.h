@@ -0,0 +1,52 @@
+#ifndef _Render_Snapshot_H_
+#define _Render_Snapshot_H_
+
+// An immutable copy of everything needed to draw one frame of a scene.
+// Captured on the update thread once a frame's logic is done so a
+// render thread can draw it while the next frame is being simulated.
+// Only resource pointers are shared. Resources are not modified or
+// freed while a scene is running.
+
+#include <vector>
+
+namespace QwerkE {
+
+    class Scene;
+    class SceneEntities;
+    class ShaderProgram;
+    class Material;
+    class Mesh;
+
+    struct RenderItem
+    {
+        float worldMatrix[16];
+        ShaderProgram* shader = nullptr;
+        Material* material = nullptr;
+        Mesh* mesh = nullptr;
+    };
+
+    struct RenderSnapshot
+    {
+        // Reuses item storage between frames. Items come from the render
+        // archetypes of entities, which must have up to date world matrices.
+        // With a camera, entities outside its frustum are left out.
+        void Capture(Scene* scene, SceneEntities& entities, unsigned long long frameIndex);
+        void Clear();
+
+        unsigned long long frameIndex = 0;
+
+        bool hasCamera = false;
+        float viewMatrix[16];
+        float projectionMatrix[16];
+        float cameraPosition[3];
+
+        // The scene's first light, as the framework's render routine uses
+        bool hasLight = false;
+        float lightPosition[3];
+        float lightColour[3];
+
+        std::vector<RenderItem> items;
+    };
+
+}
+#endif // _Render_Snapshot_H_
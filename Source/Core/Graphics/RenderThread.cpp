@@ -0,0 +1,123 @@
+#include "RenderThread.h"
+
+#include "../QwerkE_Framework/Libraries/glew/GL/glew.h"
+#include "../QwerkE_Framework/Libraries/glfw/GLFW/glfw3.h"
+#include "../Profiler/TraceRecorder.h"
+
+namespace QwerkE {
+
+    RenderThread::RenderThread()
+    {
+        for (int i = 0; i < s_SnapshotCount; i++)
+        {
+            m_FreeSnapshots.push_back(&m_Snapshots[i]);
+        }
+    }
+
+    RenderThread::~RenderThread()
+    {
+        Stop();
+    }
+
+    void RenderThread::Start(GLFWwindow* window)
+    {
+        if (m_Running)
+            return;
+
+        m_Window = window;
+        m_StopRequested = false;
+        m_Running = true;
+        m_Thread = std::thread(&RenderThread::p_Run, this);
+    }
+
+    void RenderThread::Stop()
+    {
+        if (!m_Running)
+            return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_Mutex);
+            m_StopRequested = true;
+        }
+        m_Condition.notify_all();
+        m_Thread.join();
+
+        // Unsubmitted work is dropped
+        if (m_QueuedSnapshot)
+        {
+            m_FreeSnapshots.push_back(m_QueuedSnapshot);
+            m_QueuedSnapshot = nullptr;
+        }
+        m_Running = false;
+    }
+
+    RenderSnapshot* RenderThread::AcquireSnapshot()
+    {
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this] { return !m_FreeSnapshots.empty(); });
+
+        RenderSnapshot* snapshot = m_FreeSnapshots.back();
+        m_FreeSnapshots.pop_back();
+        return snapshot;
+    }
+
+    void RenderThread::Submit(RenderSnapshot* snapshot)
+    {
+        PROFILE_SCOPE("Render Thread Submit");
+
+        std::unique_lock<std::mutex> lock(m_Mutex);
+        m_Condition.wait(lock, [this] { return m_QueuedSnapshot == nullptr || m_StopRequested; });
+
+        if (m_StopRequested)
+        {
+            m_FreeSnapshots.push_back(snapshot);
+            return;
+        }
+
+        m_QueuedSnapshot = snapshot;
+        lock.unlock();
+        m_Condition.notify_all();
+    }
+
+    void RenderThread::p_Run()
+    {
+        glfwMakeContextCurrent(m_Window);
+
+        while (true)
+        {
+            RenderSnapshot* snapshot = nullptr;
+            {
+                std::unique_lock<std::mutex> lock(m_Mutex);
+                m_Condition.wait(lock, [this] { return m_QueuedSnapshot != nullptr || m_StopRequested; });
+
+                if (m_StopRequested)
+                    break;
+
+                snapshot = m_QueuedSnapshot;
+                m_QueuedSnapshot = nullptr;
+            }
+            m_Condition.notify_all(); // Submit() can queue the next frame now
+
+            p_DrawSnapshot(snapshot);
+
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_FreeSnapshots.push_back(snapshot);
+            }
+            m_Condition.notify_all();
+        }
+
+        m_Renderer.Clear();
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    void RenderThread::p_DrawSnapshot(const RenderSnapshot* snapshot)
+    {
+        PROFILE_SCOPE("Render Thread Draw");
+
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        m_Renderer.Draw(*snapshot);
+        glfwSwapBuffers(m_Window);
+    }
+
+}
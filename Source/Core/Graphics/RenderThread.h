@@ -0,0 +1,62 @@
+#ifndef _Render_Thread_H_
+#define _Render_Thread_H_
+
+// Draws RenderSnapshots on a dedicated thread so the next frame can be
+// simulated while the current one is submitted to the GPU.
+// The thread takes ownership of the window's GL context while running.
+// The caller must release the context before Start() and can make it
+// current again after Stop().
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "RenderSnapshot.h"
+#include "SnapshotRenderer.h"
+
+struct GLFWwindow;
+
+namespace QwerkE {
+
+    class RenderThread
+    {
+    public:
+        RenderThread();
+        ~RenderThread();
+
+        void Start(GLFWwindow* window);
+        void Stop();
+
+        bool IsRunning() const { return m_Running; }
+
+        // Returns a snapshot that is free to be written. Blocks if the render
+        // thread is still holding every buffer.
+        RenderSnapshot* AcquireSnapshot();
+
+        // Queues a snapshot from AcquireSnapshot() to be drawn. Blocks while a
+        // previous snapshot is still waiting so the pipeline is never more
+        // than 1 frame deep.
+        void Submit(RenderSnapshot* snapshot);
+
+    private:
+        void p_Run();
+        void p_DrawSnapshot(const RenderSnapshot* snapshot);
+
+        static const int s_SnapshotCount = 3; // Writing, queued and drawing
+        RenderSnapshot m_Snapshots[s_SnapshotCount];
+        std::vector<RenderSnapshot*> m_FreeSnapshots;
+        RenderSnapshot* m_QueuedSnapshot = nullptr;
+
+        std::thread m_Thread;
+        std::mutex m_Mutex;
+        std::condition_variable m_Condition;
+        bool m_Running = false;
+        bool m_StopRequested = false;
+
+        GLFWwindow* m_Window = nullptr;
+        SnapshotRenderer m_Renderer; // Render thread only
+    };
+
+}
+#endif // _Render_Thread_H_
@@ -0,0 +1,98 @@
+#include "SnapshotRenderer.h"
+#include "RenderSnapshot.h"
+
+#include "../QwerkE_Framework/Libraries/glew/GL/glew.h"
+
+#include "../QwerkE_Framework/Source/Core/Graphics/Shader/ShaderProgram.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Material.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Texture.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/Mesh/Mesh.h"
+#include "../Profiler/TraceRecorder.h"
+
+namespace QwerkE {
+
+    // Material schematics only ever use this shine, and the render snapshot
+    // has no per material value to pass yet
+    static const float s_Shine = 0.5f;
+
+    static const eMaterialMaps s_SlotMaps[] = { MatMap_Ambient, MatMap_Diffuse, MatMap_Specular, MatMap_Normal };
+    static const char* const s_SlotUniforms[] = { "u_AmbientTexture", "u_DiffuseTexture", "u_SpecularTexture", "u_NormalTexture" };
+
+    void SnapshotRenderer::Draw(const RenderSnapshot& snapshot)
+    {
+        PROFILE_SCOPE("Snapshot Renderer Draw");
+
+        if (!snapshot.hasCamera)
+            return;
+
+        GLuint currentProgram = 0;
+        for (const RenderItem& item : snapshot.items)
+        {
+            if (item.shader == nullptr || item.mesh == nullptr)
+                continue;
+
+            const GLuint program = item.shader->GetProgram();
+            const UniformLocations& uniforms = GetUniformLocations(program);
+
+            if (program != currentProgram)
+            {
+                glUseProgram(program);
+                currentProgram = program;
+                glUniformMatrix4fv(uniforms.viewMat, 1, GL_FALSE, snapshot.viewMatrix);
+                glUniformMatrix4fv(uniforms.projMat, 1, GL_FALSE, snapshot.projectionMatrix);
+                glUniform3fv(uniforms.camPos, 1, snapshot.cameraPosition);
+                if (snapshot.hasLight)
+                {
+                    glUniform3fv(uniforms.lightPos, 1, snapshot.lightPosition);
+                    glUniform3fv(uniforms.lightColor, 1, snapshot.lightColour);
+                }
+                glUniform1f(uniforms.shine, s_Shine);
+            }
+
+            glUniformMatrix4fv(uniforms.worldMat, 1, GL_FALSE, item.worldMatrix);
+
+            if (item.material)
+            {
+                // One texture unit per slot, so units never change between items
+                for (int slot = 0; slot < TextureSlot_Count; slot++)
+                {
+                    if (uniforms.textures[slot] < 0)
+                        continue;
+
+                    const Texture* texture = item.material->GetMaterialByType(s_SlotMaps[slot]);
+                    if (texture == nullptr)
+                        continue;
+
+                    glActiveTexture(GL_TEXTURE0 + slot);
+                    glBindTexture(GL_TEXTURE_2D, texture->s_Handle);
+                    glUniform1i(uniforms.textures[slot], slot);
+                }
+            }
+
+            item.mesh->Draw();
+        }
+        glUseProgram(0);
+    }
+
+    const SnapshotRenderer::UniformLocations& SnapshotRenderer::GetUniformLocations(unsigned int program)
+    {
+        auto it = m_UniformLocations.find(program);
+        if (it != m_UniformLocations.end())
+            return it->second;
+
+        UniformLocations& uniforms = m_UniformLocations[program];
+        uniforms.worldMat = glGetUniformLocation(program, "u_WorldMat");
+        uniforms.viewMat = glGetUniformLocation(program, "u_ViewMat");
+        uniforms.projMat = glGetUniformLocation(program, "u_ProjMat");
+        uniforms.camPos = glGetUniformLocation(program, "u_CamPos");
+        uniforms.lightPos = glGetUniformLocation(program, "u_LightPos");
+        uniforms.lightColor = glGetUniformLocation(program, "u_LightColor");
+        uniforms.shine = glGetUniformLocation(program, "u_Shine");
+        for (int slot = 0; slot < TextureSlot_Count; slot++)
+        {
+            uniforms.textures[slot] = glGetUniformLocation(program, s_SlotUniforms[slot]);
+        }
+        return uniforms;
+    }
+
+}
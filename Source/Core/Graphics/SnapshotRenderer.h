@@ -0,0 +1,52 @@
+#ifndef _Snapshot_Renderer_H_
+#define _Snapshot_Renderer_H_
+
+// Draws the items of a RenderSnapshot with the GL context of the calling
+// thread, for RenderThread. Sets the uniforms the framework's render
+// routine sets: transforms, camera, the first light, shine and the
+// ambient, diffuse, specular and normal maps of each material. Nothing is
+// drawn for snapshots without a camera.
+
+#include <unordered_map>
+
+namespace QwerkE {
+
+    struct RenderSnapshot;
+
+    class SnapshotRenderer
+    {
+    public:
+        // Leaves the target as it is, so clear it first
+        void Draw(const RenderSnapshot& snapshot);
+
+        // Call when the GL context goes away, as program ids can be reused
+        void Clear() { m_UniformLocations.clear(); }
+
+    private:
+        enum eTextureSlots
+        {
+            TextureSlot_Ambient,
+            TextureSlot_Diffuse,
+            TextureSlot_Specular,
+            TextureSlot_Normal,
+            TextureSlot_Count
+        };
+
+        struct UniformLocations
+        {
+            int worldMat = -1;
+            int viewMat = -1;
+            int projMat = -1;
+            int camPos = -1;
+            int lightPos = -1;
+            int lightColor = -1;
+            int shine = -1;
+            int textures[TextureSlot_Count] = { -1, -1, -1, -1 };
+        };
+        const UniformLocations& GetUniformLocations(unsigned int program);
+
+        std::unordered_map<unsigned int, UniformLocations> m_UniformLocations;
+    };
+
+}
+#endif // _Snapshot_Renderer_H_
@@ -0,0 +1,152 @@
+#include "VertexQuantization.h"
+
+#include <cmath>
+#include <cstring>
+
+namespace QwerkE {
+
+    namespace VertexQuantization
+    {
+        unsigned short FloatToHalf(float value)
+        {
+            unsigned int bits;
+            memcpy(&bits, &value, sizeof(bits));
+
+            const unsigned int sign = (bits >> 16) & 0x8000;
+            const unsigned int magnitude = bits & 0x7fffffff;
+
+            if (magnitude >= 0x7f800000) // Infinity, or NaN kept quiet
+                return (unsigned short)(sign | 0x7c00 | (magnitude > 0x7f800000 ? 0x200 : 0));
+            if (magnitude >= 0x477ff000) // Rounds past 65504
+                return (unsigned short)(sign | 0x7c00);
+
+            if (magnitude < 0x38800000)
+            {
+                // Subnormal halves are multiples of 2^-24
+                float absolute;
+                memcpy(&absolute, &magnitude, sizeof(absolute));
+                return (unsigned short)(sign | (unsigned int)lrintf(absolute * 16777216.0f));
+            }
+
+            // Rebias the exponent from 127 to 15, then round the mantissa to 10 bits, to even on ties
+            const unsigned int rebiased = magnitude - 0x38000000;
+            return (unsigned short)(sign | ((rebiased + 0xfff + ((rebiased >> 13) & 1)) >> 13));
+        }
+
+        float HalfToFloat(unsigned short half)
+        {
+            const unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+            const unsigned int exponent = (half >> 10) & 0x1f;
+            const unsigned int mantissa = half & 0x3ff;
+
+            if (exponent == 0)
+            {
+                const float value = mantissa * (1.0f / 16777216.0f);
+                return sign ? -value : value;
+            }
+
+            const unsigned int bits = exponent == 0x1f ?
+                sign | 0x7f800000 | (mantissa << 13) :
+                sign | ((exponent + 112) << 23) | (mantissa << 13);
+
+            float value;
+            memcpy(&value, &bits, sizeof(value));
+            return value;
+        }
+
+        static short ToSnorm16(float value)
+        {
+            value = value < -1.0f ? -1.0f : (value > 1.0f ? 1.0f : value);
+            return (short)lrintf(value * 32767.0f);
+        }
+
+        static float FromSnorm16(short value)
+        {
+            const float result = value / 32767.0f;
+            return result < -1.0f ? -1.0f : result;
+        }
+
+        void OctEncode(const float direction[3], short encoded[2])
+        {
+            const float length = fabsf(direction[0]) + fabsf(direction[1]) + fabsf(direction[2]);
+            if (length <= 0.0f)
+            {
+                encoded[0] = 0;
+                encoded[1] = 0;
+                return;
+            }
+
+            // Project onto the octahedron, then fold its lower half over the upper one
+            float x = direction[0] / length;
+            float y = direction[1] / length;
+            if (direction[2] < 0.0f)
+            {
+                const float foldedX = (1.0f - fabsf(y)) * (x >= 0.0f ? 1.0f : -1.0f);
+                const float foldedY = (1.0f - fabsf(x)) * (y >= 0.0f ? 1.0f : -1.0f);
+                x = foldedX;
+                y = foldedY;
+            }
+
+            encoded[0] = ToSnorm16(x);
+            encoded[1] = ToSnorm16(y);
+        }
+
+        void OctDecode(const short encoded[2], float direction[3])
+        {
+            float x = FromSnorm16(encoded[0]);
+            float y = FromSnorm16(encoded[1]);
+            const float z = 1.0f - fabsf(x) - fabsf(y);
+
+            // Unfold the lower half
+            const float shift = z < 0.0f ? -z : 0.0f;
+            x += x >= 0.0f ? -shift : shift;
+            y += y >= 0.0f ? -shift : shift;
+
+            const float length = sqrtf(x * x + y * y + z * z);
+            direction[0] = x / length;
+            direction[1] = y / length;
+            direction[2] = z / length;
+        }
+
+        unsigned short QuantizeUnorm16(float value, float min, float max)
+        {
+            if (!(max > min))
+                return 0;
+
+            float normalized = (value - min) / (max - min);
+            normalized = normalized < 0.0f ? 0.0f : (normalized > 1.0f ? 1.0f : normalized);
+            return (unsigned short)lrintf(normalized * 65535.0f);
+        }
+
+        float DequantizeUnorm16(unsigned short value, float min, float max)
+        {
+            return min + (max - min) * (value / 65535.0f);
+        }
+
+        void Pack(const CookedMeshVertex& vertex, const float min[3], const float max[3], CookedMeshPackedVertex& packed)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                packed.position[i] = QuantizeUnorm16(vertex.position[i], min[i], max[i]);
+            }
+            packed.position[3] = 0;
+
+            OctEncode(vertex.normal, packed.normal);
+            packed.uv[0] = FloatToHalf(vertex.uv[0]);
+            packed.uv[1] = FloatToHalf(vertex.uv[1]);
+        }
+
+        void Unpack(const CookedMeshPackedVertex& packed, const float min[3], const float max[3], CookedMeshVertex& vertex)
+        {
+            for (int i = 0; i < 3; i++)
+            {
+                vertex.position[i] = DequantizeUnorm16(packed.position[i], min[i], max[i]);
+            }
+
+            OctDecode(packed.normal, vertex.normal);
+            vertex.uv[0] = HalfToFloat(packed.uv[0]);
+            vertex.uv[1] = HalfToFloat(packed.uv[1]);
+        }
+    }
+
+}
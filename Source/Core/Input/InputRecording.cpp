@@ -0,0 +1,179 @@
+#include "InputRecording.h"
+
+#include "../QwerkE_Framework/Source/Headers/QwerkE_Enums.h"
+#include "../QwerkE_Framework/Source/Core/Input/Input.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <cstring>
+
+namespace QwerkE {
+
+    static const char s_Magic[4] = { 'Q', 'I', 'N', 'P' };
+    static const unsigned short s_Version = 1;
+
+    struct InputLogHeader
+    {
+        char magic[4];
+        unsigned short version;
+        unsigned short reserved;
+    };
+
+    InputRecorder::~InputRecorder()
+    {
+        End();
+    }
+
+    bool InputRecorder::Begin(const char* filePath)
+    {
+        End();
+
+        m_File = fopen(filePath, "wb");
+        if (m_File == nullptr)
+        {
+            LOG_ERROR("InputRecorder: Could not open {0} for writing", filePath);
+            return false;
+        }
+
+        InputLogHeader header;
+        memcpy(header.magic, s_Magic, sizeof(s_Magic));
+        header.version = s_Version;
+        header.reserved = 0;
+        fwrite(&header, sizeof(header), 1, m_File);
+
+        m_FrameCount = 0;
+        LOG_INFO("InputRecorder: Recording input to {0}", filePath);
+        return true;
+    }
+
+    void InputRecorder::End()
+    {
+        if (m_File == nullptr)
+            return;
+
+        fclose(m_File);
+        m_File = nullptr;
+        LOG_INFO("InputRecorder: Recorded {0} frames", m_FrameCount);
+    }
+
+    void InputRecorder::BeginFrame(double deltaTime)
+    {
+        m_FrameDeltaTime = deltaTime;
+    }
+
+    void InputRecorder::RecordInput()
+    {
+        if (m_File == nullptr)
+            return;
+
+        // Most frames have no events, so build the frame on the stack
+        unsigned char events[eKeys::eKeys_MAX * 2][3];
+        unsigned short eventCount = 0;
+
+        for (unsigned short key = 0; key < eKeys::eKeys_MAX; key++)
+        {
+            if (Input::FrameKeyAction((eKeys)key, eKeyState::eKeyState_Press))
+            {
+                memcpy(events[eventCount], &key, sizeof(key));
+                events[eventCount][2] = (unsigned char)eKeyState::eKeyState_Press;
+                eventCount++;
+            }
+            if (Input::FrameKeyAction((eKeys)key, eKeyState::eKeyState_Release))
+            {
+                memcpy(events[eventCount], &key, sizeof(key));
+                events[eventCount][2] = (unsigned char)eKeyState::eKeyState_Release;
+                eventCount++;
+            }
+        }
+
+        fwrite(&m_FrameDeltaTime, sizeof(m_FrameDeltaTime), 1, m_File);
+        fwrite(&eventCount, sizeof(eventCount), 1, m_File);
+        if (eventCount)
+            fwrite(events, sizeof(events[0]), eventCount, m_File);
+
+        m_FrameCount++;
+    }
+
+    InputReplayer::~InputReplayer()
+    {
+        Close();
+    }
+
+    bool InputReplayer::Open(const char* filePath)
+    {
+        Close();
+
+        m_File = fopen(filePath, "rb");
+        if (m_File == nullptr)
+        {
+            LOG_ERROR("InputReplayer: Could not open {0}", filePath);
+            return false;
+        }
+
+        InputLogHeader header;
+        if (fread(&header, sizeof(header), 1, m_File) != 1 ||
+            memcmp(header.magic, s_Magic, sizeof(s_Magic)) != 0 ||
+            header.version != s_Version)
+        {
+            LOG_ERROR("InputReplayer: {0} is not a version {1} input log", filePath, s_Version);
+            Close();
+            return false;
+        }
+
+        m_FrameCount = 0;
+        LOG_INFO("InputReplayer: Replaying input from {0}", filePath);
+        return true;
+    }
+
+    void InputReplayer::Close()
+    {
+        if (m_File == nullptr)
+            return;
+
+        fclose(m_File);
+        m_File = nullptr;
+        m_FrameEvents.clear();
+        LOG_INFO("InputReplayer: Replayed {0} frames", m_FrameCount);
+    }
+
+    bool InputReplayer::BeginFrame(double& deltaTime)
+    {
+        m_FrameEvents.clear();
+
+        if (m_File == nullptr)
+            return false;
+
+        unsigned short eventCount = 0;
+        if (fread(&deltaTime, sizeof(deltaTime), 1, m_File) != 1 ||
+            fread(&eventCount, sizeof(eventCount), 1, m_File) != 1)
+        {
+            return false;
+        }
+
+        for (unsigned short i = 0; i < eventCount; i++)
+        {
+            unsigned char event[3];
+            if (fread(event, sizeof(event), 1, m_File) != 1)
+            {
+                LOG_ERROR("InputReplayer: Log ends in the middle of frame {0}", m_FrameCount);
+                return false;
+            }
+
+            KeyEvent keyEvent;
+            memcpy(&keyEvent.key, event, sizeof(keyEvent.key));
+            keyEvent.state = event[2];
+            m_FrameEvents.push_back(keyEvent);
+        }
+
+        m_FrameCount++;
+        return true;
+    }
+
+    void InputReplayer::InjectInput()
+    {
+        for (const KeyEvent& keyEvent : m_FrameEvents)
+        {
+            Input::ProcessKeyEvent((eKeys)keyEvent.key, (eKeyState)keyEvent.state);
+        }
+    }
+
+}
@@ -0,0 +1,67 @@
+#ifndef _Input_Recording_H_
+#define _Input_Recording_H_
+
+// Records per frame key events and frame times to a binary log, and plays
+// them back so the same scene sees the exact same input and time steps.
+// The engine detaches the window's input callbacks while replaying, so
+// live keys and mouse movement can't mix with the recording.
+//
+// File layout, little endian:
+//   Header { char magic[4] = "QINP", u16 version, u16 reserved }
+//   Frame  { f64 deltaTime, u16 eventCount, Event events[eventCount] }
+//   Event  { u16 key, u8 state }
+
+#include <cstdio>
+#include <vector>
+
+namespace QwerkE {
+
+    class InputRecorder
+    {
+    public:
+        ~InputRecorder();
+
+        bool Begin(const char* filePath);
+        void End();
+        bool IsRecording() const { return m_File != nullptr; }
+
+        void BeginFrame(double deltaTime);
+
+        // Samples Input for this frame's key presses and releases. Call after input is polled.
+        void RecordInput();
+
+    private:
+        FILE* m_File = nullptr;
+        double m_FrameDeltaTime = 0.0;
+        unsigned long long m_FrameCount = 0;
+    };
+
+    class InputReplayer
+    {
+    public:
+        ~InputReplayer();
+
+        bool Open(const char* filePath);
+        void Close();
+        bool IsReplaying() const { return m_File != nullptr; }
+
+        // Reads the next frame's delta time and events. Returns false at the end of the log.
+        bool BeginFrame(double& deltaTime);
+
+        // Feeds this frame's events to Input. Call after input is polled.
+        void InjectInput();
+
+    private:
+        struct KeyEvent
+        {
+            unsigned short key;
+            unsigned char state;
+        };
+
+        FILE* m_File = nullptr;
+        std::vector<KeyEvent> m_FrameEvents;
+        unsigned long long m_FrameCount = 0;
+    };
+
+}
+#endif // _Input_Recording_H_
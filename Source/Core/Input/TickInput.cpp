@@ -0,0 +1,51 @@
+#include "TickInput.h"
+
+#include "../QwerkE_Framework/Source/Headers/QwerkE_Enums.h"
+#include "../QwerkE_Framework/Source/Core/Input/Input.h"
+
+namespace QwerkE {
+
+    void TickInput::LatchFrameInput()
+    {
+        m_FrameEvents.clear();
+        m_Ticked = false;
+
+        for (unsigned short key = 0; key < eKeys::eKeys_MAX; key++)
+        {
+            // Same order as InputRecorder, so replays latch the same way
+            if (Input::FrameKeyAction((eKeys)key, eKeyState::eKeyState_Press))
+                m_FrameEvents.push_back({ key, (unsigned char)eKeyState::eKeyState_Press });
+            if (Input::FrameKeyAction((eKeys)key, eKeyState::eKeyState_Release))
+                m_FrameEvents.push_back({ key, (unsigned char)eKeyState::eKeyState_Release });
+        }
+
+        m_PendingEvents.insert(m_PendingEvents.end(), m_FrameEvents.begin(), m_FrameEvents.end());
+    }
+
+    void TickInput::BeginTick()
+    {
+        Input::NewFrame(); // Drops the edges the last tick saw
+        Inject(m_PendingEvents);
+        m_PendingEvents.clear();
+        m_Ticked = true;
+    }
+
+    void TickInput::EndFrame()
+    {
+        if (!m_Ticked)
+            return;
+
+        Input::NewFrame();
+        Inject(m_FrameEvents);
+        m_Ticked = false;
+    }
+
+    void TickInput::Inject(const std::vector<KeyEvent>& events)
+    {
+        for (const KeyEvent& event : events)
+        {
+            Input::ProcessKeyEvent((eKeys)event.key, (eKeyState)event.state);
+        }
+    }
+
+}
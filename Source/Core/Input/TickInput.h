@@ -0,0 +1,45 @@
+#ifndef _Tick_Input_H_
+#define _Tick_Input_H_
+
+// Input is polled once a frame, but the fixed timestep simulation runs 0
+// to N ticks a frame. Key presses and releases are latched here until a
+// tick consumes them, so Input::FrameKeyAction() reports each to exactly 1
+// tick. Frames without a tick carry them to the next frame's first tick,
+// and later ticks of a frame see none.
+//
+// Only frame edges are latched. Held keys are left to the framework.
+
+#include <vector>
+
+namespace QwerkE {
+
+    class TickInput
+    {
+    public:
+        // Samples this frame's presses and releases. Call after input is
+        // polled, before the frame's ticks.
+        void LatchFrameInput();
+
+        // Gives Input the edges no tick has seen yet, and clears them
+        void BeginTick();
+
+        // Gives Input this frame's edges back for code that runs once a
+        // frame, if a tick cleared them
+        void EndFrame();
+
+    private:
+        struct KeyEvent
+        {
+            unsigned short key;
+            unsigned char state;
+        };
+
+        static void Inject(const std::vector<KeyEvent>& events);
+
+        std::vector<KeyEvent> m_FrameEvents;
+        std::vector<KeyEvent> m_PendingEvents; // Latched, not seen by a tick yet
+        bool m_Ticked = false; // A tick replaced Input's frame edges
+    };
+
+}
+#endif // _Tick_Input_H_
@@ -0,0 +1,179 @@
+#include "FrameGraph.h"
+#include "TaskScheduler.h"
+
+#include "../Profiler/TraceRecorder.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <string>
+#include <thread>
+
+namespace QwerkE {
+
+    FrameGraph::NodeId FrameGraph::AddNode(const char* name, NodeFunction function, eFrameGraphThread thread)
+    {
+        Node node;
+        node.name = name;
+        node.function = function;
+        node.thread = thread;
+        m_Nodes.push_back(node);
+        m_Compiled = false;
+        return (NodeId)(m_Nodes.size() - 1);
+    }
+
+    void FrameGraph::AddDependency(NodeId node, NodeId dependency)
+    {
+        m_Nodes[dependency].dependents.push_back(node);
+        m_Nodes[node].dependencies.push_back(dependency);
+        m_Compiled = false;
+    }
+
+    bool FrameGraph::Compile()
+    {
+        const size_t count = m_Nodes.size();
+
+        // Kahn's algorithm
+        std::vector<unsigned short> remaining(count);
+        m_Order.clear();
+        for (NodeId i = 0; i < count; i++)
+        {
+            remaining[i] = (unsigned short)m_Nodes[i].dependencies.size();
+            if (remaining[i] == 0)
+                m_Order.push_back(i);
+        }
+
+        for (size_t i = 0; i < m_Order.size(); i++)
+        {
+            for (NodeId dependent : m_Nodes[m_Order[i]].dependents)
+            {
+                if (--remaining[dependent] == 0)
+                    m_Order.push_back(dependent);
+            }
+        }
+
+        if (m_Order.size() != count)
+        {
+            LOG_ERROR("FrameGraph: Dependency cycle found. {0} of {1} nodes could not be ordered.", count - m_Order.size(), count);
+            return false;
+        }
+
+        m_Tasks.resize(count);
+        for (NodeId i = 0; i < count; i++)
+        {
+            m_Tasks[i].graph = this;
+            m_Tasks[i].node = i;
+        }
+        m_RemainingDependencies.reset(new std::atomic<unsigned short>[count]);
+        m_MainThreadQueue.reserve(count);
+
+        m_Compiled = true;
+        return true;
+    }
+
+    void FrameGraph::Execute(TaskScheduler* scheduler)
+    {
+        PROFILE_SCOPE("Frame Graph");
+
+        if (!m_Compiled && !Compile())
+            return;
+
+        if (scheduler == nullptr || scheduler->WorkerCount() == 0)
+        {
+            for (NodeId node : m_Order)
+            {
+                PROFILE_SCOPE(m_Nodes[node].name);
+                m_Nodes[node].function();
+            }
+            return;
+        }
+
+        m_Scheduler = scheduler;
+        m_CompletedCount = 0;
+        for (NodeId i = 0; i < m_Nodes.size(); i++)
+        {
+            m_RemainingDependencies[i] = (unsigned short)m_Nodes[i].dependencies.size();
+        }
+
+        for (NodeId i = 0; i < m_Nodes.size(); i++)
+        {
+            if (m_Nodes[i].dependencies.empty())
+                p_Dispatch(i);
+        }
+
+        // Run main thread nodes as they become ready and help with the rest
+        while (m_CompletedCount < m_Nodes.size())
+        {
+            NodeId mainThreadNode = 0;
+            bool hasMainThreadNode = false;
+            {
+                std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+                if (!m_MainThreadQueue.empty())
+                {
+                    mainThreadNode = m_MainThreadQueue.back();
+                    m_MainThreadQueue.pop_back();
+                    hasMainThreadNode = true;
+                }
+            }
+
+            if (hasMainThreadNode)
+                p_RunNode(mainThreadNode);
+            else if (!scheduler->RunPendingTask())
+                std::this_thread::yield();
+        }
+
+        m_Scheduler = nullptr;
+    }
+
+    void FrameGraph::LogGraph() const
+    {
+        LOG_INFO("FrameGraph: {0} nodes", m_Nodes.size());
+        for (NodeId i = 0; i < m_Nodes.size(); i++)
+        {
+            std::string dependencies;
+            for (NodeId dependency : m_Nodes[i].dependencies)
+            {
+                if (!dependencies.empty())
+                    dependencies += ", ";
+                dependencies += m_Nodes[dependency].name;
+            }
+            LOG_INFO("  {0}{1} <- [{2}]", m_Nodes[i].name,
+                m_Nodes[i].thread == FrameGraphThread_Main ? " (main thread)" : "", dependencies.c_str());
+        }
+    }
+
+    void FrameGraph::p_RunNodeTask(void* data)
+    {
+        NodeTask* task = (NodeTask*)data;
+        task->graph->p_RunNode(task->node);
+    }
+
+    void FrameGraph::p_RunNode(NodeId node)
+    {
+        {
+            PROFILE_SCOPE(m_Nodes[node].name);
+            m_Nodes[node].function();
+        }
+
+        for (NodeId dependent : m_Nodes[node].dependents)
+        {
+            if (--m_RemainingDependencies[dependent] == 0)
+                p_Dispatch(dependent);
+        }
+
+        // Last, so Execute() can't return while dependents are being dispatched
+        m_CompletedCount++;
+    }
+
+    void FrameGraph::p_Dispatch(NodeId node)
+    {
+        if (m_Nodes[node].thread == FrameGraphThread_Main)
+        {
+            std::lock_guard<std::mutex> lock(m_MainThreadMutex);
+            m_MainThreadQueue.push_back(node);
+        }
+        else
+        {
+            m_Scheduler->Schedule(&FrameGraph::p_RunNodeTask, &m_Tasks[node]);
+        }
+    }
+
+}
@@ -0,0 +1,84 @@
+#ifndef _Frame_Graph_H_
+#define _Frame_Graph_H_
+
+// Describes a frame's work as named nodes with explicit dependencies.
+// Nodes whose dependencies are done run as soon as possible, in parallel
+// on a TaskScheduler when one is given. Nodes that touch the window,
+// input or UI libraries must run on the thread calling Execute().
+// Every node runs inside a PROFILE_SCOPE of its own name so overlap
+// between systems shows up in profiler captures.
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace QwerkE {
+
+    class TaskScheduler;
+
+    enum eFrameGraphThread : unsigned char
+    {
+        FrameGraphThread_Any = 0,
+        FrameGraphThread_Main
+    };
+
+    class FrameGraph
+    {
+    public:
+        typedef unsigned short NodeId;
+        typedef std::function<void()> NodeFunction;
+
+        NodeId AddNode(const char* name, NodeFunction function, eFrameGraphThread thread = FrameGraphThread_Any);
+
+        // node will not start until dependency has finished
+        void AddDependency(NodeId node, NodeId dependency);
+
+        // Orders nodes and prepares counters. Returns false if dependencies form a cycle.
+        bool Compile();
+
+        // Runs every node once. Without a scheduler nodes run in order on the calling thread.
+        void Execute(TaskScheduler* scheduler);
+
+        // Writes nodes and their dependencies to the log
+        void LogGraph() const;
+
+        unsigned short NodeCount() const { return (unsigned short)m_Nodes.size(); }
+        const char* NodeName(NodeId node) const { return m_Nodes[node].name; }
+
+    private:
+        struct Node
+        {
+            const char* name;
+            NodeFunction function;
+            eFrameGraphThread thread;
+            std::vector<NodeId> dependents;
+            std::vector<NodeId> dependencies;
+        };
+
+        struct NodeTask
+        {
+            FrameGraph* graph;
+            NodeId node;
+        };
+
+        static void p_RunNodeTask(void* data);
+        void p_RunNode(NodeId node);
+        void p_Dispatch(NodeId node);
+
+        std::vector<Node> m_Nodes;
+        std::vector<NodeId> m_Order; // Topological order from Compile()
+        std::vector<NodeTask> m_Tasks;
+        std::unique_ptr<std::atomic<unsigned short>[]> m_RemainingDependencies;
+        bool m_Compiled = false;
+
+        // Per Execute() state
+        TaskScheduler* m_Scheduler = nullptr;
+        std::atomic<unsigned short> m_CompletedCount;
+        std::mutex m_MainThreadMutex;
+        std::vector<NodeId> m_MainThreadQueue;
+    };
+
+}
+#endif // _Frame_Graph_H_
@@ -0,0 +1,170 @@
+#include "TaskScheduler.h"
+
+namespace QwerkE {
+
+    // Queue owned by the current thread, or the shared queue for non workers
+    static thread_local const TaskScheduler* t_Owner = nullptr;
+    static thread_local unsigned int t_QueueIndex = 0;
+
+    TaskScheduler::TaskScheduler(unsigned int workerCount)
+        : m_BackgroundQueuedCount(0), m_BackgroundRunningCount(0), m_Running(true), m_QueuedTaskCount(0)
+    {
+        m_SharedQueueIndex = workerCount;
+        m_MaxBackgroundRunning = workerCount > 1 ? workerCount - 1 : 1;
+        m_Queues.reset(new TaskQueue[workerCount + 1]);
+
+        m_Workers.reserve(workerCount);
+        for (unsigned int i = 0; i < workerCount; i++)
+        {
+            m_Workers.push_back(std::thread(&TaskScheduler::p_WorkerLoop, this, i));
+        }
+    }
+
+    TaskScheduler::~TaskScheduler()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_Running = false;
+        }
+        m_SleepCondition.notify_all();
+
+        for (std::thread& worker : m_Workers)
+        {
+            worker.join();
+        }
+    }
+
+    void TaskScheduler::Schedule(TaskFunction function, void* data)
+    {
+        const unsigned int queueIndex = t_Owner == this ? t_QueueIndex : m_SharedQueueIndex;
+
+        {
+            // Count before publishing, or a thief could pop the task and
+            // decrement first, wrapping the count. Lock so a worker can't
+            // miss the wake up between checking the count and sleeping.
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_QueuedTaskCount++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_Queues[queueIndex].mutex);
+            m_Queues[queueIndex].tasks.push_back({ function, data });
+        }
+        m_SleepCondition.notify_one();
+    }
+
+    void TaskScheduler::ScheduleBackground(TaskFunction function, void* data)
+    {
+        {
+            // Counted first for the same reasons as in Schedule()
+            std::lock_guard<std::mutex> lock(m_SleepMutex);
+            m_BackgroundQueuedCount++;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_BackgroundQueue.mutex);
+            m_BackgroundQueue.tasks.push_back({ function, data });
+        }
+        m_SleepCondition.notify_one();
+    }
+
+    bool TaskScheduler::RunPendingTask()
+    {
+        const unsigned int queueIndex = t_Owner == this ? t_QueueIndex : m_SharedQueueIndex;
+
+        Task task;
+        if (!p_PopOrSteal(queueIndex, task))
+            return false;
+
+        task.function(task.data);
+        return true;
+    }
+
+    void TaskScheduler::p_WorkerLoop(unsigned int queueIndex)
+    {
+        t_Owner = this;
+        t_QueueIndex = queueIndex;
+
+        while (true)
+        {
+            Task task;
+            if (p_PopOrSteal(queueIndex, task))
+            {
+                task.function(task.data);
+                continue;
+            }
+
+            if (p_PopBackground(task))
+            {
+                task.function(task.data);
+                {
+                    // Another background task may have been waiting for the slot
+                    std::lock_guard<std::mutex> lock(m_SleepMutex);
+                    m_BackgroundRunningCount--;
+                }
+                m_SleepCondition.notify_one();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(m_SleepMutex);
+            m_SleepCondition.wait(lock, [this] { return p_HasWork() || !m_Running; });
+
+            if (!m_Running)
+                break;
+        }
+
+        t_Owner = nullptr;
+    }
+
+    bool TaskScheduler::p_PopOrSteal(unsigned int queueIndex, Task& task)
+    {
+        // Newest task from our own queue is the most likely to be in cache
+        {
+            TaskQueue& own = m_Queues[queueIndex];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (!own.tasks.empty())
+            {
+                task = own.tasks.back();
+                own.tasks.pop_back();
+                m_QueuedTaskCount--;
+                return true;
+            }
+        }
+
+        // Oldest task from anyone else, starting with our neighbour to spread contention
+        const unsigned int queueCount = m_SharedQueueIndex + 1;
+        for (unsigned int i = 1; i < queueCount; i++)
+        {
+            TaskQueue& victim = m_Queues[(queueIndex + i) % queueCount];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty())
+            {
+                task = victim.tasks.front();
+                victim.tasks.pop_front();
+                m_QueuedTaskCount--;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool TaskScheduler::p_PopBackground(Task& task)
+    {
+        std::lock_guard<std::mutex> lock(m_BackgroundQueue.mutex);
+        if (m_BackgroundQueue.tasks.empty() || m_BackgroundRunningCount >= m_MaxBackgroundRunning)
+            return false;
+
+        task = m_BackgroundQueue.tasks.front();
+        m_BackgroundQueue.tasks.pop_front();
+        m_BackgroundQueuedCount--;
+        m_BackgroundRunningCount++;
+        return true;
+    }
+
+    bool TaskScheduler::p_HasWork() const
+    {
+        return m_QueuedTaskCount > 0 || (m_BackgroundQueuedCount > 0 && m_BackgroundRunningCount < m_MaxBackgroundRunning);
+    }
+
+}
@@ -0,0 +1,78 @@
+#ifndef _Task_Scheduler_H_
+#define _Task_Scheduler_H_
+
+// Small work stealing thread pool for short lived engine tasks.
+// Every worker owns a queue. Workers push and pop from the back of their
+// own queue and steal from the front of other queues when they run dry.
+// Tasks scheduled from outside the pool go to a shared queue that
+// everyone steals from. Threads that wait on task results should call
+// RunPendingTask() to help out instead of blocking.
+//
+// Long running work, like loading a file, goes through
+// ScheduleBackground() instead. Only idle workers run background tasks,
+// and RunPendingTask() never does, so a thread waiting on short tasks
+// can't get stuck in one. With more than 1 worker, 1 is always left for
+// other tasks.
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace QwerkE {
+
+    class TaskScheduler
+    {
+    public:
+        typedef void (*TaskFunction)(void* data);
+
+        TaskScheduler(unsigned int workerCount);
+        ~TaskScheduler();
+
+        void Schedule(TaskFunction function, void* data);
+        void ScheduleBackground(TaskFunction function, void* data);
+
+        // Runs 1 queued task on the calling thread. Returns false if no task was found.
+        bool RunPendingTask();
+
+        unsigned int WorkerCount() const { return (unsigned int)m_Workers.size(); }
+
+    private:
+        struct Task
+        {
+            TaskFunction function;
+            void* data;
+        };
+
+        struct TaskQueue
+        {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        void p_WorkerLoop(unsigned int queueIndex);
+        bool p_PopOrSteal(unsigned int queueIndex, Task& task);
+        bool p_PopBackground(Task& task);
+        bool p_HasWork() const;
+
+        std::vector<std::thread> m_Workers;
+        std::unique_ptr<TaskQueue[]> m_Queues; // 1 per worker, then the shared queue
+        unsigned int m_SharedQueueIndex = 0;
+
+        TaskQueue m_BackgroundQueue;
+        std::atomic<unsigned int> m_BackgroundQueuedCount;
+        std::atomic<unsigned int> m_BackgroundRunningCount;
+        unsigned int m_MaxBackgroundRunning = 1;
+
+        std::atomic<bool> m_Running;
+        std::atomic<unsigned int> m_QueuedTaskCount;
+
+        std::mutex m_SleepMutex;
+        std::condition_variable m_SleepCondition;
+    };
+
+}
+#endif // _Task_Scheduler_H_
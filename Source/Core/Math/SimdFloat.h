@@ -0,0 +1,136 @@
+#ifndef _Simd_Float_H_
+#define _Simd_Float_H_
+
+// A float vector as wide as the target allows, for writing a batch kernel
+// once and building it for AVX (8 lanes), SSE2 (4 lanes) or plain floats
+// (1 lane). The widest instruction set enabled at compile time is used.
+// Define SimdForceScalar to build the scalar path on any target.
+
+#include <cmath>
+
+#if !defined(SimdForceScalar)
+#if defined(__AVX__)
+#define SimdAvxEnabled 1
+#define SimdSseEnabled 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define SimdSseEnabled 1
+#endif
+#endif
+
+#if defined(SimdSseEnabled)
+#include <immintrin.h>
+#endif
+
+namespace QwerkE {
+
+    namespace Simd
+    {
+#if defined(SimdAvxEnabled)
+        typedef __m256 Float;
+        static const int Width = 8;
+        inline const char* Name() { return "AVX"; }
+
+        inline Float Load(const float* p) { return _mm256_loadu_ps(p); }
+        inline void Store(float* p, Float a) { _mm256_storeu_ps(p, a); }
+        inline Float Set(float a) { return _mm256_set1_ps(a); }
+        inline Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+        inline Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+        inline Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+        inline Float Round(Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+        inline Float Floor(Float a) { return _mm256_floor_ps(a); }
+        inline Float Equal(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+        inline Float Or(Float a, Float b) { return _mm256_or_ps(a, b); }
+        inline Float Less(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+        inline Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+        // 1 bit per lane, set where the mask is
+        inline int MaskBits(Float mask) { return _mm256_movemask_ps(mask); }
+        // mask ? a : b
+        inline Float Select(Float mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+#elif defined(SimdSseEnabled)
+        typedef __m128 Float;
+        static const int Width = 4;
+        inline const char* Name() { return "SSE2"; }
+
+        inline Float Load(const float* p) { return _mm_loadu_ps(p); }
+        inline void Store(float* p, Float a) { _mm_storeu_ps(p, a); }
+        inline Float Set(float a) { return _mm_set1_ps(a); }
+        inline Float Add(Float a, Float b) { return _mm_add_ps(a, b); }
+        inline Float Sub(Float a, Float b) { return _mm_sub_ps(a, b); }
+        inline Float Mul(Float a, Float b) { return _mm_mul_ps(a, b); }
+        // Both assume |a| < 2^31, which holds for reduced angles
+        inline Float Round(Float a) { return _mm_cvtepi32_ps(_mm_cvtps_epi32(a)); }
+        inline Float Floor(Float a)
+        {
+            const Float truncated = _mm_cvtepi32_ps(_mm_cvttps_epi32(a));
+            return _mm_sub_ps(truncated, _mm_and_ps(_mm_cmpgt_ps(truncated, a), _mm_set1_ps(1.0f)));
+        }
+        inline Float Equal(Float a, Float b) { return _mm_cmpeq_ps(a, b); }
+        inline Float Or(Float a, Float b) { return _mm_or_ps(a, b); }
+        inline Float Less(Float a, Float b) { return _mm_cmplt_ps(a, b); }
+        inline Float Abs(Float a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+        inline int MaskBits(Float mask) { return _mm_movemask_ps(mask); }
+        inline Float Select(Float mask, Float a, Float b) { return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b)); }
+#else
+        typedef float Float;
+        static const int Width = 1;
+        inline const char* Name() { return "Scalar"; }
+
+        inline Float Load(const float* p) { return *p; }
+        inline void Store(float* p, Float a) { *p = a; }
+        inline Float Set(float a) { return a; }
+        inline Float Add(Float a, Float b) { return a + b; }
+        inline Float Sub(Float a, Float b) { return a - b; }
+        inline Float Mul(Float a, Float b) { return a * b; }
+        inline Float Round(Float a) { return std::nearbyint(a); }
+        inline Float Floor(Float a) { return std::floor(a); }
+        // Masks are 1 or 0
+        inline Float Equal(Float a, Float b) { return a == b ? 1.0f : 0.0f; }
+        inline Float Or(Float a, Float b) { return (a != 0.0f || b != 0.0f) ? 1.0f : 0.0f; }
+        inline Float Less(Float a, Float b) { return a < b ? 1.0f : 0.0f; }
+        inline Float Abs(Float a) { return std::fabs(a); }
+        inline int MaskBits(Float mask) { return mask != 0.0f ? 1 : 0; }
+        inline Float Select(Float mask, Float a, Float b) { return mask != 0.0f ? a : b; }
+#endif
+
+        inline Float MulAdd(Float a, Float b, Float c) { return Add(Mul(a, b), c); }
+
+        // Sine and cosine of radians. Accurate to a few float ulps for
+        // angles within +-10^5 radians.
+        inline void SinCos(Float x, Float& outSin, Float& outCos)
+        {
+            // Reduce to r in [-pi/4, pi/4] and a quadrant, x = r + quadrant * pi/2.
+            // pi/2 is split in 3 so q * pi/2 is exact enough for large q.
+            const Float q = Round(Mul(x, Set(0.636619772367581f)));
+            Float r = Sub(x, Mul(q, Set(1.5703125f)));
+            r = Sub(r, Mul(q, Set(4.837512969970703125e-4f)));
+            r = Sub(r, Mul(q, Set(7.54978995489188216e-8f)));
+
+            const Float r2 = Mul(r, r);
+
+            // Minimax polynomials from Cephes
+            Float s = MulAdd(r2, Set(-1.9515295891e-4f), Set(8.3321608736e-3f));
+            s = MulAdd(s, r2, Set(-1.6666654611e-1f));
+            s = MulAdd(Mul(s, r2), r, r);
+
+            Float c = MulAdd(r2, Set(2.443315711809948e-5f), Set(-1.388731625493765e-3f));
+            c = MulAdd(c, r2, Set(4.166664568298827e-2f));
+            c = MulAdd(Mul(c, r2), r2, Sub(Set(1.0f), Mul(r2, Set(0.5f))));
+
+            // quadrant mod 4
+            const Float quadrant = Sub(q, Mul(Floor(Mul(q, Set(0.25f))), Set(4.0f)));
+            const Float is1 = Equal(quadrant, Set(1.0f));
+            const Float is2 = Equal(quadrant, Set(2.0f));
+            const Float is3 = Equal(quadrant, Set(3.0f));
+
+            const Float swap = Or(is1, is3);
+            const Float sine = Select(swap, c, s);
+            const Float cosine = Select(swap, s, c);
+
+            const Float zero = Set(0.0f);
+            outSin = Select(Or(is2, is3), Sub(zero, sine), sine);
+            outCos = Select(Or(is1, is2), Sub(zero, cosine), cosine);
+        }
+    }
+
+}
+#endif // _Simd_Float_H_
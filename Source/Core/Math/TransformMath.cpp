@@ -0,0 +1,365 @@
+#include "TransformMath.h"
+#include "SimdFloat.h"
+
+#include <cmath>
+
+namespace QwerkE {
+
+    namespace TransformMath
+    {
+        static const float s_DegreesToRadians = 3.14159265358979f / 180.0f;
+
+        const char* SimdName()
+        {
+            return Simd::Name();
+        }
+
+        void Identity(float out[16])
+        {
+            for (int i = 0; i < 16; i++)
+                out[i] = 0.0f;
+            out[0] = out[5] = out[10] = out[15] = 1.0f;
+        }
+
+        void ComposeSRT(const float position[3], const float rotation[3], const float scale[3], float out[16])
+        {
+            const float sx = std::sin(rotation[0] * s_DegreesToRadians), cx = std::cos(rotation[0] * s_DegreesToRadians);
+            const float sy = std::sin(rotation[1] * s_DegreesToRadians), cy = std::cos(rotation[1] * s_DegreesToRadians);
+            const float sz = std::sin(rotation[2] * s_DegreesToRadians), cz = std::cos(rotation[2] * s_DegreesToRadians);
+
+            // R = Rz * Ry * Rx
+            const float r00 = cz * cy, r01 = cz * sy * sx - sz * cx, r02 = cz * sy * cx + sz * sx;
+            const float r10 = sz * cy, r11 = sz * sy * sx + cz * cx, r12 = sz * sy * cx - cz * sx;
+            const float r20 = -sy,     r21 = cy * sx,                r22 = cy * cx;
+
+            // Columns are the scaled basis vectors
+            out[0] = r00 * scale[0]; out[1] = r10 * scale[0]; out[2] = r20 * scale[0]; out[3] = 0.0f;
+            out[4] = r01 * scale[1]; out[5] = r11 * scale[1]; out[6] = r21 * scale[1]; out[7] = 0.0f;
+            out[8] = r02 * scale[2]; out[9] = r12 * scale[2]; out[10] = r22 * scale[2]; out[11] = 0.0f;
+            out[12] = position[0]; out[13] = position[1]; out[14] = position[2]; out[15] = 1.0f;
+        }
+
+        void DecomposeSRT(const float m[16], float position[3], float rotation[3], float scale[3])
+        {
+            position[0] = m[12];
+            position[1] = m[13];
+            position[2] = m[14];
+
+            for (int axis = 0; axis < 3; axis++)
+            {
+                const float* column = m + axis * 4;
+                scale[axis] = std::sqrt(column[0] * column[0] + column[1] * column[1] + column[2] * column[2]);
+            }
+
+            // Same terms as ComposeSRT, with the scale taken out
+            const float r00 = scale[0] > 0.0f ? m[0] / scale[0] : 1.0f;
+            const float r10 = scale[0] > 0.0f ? m[1] / scale[0] : 0.0f;
+            const float r20 = scale[0] > 0.0f ? m[2] / scale[0] : 0.0f;
+            const float r11 = scale[1] > 0.0f ? m[5] / scale[1] : 1.0f;
+            const float r21 = scale[1] > 0.0f ? m[6] / scale[1] : 0.0f;
+            const float r12 = scale[2] > 0.0f ? m[9] / scale[2] : 0.0f;
+            const float r22 = scale[2] > 0.0f ? m[10] / scale[2] : 1.0f;
+
+            const float sy = std::fmax(-1.0f, std::fmin(1.0f, -r20));
+            rotation[1] = std::asin(sy) / s_DegreesToRadians;
+            if (std::fabs(sy) < 0.9999f)
+            {
+                rotation[0] = std::atan2(r21, r22) / s_DegreesToRadians;
+                rotation[2] = std::atan2(r10, r00) / s_DegreesToRadians;
+            }
+            else
+            {
+                // Gimbal lock. Only X + Z is known, so Z takes 0.
+                rotation[0] = std::atan2(-r12, r11) / s_DegreesToRadians;
+                rotation[2] = 0.0f;
+            }
+        }
+
+        void InvertAffine(const float m[16], float out[16])
+        {
+            // Inverse of the upper 3x3 from its cofactors
+            const float c00 = m[5] * m[10] - m[9] * m[6];
+            const float c01 = m[9] * m[2] - m[1] * m[10];
+            const float c02 = m[1] * m[6] - m[5] * m[2];
+            const float det = m[0] * c00 + m[4] * c01 + m[8] * c02;
+            const float invDet = det != 0.0f ? 1.0f / det : 0.0f;
+
+            out[0] = c00 * invDet;
+            out[1] = c01 * invDet;
+            out[2] = c02 * invDet;
+            out[4] = (m[8] * m[6] - m[4] * m[10]) * invDet;
+            out[5] = (m[0] * m[10] - m[8] * m[2]) * invDet;
+            out[6] = (m[4] * m[2] - m[0] * m[6]) * invDet;
+            out[8] = (m[4] * m[9] - m[8] * m[5]) * invDet;
+            out[9] = (m[8] * m[1] - m[0] * m[9]) * invDet;
+            out[10] = (m[0] * m[5] - m[4] * m[1]) * invDet;
+            out[3] = out[7] = out[11] = 0.0f;
+
+            // Translation is -inverse(3x3) * t
+            for (int row = 0; row < 3; row++)
+            {
+                out[12 + row] = -(out[row] * m[12] + out[4 + row] * m[13] + out[8 + row] * m[14]);
+            }
+            out[15] = 1.0f;
+        }
+
+        void ComposeSRTBatch(const TransformArrays& transforms, size_t count, float* outMatrices)
+        {
+            const Simd::Float toRadians = Simd::Set(s_DegreesToRadians);
+
+            // Rotation and scale of each lane, 9 values per matrix
+            float basis[9][Simd::Width];
+
+            size_t i = 0;
+            for (; i + Simd::Width <= count; i += Simd::Width)
+            {
+                Simd::Float sx, cx, sy, cy, sz, cz;
+                Simd::SinCos(Simd::Mul(Simd::Load(transforms.rotationX + i), toRadians), sx, cx);
+                Simd::SinCos(Simd::Mul(Simd::Load(transforms.rotationY + i), toRadians), sy, cy);
+                Simd::SinCos(Simd::Mul(Simd::Load(transforms.rotationZ + i), toRadians), sz, cz);
+
+                const Simd::Float scaleX = Simd::Load(transforms.scaleX + i);
+                const Simd::Float scaleY = Simd::Load(transforms.scaleY + i);
+                const Simd::Float scaleZ = Simd::Load(transforms.scaleZ + i);
+
+                // Same terms as ComposeSRT
+                const Simd::Float sysx = Simd::Mul(sy, sx);
+                const Simd::Float sycx = Simd::Mul(sy, cx);
+                Simd::Store(basis[0], Simd::Mul(Simd::Mul(cz, cy), scaleX));
+                Simd::Store(basis[1], Simd::Mul(Simd::Mul(sz, cy), scaleX));
+                Simd::Store(basis[2], Simd::Mul(Simd::Sub(Simd::Set(0.0f), sy), scaleX));
+                Simd::Store(basis[3], Simd::Mul(Simd::Sub(Simd::Mul(cz, sysx), Simd::Mul(sz, cx)), scaleY));
+                Simd::Store(basis[4], Simd::Mul(Simd::Add(Simd::Mul(sz, sysx), Simd::Mul(cz, cx)), scaleY));
+                Simd::Store(basis[5], Simd::Mul(Simd::Mul(cy, sx), scaleY));
+                Simd::Store(basis[6], Simd::Mul(Simd::Add(Simd::Mul(cz, sycx), Simd::Mul(sz, sx)), scaleZ));
+                Simd::Store(basis[7], Simd::Mul(Simd::Sub(Simd::Mul(sz, sycx), Simd::Mul(cz, sx)), scaleZ));
+                Simd::Store(basis[8], Simd::Mul(Simd::Mul(cy, cx), scaleZ));
+
+                // Lanes to 1 matrix each
+                for (int lane = 0; lane < Simd::Width; lane++)
+                {
+                    float* out = outMatrices + (i + lane) * 16;
+                    out[0] = basis[0][lane]; out[1] = basis[1][lane]; out[2] = basis[2][lane]; out[3] = 0.0f;
+                    out[4] = basis[3][lane]; out[5] = basis[4][lane]; out[6] = basis[5][lane]; out[7] = 0.0f;
+                    out[8] = basis[6][lane]; out[9] = basis[7][lane]; out[10] = basis[8][lane]; out[11] = 0.0f;
+                    out[12] = transforms.positionX[i + lane];
+                    out[13] = transforms.positionY[i + lane];
+                    out[14] = transforms.positionZ[i + lane];
+                    out[15] = 1.0f;
+                }
+            }
+
+            for (; i < count; i++)
+            {
+                const float position[3] = { transforms.positionX[i], transforms.positionY[i], transforms.positionZ[i] };
+                const float rotation[3] = { transforms.rotationX[i], transforms.rotationY[i], transforms.rotationZ[i] };
+                const float scale[3] = { transforms.scaleX[i], transforms.scaleY[i], transforms.scaleZ[i] };
+                ComposeSRT(position, rotation, scale, outMatrices + i * 16);
+            }
+        }
+
+        void Multiply(const float a[16], const float b[16], float out[16])
+        {
+#if defined(SimdSseEnabled)
+            const __m128 a0 = _mm_loadu_ps(a);
+            const __m128 a1 = _mm_loadu_ps(a + 4);
+            const __m128 a2 = _mm_loadu_ps(a + 8);
+            const __m128 a3 = _mm_loadu_ps(a + 12);
+
+            // Each column of out is a's columns weighted by a column of b
+            for (int column = 0; column < 4; column++)
+            {
+                const float* weights = b + column * 4;
+                __m128 result = _mm_mul_ps(a0, _mm_set1_ps(weights[0]));
+                result = _mm_add_ps(result, _mm_mul_ps(a1, _mm_set1_ps(weights[1])));
+                result = _mm_add_ps(result, _mm_mul_ps(a2, _mm_set1_ps(weights[2])));
+                result = _mm_add_ps(result, _mm_mul_ps(a3, _mm_set1_ps(weights[3])));
+                _mm_storeu_ps(out + column * 4, result);
+            }
+#else
+            MultiplyScalar(a, b, out);
+#endif
+        }
+
+        void MultiplyScalar(const float a[16], const float b[16], float out[16])
+        {
+            for (int column = 0; column < 4; column++)
+            {
+                for (int row = 0; row < 4; row++)
+                {
+                    out[column * 4 + row] =
+                        a[0 * 4 + row] * b[column * 4 + 0] +
+                        a[1 * 4 + row] * b[column * 4 + 1] +
+                        a[2 * 4 + row] * b[column * 4 + 2] +
+                        a[3 * 4 + row] * b[column * 4 + 3];
+                }
+            }
+        }
+
+        static void TransformBatch(const float m[16], float w, size_t count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+        {
+            const Simd::Float m0 = Simd::Set(m[0]), m1 = Simd::Set(m[1]), m2 = Simd::Set(m[2]);
+            const Simd::Float m4 = Simd::Set(m[4]), m5 = Simd::Set(m[5]), m6 = Simd::Set(m[6]);
+            const Simd::Float m8 = Simd::Set(m[8]), m9 = Simd::Set(m[9]), m10 = Simd::Set(m[10]);
+            const Simd::Float tx = Simd::Set(m[12] * w), ty = Simd::Set(m[13] * w), tz = Simd::Set(m[14] * w);
+
+            size_t i = 0;
+            for (; i + Simd::Width <= count; i += Simd::Width)
+            {
+                const Simd::Float vx = Simd::Load(x + i);
+                const Simd::Float vy = Simd::Load(y + i);
+                const Simd::Float vz = Simd::Load(z + i);
+                Simd::Store(outX + i, Simd::MulAdd(m0, vx, Simd::MulAdd(m4, vy, Simd::MulAdd(m8, vz, tx))));
+                Simd::Store(outY + i, Simd::MulAdd(m1, vx, Simd::MulAdd(m5, vy, Simd::MulAdd(m9, vz, ty))));
+                Simd::Store(outZ + i, Simd::MulAdd(m2, vx, Simd::MulAdd(m6, vy, Simd::MulAdd(m10, vz, tz))));
+            }
+
+            for (; i < count; i++)
+            {
+                const float vx = x[i], vy = y[i], vz = z[i];
+                outX[i] = m[0] * vx + m[4] * vy + m[8] * vz + m[12] * w;
+                outY[i] = m[1] * vx + m[5] * vy + m[9] * vz + m[13] * w;
+                outZ[i] = m[2] * vx + m[6] * vy + m[10] * vz + m[14] * w;
+            }
+        }
+
+        void TransformPointsBatch(const float matrix[16], size_t count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+        {
+            TransformBatch(matrix, 1.0f, count, x, y, z, outX, outY, outZ);
+        }
+
+        void TransformVectorsBatch(const float matrix[16], size_t count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ)
+        {
+            TransformBatch(matrix, 0.0f, count, x, y, z, outX, outY, outZ);
+        }
+
+        void QuaternionFromEuler(const float rotation[3], float out[4])
+        {
+            const float halfX = rotation[0] * s_DegreesToRadians * 0.5f;
+            const float halfY = rotation[1] * s_DegreesToRadians * 0.5f;
+            const float halfZ = rotation[2] * s_DegreesToRadians * 0.5f;
+
+            const float qx[4] = { std::sin(halfX), 0.0f, 0.0f, std::cos(halfX) };
+            const float qy[4] = { 0.0f, std::sin(halfY), 0.0f, std::cos(halfY) };
+            const float qz[4] = { 0.0f, 0.0f, std::sin(halfZ), std::cos(halfZ) };
+
+            // qz * qy * qx matches R = Rz * Ry * Rx
+            float zy[4];
+            QuaternionMultiply(qz, qy, zy);
+            QuaternionMultiply(zy, qx, out);
+        }
+
+        void QuaternionMultiply(const float a[4], const float b[4], float out[4])
+        {
+            const float x = a[3] * b[0] + a[0] * b[3] + a[1] * b[2] - a[2] * b[1];
+            const float y = a[3] * b[1] - a[0] * b[2] + a[1] * b[3] + a[2] * b[0];
+            const float z = a[3] * b[2] + a[0] * b[1] - a[1] * b[0] + a[2] * b[3];
+            const float w = a[3] * b[3] - a[0] * b[0] - a[1] * b[1] - a[2] * b[2];
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+            out[3] = w;
+        }
+
+        void QuaternionRotate(const float q[4], const float v[3], float out[3])
+        {
+            // v + 2w(u x v) + 2u x (u x v), where u is q's vector part
+            const float tx = 2.0f * (q[1] * v[2] - q[2] * v[1]);
+            const float ty = 2.0f * (q[2] * v[0] - q[0] * v[2]);
+            const float tz = 2.0f * (q[0] * v[1] - q[1] * v[0]);
+
+            const float x = v[0] + q[3] * tx + (q[1] * tz - q[2] * ty);
+            const float y = v[1] + q[3] * ty + (q[2] * tx - q[0] * tz);
+            const float z = v[2] + q[3] * tz + (q[0] * ty - q[1] * tx);
+            out[0] = x;
+            out[1] = y;
+            out[2] = z;
+        }
+
+        void QuaternionToMatrix(const float q[4], float out[16])
+        {
+            const float xx = q[0] * q[0], yy = q[1] * q[1], zz = q[2] * q[2];
+            const float xy = q[0] * q[1], xz = q[0] * q[2], yz = q[1] * q[2];
+            const float wx = q[3] * q[0], wy = q[3] * q[1], wz = q[3] * q[2];
+
+            out[0] = 1.0f - 2.0f * (yy + zz); out[1] = 2.0f * (xy + wz); out[2] = 2.0f * (xz - wy); out[3] = 0.0f;
+            out[4] = 2.0f * (xy - wz); out[5] = 1.0f - 2.0f * (xx + zz); out[6] = 2.0f * (yz + wx); out[7] = 0.0f;
+            out[8] = 2.0f * (xz + wy); out[9] = 2.0f * (yz - wx); out[10] = 1.0f - 2.0f * (xx + yy); out[11] = 0.0f;
+            out[12] = 0.0f; out[13] = 0.0f; out[14] = 0.0f; out[15] = 1.0f;
+        }
+
+        void QuaternionSlerp(const float a[4], const float b[4], float t, float out[4])
+        {
+            float dot = a[0] * b[0] + a[1] * b[1] + a[2] * b[2] + a[3] * b[3];
+
+            // q and -q are the same rotation. Take the shorter way around.
+            float sign = 1.0f;
+            if (dot < 0.0f)
+            {
+                dot = -dot;
+                sign = -1.0f;
+            }
+
+            float weightA = 1.0f - t;
+            float weightB = t;
+            if (dot < 0.9995f)
+            {
+                const float angle = std::acos(dot);
+                const float inverseSin = 1.0f / std::sin(angle);
+                weightA = std::sin((1.0f - t) * angle) * inverseSin;
+                weightB = std::sin(t * angle) * inverseSin;
+            }
+            weightB *= sign;
+
+            float length = 0.0f;
+            for (int i = 0; i < 4; i++)
+            {
+                out[i] = a[i] * weightA + b[i] * weightB;
+                length += out[i] * out[i];
+            }
+
+            // Only needed for the nearly parallel lerp, cheap enough to always do
+            const float inverseLength = 1.0f / std::sqrt(length);
+            for (int i = 0; i < 4; i++)
+            {
+                out[i] *= inverseLength;
+            }
+        }
+
+        void QuaternionMultiplyBatch(size_t count,
+            const float* ax, const float* ay, const float* az, const float* aw,
+            const float* bx, const float* by, const float* bz, const float* bw,
+            float* outX, float* outY, float* outZ, float* outW)
+        {
+            size_t i = 0;
+            for (; i + Simd::Width <= count; i += Simd::Width)
+            {
+                const Simd::Float x1 = Simd::Load(ax + i), y1 = Simd::Load(ay + i), z1 = Simd::Load(az + i), w1 = Simd::Load(aw + i);
+                const Simd::Float x2 = Simd::Load(bx + i), y2 = Simd::Load(by + i), z2 = Simd::Load(bz + i), w2 = Simd::Load(bw + i);
+
+                const Simd::Float x = Simd::Sub(Simd::Add(Simd::Add(Simd::Mul(w1, x2), Simd::Mul(x1, w2)), Simd::Mul(y1, z2)), Simd::Mul(z1, y2));
+                const Simd::Float y = Simd::Add(Simd::Add(Simd::Sub(Simd::Mul(w1, y2), Simd::Mul(x1, z2)), Simd::Mul(y1, w2)), Simd::Mul(z1, x2));
+                const Simd::Float z = Simd::Add(Simd::Sub(Simd::Add(Simd::Mul(w1, z2), Simd::Mul(x1, y2)), Simd::Mul(y1, x2)), Simd::Mul(z1, w2));
+                const Simd::Float w = Simd::Sub(Simd::Sub(Simd::Sub(Simd::Mul(w1, w2), Simd::Mul(x1, x2)), Simd::Mul(y1, y2)), Simd::Mul(z1, z2));
+
+                Simd::Store(outX + i, x);
+                Simd::Store(outY + i, y);
+                Simd::Store(outZ + i, z);
+                Simd::Store(outW + i, w);
+            }
+
+            for (; i < count; i++)
+            {
+                const float a[4] = { ax[i], ay[i], az[i], aw[i] };
+                const float b[4] = { bx[i], by[i], bz[i], bw[i] };
+                float result[4];
+                QuaternionMultiply(a, b, result);
+                outX[i] = result[0];
+                outY[i] = result[1];
+                outZ[i] = result[2];
+                outW[i] = result[3];
+            }
+        }
+    }
+
+}
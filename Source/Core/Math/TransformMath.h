@@ -0,0 +1,81 @@
+#ifndef _Transform_Math_H_
+#define _Transform_Math_H_
+
+// Plain float array matrix helpers used by engine systems that keep
+// their own copies of object transforms (render snapshots, etc).
+// Matrices are 4x4, column major, to match OpenGL uniforms.
+// Rotations are euler angles in degrees, applied X, then Y, then Z.
+// Quaternions are x, y, z, w.
+//
+// Multiply and the Batch functions use SSE2 or AVX when the build
+// targets them (see SimdFloat.h). The scalar versions are kept for
+// comparison.
+
+#include <cstddef>
+
+namespace QwerkE {
+
+    namespace TransformMath
+    {
+        // N transforms as structure of arrays, like EntityArchetype
+        struct TransformArrays
+        {
+            const float* positionX;
+            const float* positionY;
+            const float* positionZ;
+            const float* rotationX;
+            const float* rotationY;
+            const float* rotationZ;
+            const float* scaleX;
+            const float* scaleY;
+            const float* scaleZ;
+        };
+
+        // Name of the instruction set the Batch functions were built for
+        const char* SimdName();
+
+        void Identity(float out[16]);
+
+        // out = scale, then rotate, then translate
+        void ComposeSRT(const float position[3], const float rotation[3], const float scale[3], float out[16]);
+
+        // Undoes ComposeSRT for positive scales. Shear, as from a non-uniform
+        // scale under a rotation, is lost.
+        void DecomposeSRT(const float m[16], float position[3], float rotation[3], float scale[3]);
+
+        // For matrices made of scales, rotations and translations. out may
+        // not alias m.
+        void InvertAffine(const float m[16], float out[16]);
+
+        // Writes count matrices, 16 floats apart
+        void ComposeSRTBatch(const TransformArrays& transforms, size_t count, float* outMatrices);
+
+        // out = a * b. out may not alias a or b.
+        void Multiply(const float a[16], const float b[16], float out[16]);
+        void MultiplyScalar(const float a[16], const float b[16], float out[16]);
+
+        // Transforms count points (w = 1) or directions (w = 0) stored as
+        // arrays. Outputs may be the inputs.
+        void TransformPointsBatch(const float matrix[16], size_t count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ);
+        void TransformVectorsBatch(const float matrix[16], size_t count, const float* x, const float* y, const float* z, float* outX, float* outY, float* outZ);
+
+        // Same rotation as ComposeSRT
+        void QuaternionFromEuler(const float rotation[3], float out[4]);
+        // Rotates by b, then a. out may alias a or b.
+        void QuaternionMultiply(const float a[4], const float b[4], float out[4]);
+        void QuaternionRotate(const float q[4], const float v[3], float out[3]);
+        // Expects a unit quaternion. Writes a rotation only matrix.
+        void QuaternionToMatrix(const float q[4], float out[16]);
+        // Shortest path. Both must be unit quaternions.
+        void QuaternionSlerp(const float a[4], const float b[4], float t, float out[4]);
+
+        // out[i] = a[i] * b[i] for count quaternions stored as 4 arrays each.
+        // Outputs may be the inputs.
+        void QuaternionMultiplyBatch(size_t count,
+            const float* ax, const float* ay, const float* az, const float* aw,
+            const float* bx, const float* by, const float* bz, const float* bw,
+            float* outX, float* outY, float* outZ, float* outW);
+    }
+
+}
+#endif // _Transform_Math_H_
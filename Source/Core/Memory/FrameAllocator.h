@@ -0,0 +1,55 @@
+#ifndef _Frame_Allocator_H_
+#define _Frame_Allocator_H_
+
+// STL allocator that draws from the calling thread's FrameArena.
+// Containers using it must be destroyed, or stop being used, before
+// the end of the frame. Deallocation is a no op.
+//
+// FrameVector<GameObject*> visible;
+// FrameString label;
+
+#include "FrameArena.h"
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    template <class T>
+    class FrameAllocator
+    {
+    public:
+        typedef T value_type;
+
+        FrameAllocator() : m_Arena(&FrameArena::ThreadArena()) {}
+        explicit FrameAllocator(FrameArena* arena) : m_Arena(arena) {}
+
+        template <class U>
+        FrameAllocator(const FrameAllocator<U>& other) : m_Arena(other.Arena()) {}
+
+        T* allocate(size_t count) { return m_Arena->AllocateArray<T>(count); }
+        void deallocate(T*, size_t) {}
+
+        FrameArena* Arena() const { return m_Arena; }
+
+    private:
+        FrameArena* m_Arena;
+    };
+
+    template <class T, class U>
+    bool operator==(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.Arena() == b.Arena(); }
+
+    template <class T, class U>
+    bool operator!=(const FrameAllocator<T>& a, const FrameAllocator<U>& b) { return a.Arena() != b.Arena(); }
+
+    template <class T>
+    using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+    template <class Key, class Value, class Compare = std::less<Key>>
+    using FrameMap = std::map<Key, Value, Compare, FrameAllocator<std::pair<const Key, Value>>>;
+
+    typedef std::basic_string<char, std::char_traits<char>, FrameAllocator<char>> FrameString;
+
+}
+#endif // _Frame_Allocator_H_
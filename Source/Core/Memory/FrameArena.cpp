@@ -0,0 +1,103 @@
+#include "FrameArena.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+
+namespace QwerkE {
+
+    static std::atomic<unsigned int> s_Frame(0);
+
+    // Deletes the calling thread's arena when the thread exits
+    struct ThreadArenaOwner
+    {
+        FrameArena* arena = nullptr;
+
+        ~ThreadArenaOwner()
+        {
+            delete arena;
+        }
+    };
+
+    static thread_local ThreadArenaOwner t_ArenaOwner;
+
+    FrameArena::FrameArena(size_t capacity)
+        : m_Capacity(capacity)
+    {
+        m_Block = new char[m_Capacity];
+    }
+
+    FrameArena::~FrameArena()
+    {
+        Rewind();
+        delete[] m_Block;
+    }
+
+    void* FrameArena::Allocate(size_t size, size_t alignment)
+    {
+        // alignment must be a power of 2
+        const uintptr_t base = (uintptr_t)m_Block;
+        const uintptr_t aligned = (base + m_Offset + alignment - 1) & ~(uintptr_t)(alignment - 1);
+        const size_t newOffset = (size_t)(aligned - base) + size;
+
+        if (newOffset <= m_Capacity)
+        {
+            m_BytesUsed += newOffset - m_Offset;
+            m_Offset = newOffset;
+            return (void*)aligned;
+        }
+
+        // Out of space this frame. Fall back to the heap until the next rewind.
+        char* overflow = new char[size + alignment];
+        m_OverflowBlocks.push_back(overflow);
+        m_BytesUsed += size + alignment;
+        return (void*)(((uintptr_t)overflow + alignment - 1) & ~(uintptr_t)(alignment - 1));
+    }
+
+    void FrameArena::Rewind()
+    {
+        m_HighWaterMark = std::max(m_HighWaterMark, m_BytesUsed);
+
+        if (!m_OverflowBlocks.empty())
+        {
+            for (char* block : m_OverflowBlocks)
+            {
+                delete[] block;
+            }
+            m_OverflowBlocks.clear();
+
+            // Grow so next frame fits in 1 block
+            delete[] m_Block;
+            m_Capacity = m_HighWaterMark + m_HighWaterMark / 2;
+            m_Block = new char[m_Capacity];
+        }
+
+        m_Offset = 0;
+        m_BytesUsed = 0;
+    }
+
+    FrameArena& FrameArena::ThreadArena()
+    {
+        const unsigned int frame = s_Frame.load(std::memory_order_relaxed);
+
+        FrameArena* arena = t_ArenaOwner.arena;
+        if (arena == nullptr)
+        {
+            arena = new FrameArena(s_DefaultCapacity);
+            arena->m_Frame = frame;
+            t_ArenaOwner.arena = arena;
+        }
+        else if (arena->m_Frame != frame)
+        {
+            arena->Rewind();
+            arena->m_Frame = frame;
+        }
+        return *arena;
+    }
+
+    void FrameArena::NewFrame()
+    {
+        s_Frame.fetch_add(1, std::memory_order_relaxed);
+    }
+
+}
@@ -0,0 +1,65 @@
+#ifndef _Frame_Arena_H_
+#define _Frame_Arena_H_
+
+// Linear allocator for memory that only needs to live until the end of
+// the current frame. Allocating is a pointer bump and nothing is freed
+// individually. Engine::NewFrame() starts a new frame, and each thread's
+// arena is rewound by that thread the next time it asks for it, so no
+// thread touches another's arena.
+//
+// If a frame needs more than the arena's block, extra blocks come from
+// the heap and are released on the next rewind. The main block then
+// grows to the frame's high water mark so steady state frames never
+// touch the heap.
+//
+// Pointers from an arena must not be kept past the end of the frame.
+
+#include <cstddef>
+#include <vector>
+
+namespace QwerkE {
+
+    class FrameArena
+    {
+    public:
+        FrameArena(size_t capacity);
+        ~FrameArena();
+
+        FrameArena(const FrameArena&) = delete;
+        FrameArena& operator=(const FrameArena&) = delete;
+
+        void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+        template <class T>
+        T* AllocateArray(size_t count) { return (T*)Allocate(sizeof(T) * count, alignof(T)); }
+
+        void Rewind();
+
+        size_t BytesUsed() const { return m_BytesUsed; }
+        size_t Capacity() const { return m_Capacity; }
+        size_t OverflowCount() const { return m_OverflowBlocks.size(); }
+
+        // Arena for the calling thread. Created on first use, and rewound
+        // on the first use of each frame.
+        static FrameArena& ThreadArena();
+
+        // Frees every thread's frame memory, as each thread next asks for
+        // its arena. Call between frames.
+        static void NewFrame();
+
+        static const size_t s_DefaultCapacity = 256 * 1024;
+
+    private:
+        char* m_Block = nullptr;
+        size_t m_Capacity = 0;
+        size_t m_Offset = 0;
+
+        size_t m_BytesUsed = 0; // Includes overflow
+        size_t m_HighWaterMark = 0;
+        std::vector<char*> m_OverflowBlocks;
+
+        unsigned int m_Frame = 0; // Frame of the last rewind
+    };
+
+}
+#endif // _Frame_Arena_H_
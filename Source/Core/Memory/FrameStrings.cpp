@@ -0,0 +1,60 @@
+#include "FrameStrings.h"
+#include "FrameArena.h"
+
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace QwerkE {
+
+    static const char* FrameFormatV(const char* format, va_list args)
+    {
+        va_list argsCopy;
+        va_copy(argsCopy, args);
+        const int length = vsnprintf(nullptr, 0, format, argsCopy);
+        va_end(argsCopy);
+
+        if (length < 0)
+            return "";
+
+        char* buffer = FrameArena::ThreadArena().AllocateArray<char>((size_t)length + 1);
+        vsnprintf(buffer, (size_t)length + 1, format, args);
+        return buffer;
+    }
+
+    const char* FrameFormat(const char* format, ...)
+    {
+        va_list args;
+        va_start(args, format);
+        const char* result = FrameFormatV(format, args);
+        va_end(args);
+        return result;
+    }
+
+    const char* FrameToString(int value)
+    {
+        return FrameFormat("%i", value);
+    }
+
+    const char* FrameToString(unsigned int value)
+    {
+        return FrameFormat("%u", value);
+    }
+
+    const char* FrameToString(float value)
+    {
+        return FrameFormat("%f", value);
+    }
+
+    const char* FrameCombine(const char* a, const char* b)
+    {
+        const size_t lengthA = strlen(a);
+        const size_t lengthB = strlen(b);
+
+        char* buffer = FrameArena::ThreadArena().AllocateArray<char>(lengthA + lengthB + 1);
+        memcpy(buffer, a, lengthA);
+        memcpy(buffer + lengthA, b, lengthB + 1);
+        return buffer;
+    }
+
+}
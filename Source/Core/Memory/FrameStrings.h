@@ -0,0 +1,21 @@
+#ifndef _Frame_Strings_H_
+#define _Frame_Strings_H_
+
+// String helpers that return frame arena memory instead of heap
+// allocated std::strings. Useful for UI labels and log text that is
+// rebuilt every frame. Results are only valid until the end of the frame.
+
+namespace QwerkE {
+
+    // printf style formatting
+    const char* FrameFormat(const char* format, ...);
+
+    const char* FrameToString(int value);
+    const char* FrameToString(unsigned int value);
+    const char* FrameToString(float value);
+
+    // Concatenates a and b
+    const char* FrameCombine(const char* a, const char* b);
+
+}
+#endif // _Frame_Strings_H_
@@ -0,0 +1,97 @@
+#include "HeapCounter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace QwerkE {
+
+    static std::atomic<unsigned long long> s_TotalAllocations(0);
+    static unsigned long long s_FrameStartAllocations = 0;
+    static unsigned int s_LastFrameAllocations = 0;
+
+    namespace HeapCounter
+    {
+        void NewFrame()
+        {
+            const unsigned long long total = s_TotalAllocations.load(std::memory_order_relaxed);
+            s_LastFrameAllocations = (unsigned int)(total - s_FrameStartAllocations);
+            s_FrameStartAllocations = total;
+        }
+
+        unsigned int LastFrameAllocations()
+        {
+            return s_LastFrameAllocations;
+        }
+
+        unsigned long long TotalAllocations()
+        {
+            return s_TotalAllocations.load(std::memory_order_relaxed);
+        }
+    }
+
+}
+
+#if TrackHeapAllocations
+
+static void* CountedAllocate(size_t size)
+{
+    QwerkE::s_TotalAllocations.fetch_add(1, std::memory_order_relaxed);
+    return malloc(size ? size : 1);
+}
+
+void* operator new(size_t size)
+{
+    if (void* memory = CountedAllocate(size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new[](size_t size)
+{
+    if (void* memory = CountedAllocate(size))
+        return memory;
+    throw std::bad_alloc();
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+    return CountedAllocate(size);
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, size_t) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
+
+void operator delete[](void* memory, const std::nothrow_t&) noexcept
+{
+    free(memory);
+}
+
+#endif // TrackHeapAllocations
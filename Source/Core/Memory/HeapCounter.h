@@ -0,0 +1,24 @@
+#ifndef _Heap_Counter_H_
+#define _Heap_Counter_H_
+
+// Counts calls to global operator new so per frame heap traffic can be
+// watched from the editor. Set TrackHeapAllocations to 0 to use the
+// default allocator functions without counting.
+
+#define TrackHeapAllocations 1
+
+namespace QwerkE {
+
+    namespace HeapCounter
+    {
+        // Ends the current count and starts a new one. Call once per frame.
+        void NewFrame();
+
+        // Allocations made during the last complete frame, on any thread
+        unsigned int LastFrameAllocations();
+
+        unsigned long long TotalAllocations();
+    }
+
+}
+#endif // _Heap_Counter_H_
@@ -0,0 +1,174 @@
+#include "ProfilerHistory.h"
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <mutex>
+
+namespace QwerkE {
+
+    // One extra slot so the oldest frame still has an end time
+    static const unsigned int s_FrameSlots = ProfilerHistory::s_FrameCapacity + 1;
+
+    // Bounds memory if frames stop being marked while events keep coming
+    static const size_t s_MaxEvents = 1 << 18;
+
+    // Scopes are written just after they end, so give the drain a moment to catch them
+    static const unsigned long long s_DrainMargin = 1000000; // 1ms
+
+    static std::atomic<bool> s_Enabled(false);
+
+    static std::mutex s_Mutex;
+    static unsigned long long s_FrameStarts[s_FrameSlots];
+    static unsigned long long s_FramesMarked = 0;
+    static unsigned long long s_LastDrainTime = 0;
+    static std::deque<ProfilerEvent> s_Events;
+
+    static bool FrameInHistory(unsigned long long frameIndex)
+    {
+        return frameIndex + 1 < s_FramesMarked && s_FramesMarked - frameIndex <= s_FrameSlots;
+    }
+
+    namespace ProfilerHistory
+    {
+        void SetEnabled(bool enabled)
+        {
+            if (enabled && !s_Enabled.load())
+                Clear(); // Old data would leave a gap
+
+            s_Enabled.store(enabled);
+        }
+
+        bool IsEnabled()
+        {
+            return s_Enabled.load(std::memory_order_relaxed);
+        }
+
+        void MarkFrame()
+        {
+            if (!IsEnabled())
+                return;
+
+            const unsigned long long now = TraceRecorder::Now();
+
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_FrameStarts[s_FramesMarked % s_FrameSlots] = now;
+            s_FramesMarked++;
+        }
+
+        void AddEvents(unsigned int threadId, const std::vector<TraceEvent>& events)
+        {
+            if (!IsEnabled())
+                return;
+
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            for (const TraceEvent& event : events)
+            {
+                ProfilerEvent profilerEvent;
+                profilerEvent.name = event.name;
+                profilerEvent.startTime = event.startTime;
+                profilerEvent.endTime = event.endTime;
+                profilerEvent.threadId = threadId;
+                s_Events.push_back(profilerEvent);
+            }
+
+            // Drop events that ended before the oldest frame in the history.
+            // Blocks arrive in drain order, so old events are at the front.
+            const unsigned long long oldestFrame = s_FramesMarked > s_FrameSlots ? s_FramesMarked - s_FrameSlots : 0;
+            const unsigned long long oldestTime = s_FramesMarked > 0 ? s_FrameStarts[oldestFrame % s_FrameSlots] : 0;
+            while (!s_Events.empty() && (s_Events.front().endTime < oldestTime || s_Events.size() > s_MaxEvents))
+            {
+                s_Events.pop_front();
+            }
+        }
+
+        void DrainComplete(unsigned long long drainStartTime)
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_LastDrainTime = drainStartTime;
+        }
+
+        void Clear()
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            s_FramesMarked = 0;
+            s_LastDrainTime = 0;
+            s_Events.clear();
+        }
+
+        bool NewestCompleteFrame(unsigned long long& frameIndex)
+        {
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (s_FramesMarked < 2)
+                return false;
+
+            for (unsigned long long i = s_FramesMarked - 2; FrameInHistory(i); i--)
+            {
+                const unsigned long long endTime = s_FrameStarts[(i + 1) % s_FrameSlots];
+                if (endTime + s_DrainMargin <= s_LastDrainTime)
+                {
+                    frameIndex = i;
+                    return true;
+                }
+
+                if (i == 0)
+                    break;
+            }
+            return false;
+        }
+
+        void CopyFrameTimes(unsigned long long lastFrameIndex, std::vector<float>& frameTimes)
+        {
+            frameTimes.clear();
+
+            std::lock_guard<std::mutex> lock(s_Mutex);
+            if (!FrameInHistory(lastFrameIndex))
+                return;
+
+            unsigned long long firstFrameIndex = lastFrameIndex;
+            while (firstFrameIndex > 0 && FrameInHistory(firstFrameIndex - 1))
+            {
+                firstFrameIndex--;
+            }
+
+            for (unsigned long long i = firstFrameIndex; i <= lastFrameIndex; i++)
+            {
+                const unsigned long long duration = s_FrameStarts[(i + 1) % s_FrameSlots] - s_FrameStarts[i % s_FrameSlots];
+                frameTimes.push_back((float)(duration / 1000000.0));
+            }
+        }
+
+        bool CopyFrame(unsigned long long frameIndex, ProfilerFrame& frame)
+        {
+            frame.events.clear();
+
+            {
+                std::lock_guard<std::mutex> lock(s_Mutex);
+                if (!FrameInHistory(frameIndex))
+                    return false;
+
+                frame.frameIndex = frameIndex;
+                frame.startTime = s_FrameStarts[frameIndex % s_FrameSlots];
+                frame.endTime = s_FrameStarts[(frameIndex + 1) % s_FrameSlots];
+
+                for (const ProfilerEvent& event : s_Events)
+                {
+                    if (event.startTime < frame.endTime && event.endTime > frame.startTime)
+                        frame.events.push_back(event);
+                }
+            }
+
+            // Parents before children when starts match
+            std::sort(frame.events.begin(), frame.events.end(), [](const ProfilerEvent& a, const ProfilerEvent& b)
+            {
+                if (a.threadId != b.threadId)
+                    return a.threadId < b.threadId;
+                if (a.startTime != b.startTime)
+                    return a.startTime < b.startTime;
+                return a.endTime > b.endTime;
+            });
+            return true;
+        }
+    }
+
+}
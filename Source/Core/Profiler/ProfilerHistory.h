@@ -0,0 +1,61 @@
+#ifndef _Profiler_History_H_
+#define _Profiler_History_H_
+
+// Keeps the last few hundred frames of TraceRecorder events in memory
+// for live tools like the editor's profiler panel. Frames are marked by
+// the main thread. Events arrive from the TraceRecorder drain thread, so
+// the newest frame's events show up a little after it ends.
+//
+// Collection is off until SetEnabled(true) so builds without the panel
+// pay nothing extra.
+
+#include "TraceRecorder.h"
+
+#include <vector>
+
+namespace QwerkE {
+
+    struct ProfilerEvent
+    {
+        const char* name;
+        unsigned long long startTime;
+        unsigned long long endTime;
+        unsigned int threadId;
+    };
+
+    struct ProfilerFrame
+    {
+        unsigned long long frameIndex = 0;
+        unsigned long long startTime = 0;
+        unsigned long long endTime = 0;
+        std::vector<ProfilerEvent> events; // Sorted by thread, then start time
+    };
+
+    namespace ProfilerHistory
+    {
+        static const unsigned int s_FrameCapacity = 300;
+
+        void SetEnabled(bool enabled);
+        bool IsEnabled();
+
+        // Ends the previous frame and starts a new one. Main thread only.
+        void MarkFrame();
+
+        // TraceRecorder drain thread
+        void AddEvents(unsigned int threadId, const std::vector<TraceEvent>& events);
+        void DrainComplete(unsigned long long drainStartTime);
+
+        void Clear();
+
+        // Newest frame whose events have all been drained. Returns false if there is none yet.
+        bool NewestCompleteFrame(unsigned long long& frameIndex);
+
+        // Frame durations in milliseconds, oldest first, ending at frameIndex
+        void CopyFrameTimes(unsigned long long lastFrameIndex, std::vector<float>& frameTimes);
+
+        // Returns false once the frame is older than the history
+        bool CopyFrame(unsigned long long frameIndex, ProfilerFrame& frame);
+    }
+
+}
+#endif // _Profiler_History_H_
@@ -0,0 +1,455 @@
+#include "TraceRecorder.h"
+#include "ProfilerHistory.h"
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// .qtrace layout, little endian. Integers marked v are LEB128 varints.
+//   Header { char magic[4] = "QTRC", u16 version, u16 reserved }
+//   Name   { u8 'N', v id, v length, char name[length] }
+//   Block  { u8 'B', v threadId, v count, Event events[count] }
+//   Event  { v nameId, v startDelta, v duration }
+// startDelta is from the previous event start in the block, or from the
+// session start for the first event. Events in a block are sorted by start.
+// Names are written once, before the first block that uses them.
+
+namespace QwerkE {
+
+    static const char s_Magic[4] = { 'Q', 'T', 'R', 'C' };
+    static const unsigned short s_Version = 1;
+
+    static const unsigned int s_RingBufferCapacity = 1 << 14; // Events per thread. Must be a power of 2.
+    static const std::chrono::milliseconds s_DrainInterval(10);
+
+    // Single producer (the owning thread), single consumer (the drain thread)
+    class ThreadTraceBuffer
+    {
+    public:
+        ThreadTraceBuffer(unsigned int threadId) : m_ThreadId(threadId) {}
+
+        void Write(const TraceEvent& event)
+        {
+            const unsigned int head = m_Head.load(std::memory_order_relaxed);
+            const unsigned int tail = m_Tail.load(std::memory_order_acquire);
+            if (head - tail >= s_RingBufferCapacity)
+            {
+                m_Dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+
+            m_Events[head & (s_RingBufferCapacity - 1)] = event;
+            m_Head.store(head + 1, std::memory_order_release);
+        }
+
+        // Consumer only
+        void Read(std::vector<TraceEvent>& out)
+        {
+            const unsigned int head = m_Head.load(std::memory_order_acquire);
+            const unsigned int tail = m_Tail.load(std::memory_order_relaxed);
+            for (unsigned int i = tail; i != head; i++)
+            {
+                out.push_back(m_Events[i & (s_RingBufferCapacity - 1)]);
+            }
+            m_Tail.store(head, std::memory_order_release);
+        }
+
+        // Consumer only
+        void Discard()
+        {
+            m_Tail.store(m_Head.load(std::memory_order_acquire), std::memory_order_release);
+            m_Dropped.store(0, std::memory_order_relaxed);
+        }
+
+        unsigned int ThreadId() const { return m_ThreadId; }
+        unsigned long long Dropped() const { return m_Dropped.load(std::memory_order_relaxed); }
+
+        std::atomic<bool> m_Retired{ false }; // Owning thread has exited
+
+    private:
+        TraceEvent m_Events[s_RingBufferCapacity];
+        std::atomic<unsigned int> m_Head{ 0 };
+        std::atomic<unsigned int> m_Tail{ 0 };
+        std::atomic<unsigned long long> m_Dropped{ 0 };
+        const unsigned int m_ThreadId;
+    };
+
+    static std::atomic<bool> s_Recording(false);
+    static std::chrono::steady_clock::time_point s_SessionStart;
+
+    static std::mutex s_BuffersMutex;
+    static std::vector<ThreadTraceBuffer*> s_Buffers;
+    static unsigned int s_NextThreadId = 0;
+
+    static std::thread s_DrainThread;
+    static std::mutex s_DrainMutex;
+    static std::condition_variable s_DrainSignal;
+    static bool s_StopDraining = false;
+    static unsigned long long s_DroppedEvents = 0;
+
+    // Drain thread only
+    static FILE* s_File = nullptr;
+    static std::unordered_map<const char*, unsigned int> s_NameIds;
+    static std::vector<TraceEvent> s_DrainEvents;
+    static std::vector<unsigned char> s_Encoded;
+
+    struct ThreadTraceBufferOwner
+    {
+        ThreadTraceBuffer* buffer = nullptr;
+
+        ~ThreadTraceBufferOwner()
+        {
+            // The drain thread deletes the buffer once it is empty
+            if (buffer)
+                buffer->m_Retired.store(true, std::memory_order_release);
+        }
+    };
+
+    static thread_local ThreadTraceBufferOwner t_BufferOwner;
+
+    static ThreadTraceBuffer* GetThreadBuffer()
+    {
+        if (t_BufferOwner.buffer == nullptr)
+        {
+            std::lock_guard<std::mutex> lock(s_BuffersMutex);
+            t_BufferOwner.buffer = new ThreadTraceBuffer(s_NextThreadId++);
+            s_Buffers.push_back(t_BufferOwner.buffer);
+        }
+        return t_BufferOwner.buffer;
+    }
+
+    static void WriteVarint(std::vector<unsigned char>& out, unsigned long long value)
+    {
+        while (value >= 0x80)
+        {
+            out.push_back((unsigned char)(value | 0x80));
+            value >>= 7;
+        }
+        out.push_back((unsigned char)value);
+    }
+
+    static bool ReadVarint(FILE* file, unsigned long long& value)
+    {
+        value = 0;
+        for (int shift = 0; shift < 64; shift += 7)
+        {
+            const int byte = fgetc(file);
+            if (byte == EOF)
+                return false;
+
+            value |= (unsigned long long)(byte & 0x7F) << shift;
+            if ((byte & 0x80) == 0)
+                return true;
+        }
+        return false;
+    }
+
+    static unsigned int GetNameId(const char* name)
+    {
+        auto it = s_NameIds.find(name);
+        if (it != s_NameIds.end())
+            return it->second;
+
+        const unsigned int id = (unsigned int)s_NameIds.size();
+        s_NameIds[name] = id;
+
+        const size_t length = strlen(name);
+        s_Encoded.push_back('N');
+        WriteVarint(s_Encoded, id);
+        WriteVarint(s_Encoded, length);
+        s_Encoded.insert(s_Encoded.end(), name, name + length);
+        return id;
+    }
+
+    static void EncodeBlock(unsigned int threadId)
+    {
+        // Scopes end (and are written) inner first. Sorting by start keeps deltas small and positive.
+        std::sort(s_DrainEvents.begin(), s_DrainEvents.end(),
+            [](const TraceEvent& a, const TraceEvent& b) { return a.startTime < b.startTime; });
+
+        // Names go before the block that uses them
+        for (const TraceEvent& event : s_DrainEvents)
+        {
+            GetNameId(event.name);
+        }
+
+        s_Encoded.push_back('B');
+        WriteVarint(s_Encoded, threadId);
+        WriteVarint(s_Encoded, s_DrainEvents.size());
+
+        unsigned long long previousStart = 0;
+        for (const TraceEvent& event : s_DrainEvents)
+        {
+            WriteVarint(s_Encoded, s_NameIds[event.name]);
+            WriteVarint(s_Encoded, event.startTime - previousStart);
+            WriteVarint(s_Encoded, event.endTime - event.startTime);
+            previousStart = event.startTime;
+        }
+    }
+
+    static void DrainBuffers()
+    {
+        const unsigned long long drainStartTime = TraceRecorder::Now();
+        s_Encoded.clear();
+
+        {
+            std::lock_guard<std::mutex> lock(s_BuffersMutex);
+            for (size_t i = 0; i < s_Buffers.size();)
+            {
+                ThreadTraceBuffer* buffer = s_Buffers[i];
+
+                // Check before reading so no events are written after the last read
+                const bool retired = buffer->m_Retired.load(std::memory_order_acquire);
+
+                s_DrainEvents.clear();
+                buffer->Read(s_DrainEvents);
+                if (!s_DrainEvents.empty())
+                {
+                    if (s_File)
+                        EncodeBlock(buffer->ThreadId());
+                    ProfilerHistory::AddEvents(buffer->ThreadId(), s_DrainEvents);
+                }
+
+                if (retired)
+                {
+                    s_DroppedEvents += buffer->Dropped();
+                    s_Buffers.erase(s_Buffers.begin() + i);
+                    delete buffer;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+
+        if (!s_Encoded.empty())
+            fwrite(s_Encoded.data(), 1, s_Encoded.size(), s_File);
+
+        ProfilerHistory::DrainComplete(drainStartTime);
+    }
+
+    static void DrainThreadRun()
+    {
+        std::unique_lock<std::mutex> lock(s_DrainMutex);
+        while (!s_StopDraining)
+        {
+            s_DrainSignal.wait_for(lock, s_DrainInterval);
+
+            lock.unlock();
+            DrainBuffers();
+            lock.lock();
+        }
+
+        lock.unlock();
+        DrainBuffers(); // Events written before recording stopped
+    }
+
+    namespace TraceRecorder
+    {
+        bool BeginSession(const char* filePath)
+        {
+            if (s_Recording.load())
+                EndSession();
+
+            if (filePath)
+            {
+                s_File = fopen(filePath, "wb");
+                if (s_File == nullptr)
+                {
+                    LOG_ERROR("TraceRecorder: Could not open {0} for writing", filePath);
+                    return false;
+                }
+
+                fwrite(s_Magic, sizeof(s_Magic), 1, s_File);
+                fwrite(&s_Version, sizeof(s_Version), 1, s_File);
+                const unsigned short reserved = 0;
+                fwrite(&reserved, sizeof(reserved), 1, s_File);
+            }
+
+            s_NameIds.clear();
+            s_DroppedEvents = 0;
+            {
+                // Scopes left over from a previous session
+                std::lock_guard<std::mutex> lock(s_BuffersMutex);
+                for (ThreadTraceBuffer* buffer : s_Buffers)
+                {
+                    buffer->Discard();
+                }
+            }
+
+            s_SessionStart = std::chrono::steady_clock::now();
+            ProfilerHistory::Clear(); // Times restart from 0
+            s_StopDraining = false;
+            s_DrainThread = std::thread(DrainThreadRun);
+            s_Recording.store(true);
+
+            if (filePath)
+                LOG_INFO("TraceRecorder: Recording to {0}", filePath);
+            return true;
+        }
+
+        void EndSession()
+        {
+            if (!s_Recording.exchange(false))
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(s_DrainMutex);
+                s_StopDraining = true;
+            }
+            s_DrainSignal.notify_one();
+            s_DrainThread.join();
+
+            const unsigned long long dropped = DroppedEventCount();
+            if (dropped > 0)
+                LOG_WARN("TraceRecorder: {0} events were dropped. Ring buffers were full.", dropped);
+
+            if (s_File)
+            {
+                fclose(s_File);
+                s_File = nullptr;
+            }
+        }
+
+        bool IsRecording()
+        {
+            return s_Recording.load(std::memory_order_relaxed);
+        }
+
+        void WriteEvent(const char* name, unsigned long long startTime, unsigned long long endTime)
+        {
+            TraceEvent event;
+            event.name = name;
+            event.startTime = startTime;
+            event.endTime = endTime;
+            GetThreadBuffer()->Write(event);
+        }
+
+        unsigned long long Now()
+        {
+            return (unsigned long long)std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - s_SessionStart).count();
+        }
+
+        unsigned long long DroppedEventCount()
+        {
+            std::lock_guard<std::mutex> lock(s_BuffersMutex);
+            unsigned long long dropped = s_DroppedEvents;
+            for (const ThreadTraceBuffer* buffer : s_Buffers)
+            {
+                dropped += buffer->Dropped();
+            }
+            return dropped;
+        }
+
+        bool ConvertToJson(const char* tracePath, const char* jsonPath)
+        {
+            FILE* trace = fopen(tracePath, "rb");
+            if (trace == nullptr)
+            {
+                LOG_ERROR("TraceRecorder: Could not open {0}", tracePath);
+                return false;
+            }
+
+            char magic[4];
+            unsigned short version = 0;
+            unsigned short reserved = 0;
+            if (fread(magic, sizeof(magic), 1, trace) != 1 ||
+                fread(&version, sizeof(version), 1, trace) != 1 ||
+                fread(&reserved, sizeof(reserved), 1, trace) != 1 ||
+                memcmp(magic, s_Magic, sizeof(s_Magic)) != 0 || version != s_Version)
+            {
+                LOG_ERROR("TraceRecorder: {0} is not a version {1} trace", tracePath, s_Version);
+                fclose(trace);
+                return false;
+            }
+
+            FILE* json = fopen(jsonPath, "w");
+            if (json == nullptr)
+            {
+                LOG_ERROR("TraceRecorder: Could not open {0} for writing", jsonPath);
+                fclose(trace);
+                return false;
+            }
+
+            // Same layout as the Instrumentor's output
+            fputs("{\"otherData\": {},\"traceEvents\":[", json);
+
+            std::vector<std::string> names;
+            unsigned long long eventCount = 0;
+            bool valid = true;
+
+            int tag;
+            while (valid && (tag = fgetc(trace)) != EOF)
+            {
+                if (tag == 'N')
+                {
+                    unsigned long long id, length;
+                    valid = ReadVarint(trace, id) && ReadVarint(trace, length) && id == names.size();
+                    if (!valid)
+                        break;
+
+                    std::string name((size_t)length, '\0');
+                    valid = length == 0 || fread(&name[0], 1, (size_t)length, trace) == length;
+
+                    // Escape for JSON
+                    std::string escaped;
+                    for (char c : name)
+                    {
+                        if (c == '"' || c == '\\')
+                            escaped.push_back('\\');
+                        escaped.push_back(c);
+                    }
+                    names.push_back(escaped);
+                }
+                else if (tag == 'B')
+                {
+                    unsigned long long threadId, count;
+                    valid = ReadVarint(trace, threadId) && ReadVarint(trace, count);
+
+                    unsigned long long startTime = 0;
+                    for (unsigned long long i = 0; valid && i < count; i++)
+                    {
+                        unsigned long long nameId, startDelta, duration;
+                        valid = ReadVarint(trace, nameId) && ReadVarint(trace, startDelta) &&
+                            ReadVarint(trace, duration) && nameId < names.size();
+                        if (!valid)
+                            break;
+
+                        startTime += startDelta;
+                        fprintf(json, "%s{\"cat\":\"function\",\"dur\":%.3f,\"name\":\"%s\",\"ph\":\"X\",\"pid\":0,\"tid\":%llu,\"ts\":%.3f}",
+                            eventCount ? "," : "", duration / 1000.0, names[(size_t)nameId].c_str(), threadId, startTime / 1000.0);
+                        eventCount++;
+                    }
+                }
+                else
+                {
+                    valid = false;
+                }
+            }
+
+            fputs("]}", json);
+            fclose(json);
+            fclose(trace);
+
+            // A session that was not ended cleanly is cut short. Keep what was read.
+            if (!valid)
+                LOG_WARN("TraceRecorder: {0} ends with incomplete data", tracePath);
+
+            LOG_INFO("TraceRecorder: Wrote {0} events to {1}", eventCount, jsonPath);
+            return true;
+        }
+    }
+
+}
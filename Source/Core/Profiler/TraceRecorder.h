@@ -0,0 +1,87 @@
+#ifndef _Trace_Recorder_H_
+#define _Trace_Recorder_H_
+
+// Low overhead alternative to the framework's Instrumentor. Each thread
+// writes fixed size events into its own lock free ring buffer. A
+// background thread drains the buffers and writes them to a compact
+// binary .qtrace file. Nothing is formatted while the engine is running.
+// Use TraceRecorder::ConvertToJson() offline to get a chrome://tracing file.
+//
+// Include this header instead of the framework's Profiler.h. With
+// TraceRingBufferEnabled set, PROFILE_SCOPE records to the ring buffers.
+
+#include "../QwerkE_Framework/Source/Debug/Profiler/Profiler.h"
+
+#include <new>
+
+#define TraceRingBufferEnabled 1
+
+namespace QwerkE {
+
+    struct TraceEvent
+    {
+        const char* name;
+        unsigned long long startTime;
+        unsigned long long endTime;
+    };
+
+    namespace TraceRecorder
+    {
+        // A null filePath records for live tools, like the editor profiler, without writing a file
+        bool BeginSession(const char* filePath);
+        void EndSession();
+        bool IsRecording();
+
+        // Times are nanoseconds from TraceRecorder::Now()
+        void WriteEvent(const char* name, unsigned long long startTime, unsigned long long endTime);
+        unsigned long long Now();
+
+        // Events lost to full ring buffers this session
+        unsigned long long DroppedEventCount();
+
+        // Writes a binary trace as chrome tracing JSON
+        bool ConvertToJson(const char* tracePath, const char* jsonPath);
+    }
+
+    // Name must outlive the session. String literals are fine.
+    // Falls back to the Instrumentor when no trace session is recording.
+    class TraceScope
+    {
+    public:
+        TraceScope(const char* name)
+        {
+            if (TraceRecorder::IsRecording())
+            {
+                m_Name = name;
+                m_StartTime = TraceRecorder::Now();
+            }
+            else
+            {
+                new (m_InstrumentationTimer) InstrumentationTimer(name);
+            }
+        }
+
+        ~TraceScope()
+        {
+            if (m_Name)
+                TraceRecorder::WriteEvent(m_Name, m_StartTime, TraceRecorder::Now());
+            else
+                ((InstrumentationTimer*)m_InstrumentationTimer)->~InstrumentationTimer();
+        }
+
+    private:
+        const char* m_Name = nullptr;
+        unsigned long long m_StartTime = 0;
+        alignas(InstrumentationTimer) unsigned char m_InstrumentationTimer[sizeof(InstrumentationTimer)];
+    };
+
+}
+
+#if TraceRingBufferEnabled
+#undef PROFILE_SCOPE
+#define PROFILE_SCOPE_COMBINE(a, b) a##b
+#define PROFILE_SCOPE_NAME(line) PROFILE_SCOPE_COMBINE(traceScope, line)
+#define PROFILE_SCOPE(name) QwerkE::TraceScope PROFILE_SCOPE_NAME(__LINE__)(name)
+#endif // TraceRingBufferEnabled
+
+#endif // _Trace_Recorder_H_
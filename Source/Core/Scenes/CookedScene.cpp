@@ -0,0 +1,132 @@
+#include "CookedScene.h"
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+#include <cstring>
+#include <sys/stat.h>
+
+namespace QwerkE {
+
+    const char CookedScene::s_Magic[4] = { 'Q', 'S', 'C', 'N' };
+
+    static bool InBounds(unsigned long long offset, unsigned long long size, size_t fileSize)
+    {
+        return offset % 4 == 0 && offset <= fileSize && size <= fileSize - offset;
+    }
+
+    bool CookedScene::Open(const char* filePath)
+    {
+        Close();
+
+        if (!m_File.Open(filePath))
+            return false;
+
+        const unsigned char* data = m_File.Data();
+        const size_t size = m_File.Size();
+        const CookedSceneHeader* header = (const CookedSceneHeader*)data;
+
+        if (size < sizeof(CookedSceneHeader) ||
+            memcmp(header->magic, s_Magic, sizeof(s_Magic)) != 0 ||
+            header->version != s_Version)
+        {
+            LOG_ERROR("CookedScene: {0} is not a version {1} cooked scene", filePath, s_Version);
+            Close();
+            return false;
+        }
+
+        if (!InBounds(header->entitiesOffset, (unsigned long long)header->entityCount * sizeof(CookedEntity), size) ||
+            !InBounds(header->componentsOffset, header->componentsSize, size) ||
+            !InBounds(header->stringsOffset, header->stringsSize, size) ||
+            header->stringsSize == 0 || data[header->stringsOffset + header->stringsSize - 1] != '\0')
+        {
+            LOG_ERROR("CookedScene: {0} is truncated or corrupt", filePath);
+            Close();
+            return false;
+        }
+
+        const CookedEntity* entities = (const CookedEntity*)(data + header->entitiesOffset);
+        for (unsigned int i = 0; i < header->entityCount; i++)
+        {
+            const CookedEntity& entity = entities[i];
+            if (entity.list >= CookedList_Max ||
+                entity.componentsOffset % 4 != 0 ||
+                entity.componentsOffset > header->componentsSize ||
+                entity.componentsSize > header->componentsSize - entity.componentsOffset)
+            {
+                LOG_ERROR("CookedScene: {0} has an invalid entity {1}", filePath, i);
+                Close();
+                return false;
+            }
+        }
+
+        m_Header = header;
+        m_Entities = entities;
+        m_Components = data + header->componentsOffset;
+        m_Strings = (const char*)(data + header->stringsOffset);
+        return true;
+    }
+
+    void CookedScene::Close()
+    {
+        m_File.Close();
+        m_Header = nullptr;
+        m_Entities = nullptr;
+        m_Components = nullptr;
+        m_Strings = nullptr;
+    }
+
+    bool CookedScene::IsUpToDate(const char* sourceFilePath) const
+    {
+        unsigned long long size;
+        long long writeTime;
+        if (!SourceFileInfo(sourceFilePath, size, writeTime))
+            return true;
+
+        return size == m_Header->sourceSize && writeTime == m_Header->sourceWriteTime;
+    }
+
+    const char* CookedScene::GetString(unsigned int offset) const
+    {
+        if (offset >= m_Header->stringsSize)
+            return "";
+        return m_Strings + offset;
+    }
+
+    const void* CookedScene::FindComponent(const CookedEntity& entity, eCookedComponents type, unsigned int& dataSize) const
+    {
+        unsigned int offset = 0;
+        while (offset + sizeof(CookedComponentHeader) <= entity.componentsSize)
+        {
+            const unsigned char* record = m_Components + entity.componentsOffset + offset;
+            const CookedComponentHeader* header = (const CookedComponentHeader*)record;
+            const unsigned int remaining = entity.componentsSize - offset - sizeof(CookedComponentHeader);
+            if (header->size > remaining || header->size % 4 != 0)
+                return nullptr; // Corrupt
+
+            if (header->type == type)
+            {
+                dataSize = header->size;
+                return record + sizeof(CookedComponentHeader);
+            }
+            offset += sizeof(CookedComponentHeader) + header->size;
+        }
+        return nullptr;
+    }
+
+    std::string CookedScene::CookedPath(const char* sourceFilePath)
+    {
+        return std::string(sourceFilePath) + "c";
+    }
+
+    bool CookedScene::SourceFileInfo(const char* filePath, unsigned long long& size, long long& writeTime)
+    {
+        struct stat info;
+        if (stat(filePath, &info) != 0)
+            return false;
+
+        size = (unsigned long long)info.st_size;
+        writeTime = (long long)info.st_mtime;
+        return true;
+    }
+
+}
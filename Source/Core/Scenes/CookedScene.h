@@ -0,0 +1,164 @@
+#ifndef _Cooked_Scene_H_
+#define _Cooked_Scene_H_
+
+// Binary scene format made by SceneCooker from a .qscene file. A cooked
+// file is memory mapped and read in place. Strings point into the file
+// and the entity table is used directly, so loading does no parsing.
+//
+// File layout, little endian. Offsets are bytes from the start of the
+// file, and every section starts on a 4 byte boundary.
+//   Header      { CookedSceneHeader }
+//   Entities    { CookedEntity entities[entityCount] }
+//   Components  { Component records, found from each entity's range }
+//   Strings     { Null terminated UTF-8 strings. Offset 0 is "". }
+//
+// A component record is a CookedComponentHeader then size bytes of data:
+//   Camera           { CookedCamera }
+//   Light            { }
+//   Render           { CookedRender, CookedRenderable renderables[renderableCount] }
+//   TransformRoutine { CookedTransformRoutine }
+//   RenderRoutine    { }
+
+#include "../FileSystem/MappedFile.h"
+#include "../Entities/EntityGuid.h"
+
+#include <string>
+
+namespace QwerkE {
+
+    // The scene list an entity is added to
+    enum eCookedSceneLists : unsigned char
+    {
+        CookedList_Object = 0,
+        CookedList_Camera,
+        CookedList_Light,
+        CookedList_Max
+    };
+
+    enum eCookedComponents : unsigned short
+    {
+        CookedComponent_Camera = 0,
+        CookedComponent_Light,
+        CookedComponent_Render,
+        CookedComponent_TransformRoutine,
+        CookedComponent_RenderRoutine,
+        CookedComponent_Max
+    };
+
+    struct CookedSceneHeader
+    {
+        char magic[4]; // "QSCN"
+        unsigned short version;
+        unsigned short reserved;
+
+        // Source .qscene file the scene was cooked from, to detect stale files
+        unsigned long long sourceSize;
+        long long sourceWriteTime;
+
+        unsigned int entityCount;
+        unsigned int entitiesOffset;
+        unsigned int componentsOffset;
+        unsigned int componentsSize;
+        unsigned int stringsOffset;
+        unsigned int stringsSize;
+    };
+
+    struct CookedEntity
+    {
+        unsigned int name; // String offset
+        unsigned int list; // eCookedSceneLists
+        int tag; // eGameObjectTags
+        float position[3];
+        float rotation[3];
+        float scale[3];
+
+        // Range of component records in the components section
+        unsigned int componentsOffset;
+        unsigned int componentsSize;
+
+        // EntityGuid, low word first. Split as sections are only 4 byte aligned.
+        unsigned int guid[2];
+        unsigned int parentGuid[2]; // 0 without a parent
+
+        EntityGuid Guid() const { return ((EntityGuid)guid[1] << 32) | guid[0]; }
+        EntityGuid ParentGuid() const { return ((EntityGuid)parentGuid[1] << 32) | parentGuid[0]; }
+    };
+
+    struct CookedComponentHeader
+    {
+        unsigned short type; // eCookedComponents
+        unsigned short reserved;
+        unsigned int size; // Bytes of data after the header, a multiple of 4
+    };
+
+    struct CookedCamera
+    {
+        int cameraType; // eCamType
+    };
+
+    struct CookedRender
+    {
+        unsigned int schematicName; // String offset
+        unsigned int renderableCount;
+    };
+
+    // All string offsets
+    struct CookedRenderable
+    {
+        unsigned int name;
+        unsigned int shader;
+        unsigned int material;
+        unsigned int meshFile;
+        unsigned int meshName;
+    };
+
+    struct CookedTransformRoutine
+    {
+        float speed;
+        float positionOffset[3];
+        float rotationOffset[3];
+        float scaleOffset[3];
+    };
+
+    class CookedScene
+    {
+    public:
+        static const char s_Magic[4];
+        static const unsigned short s_Version = 3;
+
+        // Maps the file and checks that every section is in bounds
+        bool Open(const char* filePath);
+        void Close();
+        bool IsOpen() const { return m_Header != nullptr; }
+
+        // False when the source file changed since the scene was cooked.
+        // A missing source file is fine, as in builds that only ship cooked scenes.
+        bool IsUpToDate(const char* sourceFilePath) const;
+
+        const CookedSceneHeader& Header() const { return *m_Header; }
+        unsigned int EntityCount() const { return m_Header->entityCount; }
+        const CookedEntity& GetEntity(unsigned int index) const { return m_Entities[index]; }
+
+        // Out of range offsets give ""
+        const char* GetString(unsigned int offset) const;
+
+        // The data of an entity's component of the given type, or null.
+        // dataSize is set to the size of the data.
+        const void* FindComponent(const CookedEntity& entity, eCookedComponents type, unsigned int& dataSize) const;
+
+        // The path a .qscene file is cooked to. "Test.qscene" gives "Test.qscenec".
+        static std::string CookedPath(const char* sourceFilePath);
+
+        // Size and last write time of a file, as stored in headers
+        static bool SourceFileInfo(const char* filePath, unsigned long long& size, long long& writeTime);
+
+    private:
+        MappedFile m_File;
+        const CookedSceneHeader* m_Header = nullptr;
+        const CookedEntity* m_Entities = nullptr;
+        const unsigned char* m_Components = nullptr;
+        const char* m_Strings = nullptr;
+    };
+
+}
+#endif // _Cooked_Scene_H_
@@ -0,0 +1,166 @@
+#include "Prefabs.h"
+#include "SceneJson.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Routines/RenderRoutine.h"
+#include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+#include <map>
+#include <memory>
+#include <unordered_map>
+
+namespace QwerkE {
+
+    namespace Prefabs
+    {
+        static std::unordered_map<std::string, std::unique_ptr<PrefabTemplate>> s_Templates; // By file path
+
+        static const PrefabTransform s_Origin = { { 0.0f, 0.0f, 0.0f }, { 0.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 1.0f } };
+
+        static Mesh* LoadMesh(const char* meshFile, const char* meshName)
+        {
+            // "None" marks meshes made in code rather than loaded from a file
+            if (meshFile[0] == '\0' || strcmp(meshFile, "None") == 0)
+                return Resources::GetMesh(meshName);
+            return Resources::GetMeshFromFile(meshFile, meshName);
+        }
+
+        static std::string TemplateName(const char* filePath)
+        {
+            std::string name = filePath;
+
+            const size_t slash = name.find_last_of("/\\");
+            if (slash != std::string::npos)
+                name.erase(0, slash + 1);
+
+            const size_t dot = name.find_last_of('.');
+            if (dot != std::string::npos)
+                name.erase(dot);
+            return name;
+        }
+
+        // "Renderables": [{ "Name": [{ "Shader": "", "Material": "", "MeshFile": "", "MeshName": "" }], ... }]
+        static bool Compile(const char* filePath, PrefabTemplate& prefab)
+        {
+            char* fileData = LoadCompleteFile(filePath, nullptr);
+            cJSON* root = fileData ? cJSON_Parse(fileData) : nullptr;
+            delete[] fileData;
+            if (root == nullptr)
+                return false;
+
+            prefab.name = TemplateName(filePath);
+
+            cJSON* renderables = SceneJson::GetValues(root, "Renderables");
+            for (cJSON* entry = renderables ? renderables->child : nullptr; entry; entry = entry->next)
+            {
+                cJSON* values = SceneJson::Unwrap(entry);
+                if (values == nullptr || entry->string == nullptr)
+                    continue;
+
+                // The setters can bind mesh attributes to the shader, which
+                // is done here once instead of for every instance
+                Renderable renderable;
+                renderable.SetRenderableName(entry->string);
+                renderable.SetShader(Resources::GetShaderProgram(SceneJson::ReadString(values, "Shader")));
+                renderable.SetMaterial(Resources::GetMaterial(SceneJson::ReadString(values, "Material")));
+                renderable.SetMesh(LoadMesh(SceneJson::ReadString(values, "MeshFile"), SceneJson::ReadString(values, "MeshName")));
+                prefab.renderables.push_back(renderable);
+            }
+
+            cJSON_Delete(root);
+            return true;
+        }
+
+        PrefabTemplate* Load(const char* schematicFilePath)
+        {
+            std::unique_ptr<PrefabTemplate>& prefab = s_Templates[schematicFilePath];
+            if (prefab)
+                return prefab.get();
+
+            PROFILE_SCOPE("Prefab Compile");
+
+            prefab.reset(new PrefabTemplate());
+            if (!Compile(schematicFilePath, *prefab))
+            {
+                LOG_ERROR("Prefabs: Could not read schematic {0}", schematicFilePath);
+                s_Templates.erase(schematicFilePath);
+                return nullptr;
+            }
+
+            LOG_INFO("Prefabs: Compiled {0} with {1} renderables", prefab->name, prefab->renderables.size());
+            return prefab.get();
+        }
+
+        void Clear()
+        {
+            s_Templates.clear();
+        }
+
+        void Instantiate(PrefabTemplate& prefab, Scene* scene, unsigned int count, const PrefabTransform* transforms, std::vector<GameObject*>& instances)
+        {
+            PROFILE_SCOPE("Prefab Instantiate");
+
+            instances.reserve(instances.size() + count);
+
+            const std::map<std::string, GameObject*>* objects = scene ? &scene->GetObjectList() : nullptr;
+
+            // Only the number changes from 1 name to the next
+            std::string name = prefab.name;
+            const size_t prefixLength = name.size();
+            char number[16];
+
+            for (unsigned int i = 0; i < count; i++)
+            {
+                do
+                {
+                    snprintf(number, sizeof(number), "%u", prefab.nextInstance++);
+                    name.replace(prefixLength, std::string::npos, number);
+                } while (objects && objects->find(name) != objects->end());
+
+                const PrefabTransform& transform = transforms ? transforms[i] : s_Origin;
+
+                GameObject* object = new GameObject(scene);
+                object->SetName(name);
+                object->SetPosition(vec3(transform.position[0], transform.position[1], transform.position[2]));
+                object->SetRotation(vec3(transform.rotation[0], transform.rotation[1], transform.rotation[2]));
+                object->SetScale(vec3(transform.scale[0], transform.scale[1], transform.scale[2]));
+
+                RenderComponent* rComp = new RenderComponent();
+                object->AddComponent(rComp);
+                for (const Renderable& renderable : prefab.renderables)
+                {
+                    rComp->AddRenderable(renderable);
+                }
+
+                object->AddDrawRoutine((Routine*) new RenderRoutine());
+                object->GetFirstDrawRoutineOfType(Routine_Render)->Initialize();
+
+                instances.push_back(object);
+            }
+        }
+
+        void Spawn(PrefabTemplate& prefab, Scene* scene, unsigned int count, const PrefabTransform* transforms, std::vector<GameObject*>* instances)
+        {
+            std::vector<GameObject*> spawned;
+            std::vector<GameObject*>& created = instances ? *instances : spawned;
+            const size_t first = created.size();
+
+            Instantiate(prefab, scene, count, transforms, created);
+
+            PROFILE_SCOPE("Prefab Spawn");
+            for (size_t i = first; i < created.size(); i++)
+            {
+                scene->AddObjectToScene(created[i]);
+            }
+        }
+    }
+
+}
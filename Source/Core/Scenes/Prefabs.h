@@ -0,0 +1,56 @@
+#ifndef _Prefabs_H_
+#define _Prefabs_H_
+
+// Object schematics (.osch) compiled once into templates. A template keeps
+// its renderables with their shaders, materials and meshes already looked
+// up and bound, so instancing copies them instead of parsing the schematic
+// and searching Resources again.
+//
+// Instances are plain GameObjects with a RenderComponent and a
+// RenderRoutine, the same as objects loaded from a scene file. Scenes own
+// and delete their objects 1 by 1, so instances are heap allocated like
+// any other GameObject. Everything else is prepared once per template or
+// once per Instantiate() call.
+
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+    class Scene;
+
+    struct PrefabTransform
+    {
+        float position[3];
+        float rotation[3];
+        float scale[3];
+    };
+
+    struct PrefabTemplate
+    {
+        std::string name; // The schematic's file name without extension. Instances are name0, name1, ...
+        std::vector<Renderable> renderables; // Bound, ready to copy
+        unsigned int nextInstance = 0;
+    };
+
+    namespace Prefabs
+    {
+        // Compiles the schematic on first use. Null if it can't be read.
+        // Templates live until Clear().
+        PrefabTemplate* Load(const char* schematicFilePath);
+        void Clear();
+
+        // Creates count objects for scene and appends them to instances
+        // without adding them to it. Names already used in the scene are
+        // skipped. A null transforms places them all at the origin.
+        void Instantiate(PrefabTemplate& prefab, Scene* scene, unsigned int count, const PrefabTransform* transforms, std::vector<GameObject*>& instances);
+
+        // Instantiate(), then adds each object to scene
+        void Spawn(PrefabTemplate& prefab, Scene* scene, unsigned int count, const PrefabTransform* transforms, std::vector<GameObject*>* instances = nullptr);
+    }
+
+}
+#endif // _Prefabs_H_
@@ -0,0 +1,364 @@
+#include "SceneCooker.h"
+#include "SceneJson.h"
+
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstdio>
+#include <cstring>
+
+namespace QwerkE {
+
+    static_assert(sizeof(CookedSceneHeader) == 48, "Cooked scene header layout changed");
+    static_assert(sizeof(CookedEntity) == 72, "Cooked entity layout changed");
+    static_assert(sizeof(CookedComponentHeader) == 8, "Cooked component header layout changed");
+
+    CookedSceneWriter::CookedSceneWriter()
+    {
+        memset(&m_Header, 0, sizeof(m_Header));
+        memcpy(m_Header.magic, CookedScene::s_Magic, sizeof(m_Header.magic));
+        m_Header.version = CookedScene::s_Version;
+
+        m_Strings.push_back('\0'); // Offset 0 is ""
+        m_StringOffsets[""] = 0;
+    }
+
+    void CookedSceneWriter::SetSource(unsigned long long size, long long writeTime)
+    {
+        m_Header.sourceSize = size;
+        m_Header.sourceWriteTime = writeTime;
+    }
+
+    unsigned int CookedSceneWriter::AddString(const char* value)
+    {
+        if (value == nullptr)
+            return 0;
+
+        auto it = m_StringOffsets.find(value);
+        if (it != m_StringOffsets.end())
+            return it->second;
+
+        const unsigned int offset = (unsigned int)m_Strings.size();
+        m_Strings.insert(m_Strings.end(), value, value + strlen(value) + 1);
+        m_StringOffsets[value] = offset;
+        return offset;
+    }
+
+    void CookedSceneWriter::BeginEntity(const char* name, EntityGuid guid, EntityGuid parentGuid, eCookedSceneLists list, int tag, const float position[3], const float rotation[3], const float scale[3])
+    {
+        CookedEntity entity;
+        entity.name = AddString(name);
+        entity.guid[0] = (unsigned int)guid;
+        entity.guid[1] = (unsigned int)(guid >> 32);
+        entity.parentGuid[0] = (unsigned int)parentGuid;
+        entity.parentGuid[1] = (unsigned int)(parentGuid >> 32);
+        entity.list = list;
+        entity.tag = tag;
+        for (int i = 0; i < 3; i++)
+        {
+            entity.position[i] = position[i];
+            entity.rotation[i] = rotation[i];
+            entity.scale[i] = scale[i];
+        }
+        entity.componentsOffset = (unsigned int)m_Components.size();
+        entity.componentsSize = 0;
+        m_Entities.push_back(entity);
+
+        m_RenderOpen = false;
+    }
+
+    size_t CookedSceneWriter::BeginComponent(eCookedComponents type, unsigned int dataSize)
+    {
+        CookedComponentHeader header;
+        header.type = type;
+        header.reserved = 0;
+        header.size = dataSize;
+
+        const size_t headerOffset = m_Components.size();
+        m_Components.resize(headerOffset + sizeof(header) + dataSize);
+        memcpy(&m_Components[headerOffset], &header, sizeof(header));
+
+        m_Entities.back().componentsSize = (unsigned int)(m_Components.size() - m_Entities.back().componentsOffset);
+        m_RenderOpen = false;
+        return headerOffset + sizeof(header);
+    }
+
+    void CookedSceneWriter::AddCamera(int cameraType)
+    {
+        CookedCamera camera;
+        camera.cameraType = cameraType;
+        const size_t offset = BeginComponent(CookedComponent_Camera, sizeof(camera));
+        memcpy(&m_Components[offset], &camera, sizeof(camera));
+    }
+
+    void CookedSceneWriter::AddLight()
+    {
+        BeginComponent(CookedComponent_Light, 0);
+    }
+
+    void CookedSceneWriter::AddRender(const char* schematicName)
+    {
+        CookedRender render;
+        render.schematicName = AddString(schematicName);
+        render.renderableCount = 0;
+
+        const size_t offset = BeginComponent(CookedComponent_Render, sizeof(render));
+        memcpy(&m_Components[offset], &render, sizeof(render));
+
+        m_RenderRecord = offset - sizeof(CookedComponentHeader);
+        m_RenderOpen = true;
+    }
+
+    void CookedSceneWriter::AddRenderable(const char* name, const char* shader, const char* material, const char* meshFile, const char* meshName)
+    {
+        if (!m_RenderOpen)
+            return;
+
+        CookedRenderable renderable;
+        renderable.name = AddString(name);
+        renderable.shader = AddString(shader);
+        renderable.material = AddString(material);
+        renderable.meshFile = AddString(meshFile);
+        renderable.meshName = AddString(meshName);
+
+        const size_t offset = m_Components.size();
+        m_Components.resize(offset + sizeof(renderable));
+        memcpy(&m_Components[offset], &renderable, sizeof(renderable));
+
+        // Grow the open render record
+        CookedComponentHeader* header = (CookedComponentHeader*)&m_Components[m_RenderRecord];
+        header->size += sizeof(renderable);
+        CookedRender* render = (CookedRender*)&m_Components[m_RenderRecord + sizeof(CookedComponentHeader)];
+        render->renderableCount++;
+
+        m_Entities.back().componentsSize += sizeof(renderable);
+    }
+
+    void CookedSceneWriter::AddTransformRoutine(float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3])
+    {
+        CookedTransformRoutine routine;
+        routine.speed = speed;
+        for (int i = 0; i < 3; i++)
+        {
+            routine.positionOffset[i] = positionOffset[i];
+            routine.rotationOffset[i] = rotationOffset[i];
+            routine.scaleOffset[i] = scaleOffset[i];
+        }
+
+        const size_t offset = BeginComponent(CookedComponent_TransformRoutine, sizeof(routine));
+        memcpy(&m_Components[offset], &routine, sizeof(routine));
+    }
+
+    void CookedSceneWriter::AddRenderRoutine()
+    {
+        BeginComponent(CookedComponent_RenderRoutine, 0);
+    }
+
+    static size_t AlignTo4(size_t value)
+    {
+        return (value + 3) & ~(size_t)3;
+    }
+
+    void CookedSceneWriter::Write(std::vector<unsigned char>& out) const
+    {
+        CookedSceneHeader header = m_Header;
+        header.entityCount = (unsigned int)m_Entities.size();
+        header.entitiesOffset = sizeof(CookedSceneHeader);
+        header.componentsOffset = (unsigned int)(header.entitiesOffset + m_Entities.size() * sizeof(CookedEntity));
+        header.componentsSize = (unsigned int)m_Components.size();
+        header.stringsOffset = (unsigned int)AlignTo4(header.componentsOffset + m_Components.size());
+        header.stringsSize = (unsigned int)m_Strings.size();
+
+        out.assign(AlignTo4(header.stringsOffset + m_Strings.size()), 0);
+        memcpy(&out[0], &header, sizeof(header));
+        if (!m_Entities.empty())
+            memcpy(&out[header.entitiesOffset], m_Entities.data(), m_Entities.size() * sizeof(CookedEntity));
+        if (!m_Components.empty())
+            memcpy(&out[header.componentsOffset], m_Components.data(), m_Components.size());
+        memcpy(&out[header.stringsOffset], m_Strings.data(), m_Strings.size());
+    }
+
+    bool CookedSceneWriter::WriteFile(const char* filePath) const
+    {
+        std::vector<unsigned char> data;
+        Write(data);
+
+        FILE* file = fopen(filePath, "wb");
+        if (file == nullptr)
+        {
+            LOG_ERROR("CookedSceneWriter: Could not open {0} for writing", filePath);
+            return false;
+        }
+
+        const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+        fclose(file);
+
+        if (!written)
+        {
+            LOG_ERROR("CookedSceneWriter: Could not write {0}", filePath);
+            remove(filePath);
+        }
+        return written;
+    }
+
+    namespace SceneCooker
+    {
+        using namespace SceneJson;
+
+        static bool CookComponents(cJSON* object, const char* objectName, CookedSceneWriter& writer)
+        {
+            cJSON* components = GetValues(object, "ComponentList");
+            for (cJSON* entry = components ? components->child : nullptr; entry; entry = entry->next)
+            {
+                cJSON* component = Unwrap(entry);
+                const char* componentName = ReadString(component, "ComponentName");
+
+                if (strcmp(componentName, "Camera") == 0)
+                {
+                    // Cooked cameras are made by Factory::CreateFreeCamera()
+                    const int cameraType = (int)ReadNumber(component, "CamType", 0.0);
+                    if (cameraType != 0)
+                    {
+                        LOG_WARN("SceneCooker: {0} has an unsupported camera type {1}", objectName, cameraType);
+                        return false;
+                    }
+                    writer.AddCamera(cameraType);
+                }
+                else if (strcmp(componentName, "Light") == 0)
+                {
+                    writer.AddLight();
+                }
+                else if (strcmp(componentName, "Render") == 0)
+                {
+                    writer.AddRender(ReadString(component, "SchematicName"));
+
+                    cJSON* renderables = GetValues(component, "Renderables");
+                    for (cJSON* item = renderables ? renderables->child : nullptr; item; item = item->next)
+                    {
+                        cJSON* renderable = Unwrap(item);
+                        writer.AddRenderable(item->string ? item->string : "",
+                            ReadString(renderable, "Shader"), ReadString(renderable, "Material"),
+                            ReadString(renderable, "MeshFile"), ReadString(renderable, "MeshName"));
+                    }
+                }
+                else
+                {
+                    LOG_WARN("SceneCooker: {0} has an unsupported component \"{1}\"", objectName, componentName);
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static bool CookRoutines(cJSON* object, const char* objectName, CookedSceneWriter& writer)
+        {
+            cJSON* routines = GetValues(object, "RoutineList");
+
+            cJSON* updateRoutines = GetValues(routines, "UpdateRoutines");
+            for (cJSON* entry = updateRoutines ? updateRoutines->child : nullptr; entry; entry = entry->next)
+            {
+                cJSON* routine = Unwrap(entry);
+                const char* routineName = ReadString(routine, "RoutineName");
+                if (strcmp(routineName, "Transform") != 0)
+                {
+                    LOG_WARN("SceneCooker: {0} has an unsupported update routine \"{1}\"", objectName, routineName);
+                    return false;
+                }
+
+                cJSON* values = GetValues(routine, "TransformValues");
+                float position[3], rotation[3], scale[3];
+                ReadVector(values, "Position", position, 0.0f);
+                ReadVector(values, "Rotation", rotation, 0.0f);
+                ReadVector(values, "Scale", scale, 0.0f);
+                writer.AddTransformRoutine((float)ReadNumber(routine, "Speed", 1.0), position, rotation, scale);
+            }
+
+            cJSON* drawRoutines = GetValues(routines, "DrawRoutines");
+            for (cJSON* entry = drawRoutines ? drawRoutines->child : nullptr; entry; entry = entry->next)
+            {
+                const char* routineName = ReadString(Unwrap(entry), "RoutineName");
+                if (strcmp(routineName, "Render") != 0)
+                {
+                    LOG_WARN("SceneCooker: {0} has an unsupported draw routine \"{1}\"", objectName, routineName);
+                    return false;
+                }
+                writer.AddRenderRoutine();
+            }
+            return true;
+        }
+
+        bool Cook(const char* sourceFilePath, const char* cookedFilePath)
+        {
+            PROFILE_SCOPE("Scene Cook");
+
+            unsigned long long sourceSize;
+            long long sourceWriteTime;
+            if (!CookedScene::SourceFileInfo(sourceFilePath, sourceSize, sourceWriteTime))
+            {
+                LOG_ERROR("SceneCooker: Could not find {0}", sourceFilePath);
+                return false;
+            }
+
+            char* fileData = LoadCompleteFile(sourceFilePath, nullptr);
+            cJSON* root = fileData ? cJSON_Parse(fileData) : nullptr;
+            delete[] fileData;
+
+            if (root == nullptr)
+            {
+                LOG_ERROR("SceneCooker: Error parsing {0}", sourceFilePath);
+                return false;
+            }
+
+            CookedSceneWriter writer;
+            writer.SetSource(sourceSize, sourceWriteTime);
+
+            bool cooked = true;
+            for (int list = 0; list < CookedList_Max && cooked; list++)
+            {
+                cJSON* objects = GetValues(root, s_Lists[list]);
+                for (cJSON* entry = objects ? objects->child : nullptr; entry && cooked; entry = entry->next)
+                {
+                    cJSON* object = Unwrap(entry);
+                    const char* name = entry->string ? entry->string : "";
+
+                    float position[3], rotation[3], scale[3];
+                    ReadVector(object, "Position", position, 0.0f);
+                    ReadVector(object, "Rotation", rotation, 0.0f);
+                    ReadVector(object, "Scale", scale, 1.0f);
+
+                    writer.BeginEntity(name, ReadGuid(object), ReadParentGuid(object), (eCookedSceneLists)list, (int)ReadNumber(object, "ObjectTag", 0.0), position, rotation, scale);
+                    cooked = CookComponents(object, name, writer) && CookRoutines(object, name, writer);
+                }
+            }
+
+            cJSON_Delete(root);
+
+            if (!cooked)
+            {
+                LOG_WARN("SceneCooker: {0} was not cooked. It will load from JSON.", sourceFilePath);
+                return false;
+            }
+
+            if (!writer.WriteFile(cookedFilePath))
+                return false;
+
+            LOG_INFO("SceneCooker: Cooked {0} entities from {1} to {2}", writer.EntityCount(), sourceFilePath, cookedFilePath);
+            return true;
+        }
+
+        bool CookIfStale(const char* sourceFilePath)
+        {
+            const std::string cookedPath = CookedScene::CookedPath(sourceFilePath);
+
+            CookedScene cooked;
+            if (cooked.Open(cookedPath.c_str()) && cooked.IsUpToDate(sourceFilePath))
+                return true;
+            cooked.Close(); // Release the mapping before writing over it
+
+            return Cook(sourceFilePath, cookedPath.c_str());
+        }
+    }
+
+}
@@ -0,0 +1,63 @@
+#ifndef _Scene_Cooker_H_
+#define _Scene_Cooker_H_
+
+// Converts .qscene JSON files to the cooked binary format in CookedScene.h.
+// CookedSceneWriter builds the binary from any source, one entity at a time.
+
+#include "CookedScene.h"
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QwerkE {
+
+    class CookedSceneWriter
+    {
+    public:
+        CookedSceneWriter();
+
+        void SetSource(unsigned long long size, long long writeTime);
+
+        // Components added after belong to this entity
+        void BeginEntity(const char* name, EntityGuid guid, EntityGuid parentGuid, eCookedSceneLists list, int tag, const float position[3], const float rotation[3], const float scale[3]);
+
+        void AddCamera(int cameraType);
+        void AddLight();
+        // Renderables added after belong to this render component
+        void AddRender(const char* schematicName);
+        void AddRenderable(const char* name, const char* shader, const char* material, const char* meshFile, const char* meshName);
+        void AddTransformRoutine(float speed, const float positionOffset[3], const float rotationOffset[3], const float scaleOffset[3]);
+        void AddRenderRoutine();
+
+        size_t EntityCount() const { return m_Entities.size(); }
+
+        void Write(std::vector<unsigned char>& out) const;
+        bool WriteFile(const char* filePath) const;
+
+    private:
+        unsigned int AddString(const char* value);
+        // Returns the offset of the record's data
+        size_t BeginComponent(eCookedComponents type, unsigned int dataSize);
+
+        CookedSceneHeader m_Header;
+        std::vector<CookedEntity> m_Entities;
+        std::vector<unsigned char> m_Components;
+        std::vector<char> m_Strings;
+        std::unordered_map<std::string, unsigned int> m_StringOffsets;
+        size_t m_RenderRecord = 0; // Offset of the open render record's header
+        bool m_RenderOpen = false;
+    };
+
+    namespace SceneCooker
+    {
+        // Returns false, writing nothing, when the scene can't be read or
+        // has content the cooked format can't hold
+        bool Cook(const char* sourceFilePath, const char* cookedFilePath);
+
+        // Cooks when the cooked file is missing or older than the source
+        bool CookIfStale(const char* sourceFilePath);
+    }
+
+}
+#endif // _Scene_Cooker_H_
@@ -0,0 +1,321 @@
+#include "SceneImage.h"
+#include "../Entities/SceneEntities.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Routines/RenderRoutine.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../QwerkE_Framework/Source/Core/Factory/Factory.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstring>
+#include <map>
+
+namespace QwerkE {
+
+    static void CaptureVector(const vec3& value, float out[3])
+    {
+        out[0] = value.x;
+        out[1] = value.y;
+        out[2] = value.z;
+    }
+
+    static std::vector<Renderable>* GetRenderables(RenderComponent* rComp)
+    {
+        return (std::vector<Renderable>*)rComp->LookAtRenderableList();
+    }
+
+    void SceneImage::Capture(Scene* scene, const SceneEntities& entities)
+    {
+        PROFILE_SCOPE("Scene Image Capture");
+
+        Clear();
+        if (scene == nullptr)
+            return;
+
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        const std::vector<GameObject*>& cameras = scene->GetCameraList();
+        const std::vector<GameObject*>& lights = scene->GetLightList();
+
+        m_ObjectCount = objects.size();
+        m_CameraCount = cameras.size();
+        m_LightCount = lights.size();
+        m_Entities.reserve(m_ObjectCount + m_CameraCount + m_LightCount);
+
+        for (const auto& p : objects)
+        {
+            CaptureObject(p.second, CookedList_Object, entities);
+        }
+        for (GameObject* camera : cameras)
+        {
+            CaptureObject(camera, CookedList_Camera, entities);
+        }
+        for (GameObject* light : lights)
+        {
+            CaptureObject(light, CookedList_Light, entities);
+        }
+
+        m_Scene = scene;
+    }
+
+    void SceneImage::CaptureObject(GameObject* object, eCookedSceneLists list, const SceneEntities& entities)
+    {
+        m_Entities.emplace_back();
+        EntityImage& entity = m_Entities.back();
+
+        entity.object = object;
+        entity.name = object->GetName();
+        entity.guid = entities.GetGuid(object);
+        entity.parentGuid = entities.GetGuid(entities.GetParent(object));
+        entity.list = list;
+        entity.tag = (int)object->GetTag();
+        CaptureVector(object->GetPosition(), entity.position);
+        CaptureVector(object->GetRotation(), entity.rotation);
+        CaptureVector(object->GetScale(), entity.scale);
+
+        RenderComponent* rComp = (RenderComponent*)object->GetComponent(Component_Render);
+        entity.hasRender = rComp != nullptr;
+        entity.firstRenderable = (unsigned int)m_Renderables.size();
+        entity.renderableCount = 0;
+        if (rComp)
+        {
+            std::vector<Renderable>* renderables = GetRenderables(rComp);
+            for (Renderable& renderable : *renderables)
+            {
+                RenderableImage image;
+                image.name = renderable.GetRenderableName();
+                image.shader = renderable.GetShaderSchematic();
+                image.material = renderable.GetMaterialSchematic();
+                image.mesh = renderable.GetMesh();
+                m_Renderables.push_back(image);
+            }
+            entity.renderableCount = (unsigned int)renderables->size();
+        }
+
+        entity.hasRenderRoutine = object->GetFirstDrawRoutineOfType(Routine_Render) != nullptr;
+        entity.hasTransformRoutine = entities.GetTransformRoutine(object, entity.routineSpeed,
+            entity.routinePositionOffset, entity.routineRotationOffset, entity.routineScaleOffset);
+    }
+
+    bool SceneImage::Restore(Scene* scene, SceneEntities& entities)
+    {
+        if (scene == nullptr || scene != m_Scene)
+            return false;
+
+        if (CanRestoreInPlace(scene))
+        {
+            PROFILE_SCOPE("Scene Image Restore");
+            RestoreInPlace(entities);
+        }
+        else
+        {
+            PROFILE_SCOPE("Scene Image Rebuild");
+            Rebuild(scene, entities);
+            LOG_INFO("SceneImage: Rebuilt {0} entities, as the scene's objects changed", m_Entities.size());
+        }
+        return true;
+    }
+
+    void SceneImage::Clear()
+    {
+        m_Entities.clear();
+        m_Renderables.clear();
+        m_ObjectCount = 0;
+        m_CameraCount = 0;
+        m_LightCount = 0;
+        m_Scene = nullptr;
+    }
+
+    bool SceneImage::CanRestoreInPlace(Scene* scene) const
+    {
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        const std::vector<GameObject*>& cameras = scene->GetCameraList();
+        const std::vector<GameObject*>& lights = scene->GetLightList();
+
+        if (objects.size() != m_ObjectCount || cameras.size() != m_CameraCount || lights.size() != m_LightCount)
+            return false;
+
+        // Same counts, so the captured objects being there means nothing was added
+        size_t index = 0;
+        for (const EntityImage& entity : m_Entities)
+        {
+            switch (entity.list)
+            {
+            case CookedList_Camera:
+                if (cameras[index - m_ObjectCount] != entity.object)
+                    return false;
+                break;
+            case CookedList_Light:
+                if (lights[index - m_ObjectCount - m_CameraCount] != entity.object)
+                    return false;
+                break;
+            default:
+            {
+                auto it = objects.find(entity.name);
+                if (it == objects.end() || it->second != entity.object)
+                    return false;
+                break;
+            }
+            }
+            index++;
+
+            GameObject* object = entity.object;
+            RenderComponent* rComp = (RenderComponent*)object->GetComponent(Component_Render);
+            if ((rComp != nullptr) != entity.hasRender)
+                return false;
+            if (rComp && GetRenderables(rComp)->size() != entity.renderableCount)
+                return false;
+            if ((object->GetFirstDrawRoutineOfType(Routine_Render) != nullptr) != entity.hasRenderRoutine)
+                return false;
+        }
+        return true;
+    }
+
+    void SceneImage::RestoreInPlace(SceneEntities& entities) const
+    {
+        for (const EntityImage& entity : m_Entities)
+        {
+            RestoreObject(entity, entity.object, entities);
+        }
+        RestoreParents(entities);
+
+        // Transforms and meshes changed, and with them bounds
+        entities.Invalidate();
+    }
+
+    void SceneImage::RestoreParents(SceneEntities& entities) const
+    {
+        for (const EntityImage& entity : m_Entities)
+        {
+            GameObject* object = entity.guid ? entities.FindByGuid(entity.guid) : nullptr;
+            if (object)
+                entities.SetParent(object, entity.parentGuid ? entities.FindByGuid(entity.parentGuid) : nullptr);
+        }
+    }
+
+    void SceneImage::RestoreObject(const EntityImage& entity, GameObject* object, SceneEntities& entities) const
+    {
+        object->SetTag((eGameObjectTags)entity.tag);
+        object->SetPosition(vec3(entity.position[0], entity.position[1], entity.position[2]));
+        object->SetRotation(vec3(entity.rotation[0], entity.rotation[1], entity.rotation[2]));
+        object->SetScale(vec3(entity.scale[0], entity.scale[1], entity.scale[2]));
+
+        RenderComponent* rComp = (RenderComponent*)object->GetComponent(Component_Render);
+        if (entity.hasRender && rComp && GetRenderables(rComp)->size() == entity.renderableCount)
+        {
+            std::vector<Renderable>* renderables = GetRenderables(rComp);
+            for (unsigned int i = 0; i < entity.renderableCount; i++)
+            {
+                const RenderableImage& image = m_Renderables[entity.firstRenderable + i];
+                Renderable& renderable = renderables->at(i);
+
+                // Setters can rebind mesh attributes, so skip unchanged ones
+                if (renderable.GetRenderableName() != image.name)
+                    renderable.SetRenderableName(image.name);
+                if (renderable.GetShaderSchematic() != image.shader)
+                    renderable.SetShader(image.shader);
+                if (renderable.GetMaterialSchematic() != image.material)
+                    renderable.SetMaterial(image.material);
+                if (renderable.GetMesh() != image.mesh)
+                    renderable.SetMesh(image.mesh);
+            }
+        }
+
+        float speed, positionOffset[3], rotationOffset[3], scaleOffset[3];
+        const bool hasTransformRoutine = entities.GetTransformRoutine(object, speed, positionOffset, rotationOffset, scaleOffset);
+        if (entity.hasTransformRoutine)
+        {
+            const bool changed = !hasTransformRoutine || speed != entity.routineSpeed ||
+                memcmp(positionOffset, entity.routinePositionOffset, sizeof(positionOffset)) != 0 ||
+                memcmp(rotationOffset, entity.routineRotationOffset, sizeof(rotationOffset)) != 0 ||
+                memcmp(scaleOffset, entity.routineScaleOffset, sizeof(scaleOffset)) != 0;
+            if (changed)
+                entities.AddTransformRoutine(object, entity.routineSpeed, entity.routinePositionOffset, entity.routineRotationOffset, entity.routineScaleOffset);
+        }
+        else if (hasTransformRoutine)
+        {
+            entities.RemoveTransformRoutine(object);
+        }
+    }
+
+    GameObject* SceneImage::CreateObject(Scene* scene, const EntityImage& entity) const
+    {
+        const vec3 position(entity.position[0], entity.position[1], entity.position[2]);
+
+        GameObject* object;
+        switch (entity.list)
+        {
+        case CookedList_Camera:
+            object = Factory::CreateFreeCamera(scene, position);
+            break;
+        case CookedList_Light:
+            object = Factory::CreateLight(scene, position);
+            break;
+        default:
+            object = new GameObject(scene);
+            break;
+        }
+        object->SetName(entity.name);
+
+        // Factory made objects can come with their own
+        if (entity.hasRender && object->GetComponent(Component_Render) == nullptr)
+        {
+            RenderComponent* rComp = new RenderComponent();
+            object->AddComponent(rComp);
+
+            for (unsigned int i = 0; i < entity.renderableCount; i++)
+            {
+                const RenderableImage& image = m_Renderables[entity.firstRenderable + i];
+
+                Renderable renderable;
+                renderable.SetRenderableName(image.name);
+                renderable.SetShader(image.shader);
+                renderable.SetMaterial(image.material);
+                renderable.SetMesh(image.mesh);
+                rComp->AddRenderable(renderable);
+            }
+        }
+
+        if (entity.hasRenderRoutine && object->GetFirstDrawRoutineOfType(Routine_Render) == nullptr)
+        {
+            object->AddDrawRoutine((Routine*) new RenderRoutine());
+            object->GetFirstDrawRoutineOfType(Routine_Render)->Initialize();
+        }
+
+        return object;
+    }
+
+    void SceneImage::Rebuild(Scene* scene, SceneEntities& entities)
+    {
+        scene->RemoveAllObjectsFromScene();
+        entities.Reset();
+
+        for (EntityImage& entity : m_Entities)
+        {
+            GameObject* object = CreateObject(scene, entity);
+            entities.SetGuid(object, entity.guid);
+            RestoreObject(entity, object, entities);
+
+            switch (entity.list)
+            {
+            case CookedList_Camera:
+                scene->AddCamera(object);
+                break;
+            case CookedList_Light:
+                scene->AddLight(object);
+                break;
+            default:
+                scene->AddObjectToScene(object);
+                break;
+            }
+        }
+        RestoreParents(entities);
+
+        // Factory made cameras and lights can differ from the image, so take
+        // it again to restore in place next time
+        Capture(scene, entities);
+    }
+
+}
@@ -0,0 +1,98 @@
+#ifndef _Scene_Image_H_
+#define _Scene_Image_H_
+
+// In memory copy of a scene's objects for resetting it without going back
+// to disk. Unlike a SceneSnapshot, renderables keep pointers to their
+// resident shaders, materials and meshes instead of names, so nothing is
+// looked up or loaded on Restore().
+//
+// Restore() writes the captured state back into the same GameObjects when
+// the scene still holds them, which costs about as much as copying the
+// transforms. Objects added, removed or given new components since
+// Capture() make it rebuild the scene from the image instead. Content the
+// image doesn't hold, like physics components and update routines owned
+// by the framework, is only kept by an in place restore.
+
+#include "CookedScene.h"
+
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+    class Material;
+    class Mesh;
+    class Scene;
+    class SceneEntities;
+    class ShaderProgram;
+
+    class SceneImage
+    {
+    public:
+        void Capture(Scene* scene, const SceneEntities& entities);
+
+        // entities must mirror scene. False if the image is of another scene.
+        bool Restore(Scene* scene, SceneEntities& entities);
+
+        void Clear();
+        bool IsEmpty() const { return m_Scene == nullptr; }
+        Scene* GetScene() const { return m_Scene; }
+
+    private:
+        struct RenderableImage
+        {
+            std::string name;
+            ShaderProgram* shader;
+            Material* material;
+            Mesh* mesh;
+        };
+
+        struct EntityImage
+        {
+            GameObject* object;
+            std::string name;
+            EntityGuid guid;
+            EntityGuid parentGuid;
+            eCookedSceneLists list;
+            int tag; // eGameObjectTags
+            float position[3];
+            float rotation[3];
+            float scale[3];
+
+            bool hasRender;
+            unsigned int firstRenderable; // Into m_Renderables
+            unsigned int renderableCount;
+
+            bool hasRenderRoutine;
+
+            bool hasTransformRoutine;
+            float routineSpeed;
+            float routinePositionOffset[3];
+            float routineRotationOffset[3];
+            float routineScaleOffset[3];
+        };
+
+        void CaptureObject(GameObject* object, eCookedSceneLists list, const SceneEntities& entities);
+
+        // True when every captured object is still in the scene, in the
+        // same list and with the same kinds of components
+        bool CanRestoreInPlace(Scene* scene) const;
+        void RestoreInPlace(SceneEntities& entities) const;
+        void Rebuild(Scene* scene, SceneEntities& entities);
+
+        void RestoreObject(const EntityImage& entity, GameObject* object, SceneEntities& entities) const;
+        // After every object has its GUID and transform
+        void RestoreParents(SceneEntities& entities) const;
+        GameObject* CreateObject(Scene* scene, const EntityImage& entity) const;
+
+        std::vector<EntityImage> m_Entities; // Objects, then cameras, then lights
+        std::vector<RenderableImage> m_Renderables;
+        size_t m_ObjectCount = 0;
+        size_t m_CameraCount = 0;
+        size_t m_LightCount = 0;
+        Scene* m_Scene = nullptr;
+    };
+
+}
+#endif // _Scene_Image_H_
@@ -0,0 +1,701 @@
+#include "SceneJournal.h"
+#include "SceneJson.h"
+
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../FileSystem/MappedFile.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <unordered_map>
+
+namespace QwerkE {
+
+    static_assert(sizeof(SceneJournalHeader) == 24, "Scene journal header layout changed");
+
+    namespace SceneJournal
+    {
+        using namespace SceneJson;
+
+        const char s_Magic[4] = { 'Q', 'J', 'N', 'L' };
+
+        // Journals are appended by the save thread and compacted by loads
+        static std::mutex s_FileMutex;
+
+        enum eEntryFlags : unsigned char
+        {
+            EntryFlag_Render = 1 << 0,
+            EntryFlag_RenderRoutine = 1 << 1,
+            EntryFlag_TransformRoutine = 1 << 2,
+        };
+
+        struct EntryHeader
+        {
+            unsigned char op; // eSceneJournalOps
+            unsigned char list; // eCookedSceneLists
+            unsigned char flags; // eEntryFlags
+            unsigned char reserved;
+            unsigned int guid[2]; // EntityGuid, low word first
+            unsigned int parentGuid[2];
+            int tag;
+            float position[3];
+            float rotation[3];
+            float scale[3];
+        };
+
+        struct BatchHeader
+        {
+            unsigned int entryCount;
+            unsigned int size; // Bytes of entries
+        };
+
+        std::string JournalPath(const char* sceneFilePath)
+        {
+            std::string path = sceneFilePath;
+            const size_t dot = path.find_last_of('.');
+            const size_t slash = path.find_last_of("/\\");
+            if (dot != std::string::npos && (slash == std::string::npos || dot > slash))
+                path.resize(dot);
+            return path + ".qjournal";
+        }
+
+        unsigned long long Size(const char* sceneFilePath)
+        {
+            unsigned long long size;
+            long long writeTime;
+            if (!CookedScene::SourceFileInfo(JournalPath(sceneFilePath).c_str(), size, writeTime))
+                return 0;
+            return size;
+        }
+
+        static bool IsJournalOf(const SceneJournalHeader& header, const char* sceneFilePath)
+        {
+            if (memcmp(header.magic, s_Magic, sizeof(s_Magic)) != 0 || header.version != s_Version)
+                return false;
+
+            unsigned long long size;
+            long long writeTime;
+            return CookedScene::SourceFileInfo(sceneFilePath, size, writeTime) &&
+                size == header.sceneSize && writeTime == header.sceneWriteTime;
+        }
+
+        static void WriteBytes(std::vector<unsigned char>& out, const void* data, size_t size)
+        {
+            const unsigned char* bytes = (const unsigned char*)data;
+            out.insert(out.end(), bytes, bytes + size);
+        }
+
+        static void WriteString(std::vector<unsigned char>& out, const std::string& value)
+        {
+            const unsigned short length = (unsigned short)std::min<size_t>(value.size(), 0xFFFF);
+            WriteBytes(out, &length, sizeof(length));
+            WriteBytes(out, value.data(), length);
+        }
+
+        static void WriteEntry(std::vector<unsigned char>& out, eSceneJournalOps op, const EntitySnapshot& entity)
+        {
+            EntryHeader header;
+            memset(&header, 0, sizeof(header));
+            header.op = op;
+            header.list = entity.list;
+            header.guid[0] = (unsigned int)entity.guid;
+            header.guid[1] = (unsigned int)(entity.guid >> 32);
+
+            if (op == SceneJournalOp_Upsert)
+            {
+                header.flags = (entity.hasRender ? EntryFlag_Render : 0) |
+                    (entity.hasRenderRoutine ? EntryFlag_RenderRoutine : 0) |
+                    (entity.hasTransformRoutine ? EntryFlag_TransformRoutine : 0);
+                header.parentGuid[0] = (unsigned int)entity.parentGuid;
+                header.parentGuid[1] = (unsigned int)(entity.parentGuid >> 32);
+                header.tag = entity.tag;
+                memcpy(header.position, entity.position, sizeof(header.position));
+                memcpy(header.rotation, entity.rotation, sizeof(header.rotation));
+                memcpy(header.scale, entity.scale, sizeof(header.scale));
+            }
+            WriteBytes(out, &header, sizeof(header));
+
+            if (header.flags & EntryFlag_TransformRoutine)
+            {
+                WriteBytes(out, &entity.routineSpeed, sizeof(float));
+                WriteBytes(out, entity.routinePositionOffset, sizeof(float) * 3);
+                WriteBytes(out, entity.routineRotationOffset, sizeof(float) * 3);
+                WriteBytes(out, entity.routineScaleOffset, sizeof(float) * 3);
+            }
+
+            WriteString(out, entity.name);
+
+            if (header.flags & EntryFlag_Render)
+            {
+                WriteString(out, entity.schematicName);
+                const unsigned int count = (unsigned int)entity.renderables.size();
+                WriteBytes(out, &count, sizeof(count));
+                for (const RenderableSnapshot& renderable : entity.renderables)
+                {
+                    WriteString(out, renderable.name);
+                    WriteString(out, renderable.shader);
+                    WriteString(out, renderable.material);
+                    WriteString(out, renderable.mesh);
+                }
+            }
+        }
+
+        bool Append(const char* sceneFilePath, const std::vector<const EntitySnapshot*>& upserts, const std::vector<const EntitySnapshot*>& removals)
+        {
+            PROFILE_SCOPE("Scene Journal Append");
+
+            std::lock_guard<std::mutex> lock(s_FileMutex);
+
+            const std::string journalPath = JournalPath(sceneFilePath);
+
+            bool startJournal = true;
+            if (FILE* existing = fopen(journalPath.c_str(), "rb"))
+            {
+                SceneJournalHeader header;
+                if (fread(&header, sizeof(header), 1, existing) == 1 && IsJournalOf(header, sceneFilePath))
+                    startJournal = false;
+                else
+                    LOG_WARN("SceneJournal: {0} is out of date with {1}. Starting a new journal.", journalPath.c_str(), sceneFilePath);
+                fclose(existing);
+            }
+
+            std::vector<unsigned char> data;
+            if (startJournal)
+            {
+                SceneJournalHeader header;
+                memset(&header, 0, sizeof(header));
+                memcpy(header.magic, s_Magic, sizeof(header.magic));
+                header.version = s_Version;
+                if (!CookedScene::SourceFileInfo(sceneFilePath, header.sceneSize, header.sceneWriteTime))
+                {
+                    LOG_ERROR("SceneJournal: Could not find {0}", sceneFilePath);
+                    return false;
+                }
+                WriteBytes(data, &header, sizeof(header));
+            }
+
+            const size_t batchOffset = data.size();
+            BatchHeader batch;
+            batch.entryCount = (unsigned int)(upserts.size() + removals.size());
+            batch.size = 0;
+            WriteBytes(data, &batch, sizeof(batch));
+
+            // Removals first, so a new entity can take a removed one's name
+            for (const EntitySnapshot* entity : removals)
+            {
+                WriteEntry(data, SceneJournalOp_Remove, *entity);
+            }
+            for (const EntitySnapshot* entity : upserts)
+            {
+                WriteEntry(data, SceneJournalOp_Upsert, *entity);
+            }
+
+            batch.size = (unsigned int)(data.size() - batchOffset - sizeof(batch));
+            memcpy(&data[batchOffset], &batch, sizeof(batch));
+
+            FILE* file = fopen(journalPath.c_str(), startJournal ? "wb" : "ab");
+            if (file == nullptr)
+            {
+                LOG_ERROR("SceneJournal: Could not open {0} for writing", journalPath.c_str());
+                return false;
+            }
+
+            const bool written = fwrite(data.data(), 1, data.size(), file) == data.size();
+            if (fclose(file) != 0 || !written)
+            {
+                LOG_ERROR("SceneJournal: Could not write {0}", journalPath.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        struct Reader
+        {
+            const unsigned char* data;
+            size_t size;
+            size_t offset = 0;
+
+            bool ReadBytes(void* out, size_t count)
+            {
+                if (count > size - offset)
+                    return false;
+                memcpy(out, data + offset, count);
+                offset += count;
+                return true;
+            }
+
+            bool ReadString(std::string& out)
+            {
+                unsigned short length;
+                if (!ReadBytes(&length, sizeof(length)) || length > size - offset)
+                    return false;
+                out.assign((const char*)data + offset, length);
+                offset += length;
+                return true;
+            }
+        };
+
+        static bool ReadEntry(Reader& reader, SceneJournalEntry& entry)
+        {
+            EntryHeader header;
+            if (!reader.ReadBytes(&header, sizeof(header)) || header.op >= SceneJournalOp_Max || header.list >= CookedList_Max)
+                return false;
+
+            EntitySnapshot& entity = entry.entity;
+            entry.op = (eSceneJournalOps)header.op;
+            entity.guid = ((EntityGuid)header.guid[1] << 32) | header.guid[0];
+            entity.parentGuid = ((EntityGuid)header.parentGuid[1] << 32) | header.parentGuid[0];
+            entity.list = (eCookedSceneLists)header.list;
+            entity.tag = header.tag;
+            memcpy(entity.position, header.position, sizeof(entity.position));
+            memcpy(entity.rotation, header.rotation, sizeof(entity.rotation));
+            memcpy(entity.scale, header.scale, sizeof(entity.scale));
+            entity.hasRender = (header.flags & EntryFlag_Render) != 0;
+            entity.hasRenderRoutine = (header.flags & EntryFlag_RenderRoutine) != 0;
+            entity.hasTransformRoutine = (header.flags & EntryFlag_TransformRoutine) != 0;
+
+            if (entity.hasTransformRoutine &&
+                !(reader.ReadBytes(&entity.routineSpeed, sizeof(float)) &&
+                reader.ReadBytes(entity.routinePositionOffset, sizeof(float) * 3) &&
+                reader.ReadBytes(entity.routineRotationOffset, sizeof(float) * 3) &&
+                reader.ReadBytes(entity.routineScaleOffset, sizeof(float) * 3)))
+                return false;
+
+            if (!reader.ReadString(entity.name))
+                return false;
+
+            if (entity.hasRender)
+            {
+                unsigned int count;
+                if (!reader.ReadString(entity.schematicName) || !reader.ReadBytes(&count, sizeof(count)))
+                    return false;
+
+                // At least 8 bytes each, so a corrupt count can't allocate much
+                if (count > (reader.size - reader.offset) / 8)
+                    return false;
+
+                entity.renderables.resize(count);
+                for (RenderableSnapshot& renderable : entity.renderables)
+                {
+                    if (!reader.ReadString(renderable.name) || !reader.ReadString(renderable.shader) ||
+                        !reader.ReadString(renderable.material) || !reader.ReadString(renderable.mesh))
+                        return false;
+                }
+            }
+            return true;
+        }
+
+        static bool ReadLocked(const char* sceneFilePath, std::vector<SceneJournalEntry>& entries)
+        {
+            const std::string journalPath = JournalPath(sceneFilePath);
+
+            MappedFile file;
+            if (!file.Open(journalPath.c_str()))
+                return false;
+
+            if (file.Size() < sizeof(SceneJournalHeader) || !IsJournalOf(*(const SceneJournalHeader*)file.Data(), sceneFilePath))
+            {
+                LOG_WARN("SceneJournal: {0} is out of date with {1}", journalPath.c_str(), sceneFilePath);
+                return false;
+            }
+
+            Reader reader = { file.Data(), file.Size(), sizeof(SceneJournalHeader) };
+            BatchHeader batch;
+            while (reader.ReadBytes(&batch, sizeof(batch)))
+            {
+                if (batch.size > reader.size - reader.offset)
+                    break; // Torn write
+
+                Reader batchReader = { reader.data + reader.offset, batch.size };
+                reader.offset += batch.size;
+
+                const size_t batchStart = entries.size();
+                entries.resize(batchStart + batch.entryCount);
+                for (unsigned int i = 0; i < batch.entryCount; i++)
+                {
+                    if (!ReadEntry(batchReader, entries[batchStart + i]))
+                    {
+                        LOG_ERROR("SceneJournal: {0} has a corrupt batch. Later changes are lost.", journalPath.c_str());
+                        entries.resize(batchStart);
+                        return true;
+                    }
+                }
+            }
+            return true;
+        }
+
+        bool Read(const char* sceneFilePath, std::vector<SceneJournalEntry>& entries)
+        {
+            std::lock_guard<std::mutex> lock(s_FileMutex);
+            return ReadLocked(sceneFilePath, entries);
+        }
+
+        // Keys are eComponentTags and eRoutineTypes, as the framework writes them
+        static const char* s_CameraKey = "0";
+        static const char* s_LightKey = "2";
+        static const char* s_RenderKey = "4";
+        static const char* s_RenderRoutineKey = "0";
+        static const char* s_TransformRoutineKey = "2";
+
+        // Key of the first child with the given name value, or ""
+        static std::string FindKey(cJSON* object, const char* nameKey, const char* name)
+        {
+            for (cJSON* child = object->child; child; child = child->next)
+            {
+                if (child->string && strcmp(ReadString(Unwrap(child), nameKey), name) == 0)
+                    return child->string;
+            }
+            return std::string();
+        }
+
+        static cJSON* CreateRender(const EntitySnapshot& entity, const std::unordered_map<std::string, std::string>& meshFiles)
+        {
+            cJSON* render = cJSON_CreateObject();
+            cJSON_AddItemToObject(render, "ComponentName", cJSON_CreateString("Render"));
+            cJSON_AddItemToObject(render, "SchematicName", cJSON_CreateString(entity.schematicName.c_str()));
+
+            cJSON* renderables = cJSON_CreateObject();
+            for (const RenderableSnapshot& renderable : entity.renderables)
+            {
+                // Meshes made in code have no file
+                auto meshFile = meshFiles.find(renderable.mesh);
+
+                cJSON* values = cJSON_CreateObject();
+                cJSON_AddItemToObject(values, "Shader", cJSON_CreateString(renderable.shader.c_str()));
+                cJSON_AddItemToObject(values, "Material", cJSON_CreateString(renderable.material.c_str()));
+                cJSON_AddItemToObject(values, "MeshFile", cJSON_CreateString(meshFile != meshFiles.end() ? meshFile->second.c_str() : "None"));
+                cJSON_AddItemToObject(values, "MeshName", cJSON_CreateString(renderable.mesh.c_str()));
+                cJSON_AddItemToObject(renderables, renderable.name.c_str(), Wrap(values));
+            }
+            cJSON_AddItemToObject(render, "Renderables", Wrap(renderables));
+            return render;
+        }
+
+        static cJSON* CreateRoutine(const char* routineName)
+        {
+            cJSON* routine = cJSON_CreateObject();
+            cJSON_AddItemToObject(routine, "RoutineName", cJSON_CreateString(routineName));
+            return routine;
+        }
+
+        static cJSON* CreateTransformRoutine(const EntitySnapshot& entity)
+        {
+            cJSON* routine = CreateRoutine("Transform");
+            cJSON_AddItemToObject(routine, "Speed", cJSON_CreateNumber(entity.routineSpeed));
+
+            cJSON* values = cJSON_CreateObject();
+            cJSON_AddItemToObject(values, "Position", CreateVector("Position", entity.routinePositionOffset));
+            cJSON_AddItemToObject(values, "Rotation", CreateVector("Rotation", entity.routineRotationOffset));
+            cJSON_AddItemToObject(values, "Scale", CreateVector("Scale", entity.routineScaleOffset));
+            cJSON_AddItemToObject(routine, "TransformValues", Wrap(values));
+            return routine;
+        }
+
+        static void SetTransform(cJSON* object, const EntitySnapshot& entity)
+        {
+            SetItem(object, "Position", CreateVector("Position", entity.position));
+            SetItem(object, "Rotation", CreateVector("Rotation", entity.rotation));
+            SetItem(object, "Scale", CreateVector("Scale", entity.scale));
+            SetItem(object, "ObjectTag", cJSON_CreateNumber(entity.tag));
+            SetParentGuid(object, entity.parentGuid);
+        }
+
+        static void SetRender(cJSON* object, const EntitySnapshot& entity, const std::unordered_map<std::string, std::string>& meshFiles)
+        {
+            cJSON* components = GetOrAddValues(object, "ComponentList");
+            const std::string renderKey = FindKey(components, "ComponentName", "Render");
+            if (entity.hasRender)
+                SetItem(components, renderKey.empty() ? s_RenderKey : renderKey.c_str(), Wrap(CreateRender(entity, meshFiles)));
+            else if (!renderKey.empty())
+                cJSON_DeleteItemFromObject(components, renderKey.c_str());
+        }
+
+        // Update routines other than batched transforms are not captured,
+        // so they are left as they are
+        static void SetRoutines(cJSON* object, const EntitySnapshot& entity)
+        {
+            cJSON* routines = GetOrAddValues(object, "RoutineList");
+
+            cJSON* updateRoutines = GetOrAddValues(routines, "UpdateRoutines");
+            if (entity.hasTransformRoutine)
+            {
+                const std::string key = FindKey(updateRoutines, "RoutineName", "Transform");
+                SetItem(updateRoutines, key.empty() ? s_TransformRoutineKey : key.c_str(), Wrap(CreateTransformRoutine(entity)));
+            }
+
+            cJSON* drawRoutines = GetOrAddValues(routines, "DrawRoutines");
+            const std::string renderKey = FindKey(drawRoutines, "RoutineName", "Render");
+            if (entity.hasRenderRoutine && renderKey.empty())
+                cJSON_AddItemToObject(drawRoutines, s_RenderRoutineKey, Wrap(CreateRoutine("Render")));
+            else if (!entity.hasRenderRoutine && !renderKey.empty())
+                cJSON_DeleteItemFromObject(drawRoutines, renderKey.c_str());
+        }
+
+        static cJSON* CreateEntity(const EntitySnapshot& entity, const std::unordered_map<std::string, std::string>& meshFiles)
+        {
+            cJSON* object = cJSON_CreateObject();
+            SetTransform(object, entity);
+            SetGuid(object, entity.guid);
+
+            cJSON* components = GetOrAddValues(object, "ComponentList");
+            if (entity.list == CookedList_Camera)
+            {
+                cJSON* camera = cJSON_CreateObject();
+                cJSON_AddItemToObject(camera, "ComponentName", cJSON_CreateString("Camera"));
+                cJSON_AddItemToObject(camera, "CamType", cJSON_CreateNumber(0)); // Free camera
+                cJSON_AddItemToObject(components, s_CameraKey, Wrap(camera));
+            }
+            else if (entity.list == CookedList_Light)
+            {
+                cJSON* light = cJSON_CreateObject();
+                cJSON_AddItemToObject(light, "ComponentName", cJSON_CreateString("Light"));
+                cJSON_AddItemToObject(components, s_LightKey, Wrap(light));
+            }
+
+            SetRender(object, entity, meshFiles);
+            SetRoutines(object, entity);
+            return object;
+        }
+
+        static cJSON* ParseScene(const char* sceneFilePath)
+        {
+            char* fileData = LoadCompleteFile(sceneFilePath, nullptr);
+            cJSON* root = fileData ? cJSON_Parse(fileData) : nullptr;
+            delete[] fileData;
+
+            if (root == nullptr)
+                LOG_ERROR("SceneJournal: Error parsing {0}", sceneFilePath);
+            return root;
+        }
+
+        static bool WriteScene(const char* sceneFilePath, cJSON* root)
+        {
+            char* text = cJSON_Print(root);
+            if (text == nullptr)
+                return false;
+
+            // Written beside the scene first so a failed write leaves it intact
+            const std::string tempPath = std::string(sceneFilePath) + ".tmp";
+            FILE* file = fopen(tempPath.c_str(), "wb");
+            bool written = false;
+            if (file)
+            {
+                const size_t length = strlen(text);
+                written = fwrite(text, 1, length, file) == length;
+                written = fclose(file) == 0 && written;
+            }
+            free(text);
+
+            if (!written)
+            {
+                LOG_ERROR("SceneJournal: Could not write {0}", tempPath.c_str());
+                remove(tempPath.c_str());
+                return false;
+            }
+
+            remove(sceneFilePath); // rename() won't replace files on Windows
+            if (rename(tempPath.c_str(), sceneFilePath) != 0)
+            {
+                LOG_ERROR("SceneJournal: Could not replace {0} with {1}", sceneFilePath, tempPath.c_str());
+                return false;
+            }
+            return true;
+        }
+
+        bool Compact(const char* sceneFilePath)
+        {
+            PROFILE_SCOPE("Scene Journal Compact");
+
+            std::lock_guard<std::mutex> lock(s_FileMutex);
+
+            const std::string journalPath = JournalPath(sceneFilePath);
+            if (!FileExists(journalPath.c_str()))
+                return true;
+
+            std::vector<SceneJournalEntry> entries;
+            if (!ReadLocked(sceneFilePath, entries))
+            {
+                remove(journalPath.c_str());
+                return false;
+            }
+
+            cJSON* root = ParseScene(sceneFilePath);
+            if (root == nullptr)
+                return false;
+
+            cJSON* lists[CookedList_Max];
+            std::unordered_map<std::string, cJSON*> objects[CookedList_Max];
+            std::unordered_map<EntityGuid, std::string> guidNames[CookedList_Max];
+            std::unordered_map<std::string, std::string> meshFiles; // Mesh name to file
+            for (int list = 0; list < CookedList_Max; list++)
+            {
+                lists[list] = GetOrAddValues(root, s_Lists[list]);
+                for (cJSON* entry = lists[list]->child; entry; entry = entry->next)
+                {
+                    if (entry->string == nullptr)
+                        continue;
+
+                    cJSON* object = Unwrap(entry);
+                    objects[list][entry->string] = object;
+                    if (const EntityGuid guid = ReadGuid(object))
+                        guidNames[list][guid] = entry->string;
+
+                    cJSON* components = GetValues(object, "ComponentList");
+                    const std::string renderKey = components ? FindKey(components, "ComponentName", "Render") : std::string();
+                    cJSON* renderables = renderKey.empty() ? nullptr : GetValues(GetValues(components, renderKey.c_str()), "Renderables");
+                    for (cJSON* item = renderables ? renderables->child : nullptr; item; item = item->next)
+                    {
+                        cJSON* renderable = Unwrap(item);
+                        const char* meshFile = ReadString(renderable, "MeshFile");
+                        if (meshFile[0] != '\0' && strcmp(meshFile, "None") != 0)
+                            meshFiles[ReadString(renderable, "MeshName")] = meshFile;
+                    }
+                }
+            }
+
+            for (const SceneJournalEntry& entry : entries)
+            {
+                const EntitySnapshot& entity = entry.entity;
+                std::unordered_map<std::string, cJSON*>& listObjects = objects[entity.list];
+                std::unordered_map<EntityGuid, std::string>& listGuids = guidNames[entity.list];
+
+                // By GUID, or by name for entities saved before they had one
+                auto existing = listObjects.end();
+                auto guidName = entity.guid ? listGuids.find(entity.guid) : listGuids.end();
+                if (guidName != listGuids.end())
+                {
+                    existing = listObjects.find(guidName->second);
+                }
+                else
+                {
+                    existing = listObjects.find(entity.name);
+                    if (existing != listObjects.end() && entity.guid != 0 && ReadGuid(existing->second) != 0)
+                        existing = listObjects.end(); // Another entity with the same name
+                }
+
+                if (entry.op == SceneJournalOp_Remove)
+                {
+                    if (existing != listObjects.end())
+                    {
+                        listGuids.erase(ReadGuid(existing->second));
+                        cJSON_DeleteItemFromObject(lists[entity.list], existing->first.c_str());
+                        listObjects.erase(existing);
+                    }
+                }
+                else if (existing != listObjects.end())
+                {
+                    cJSON* object = existing->second;
+                    if (existing->first != entity.name)
+                    {
+                        // Renamed. Objects are keyed by name.
+                        cJSON* item = cJSON_DetachItemFromObject(lists[entity.list], existing->first.c_str());
+                        listObjects.erase(existing);
+                        cJSON_AddItemToObject(lists[entity.list], entity.name.c_str(), item);
+                        listObjects[entity.name] = object;
+                    }
+
+                    SetTransform(object, entity);
+                    SetGuid(object, entity.guid);
+                    SetRender(object, entity, meshFiles);
+                    SetRoutines(object, entity);
+                    if (entity.guid)
+                        listGuids[entity.guid] = entity.name;
+                }
+                else
+                {
+                    cJSON* object = CreateEntity(entity, meshFiles);
+                    cJSON_AddItemToObject(lists[entity.list], entity.name.c_str(), Wrap(object));
+                    listObjects[entity.name] = object;
+                    if (entity.guid)
+                        listGuids[entity.guid] = entity.name;
+                }
+            }
+
+            const bool written = WriteScene(sceneFilePath, root);
+            cJSON_Delete(root);
+
+            if (!written)
+                return false;
+
+            remove(journalPath.c_str());
+            LOG_INFO("SceneJournal: Compacted {0} changes into {1}", entries.size(), sceneFilePath);
+            return true;
+        }
+
+        bool ReadScene(const char* sceneFilePath, SceneSnapshot& snapshot)
+        {
+            snapshot.entities.clear();
+
+            cJSON* root = ParseScene(sceneFilePath);
+            if (root == nullptr)
+                return false;
+
+            for (int list = 0; list < CookedList_Max; list++)
+            {
+                cJSON* objects = GetValues(root, s_Lists[list]);
+                for (cJSON* entry = objects ? objects->child : nullptr; entry; entry = entry->next)
+                {
+                    cJSON* object = Unwrap(entry);
+
+                    snapshot.entities.push_back(EntitySnapshot());
+                    EntitySnapshot& entity = snapshot.entities.back();
+                    entity.name = entry->string ? entry->string : "";
+                    entity.guid = ReadGuid(object);
+                    entity.parentGuid = ReadParentGuid(object);
+                    entity.list = (eCookedSceneLists)list;
+                    entity.tag = (int)ReadNumber(object, "ObjectTag", 0.0);
+                    ReadVector(object, "Position", entity.position, 0.0f);
+                    ReadVector(object, "Rotation", entity.rotation, 0.0f);
+                    ReadVector(object, "Scale", entity.scale, 1.0f);
+
+                    cJSON* components = GetValues(object, "ComponentList");
+                    const std::string renderKey = components ? FindKey(components, "ComponentName", "Render") : std::string();
+                    if (!renderKey.empty())
+                    {
+                        cJSON* render = GetValues(components, renderKey.c_str());
+                        entity.hasRender = true;
+                        entity.schematicName = ReadString(render, "SchematicName");
+
+                        cJSON* renderables = GetValues(render, "Renderables");
+                        for (cJSON* item = renderables ? renderables->child : nullptr; item; item = item->next)
+                        {
+                            cJSON* values = Unwrap(item);
+                            RenderableSnapshot renderable;
+                            renderable.name = item->string ? item->string : "";
+                            renderable.shader = ReadString(values, "Shader");
+                            renderable.material = ReadString(values, "Material");
+                            renderable.mesh = ReadString(values, "MeshName");
+                            entity.renderables.push_back(renderable);
+                        }
+                    }
+
+                    cJSON* routines = GetValues(object, "RoutineList");
+                    cJSON* drawRoutines = GetValues(routines, "DrawRoutines");
+                    entity.hasRenderRoutine = drawRoutines && !FindKey(drawRoutines, "RoutineName", "Render").empty();
+
+                    cJSON* updateRoutines = GetValues(routines, "UpdateRoutines");
+                    const std::string transformKey = updateRoutines ? FindKey(updateRoutines, "RoutineName", "Transform") : std::string();
+                    if (!transformKey.empty())
+                    {
+                        cJSON* routine = GetValues(updateRoutines, transformKey.c_str());
+                        cJSON* values = GetValues(routine, "TransformValues");
+                        entity.hasTransformRoutine = true;
+                        entity.routineSpeed = (float)ReadNumber(routine, "Speed", 1.0);
+                        ReadVector(values, "Position", entity.routinePositionOffset, 0.0f);
+                        ReadVector(values, "Rotation", entity.routineRotationOffset, 0.0f);
+                        ReadVector(values, "Scale", entity.routineScaleOffset, 0.0f);
+                    }
+                }
+            }
+
+            cJSON_Delete(root);
+            return true;
+        }
+    }
+
+}
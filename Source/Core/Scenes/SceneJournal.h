@@ -0,0 +1,82 @@
+#ifndef _Scene_Journal_H_
+#define _Scene_Journal_H_
+
+// Append only log of the entities changed by each save of a .qscene file.
+// Saving a few changed entities writes a few records instead of the whole
+// scene. Compact() later applies the log to the .qscene file and deletes it.
+//
+// The journal is only valid for the .qscene file it was started against.
+// If the scene file is written by something else, such as the framework's
+// SaveScene(), the journal is out of date and is thrown away.
+//
+// File layout, little endian. "Test.qscene" logs to "Test.qjournal".
+//   Header  { SceneJournalHeader }
+//   Batches { unsigned int entryCount, unsigned int size, entries[entryCount] }
+//
+// Each save appends 1 batch, so a torn write only loses the last batch.
+// Entities are matched by GUID, or by name when saved before GUIDs.
+// An entry is a fixed part, then strings as { unsigned short length, chars }:
+//   { op, list, flags, reserved, unsigned int guid[2], parentGuid[2], int tag, float position[3], rotation[3], scale[3] }
+//   { float speed, positionOffset[3], rotationOffset[3], scaleOffset[3] } if it has a transform routine
+//   { name }
+//   { schematicName, unsigned int count, { name, shader, material, mesh }[count] } if it renders
+
+#include "SceneSnapshot.h"
+
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    enum eSceneJournalOps : unsigned char
+    {
+        SceneJournalOp_Upsert = 0, // Add or update
+        SceneJournalOp_Remove, // Only the name, GUID and list are stored
+        SceneJournalOp_Max
+    };
+
+    struct SceneJournalEntry
+    {
+        eSceneJournalOps op;
+        EntitySnapshot entity;
+    };
+
+    struct SceneJournalHeader
+    {
+        char magic[4]; // "QJNL"
+        unsigned short version;
+        unsigned short reserved;
+
+        // Scene file the journal applies to
+        unsigned long long sceneSize;
+        long long sceneWriteTime;
+    };
+
+    namespace SceneJournal
+    {
+        extern const char s_Magic[4];
+        const unsigned short s_Version = 3;
+
+        std::string JournalPath(const char* sceneFilePath);
+
+        // Bytes of journal waiting to be compacted, 0 if none
+        unsigned long long Size(const char* sceneFilePath);
+
+        bool Append(const char* sceneFilePath, const std::vector<const EntitySnapshot*>& upserts, const std::vector<const EntitySnapshot*>& removals);
+
+        // Entries of every complete batch, in order. False when there is no
+        // valid journal for the current scene file.
+        bool Read(const char* sceneFilePath, std::vector<SceneJournalEntry>& entries);
+
+        // Applies the journal to the scene file, then deletes it. Content the
+        // journal doesn't hold, like physics components, is kept.
+        // True when there was nothing to do.
+        bool Compact(const char* sceneFilePath);
+
+        // The saved state of the entities in a .qscene file, in the form a
+        // SceneSnapshot captures them
+        bool ReadScene(const char* sceneFilePath, SceneSnapshot& snapshot);
+    }
+
+}
+#endif // _Scene_Journal_H_
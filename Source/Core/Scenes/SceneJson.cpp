@@ -0,0 +1,113 @@
+#include "SceneJson.h"
+
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+
+#include <string>
+
+namespace QwerkE {
+
+    namespace SceneJson
+    {
+        const char* const s_Lists[CookedList_Max] = { "ObjectList", "CameraList", "LightList" };
+
+        static const char s_Axes[3] = { 'X', 'Y', 'Z' };
+
+        cJSON* Unwrap(cJSON* item)
+        {
+            return (item && cJSON_IsArray(item)) ? cJSON_GetArrayItem(item, 0) : item;
+        }
+
+        cJSON* Wrap(cJSON* values)
+        {
+            cJSON* array = cJSON_CreateArray();
+            cJSON_AddItemToArray(array, values);
+            return array;
+        }
+
+        cJSON* GetValues(cJSON* object, const char* key)
+        {
+            return object ? Unwrap(cJSON_GetObjectItem(object, key)) : nullptr;
+        }
+
+        cJSON* GetOrAddValues(cJSON* object, const char* key)
+        {
+            cJSON* values = GetValues(object, key);
+            if (values == nullptr)
+            {
+                values = cJSON_CreateObject();
+                SetItem(object, key, Wrap(values));
+            }
+            return values;
+        }
+
+        const char* ReadString(cJSON* object, const char* key)
+        {
+            cJSON* item = object ? cJSON_GetObjectItem(object, key) : nullptr;
+            return (item && cJSON_IsString(item)) ? item->valuestring : "";
+        }
+
+        double ReadNumber(cJSON* object, const char* key, double defaultValue)
+        {
+            cJSON* item = object ? cJSON_GetObjectItem(object, key) : nullptr;
+            return (item && cJSON_IsNumber(item)) ? item->valuedouble : defaultValue;
+        }
+
+        void ReadVector(cJSON* object, const char* name, float out[3], float defaultValue)
+        {
+            cJSON* values = GetValues(object, name);
+            for (int i = 0; i < 3; i++)
+            {
+                const std::string key = std::string(name) + s_Axes[i];
+                out[i] = (float)ReadNumber(values, key.c_str(), defaultValue);
+            }
+        }
+
+        cJSON* CreateVector(const char* name, const float value[3])
+        {
+            cJSON* values = cJSON_CreateObject();
+            for (int i = 0; i < 3; i++)
+            {
+                const std::string key = std::string(name) + s_Axes[i];
+                cJSON_AddItemToObject(values, key.c_str(), cJSON_CreateNumber(value[i]));
+            }
+            return Wrap(values);
+        }
+
+        void SetItem(cJSON* object, const char* key, cJSON* item)
+        {
+            if (cJSON_GetObjectItem(object, key))
+                cJSON_ReplaceItemInObject(object, key, item);
+            else
+                cJSON_AddItemToObject(object, key, item);
+        }
+
+        static void SetGuidItem(cJSON* object, const char* key, EntityGuid guid)
+        {
+            if (guid != 0)
+                SetItem(object, key, cJSON_CreateString(EntityGuids::ToString(guid).c_str()));
+            else if (cJSON_GetObjectItem(object, key))
+                cJSON_DeleteItemFromObject(object, key);
+        }
+
+        EntityGuid ReadGuid(cJSON* object)
+        {
+            return EntityGuids::Parse(ReadString(object, "GUID"));
+        }
+
+        void SetGuid(cJSON* object, EntityGuid guid)
+        {
+            SetGuidItem(object, "GUID", guid);
+        }
+
+        EntityGuid ReadParentGuid(cJSON* object)
+        {
+            return EntityGuids::Parse(ReadString(object, "ParentGUID"));
+        }
+
+        void SetParentGuid(cJSON* object, EntityGuid guid)
+        {
+            SetGuidItem(object, "ParentGUID", guid);
+        }
+    }
+
+}
@@ -0,0 +1,50 @@
+#ifndef _Scene_Json_H_
+#define _Scene_Json_H_
+
+// Helpers for the cJSON layout of .qscene files, shared by the engine code
+// that reads and patches them outside of the framework.
+// Values are wrapped in 1 element arrays: "Key": [{ ... }]
+
+#include "CookedScene.h"
+#include "../Entities/EntityGuid.h"
+
+struct cJSON;
+
+namespace QwerkE {
+
+    namespace SceneJson
+    {
+        // Names of the scene lists, indexed by eCookedSceneLists
+        extern const char* const s_Lists[CookedList_Max];
+
+        cJSON* Unwrap(cJSON* item);
+        cJSON* Wrap(cJSON* values);
+
+        // The unwrapped values of a key, or null
+        cJSON* GetValues(cJSON* object, const char* key);
+        // Adds "key": [{ }] when the key is missing
+        cJSON* GetOrAddValues(cJSON* object, const char* key);
+
+        // Missing or mistyped values give "" and defaultValue
+        const char* ReadString(cJSON* object, const char* key);
+        double ReadNumber(cJSON* object, const char* key, double defaultValue);
+
+        // "Position": [{ "PositionX": x, "PositionY": y, "PositionZ": z }]
+        void ReadVector(cJSON* object, const char* name, float out[3], float defaultValue);
+        cJSON* CreateVector(const char* name, const float value[3]);
+
+        // Adds the key, or replaces its value
+        void SetItem(cJSON* object, const char* key, cJSON* item);
+
+        // "GUID": "0123456789abcdef". 0 when missing, as in files saved before GUIDs.
+        EntityGuid ReadGuid(cJSON* object);
+        // A 0 guid removes the key
+        void SetGuid(cJSON* object, EntityGuid guid);
+
+        // "ParentGUID", the same way. 0 when the entity has no parent.
+        EntityGuid ReadParentGuid(cJSON* object);
+        void SetParentGuid(cJSON* object, EntityGuid guid);
+    }
+
+}
+#endif // _Scene_Json_H_
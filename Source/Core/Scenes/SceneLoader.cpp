@@ -0,0 +1,525 @@
+#include "SceneLoader.h"
+#include "CookedScene.h"
+#include "SceneCooker.h"
+#include "SceneImage.h"
+#include "SceneJournal.h"
+#include "SceneSaver.h"
+#include "SceneJson.h"
+#include "../Entities/SceneEntities.h"
+#include "../Graphics/MeshStreamer.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Routines/RenderRoutine.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../QwerkE_Framework/Source/Core/Factory/Factory.h"
+#include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
+#include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
+#include "../QwerkE_Framework/Libraries/cJSON/cJSON.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace SceneLoader
+    {
+        static bool s_CookedScenesEnabled = true;
+        static std::unordered_map<const Scene*, std::string> s_SceneFiles;
+
+        // The state of each scene as loaded, for reloads while its file is unchanged
+        struct LoadedImage
+        {
+            SceneImage image;
+            unsigned long long fileSize = 0;
+            long long fileWriteTime = 0;
+            unsigned long long journalSize = 0; // Applied on top of the file
+        };
+        static std::unordered_map<const Scene*, LoadedImage> s_LoadedImages;
+
+        // Mesh names to the files they load from, for entities a journal adds
+        typedef std::unordered_map<std::string, std::string> MeshFiles;
+
+        void SetCookedScenesEnabled(bool enabled)
+        {
+            s_CookedScenesEnabled = enabled;
+        }
+
+        // Files not loaded yet stream in, with a placeholder until then
+        static Mesh* LoadMesh(const char* meshFile, const char* meshName, SceneEntities& entities, GameObject* object, unsigned int renderableIndex)
+        {
+            // "None" marks meshes made in code rather than loaded from a file
+            if (meshFile[0] == '\0' || strcmp(meshFile, "None") == 0)
+                return Resources::GetMesh(meshName);
+            return MeshStreamer::Request(meshFile, meshName, entities, object, renderableIndex);
+        }
+
+        static void AddRender(GameObject* object, const CookedScene& cooked, const void* data, SceneEntities& entities)
+        {
+            // Factory made objects can come with their own
+            if (object->GetComponent(Component_Render) != nullptr)
+                return;
+
+            const CookedRender* render = (const CookedRender*)data;
+            const CookedRenderable* renderables = (const CookedRenderable*)(render + 1);
+
+            RenderComponent* rComp = new RenderComponent();
+            object->AddComponent(rComp);
+
+            for (unsigned int i = 0; i < render->renderableCount; i++)
+            {
+                const CookedRenderable& cookedRenderable = renderables[i];
+
+                Renderable renderable;
+                renderable.SetRenderableName(cooked.GetString(cookedRenderable.name));
+                renderable.SetShader(Resources::GetShaderProgram(cooked.GetString(cookedRenderable.shader)));
+                renderable.SetMaterial(Resources::GetMaterial(cooked.GetString(cookedRenderable.material)));
+                renderable.SetMesh(LoadMesh(cooked.GetString(cookedRenderable.meshFile), cooked.GetString(cookedRenderable.meshName), entities, object, i));
+                rComp->AddRenderable(renderable);
+            }
+        }
+
+        static void ReadMeshFiles(const CookedScene& cooked, const void* data, MeshFiles& meshFiles)
+        {
+            const CookedRender* render = (const CookedRender*)data;
+            const CookedRenderable* renderables = (const CookedRenderable*)(render + 1);
+            for (unsigned int i = 0; i < render->renderableCount; i++)
+            {
+                meshFiles[cooked.GetString(renderables[i].meshName)] = cooked.GetString(renderables[i].meshFile);
+            }
+        }
+
+        static GameObject* NewObject(Scene* scene, eCookedSceneLists list, int tag, const vec3& position)
+        {
+            switch (list)
+            {
+            case CookedList_Camera:
+                return Factory::CreateFreeCamera(scene, position);
+            case CookedList_Light:
+                return Factory::CreateLight(scene, position);
+            default:
+            {
+                GameObject* object = new GameObject(scene);
+                object->SetTag((eGameObjectTags)tag);
+                return object;
+            }
+            }
+        }
+
+        static void AddToScene(Scene* scene, GameObject* object, eCookedSceneLists list)
+        {
+            switch (list)
+            {
+            case CookedList_Camera:
+                scene->AddCamera(object);
+                break;
+            case CookedList_Light:
+                scene->AddLight(object);
+                break;
+            default:
+                scene->AddObjectToScene(object);
+                break;
+            }
+        }
+
+        static GameObject* CreateObject(Scene* scene, const CookedScene& cooked, const CookedEntity& entity, SceneEntities& entities, MeshFiles& meshFiles)
+        {
+            const vec3 position(entity.position[0], entity.position[1], entity.position[2]);
+            GameObject* object = NewObject(scene, (eCookedSceneLists)entity.list, entity.tag, position);
+
+            object->SetName(cooked.GetString(entity.name));
+            entities.SetGuid(object, entity.Guid());
+            object->SetPosition(position);
+            object->SetRotation(vec3(entity.rotation[0], entity.rotation[1], entity.rotation[2]));
+            object->SetScale(vec3(entity.scale[0], entity.scale[1], entity.scale[2]));
+
+            unsigned int dataSize;
+            if (const void* render = cooked.FindComponent(entity, CookedComponent_Render, dataSize))
+            {
+                AddRender(object, cooked, render, entities);
+                ReadMeshFiles(cooked, render, meshFiles);
+            }
+
+            if (cooked.FindComponent(entity, CookedComponent_RenderRoutine, dataSize) &&
+                object->GetFirstDrawRoutineOfType(Routine_Render) == nullptr)
+            {
+                object->AddDrawRoutine((Routine*) new RenderRoutine());
+                object->GetFirstDrawRoutineOfType(Routine_Render)->Initialize();
+            }
+
+            // Transform routines run batched over the entity store
+            if (const void* data = cooked.FindComponent(entity, CookedComponent_TransformRoutine, dataSize))
+            {
+                const CookedTransformRoutine* routine = (const CookedTransformRoutine*)data;
+                entities.AddTransformRoutine(object, routine->speed, routine->positionOffset, routine->rotationOffset, routine->scaleOffset);
+            }
+
+            return object;
+        }
+
+        static void SetParent(SceneEntities& entities, EntityGuid guid, EntityGuid parentGuid)
+        {
+            GameObject* object = entities.FindByGuid(guid);
+            GameObject* parent = entities.FindByGuid(parentGuid);
+            if (object == nullptr || parent == nullptr || !entities.SetParent(object, parent))
+                LOG_WARN("SceneLoader: Could not find the parent {0} of {1}", EntityGuids::ToString(parentGuid).c_str(), EntityGuids::ToString(guid).c_str());
+        }
+
+        static bool LoadCooked(Scene* scene, const char* filePath, SceneEntities& entities, MeshFiles& meshFiles)
+        {
+            if (!SceneCooker::CookIfStale(filePath))
+                return false;
+
+            CookedScene cooked;
+            if (!cooked.Open(CookedScene::CookedPath(filePath).c_str()))
+                return false;
+
+            PROFILE_SCOPE("Scene Load Cooked");
+
+            scene->RemoveAllObjectsFromScene();
+            entities.Reset();
+
+            for (unsigned int i = 0; i < cooked.EntityCount(); i++)
+            {
+                const CookedEntity& entity = cooked.GetEntity(i);
+                GameObject* object = CreateObject(scene, cooked, entity, entities, meshFiles);
+                AddToScene(scene, object, (eCookedSceneLists)entity.list);
+            }
+
+            // Every object has its GUID by now
+            for (unsigned int i = 0; i < cooked.EntityCount(); i++)
+            {
+                const CookedEntity& entity = cooked.GetEntity(i);
+                if (const EntityGuid parentGuid = entity.ParentGuid())
+                    SetParent(entities, entity.Guid(), parentGuid);
+            }
+
+            LOG_INFO("SceneLoader: Loaded {0} entities from the cooked {1}", cooked.EntityCount(), filePath);
+            return true;
+        }
+
+        static GameObject* FindByName(const std::vector<GameObject*>& list, const char* name)
+        {
+            for (GameObject* object : list)
+            {
+                if (object->GetName() == name)
+                    return object;
+            }
+            return nullptr;
+        }
+
+        static GameObject* FindInList(Scene* scene, eCookedSceneLists list, const char* name)
+        {
+            switch (list)
+            {
+            case CookedList_Camera:
+                return FindByName(scene->GetCameraList(), name);
+            case CookedList_Light:
+                return FindByName(scene->GetLightList(), name);
+            default:
+            {
+                const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+                auto it = objects.find(name);
+                return it == objects.end() ? nullptr : it->second;
+            }
+            }
+        }
+
+        static void ReadMeshFiles(cJSON* object, MeshFiles& meshFiles)
+        {
+            cJSON* components = SceneJson::GetValues(object, "ComponentList");
+            for (cJSON* item = components ? components->child : nullptr; item; item = item->next)
+            {
+                cJSON* component = SceneJson::Unwrap(item);
+                if (strcmp(SceneJson::ReadString(component, "ComponentName"), "Render") != 0)
+                    continue;
+
+                cJSON* renderables = SceneJson::GetValues(component, "Renderables");
+                for (cJSON* renderable = renderables ? renderables->child : nullptr; renderable; renderable = renderable->next)
+                {
+                    cJSON* values = SceneJson::Unwrap(renderable);
+                    meshFiles[SceneJson::ReadString(values, "MeshName")] = SceneJson::ReadString(values, "MeshFile");
+                }
+            }
+        }
+
+        // The framework's loader skips GUIDs, so objects it loaded take them and
+        // their parents from the file
+        static void ReadGuids(Scene* scene, const char* filePath, SceneEntities& entities, MeshFiles& meshFiles)
+        {
+            PROFILE_SCOPE("Scene Read GUIDs");
+
+            char* fileData = LoadCompleteFile(filePath, nullptr);
+            cJSON* root = fileData ? cJSON_Parse(fileData) : nullptr;
+            delete[] fileData;
+            if (root == nullptr)
+                return;
+
+            std::vector<std::pair<EntityGuid, EntityGuid>> parents; // Linked once every GUID is set
+            for (int list = 0; list < CookedList_Max; list++)
+            {
+                cJSON* values = SceneJson::GetValues(root, SceneJson::s_Lists[list]);
+                for (cJSON* entry = values ? values->child : nullptr; entry; entry = entry->next)
+                {
+                    cJSON* object = SceneJson::Unwrap(entry);
+                    ReadMeshFiles(object, meshFiles);
+
+                    const EntityGuid guid = SceneJson::ReadGuid(object);
+                    if (const EntityGuid parentGuid = SceneJson::ReadParentGuid(object))
+                        parents.push_back(std::make_pair(guid, parentGuid));
+                    if (guid == 0 || entry->string == nullptr)
+                        continue;
+
+                    if (GameObject* gameObject = FindInList(scene, (eCookedSceneLists)list, entry->string))
+                        entities.SetGuid(gameObject, guid);
+                }
+            }
+            cJSON_Delete(root);
+
+            for (const auto& link : parents)
+            {
+                SetParent(entities, link.first, link.second);
+            }
+        }
+
+        static GameObject* CreateObject(Scene* scene, const EntitySnapshot& entity, SceneEntities& entities, const MeshFiles& meshFiles)
+        {
+            GameObject* object = NewObject(scene, entity.list, entity.tag, vec3(entity.position[0], entity.position[1], entity.position[2]));
+            object->SetName(entity.name);
+            entities.SetGuid(object, entity.guid);
+            object->SetRotation(vec3(entity.rotation[0], entity.rotation[1], entity.rotation[2]));
+            object->SetScale(vec3(entity.scale[0], entity.scale[1], entity.scale[2]));
+
+            if (entity.hasRender && object->GetComponent(Component_Render) == nullptr)
+            {
+                RenderComponent* rComp = new RenderComponent();
+                object->AddComponent(rComp);
+
+                for (unsigned int i = 0; i < entity.renderables.size(); i++)
+                {
+                    const RenderableSnapshot& snapshot = entity.renderables[i];
+                    auto meshFile = meshFiles.find(snapshot.mesh);
+
+                    Renderable renderable;
+                    renderable.SetRenderableName(snapshot.name);
+                    renderable.SetShader(Resources::GetShaderProgram(snapshot.shader.c_str()));
+                    renderable.SetMaterial(Resources::GetMaterial(snapshot.material.c_str()));
+                    renderable.SetMesh(LoadMesh(meshFile != meshFiles.end() ? meshFile->second.c_str() : "", snapshot.mesh.c_str(), entities, object, i));
+                    rComp->AddRenderable(renderable);
+                }
+            }
+
+            if (entity.hasRenderRoutine && object->GetFirstDrawRoutineOfType(Routine_Render) == nullptr)
+            {
+                object->AddDrawRoutine((Routine*) new RenderRoutine());
+                object->GetFirstDrawRoutineOfType(Routine_Render)->Initialize();
+            }
+
+            if (entity.hasTransformRoutine)
+                entities.AddTransformRoutine(object, entity.routineSpeed, entity.routinePositionOffset, entity.routineRotationOffset, entity.routineScaleOffset);
+            return object;
+        }
+
+        static void RemoveFromScene(Scene* scene, GameObject* object, eCookedSceneLists list, SceneEntities& entities)
+        {
+            entities.Remove(object);
+            switch (list)
+            {
+            case CookedList_Camera:
+                scene->RemoveCamera(object);
+                break;
+            case CookedList_Light:
+                scene->RemoveLight(object);
+                break;
+            default:
+                scene->RemoveObjectFromScene(object);
+                break;
+            }
+        }
+
+        // By GUID, or by name for entities saved before they had one
+        static GameObject* FindEntity(Scene* scene, const EntitySnapshot& entity, const SceneEntities& entities)
+        {
+            if (GameObject* object = entity.guid ? entities.FindByGuid(entity.guid) : nullptr)
+                return object;
+
+            GameObject* object = FindInList(scene, entity.list, entity.name.c_str());
+            if (object && entity.guid != 0 && entities.GetGuid(object) != 0)
+                return nullptr; // Another entity with the same name
+            return object;
+        }
+
+        // Applies the changes saved to the file's journal since it was last
+        // compacted, the way SceneJournal::Compact() would write them
+        static void ApplyJournal(Scene* scene, const char* filePath, SceneEntities& entities, const MeshFiles& meshFiles)
+        {
+            std::vector<SceneJournalEntry> entries;
+            if (!SceneJournal::Read(filePath, entries) || entries.empty())
+                return;
+
+            PROFILE_SCOPE("Scene Apply Journal");
+
+            for (const SceneJournalEntry& entry : entries)
+            {
+                const EntitySnapshot& entity = entry.entity;
+                GameObject* object = FindEntity(scene, entity, entities);
+
+                if (entry.op == SceneJournalOp_Remove)
+                {
+                    if (object)
+                        RemoveFromScene(scene, object, entity.list, entities);
+                    continue;
+                }
+
+                if (object)
+                {
+                    // Only transforms and routines are changed in place.
+                    // Anything else makes a new object.
+                    EntitySnapshot current;
+                    current.Capture(object, entity.list, entities);
+                    if (current.name != entity.name || current.hasRender != entity.hasRender || current.schematicName != entity.schematicName ||
+                        current.renderables != entity.renderables || current.hasRenderRoutine != entity.hasRenderRoutine)
+                    {
+                        RemoveFromScene(scene, object, entity.list, entities);
+                        object = nullptr;
+                    }
+                }
+
+                if (object == nullptr)
+                {
+                    AddToScene(scene, CreateObject(scene, entity, entities, meshFiles), entity.list);
+                    continue;
+                }
+
+                if (entity.list == CookedList_Object)
+                    object->SetTag((eGameObjectTags)entity.tag);
+                entities.SetGuid(object, entity.guid);
+                object->SetPosition(vec3(entity.position[0], entity.position[1], entity.position[2]));
+                object->SetRotation(vec3(entity.rotation[0], entity.rotation[1], entity.rotation[2]));
+                object->SetScale(vec3(entity.scale[0], entity.scale[1], entity.scale[2]));
+                if (entity.hasTransformRoutine)
+                    entities.AddTransformRoutine(object, entity.routineSpeed, entity.routinePositionOffset, entity.routineRotationOffset, entity.routineScaleOffset);
+                else
+                    entities.RemoveTransformRoutine(object);
+            }
+
+            // Every object has its GUID and transform by now
+            for (const SceneJournalEntry& entry : entries)
+            {
+                if (entry.op != SceneJournalOp_Upsert)
+                    continue;
+
+                GameObject* object = FindEntity(scene, entry.entity, entities);
+                if (object == nullptr)
+                    continue; // Removed by a later entry
+
+                if (entry.entity.parentGuid == 0)
+                    entities.SetParent(object, nullptr);
+                else
+                    SetParent(entities, entities.GetGuid(object), entry.entity.parentGuid);
+            }
+
+            LOG_INFO("SceneLoader: Applied {0} saved changes to {1}", entries.size(), filePath);
+        }
+
+        bool Load(Scene* scene, const char* filePath, SceneEntities& entities)
+        {
+            if (scene == nullptr || filePath == nullptr)
+                return false;
+
+            PROFILE_SCOPE("Scene Load");
+
+            s_SceneFiles[scene] = filePath;
+
+            // Saves still being appended belong in the journal. The save
+            // thread is idle after, so the file and journal stay as read.
+            SceneSaver::Flush();
+
+            MeshFiles meshFiles;
+            if (!s_CookedScenesEnabled || !LoadCooked(scene, filePath, entities, meshFiles))
+            {
+                scene->RemoveAllObjectsFromScene();
+                entities.Reset();
+                scene->LoadScene(filePath);
+                ReadGuids(scene, filePath, entities, meshFiles);
+            }
+            ApplyJournal(scene, filePath, entities, meshFiles);
+
+            LoadedImage& loaded = s_LoadedImages[scene];
+            loaded.journalSize = SceneJournal::Size(filePath);
+            if (CookedScene::SourceFileInfo(filePath, loaded.fileSize, loaded.fileWriteTime))
+                loaded.image.Capture(scene, entities);
+            else
+                loaded.image.Clear();
+            return true;
+        }
+
+        static bool IsLoadedImageCurrent(const Scene* scene, const char* filePath)
+        {
+            auto it = s_LoadedImages.find(scene);
+            if (it == s_LoadedImages.end() || it->second.image.IsEmpty())
+                return false;
+
+            // Saves since the load grow the journal, and compacting it
+            // rewrites the file
+            SceneSaver::Flush();
+            if (SceneJournal::Size(filePath) != it->second.journalSize)
+                return false;
+
+            unsigned long long size;
+            long long writeTime;
+            return CookedScene::SourceFileInfo(filePath, size, writeTime) &&
+                size == it->second.fileSize && writeTime == it->second.fileWriteTime;
+        }
+
+        void Reload(Scene* scene, SceneEntities& entities)
+        {
+            if (scene == nullptr)
+                return;
+
+            auto it = s_SceneFiles.find(scene);
+            if (it == s_SceneFiles.end())
+            {
+                entities.Reset();
+                scene->ReloadScene();
+                return;
+            }
+
+            const std::string filePath = it->second; // Load() writes to the map
+            if (IsLoadedImageCurrent(scene, filePath.c_str()))
+            {
+                PROFILE_SCOPE("Scene Reload From Image");
+                s_LoadedImages[scene].image.Restore(scene, entities);
+                return;
+            }
+            Load(scene, filePath.c_str(), entities);
+        }
+
+        void SetSceneFile(Scene* scene, const char* filePath, SceneEntities& entities)
+        {
+            if (scene == nullptr || filePath == nullptr)
+                return;
+
+            s_SceneFiles[scene] = filePath;
+
+            SceneSaver::Flush();
+            MeshFiles meshFiles;
+            ReadGuids(scene, filePath, entities, meshFiles);
+            ApplyJournal(scene, filePath, entities, meshFiles);
+        }
+
+        const char* GetSceneFile(const Scene* scene)
+        {
+            auto it = s_SceneFiles.find(scene);
+            return it == s_SceneFiles.end() ? nullptr : it->second.c_str();
+        }
+    }
+
+}
@@ -0,0 +1,41 @@
+#ifndef _Scene_Loader_H_
+#define _Scene_Loader_H_
+
+// Loads .qscene files into framework Scenes, from their cooked binary
+// version (see CookedScene.h) when there is one. Missing or stale cooked
+// files are cooked first. Scenes the cooker can't hold load from JSON
+// through the framework, as before. Changes saved to the file's
+// SceneJournal are applied to the loaded objects, leaving the file as it
+// is for the save thread to compact.
+//
+// The framework loads the scenes listed in preferences at startup. Loads
+// and reloads made after that through here take the cooked path.
+
+namespace QwerkE {
+
+    class Scene;
+    class SceneEntities;
+
+    namespace SceneLoader
+    {
+        void SetCookedScenesEnabled(bool enabled);
+
+        // Replaces the scene's objects with the ones in a .qscene file.
+        // entities must mirror scene, as transform routines are attached there.
+        bool Load(Scene* scene, const char* filePath, SceneEntities& entities);
+
+        // Loads the file the scene was last loaded from. While the file is
+        // unchanged since Load(), the scene is reset from a SceneImage taken
+        // then instead of being read again. Scenes with no known file use the
+        // framework's ReloadScene().
+        void Reload(Scene* scene, SceneEntities& entities);
+
+        // Sets the file of a scene loaded elsewhere, such as at startup, gives
+        // its objects their GUIDs from the file and applies its journal
+        void SetSceneFile(Scene* scene, const char* filePath, SceneEntities& entities);
+        // Null when unknown
+        const char* GetSceneFile(const Scene* scene);
+    }
+
+}
+#endif // _Scene_Loader_H_
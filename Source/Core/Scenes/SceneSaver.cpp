@@ -0,0 +1,422 @@
+#include "SceneSaver.h"
+#include "SceneJournal.h"
+#include "SceneSnapshot.h"
+#include "../Entities/SceneEntities.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <algorithm>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+namespace QwerkE {
+
+    namespace SceneSaver
+    {
+        struct SaveJob
+        {
+            std::string filePath;
+            bool whole = false; // changed holds every entity of the scene
+            std::vector<EntitySnapshot> changed;
+            std::vector<EntitySnapshot> removed; // Unless whole
+        };
+
+        // What a scene file holds, journal included
+        struct SavedScene
+        {
+            bool loaded = false;
+            // The scene file the entities match. Anything else writing it
+            // makes them out of date.
+            unsigned long long sceneSize = 0;
+            long long sceneWriteTime = 0;
+            std::unordered_map<std::string, EntitySnapshot> entities; // By EntitySnapshot::Key()
+        };
+
+        // The objects last captured for a file, to capture only the ones
+        // changed since
+        struct CapturedEntity
+        {
+            EntitySnapshot snapshot;
+            unsigned int seen = 0; // Last CapturedScene::epoch the object was in the scene
+        };
+
+        struct CapturedScene
+        {
+            const Scene* scene = nullptr;
+            const SceneEntities* entities = nullptr;
+            unsigned long long changeCount = 0; // SceneEntities::GetChangeCount() at the capture
+            unsigned int epoch = 0;
+            std::unordered_map<const GameObject*, CapturedEntity> objects;
+        };
+
+        static std::thread s_SaveThread;
+        static std::mutex s_SaveMutex;
+        static std::condition_variable s_SaveSignal; // Jobs queued or stop requested
+        static std::condition_variable s_IdleSignal; // Every job written
+        static std::deque<SaveJob> s_Jobs;
+        static bool s_Writing = false;
+        static bool s_StopRequested = false;
+        // Files the save thread read again, so their next save is captured whole
+        static std::unordered_set<std::string> s_WholeSaveFiles;
+
+        // Main thread only
+        static std::unordered_map<std::string, CapturedScene> s_CapturedScenes;
+
+        // Save thread only
+        static std::unordered_map<std::string, SavedScene> s_SavedScenes;
+        static std::unordered_set<std::string> s_JournaledFiles;
+
+        static bool LoadSavedScene(const char* filePath, SavedScene& saved)
+        {
+            saved.loaded = false;
+            saved.entities.clear();
+
+            // Changes left by an earlier run
+            if (SceneJournal::Size(filePath) > 0)
+                SceneJournal::Compact(filePath);
+
+            SceneSnapshot snapshot;
+            if (!SceneJournal::ReadScene(filePath, snapshot) ||
+                !CookedScene::SourceFileInfo(filePath, saved.sceneSize, saved.sceneWriteTime))
+                return false;
+
+            for (EntitySnapshot& entity : snapshot.entities)
+            {
+                saved.entities[entity.Key()] = std::move(entity);
+            }
+            saved.loaded = true;
+            return true;
+        }
+
+        static std::unordered_map<std::string, EntitySnapshot>::iterator FindSaved(SavedScene& saved, const EntitySnapshot& entity)
+        {
+            auto it = saved.entities.find(entity.Key());
+            if (it == saved.entities.end() && entity.guid != 0)
+            {
+                // Saved before it had a GUID. Upserted to store it.
+                it = saved.entities.find(entity.NameKey());
+                if (it != saved.entities.end() && it->second.guid != 0)
+                    it = saved.entities.end();
+            }
+            return it;
+        }
+
+        static void RequestWholeSave(const std::string& filePath)
+        {
+            std::lock_guard<std::mutex> lock(s_SaveMutex);
+            s_WholeSaveFiles.insert(filePath);
+        }
+
+        static void WriteSave(SaveJob& job)
+        {
+            PROFILE_SCOPE("Scene Save");
+
+            const char* filePath = job.filePath.c_str();
+            SavedScene& saved = s_SavedScenes[job.filePath];
+
+            unsigned long long sceneSize;
+            long long sceneWriteTime;
+            if (!CookedScene::SourceFileInfo(filePath, sceneSize, sceneWriteTime))
+            {
+                LOG_ERROR("SceneSaver: Could not find {0}. Nothing was saved.", filePath);
+                RequestWholeSave(job.filePath);
+                return;
+            }
+
+            if (!saved.loaded || sceneSize != saved.sceneSize || sceneWriteTime != saved.sceneWriteTime)
+            {
+                // Entities unchanged since the last capture may not match the file
+                if (!job.whole)
+                    RequestWholeSave(job.filePath);
+
+                if (!LoadSavedScene(filePath, saved))
+                {
+                    LOG_ERROR("SceneSaver: Could not read {0}. Nothing was saved.", filePath);
+                    return;
+                }
+            }
+
+            std::vector<const EntitySnapshot*> upserts;
+            std::vector<const EntitySnapshot*> removals;
+            std::unordered_set<std::string> keys; // Of saved entities captured again
+            keys.reserve(job.changed.size());
+
+            for (const EntitySnapshot& entity : job.changed)
+            {
+                auto it = FindSaved(saved, entity);
+                if (it == saved.entities.end() || it->second != entity)
+                    upserts.push_back(&entity);
+                if (it != saved.entities.end())
+                    keys.insert(it->first);
+            }
+
+            if (job.whole)
+            {
+                for (const auto& p : saved.entities)
+                {
+                    if (keys.find(p.first) == keys.end())
+                        removals.push_back(&p.second);
+                }
+            }
+            else
+            {
+                for (const EntitySnapshot& entity : job.removed)
+                {
+                    auto it = FindSaved(saved, entity);
+                    if (it != saved.entities.end() && keys.find(it->first) == keys.end())
+                        removals.push_back(&it->second);
+                }
+            }
+
+            if (upserts.empty() && removals.empty())
+            {
+                LOG_INFO("SceneSaver: {0} has no changes to save", filePath);
+                return;
+            }
+
+            if (!SceneJournal::Append(filePath, upserts, removals))
+            {
+                saved.loaded = false; // Unknown what was written. Read it again next time.
+                RequestWholeSave(job.filePath);
+                return;
+            }
+            s_JournaledFiles.insert(job.filePath);
+            LOG_INFO("SceneSaver: Saved {0} changed and {1} removed entities of {2}", upserts.size(), removals.size(), filePath);
+
+            if (job.whole)
+            {
+                saved.entities.clear();
+            }
+            else
+            {
+                std::vector<std::string> removedKeys;
+                removedKeys.reserve(removals.size());
+                for (const EntitySnapshot* entity : removals)
+                {
+                    removedKeys.push_back(entity->Key());
+                }
+                for (const std::string& key : removedKeys)
+                {
+                    saved.entities.erase(key);
+                }
+                for (const std::string& key : keys)
+                {
+                    saved.entities.erase(key); // Name keys of entities that got a GUID
+                }
+            }
+            for (EntitySnapshot& entity : job.changed)
+            {
+                saved.entities[entity.Key()] = std::move(entity);
+            }
+
+            // Compact once the journal costs about as much to apply as the scene does to load
+            if (SceneJournal::Size(filePath) * 2 > sceneSize)
+            {
+                saved.loaded = SceneJournal::Compact(filePath) &&
+                    CookedScene::SourceFileInfo(filePath, saved.sceneSize, saved.sceneWriteTime);
+            }
+        }
+
+        static void SaveThreadRun()
+        {
+            std::unique_lock<std::mutex> lock(s_SaveMutex);
+            while (true)
+            {
+                s_SaveSignal.wait(lock, [] { return s_StopRequested || !s_Jobs.empty(); });
+                if (s_Jobs.empty())
+                    break; // Stop requested and nothing left to write
+
+                SaveJob job = std::move(s_Jobs.front());
+                s_Jobs.pop_front();
+                s_Writing = true;
+
+                lock.unlock();
+                WriteSave(job);
+                lock.lock();
+
+                s_Writing = false;
+                if (s_Jobs.empty())
+                    s_IdleSignal.notify_all();
+            }
+            lock.unlock();
+
+            for (const std::string& filePath : s_JournaledFiles)
+            {
+                SceneJournal::Compact(filePath.c_str());
+            }
+            s_JournaledFiles.clear();
+            s_SavedScenes.clear();
+        }
+
+        static void EraseKey(std::vector<EntitySnapshot>& entities, const std::string& key)
+        {
+            auto it = std::find_if(entities.begin(), entities.end(), [&key](const EntitySnapshot& entity) { return entity.Key() == key; });
+            if (it != entities.end())
+                entities.erase(it);
+        }
+
+        // Folds a newer job into one of the same file that hasn't started
+        static void MergeJob(SaveJob& queued, SaveJob& job)
+        {
+            if (job.whole)
+            {
+                queued = std::move(job);
+                return;
+            }
+
+            for (EntitySnapshot& entity : job.removed)
+            {
+                EraseKey(queued.changed, entity.Key());
+                if (!queued.whole)
+                    queued.removed.push_back(std::move(entity));
+            }
+            for (EntitySnapshot& entity : job.changed)
+            {
+                const std::string key = entity.Key();
+                EraseKey(queued.changed, key);
+                EraseKey(queued.removed, key);
+                queued.changed.push_back(std::move(entity));
+            }
+        }
+
+        // Captures the objects changed since the last save of the file, and
+        // the ones that left the scene
+        static void Capture(Scene* scene, const SceneEntities& entities, CapturedScene& captured, SaveJob& job)
+        {
+            PROFILE_SCOPE("Scene Save Capture");
+
+            if (job.whole || captured.scene != scene || captured.entities != &entities)
+            {
+                job.whole = true;
+                captured.objects.clear();
+                captured.scene = scene;
+                captured.entities = &entities;
+            }
+
+            const unsigned int epoch = ++captured.epoch;
+            auto capture = [&](GameObject* object, eCookedSceneLists list)
+            {
+                auto inserted = captured.objects.insert(std::make_pair((const GameObject*)object, CapturedEntity()));
+                CapturedEntity& entity = inserted.first->second;
+                entity.seen = epoch;
+
+                const bool isNew = inserted.second;
+                if (!isNew && entity.snapshot.list == list && !entities.ChangedSince(object, captured.changeCount))
+                    return;
+
+                // Enough to remove it by, if another entity took the address
+                // or it lost its key
+                EntitySnapshot previous;
+                previous.name = entity.snapshot.name;
+                previous.guid = entity.snapshot.guid;
+                previous.list = entity.snapshot.list;
+
+                entity.snapshot.Capture(object, list, entities);
+                if (!isNew && !job.whole && previous.Key() != entity.snapshot.Key())
+                    job.removed.push_back(std::move(previous));
+                job.changed.push_back(entity.snapshot);
+            };
+
+            for (const auto& p : scene->GetObjectList())
+            {
+                capture(p.second, CookedList_Object);
+            }
+            for (GameObject* camera : scene->GetCameraList())
+            {
+                capture(camera, CookedList_Camera);
+            }
+            for (GameObject* light : scene->GetLightList())
+            {
+                capture(light, CookedList_Light);
+            }
+
+            for (auto it = captured.objects.begin(); it != captured.objects.end();)
+            {
+                if (it->second.seen == epoch)
+                {
+                    ++it;
+                    continue;
+                }
+
+                if (!job.whole)
+                    job.removed.push_back(std::move(it->second.snapshot));
+                it = captured.objects.erase(it);
+            }
+            captured.changeCount = entities.GetChangeCount();
+        }
+
+        void Save(Scene* scene, const char* filePath, const SceneEntities& entities)
+        {
+            if (scene == nullptr || filePath == nullptr)
+                return;
+
+            SaveJob job;
+            job.filePath = filePath;
+            {
+                std::lock_guard<std::mutex> lock(s_SaveMutex);
+                job.whole = s_WholeSaveFiles.erase(job.filePath) > 0;
+            }
+            Capture(scene, entities, s_CapturedScenes[job.filePath], job);
+
+            if (job.changed.empty() && job.removed.empty() && !job.whole)
+            {
+                LOG_INFO("SceneSaver: {0} has no changes to save", filePath);
+                return;
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(s_SaveMutex);
+                if (!s_SaveThread.joinable())
+                {
+                    s_StopRequested = false;
+                    s_SaveThread = std::thread(SaveThreadRun);
+                }
+
+                auto queued = std::find_if(s_Jobs.begin(), s_Jobs.end(), [&job](const SaveJob& other) { return other.filePath == job.filePath; });
+                if (queued != s_Jobs.end())
+                    MergeJob(*queued, job);
+                else
+                    s_Jobs.push_back(std::move(job));
+            }
+            s_SaveSignal.notify_one();
+        }
+
+        void Flush()
+        {
+            std::unique_lock<std::mutex> lock(s_SaveMutex);
+            s_IdleSignal.wait(lock, [] { return !s_Writing && s_Jobs.empty(); });
+        }
+
+        bool IsSaving()
+        {
+            std::lock_guard<std::mutex> lock(s_SaveMutex);
+            return s_Writing || !s_Jobs.empty();
+        }
+
+        void Shutdown()
+        {
+            if (!s_SaveThread.joinable())
+                return;
+
+            {
+                std::lock_guard<std::mutex> lock(s_SaveMutex);
+                s_StopRequested = true;
+            }
+            s_SaveSignal.notify_one();
+            s_SaveThread.join();
+
+            s_CapturedScenes.clear();
+            s_WholeSaveFiles.clear();
+        }
+    }
+
+}
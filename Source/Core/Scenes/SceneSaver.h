@@ -0,0 +1,37 @@
+#ifndef _Scene_Saver_H_
+#define _Scene_Saver_H_
+
+// Saves scenes without stalling the main thread. Save() only copies the
+// objects changed since the file's last save to SceneSnapshots, as counted
+// by SceneEntities, and notes the objects that left the scene. A save
+// thread compares the copies to the last saved state of the file and
+// appends the ones that differ to its SceneJournal. The save thread also
+// compacts journals into the .qscene file, once they grow to half its
+// size and on Shutdown(). Loads apply a journal rather than compact it.
+//
+// The first save of a file captures the whole scene, as does the next
+// save after the file was changed by anything else.
+
+namespace QwerkE {
+
+    class Scene;
+    class SceneEntities;
+
+    namespace SceneSaver
+    {
+        // Merged into a queued save of the same file that hasn't started
+        void Save(Scene* scene, const char* filePath, const SceneEntities& entities);
+
+        // Blocks until every queued save is written
+        void Flush();
+
+        // True while saves are queued or being written
+        bool IsSaving();
+
+        // Flushes, compacts every journal written and stops the save thread.
+        // Blocks until the compaction is done.
+        void Shutdown();
+    }
+
+}
+#endif // _Scene_Saver_H_
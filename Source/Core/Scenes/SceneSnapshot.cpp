@@ -0,0 +1,131 @@
+#include "SceneSnapshot.h"
+#include "../Entities/SceneEntities.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/Components/RenderComponent.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Renderable.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/Shader/ShaderProgram.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/Material.h"
+#include "../QwerkE_Framework/Source/Core/Graphics/Mesh/Mesh.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <map>
+
+namespace QwerkE {
+
+    bool RenderableSnapshot::operator==(const RenderableSnapshot& other) const
+    {
+        return name == other.name && shader == other.shader && material == other.material && mesh == other.mesh;
+    }
+
+    static bool Equal3(const float a[3], const float b[3])
+    {
+        return a[0] == b[0] && a[1] == b[1] && a[2] == b[2];
+    }
+
+    bool EntitySnapshot::operator==(const EntitySnapshot& other) const
+    {
+        if (name != other.name || guid != other.guid || parentGuid != other.parentGuid || list != other.list || tag != other.tag ||
+            !Equal3(position, other.position) || !Equal3(rotation, other.rotation) || !Equal3(scale, other.scale))
+            return false;
+
+        if (hasRender != other.hasRender || (hasRender && (schematicName != other.schematicName || renderables != other.renderables)))
+            return false;
+
+        if (hasRenderRoutine != other.hasRenderRoutine || hasTransformRoutine != other.hasTransformRoutine)
+            return false;
+
+        return !hasTransformRoutine || (routineSpeed == other.routineSpeed &&
+            Equal3(routinePositionOffset, other.routinePositionOffset) &&
+            Equal3(routineRotationOffset, other.routineRotationOffset) &&
+            Equal3(routineScaleOffset, other.routineScaleOffset));
+    }
+
+    std::string EntitySnapshot::Key() const
+    {
+        // Can't collide with name keys, which start with a list digit
+        if (guid != 0)
+            return "#" + EntityGuids::ToString(guid);
+        return NameKey();
+    }
+
+    std::string EntitySnapshot::NameKey() const
+    {
+        // Lists are saved separately, so names only need to be unique within 1
+        return std::string(1, (char)('0' + list)) + name;
+    }
+
+    static void CaptureVector(const vec3& value, float out[3])
+    {
+        out[0] = value.x;
+        out[1] = value.y;
+        out[2] = value.z;
+    }
+
+    void EntitySnapshot::Capture(GameObject* object, eCookedSceneLists objectList, const SceneEntities& entities)
+    {
+        name = object->GetName();
+        guid = entities.GetGuid(object);
+        parentGuid = entities.GetGuid(entities.GetParent(object));
+        list = objectList;
+        tag = (int)object->GetTag();
+        CaptureVector(object->GetPosition(), position);
+        CaptureVector(object->GetRotation(), rotation);
+        CaptureVector(object->GetScale(), scale);
+
+        RenderComponent* rComp = (RenderComponent*)object->GetComponent(Component_Render);
+        hasRender = rComp != nullptr;
+        schematicName.clear();
+        renderables.clear();
+        if (rComp)
+        {
+            schematicName = rComp->GetSchematicName();
+
+            std::vector<Renderable>* objectRenderables = (std::vector<Renderable>*)rComp->LookAtRenderableList();
+            renderables.resize(objectRenderables->size());
+            for (size_t i = 0; i < objectRenderables->size(); i++)
+            {
+                Renderable& renderable = objectRenderables->at(i);
+                RenderableSnapshot& snapshot = renderables[i];
+                snapshot.name = renderable.GetRenderableName();
+                snapshot.shader = renderable.GetShaderSchematic() ? renderable.GetShaderSchematic()->GetName() : "";
+                snapshot.material = renderable.GetMaterialSchematic() ? renderable.GetMaterialSchematic()->GetMaterialName() : "";
+                snapshot.mesh = renderable.GetMesh() ? renderable.GetMesh()->GetName() : "";
+            }
+        }
+
+        hasRenderRoutine = object->GetFirstDrawRoutineOfType(Routine_Render) != nullptr;
+        hasTransformRoutine = entities.GetTransformRoutine(object, routineSpeed,
+            routinePositionOffset, routineRotationOffset, routineScaleOffset);
+    }
+
+    void SceneSnapshot::Capture(Scene* scene, const SceneEntities& sceneEntities)
+    {
+        PROFILE_SCOPE("Scene Snapshot Capture");
+
+        entities.clear();
+        if (scene == nullptr)
+            return;
+
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        const std::vector<GameObject*>& cameras = scene->GetCameraList();
+        const std::vector<GameObject*>& lights = scene->GetLightList();
+        entities.resize(objects.size() + cameras.size() + lights.size());
+
+        size_t index = 0;
+        for (const auto& p : objects)
+        {
+            entities[index++].Capture(p.second, CookedList_Object, sceneEntities);
+        }
+        for (GameObject* camera : cameras)
+        {
+            entities[index++].Capture(camera, CookedList_Camera, sceneEntities);
+        }
+        for (GameObject* light : lights)
+        {
+            entities[index++].Capture(light, CookedList_Light, sceneEntities);
+        }
+    }
+
+}
@@ -0,0 +1,75 @@
+#ifndef _Scene_Snapshot_H_
+#define _Scene_Snapshot_H_
+
+// A copy of the saved state of a scene's objects: transforms, renderables
+// and the routines the engine knows about. Captured on the main thread so
+// it can be compared and written out on another while the scene runs.
+// Used by SceneSaver to find the objects that changed since the last save.
+
+#include "CookedScene.h"
+#include "../Entities/EntityGuid.h"
+
+#include <string>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+    class Scene;
+    class SceneEntities;
+
+    struct RenderableSnapshot
+    {
+        std::string name;
+        std::string shader; // Schematic names
+        std::string material;
+        std::string mesh;
+
+        bool operator==(const RenderableSnapshot& other) const;
+    };
+
+    struct EntitySnapshot
+    {
+        std::string name;
+        EntityGuid guid = 0; // 0 for entities saved before GUIDs
+        EntityGuid parentGuid = 0; // 0 without a parent, see SceneEntities::SetParent()
+        eCookedSceneLists list = CookedList_Object;
+        int tag = 0; // eGameObjectTags
+        float position[3];
+        float rotation[3];
+        float scale[3];
+
+        bool hasRender = false;
+        std::string schematicName;
+        std::vector<RenderableSnapshot> renderables;
+
+        bool hasRenderRoutine = false;
+
+        // Batched transform routine, see SceneEntities
+        bool hasTransformRoutine = false;
+        float routineSpeed = 0.0f;
+        float routinePositionOffset[3];
+        float routineRotationOffset[3];
+        float routineScaleOffset[3];
+
+        void Capture(GameObject* object, eCookedSceneLists objectList, const SceneEntities& entities);
+
+        bool operator==(const EntitySnapshot& other) const;
+        bool operator!=(const EntitySnapshot& other) const { return !(*this == other); }
+
+        // Unique within a scene. From the GUID when there is one.
+        std::string Key() const;
+        // From the list and name, for matching entities saved before GUIDs
+        std::string NameKey() const;
+    };
+
+    struct SceneSnapshot
+    {
+        // Objects, then cameras, then lights
+        void Capture(Scene* scene, const SceneEntities& entities);
+
+        std::vector<EntitySnapshot> entities;
+    };
+
+}
+#endif // _Scene_Snapshot_H_
@@ -0,0 +1,209 @@
+#include "SceneUpdater.h"
+#include "../Entities/SceneEntities.h"
+#include "../Graphics/MeshStreamer.h"
+#include "../Jobs/TaskScheduler.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Scenes.h"
+#include "../Profiler/TraceRecorder.h"
+
+#include <atomic>
+#include <map>
+#include <thread>
+
+namespace QwerkE {
+
+    struct SceneUpdater::SceneUpdate
+    {
+        Scene* scene = nullptr;
+        int sceneId = -1;
+        SceneEntities entities;
+        const char* profileName = nullptr;
+
+        double deltaTime = 0.0;
+        TaskScheduler* scheduler = nullptr;
+        std::atomic<unsigned int>* remaining = nullptr;
+    };
+
+    // Trace events keep name pointers until the session ends, so names are
+    // never freed. There is 1 per scene ID.
+    static const char* ProfileName(int sceneId)
+    {
+        static std::map<int, std::string> s_Names;
+
+        std::string& name = s_Names[sceneId];
+        if (name.empty())
+            name = "Scene Update " + std::to_string(sceneId);
+        return name.c_str();
+    }
+
+    SceneUpdater::SceneUpdater()
+    {
+    }
+
+    SceneUpdater::~SceneUpdater()
+    {
+    }
+
+    SceneEntities& SceneUpdater::GetEntities(Scene* scene)
+    {
+        return GetUpdate(scene).entities;
+    }
+
+    SceneUpdater::SceneUpdate& SceneUpdater::GetUpdate(Scene* scene)
+    {
+        std::unique_ptr<SceneUpdate>& update = m_Scenes[scene];
+        if (!update)
+        {
+            update.reset(new SceneUpdate());
+            update->scene = scene;
+            if (scene)
+            {
+                update->sceneId = (int)scene->GetSceneID();
+                update->profileName = ProfileName(update->sceneId);
+            }
+        }
+        return *update;
+    }
+
+    void SceneUpdater::Remove(Scene* scene)
+    {
+        auto it = m_Scenes.find(scene);
+        if (it != m_Scenes.end())
+        {
+            MeshStreamer::Forget(it->second->entities);
+            m_Scenes.erase(it);
+        }
+    }
+
+    void SceneUpdater::Clear()
+    {
+        for (const auto& p : m_Scenes)
+        {
+            MeshStreamer::Forget(p.second->entities);
+        }
+        m_Scenes.clear();
+    }
+
+    void SceneUpdater::PruneRemovedScenes()
+    {
+        // The framework removes scenes without telling anyone. A handful
+        // of scenes is loaded at a time, so a linear search is fine.
+        const auto* scenes = Scenes::LookAtScenes();
+        for (auto it = m_Scenes.begin(); it != m_Scenes.end();)
+        {
+            bool found = false;
+            for (const auto& p : *scenes)
+            {
+                if (p.second != nullptr && p.second == it->first)
+                {
+                    // Another scene may have taken the address
+                    found = (int)p.second->GetSceneID() == it->second->sceneId;
+                    break;
+                }
+            }
+
+            if (found)
+            {
+                ++it;
+            }
+            else
+            {
+                MeshStreamer::Forget(it->second->entities);
+                it = m_Scenes.erase(it);
+            }
+        }
+    }
+
+    void SceneUpdater::RunSceneUpdate(void* data)
+    {
+        SceneUpdate* update = (SceneUpdate*)data;
+        {
+            PROFILE_SCOPE(update->profileName);
+            // Sync() is once a frame. Between frames only marked objects
+            // and objects that came or went need picking up.
+            update->entities.SyncMarked(update->scene);
+            update->entities.UpdateRoutines(update->deltaTime, update->scheduler);
+        }
+
+        if (update->remaining)
+            update->remaining->fetch_sub(1, std::memory_order_release);
+    }
+
+    void SceneUpdater::Sync()
+    {
+        PROFILE_SCOPE("Scene Updater Sync");
+
+        PruneRemovedScenes();
+
+        for (const auto& p : *Scenes::LookAtScenes())
+        {
+            Scene* scene = p.second;
+            if (scene != nullptr && scene->GetIsEnabled())
+                GetEntities(scene).Sync(scene);
+        }
+    }
+
+    void SceneUpdater::Update(double deltaTime, TaskScheduler* scheduler)
+    {
+        PROFILE_SCOPE("Scene Updater Update");
+
+        PruneRemovedScenes();
+
+        m_Pending.clear();
+        for (const auto& p : *Scenes::LookAtScenes())
+        {
+            Scene* scene = p.second;
+            if (scene == nullptr || !scene->GetIsEnabled())
+                continue;
+
+            // Registers scenes enabled since the last Sync(), as Sync() does
+            SceneUpdate& update = GetUpdate(scene);
+            if (update.entities.HasRoutines())
+                m_Pending.push_back(&update);
+        }
+
+        if (m_Pending.empty())
+            return;
+
+        if (!m_ParallelEnabled || scheduler == nullptr || m_Pending.size() == 1)
+        {
+            for (SceneUpdate* update : m_Pending)
+            {
+                update->deltaTime = deltaTime;
+                update->scheduler = scheduler;
+                update->remaining = nullptr;
+                RunSceneUpdate(update);
+            }
+            return;
+        }
+
+        std::atomic<unsigned int> remaining((unsigned int)m_Pending.size() - 1);
+        for (size_t i = 0; i < m_Pending.size(); i++)
+        {
+            SceneUpdate* update = m_Pending[i];
+            update->deltaTime = deltaTime;
+            update->scheduler = scheduler;
+
+            // The calling thread takes the first scene itself
+            if (i > 0)
+            {
+                update->remaining = &remaining;
+                scheduler->Schedule(RunSceneUpdate, update);
+            }
+            else
+            {
+                update->remaining = nullptr;
+            }
+        }
+
+        RunSceneUpdate(m_Pending[0]);
+
+        while (remaining.load(std::memory_order_acquire) != 0)
+        {
+            if (!scheduler->RunPendingTask())
+                std::this_thread::yield();
+        }
+    }
+
+}
@@ -0,0 +1,70 @@
+#ifndef _Scene_Updater_H_
+#define _Scene_Updater_H_
+
+// Keeps a SceneEntities for every scene and runs the batched routines of
+// all enabled scenes once a simulation step.
+//
+// Scenes share no entities. A scene's update only reads its own Scene and
+// writes its own SceneEntities and GameObjects, and parents or routines
+// that point into another scene are dropped when its store is rebuilt. So
+// with a TaskScheduler every enabled scene is updated as its own task, and
+// large batches inside a scene still split into range tasks.
+//
+// Each scene's update is profiled as "Scene Update <id>".
+//
+// Routines owned by the framework are not touched here. They still run
+// one scene after another in Framework::Update(), as they can reach
+// renderer and physics state.
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace QwerkE {
+
+    class Scene;
+    class SceneEntities;
+    class TaskScheduler;
+
+    class SceneUpdater
+    {
+    public:
+        SceneUpdater();
+        ~SceneUpdater();
+
+        // Created on first use
+        SceneEntities& GetEntities(Scene* scene);
+
+        // Drops the scene's entities, parents, routines and streaming
+        // requests. Update() does this for scenes the framework no longer has.
+        void Remove(Scene* scene);
+        void Clear();
+
+        // Syncs the entities of every enabled scene. Once a frame, after
+        // the simulation, so drawing and handles see the frame's changes.
+        void Sync();
+
+        // Updates every enabled scene that has routines, and creates the
+        // entities of enabled scenes that have none yet. Returns once all
+        // of them are done. Main thread only.
+        void Update(double deltaTime, TaskScheduler* scheduler);
+
+        // Set false to update scenes one after another on the calling thread
+        void SetParallelEnabled(bool enabled) { m_ParallelEnabled = enabled; }
+
+    private:
+        struct SceneUpdate;
+
+        // Created on first use
+        SceneUpdate& GetUpdate(Scene* scene);
+        void PruneRemovedScenes();
+        static void RunSceneUpdate(void* data);
+
+        std::unordered_map<const Scene*, std::unique_ptr<SceneUpdate>> m_Scenes;
+        std::vector<SceneUpdate*> m_Pending;
+        bool m_ParallelEnabled = true;
+    };
+
+}
+#endif // _Scene_Updater_H_
@@ -0,0 +1,177 @@
+#include "TransformInterpolator.h"
+#include "../Entities/SceneEntities.h"
+
+#include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
+#include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
+
+#include <cstring>
+#include <map>
+#include <string>
+
+namespace QwerkE {
+
+    static void ReadTransform(GameObject* object, float position[3], float rotation[3], float scale[3])
+    {
+        const vec3 pos = object->GetPosition();
+        const vec3 rot = object->GetRotation();
+        const vec3 scl = object->GetScale();
+        position[0] = pos.x; position[1] = pos.y; position[2] = pos.z;
+        rotation[0] = rot.x; rotation[1] = rot.y; rotation[2] = rot.z;
+        scale[0] = scl.x; scale[1] = scl.y; scale[2] = scl.z;
+    }
+
+    static bool TransformsMatch(GameObject* object, const float position[3], const float rotation[3], const float scale[3])
+    {
+        float pos[3], rot[3], scl[3];
+        ReadTransform(object, pos, rot, scl);
+        for (int i = 0; i < 3; i++)
+        {
+            if (pos[i] != position[i] || rot[i] != rotation[i] || scl[i] != scale[i])
+                return false;
+        }
+        return true;
+    }
+
+    static float Lerp(float a, float b, float alpha)
+    {
+        return a + (b - a) * alpha;
+    }
+
+    // Rotations are euler angles in degrees. Take the short way around.
+    static float LerpDegrees(float a, float b, float alpha)
+    {
+        float delta = b - a;
+        while (delta > 180.0f) delta -= 360.0f;
+        while (delta < -180.0f) delta += 360.0f;
+        return a + delta * alpha;
+    }
+
+    bool TransformInterpolator::ObjectsChanged(Scene* scene) const
+    {
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        if (objects.size() != m_Previous.size())
+            return true;
+
+        unsigned int index = 0;
+        for (const auto& p : objects)
+        {
+            if (m_Previous[index++].object != p.second)
+                return true;
+        }
+        return false;
+    }
+
+    const TransformInterpolator::Transform* TransformInterpolator::FindPrevious(GameObject* object, unsigned int listIndex) const
+    {
+        // Objects are usually where they were at capture
+        if (listIndex < m_Previous.size() && m_Previous[listIndex].object == object)
+            return &m_Previous[listIndex].transform;
+
+        auto it = m_PreviousIndices.find(object);
+        if (it == m_PreviousIndices.end())
+            return nullptr;
+        return &m_Previous[it->second].transform;
+    }
+
+    void TransformInterpolator::Capture(Scene* scene)
+    {
+        if (scene != m_CapturedScene)
+        {
+            Clear();
+            m_CapturedScene = scene;
+        }
+
+        if (scene == nullptr)
+            return;
+
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+
+        // Storage is kept between ticks. Rebuild only when objects joined or left.
+        if (ObjectsChanged(scene))
+        {
+            m_Previous.clear();
+            m_PreviousIndices.clear();
+            for (const auto& p : objects)
+            {
+                m_PreviousIndices[p.second] = (unsigned int)m_Previous.size();
+                m_Previous.push_back({ p.second, Transform() });
+            }
+        }
+
+        for (CapturedTransform& previous : m_Previous)
+        {
+            ReadTransform(previous.object, previous.transform.position, previous.transform.rotation, previous.transform.scale);
+        }
+    }
+
+    void TransformInterpolator::Apply(Scene* scene, float alpha, SceneEntities& entities)
+    {
+        m_Applied.clear();
+
+        if (scene == nullptr || scene != m_CapturedScene)
+            return;
+
+        const std::map<std::string, GameObject*>& objects = scene->GetObjectList();
+        m_Applied.reserve(objects.size());
+
+        unsigned int listIndex = 0;
+        for (const auto& p : objects)
+        {
+            const Transform* previous = FindPrevious(p.second, listIndex++);
+            if (previous == nullptr)
+                continue; // Spawned since the last tick. Draw as is.
+
+            AppliedTransform applied;
+            applied.object = p.second;
+            ReadTransform(p.second, applied.simulated.position, applied.simulated.rotation, applied.simulated.scale);
+
+            // Objects that didn't move over the tick are drawn as is
+            const Transform& from = *previous;
+            const Transform& to = applied.simulated;
+            if (memcmp(&from, &to, sizeof(Transform)) == 0)
+                continue;
+
+            Transform& result = applied.interpolated;
+            for (int i = 0; i < 3; i++)
+            {
+                result.position[i] = Lerp(from.position[i], to.position[i], alpha);
+                result.rotation[i] = LerpDegrees(from.rotation[i], to.rotation[i], alpha);
+                result.scale[i] = Lerp(from.scale[i], to.scale[i], alpha);
+            }
+
+            p.second->SetPosition(vec3(result.position[0], result.position[1], result.position[2]));
+            p.second->SetRotation(vec3(result.rotation[0], result.rotation[1], result.rotation[2]));
+            p.second->SetScale(vec3(result.scale[0], result.scale[1], result.scale[2]));
+            entities.MarkTransformChanged(p.second);
+
+            m_Applied.push_back(applied);
+        }
+    }
+
+    void TransformInterpolator::Restore(SceneEntities& entities)
+    {
+        for (const AppliedTransform& applied : m_Applied)
+        {
+            // Objects moved while drawing (editor gizmos, entity editor input)
+            // keep their new transform instead of being snapped back.
+            if (!TransformsMatch(applied.object, applied.interpolated.position, applied.interpolated.rotation, applied.interpolated.scale))
+                continue;
+
+            const Transform& t = applied.simulated;
+            applied.object->SetPosition(vec3(t.position[0], t.position[1], t.position[2]));
+            applied.object->SetRotation(vec3(t.rotation[0], t.rotation[1], t.rotation[2]));
+            applied.object->SetScale(vec3(t.scale[0], t.scale[1], t.scale[2]));
+            entities.MarkTransformChanged(applied.object);
+        }
+        m_Applied.clear();
+    }
+
+    void TransformInterpolator::Clear()
+    {
+        m_Previous.clear();
+        m_PreviousIndices.clear();
+        m_Applied.clear();
+        m_CapturedScene = nullptr;
+    }
+
+}
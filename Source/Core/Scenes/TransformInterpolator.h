@@ -0,0 +1,61 @@
+#ifndef _Transform_Interpolator_H_
+#define _Transform_Interpolator_H_
+
+// Smooths rendering when the simulation runs at a fixed tick rate.
+// Capture() remembers object transforms before a tick. Before drawing,
+// Apply() blends between the captured and current (post tick) state
+// and Restore() puts the simulated state back once drawing is done.
+// Objects either of them moves are marked in the scene's SceneEntities.
+
+#include <unordered_map>
+#include <vector>
+
+namespace QwerkE {
+
+    class GameObject;
+    class Scene;
+    class SceneEntities;
+
+    class TransformInterpolator
+    {
+    public:
+        void Capture(Scene* scene);
+
+        void Apply(Scene* scene, float alpha, SceneEntities& entities);
+        void Restore(SceneEntities& entities);
+
+        void Clear();
+
+    private:
+        struct Transform
+        {
+            float position[3];
+            float rotation[3];
+            float scale[3];
+        };
+
+        struct CapturedTransform
+        {
+            GameObject* object;
+            Transform transform;
+        };
+
+        struct AppliedTransform
+        {
+            GameObject* object;
+            Transform simulated;
+            Transform interpolated;
+        };
+
+        bool ObjectsChanged(Scene* scene) const;
+        const Transform* FindPrevious(GameObject* object, unsigned int listIndex) const;
+
+        // In object list order. Rebuilt only when the scene's objects change.
+        std::vector<CapturedTransform> m_Previous;
+        std::unordered_map<GameObject*, unsigned int> m_PreviousIndices;
+        std::vector<AppliedTransform> m_Applied;
+        Scene* m_CapturedScene = nullptr;
+    };
+
+}
+#endif // _Transform_Interpolator_H_
@@ -0,0 +1,54 @@
+#include "FrameLimiter.h"
+
+#include "../Profiler/TraceRecorder.h"
+
+#include <thread>
+
+namespace QwerkE {
+
+    FrameLimiter::FrameLimiter()
+    {
+        SetMaxFPS(144);
+        SetSpinWindow(1500);
+        m_NextFrameStart = Clock::now();
+    }
+
+    void FrameLimiter::SetMaxFPS(unsigned short maxFPS)
+    {
+        if (maxFPS == 0)
+            maxFPS = 1;
+
+        m_FramePeriod = std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(1.0 / maxFPS));
+    }
+
+    void FrameLimiter::SetSpinWindow(unsigned short microseconds)
+    {
+        m_SpinWindow = std::chrono::microseconds(microseconds);
+    }
+
+    void FrameLimiter::WaitForNextFrame()
+    {
+        PROFILE_SCOPE("Frame Limiter");
+
+        m_NextFrameStart += m_FramePeriod;
+
+        Clock::time_point now = Clock::now();
+        if (now >= m_NextFrameStart)
+        {
+            // Running behind. Don't try to catch up by shortening future frames.
+            m_NextFrameStart = now;
+            return;
+        }
+
+        if (m_NextFrameStart - now > m_SpinWindow)
+        {
+            std::this_thread::sleep_for(m_NextFrameStart - now - m_SpinWindow);
+        }
+
+        while (Clock::now() < m_NextFrameStart)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+}
@@ -0,0 +1,33 @@
+#ifndef _Frame_Limiter_H_
+#define _Frame_Limiter_H_
+
+// Caps the frame rate by sleeping for most of the remaining frame
+// time, then spinning for the last stretch. OS sleeps are too coarse
+// to hit a deadline by themselves, and spinning the whole time burns
+// a core for nothing.
+
+#include <chrono>
+
+namespace QwerkE {
+
+    class FrameLimiter
+    {
+    public:
+        FrameLimiter();
+
+        void SetMaxFPS(unsigned short maxFPS);
+        void SetSpinWindow(unsigned short microseconds);
+
+        // Blocks until the next frame should start
+        void WaitForNextFrame();
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        Clock::duration m_FramePeriod;
+        Clock::duration m_SpinWindow;
+        Clock::time_point m_NextFrameStart;
+    };
+
+}
+#endif // _Frame_Limiter_H_
@@ -0,0 +1,71 @@
+#include "TickCounter.h"
+
+#include "../QwerkE_Framework/Source/Debug/Log/Log.h"
+
+namespace QwerkE {
+
+    TickCounter::TickCounter(const char* name, double reportIntervalSeconds)
+        : m_Name(name), m_ReportInterval(reportIntervalSeconds)
+    {
+        m_Start = Clock::now();
+        m_IntervalStart = m_Start;
+        m_TickStart = m_Start;
+    }
+
+    void TickCounter::BeginTick()
+    {
+        m_TickStart = Clock::now();
+    }
+
+    void TickCounter::EndTick()
+    {
+        const Clock::time_point now = Clock::now();
+        const double tickSeconds = std::chrono::duration<double>(now - m_TickStart).count();
+
+        m_TotalTicks++;
+        m_TotalTickSeconds += tickSeconds;
+        if (tickSeconds > m_WorstTickSeconds)
+            m_WorstTickSeconds = tickSeconds;
+
+        m_IntervalTicks++;
+        m_IntervalTickSeconds += tickSeconds;
+        if (tickSeconds > m_IntervalWorstTickSeconds)
+            m_IntervalWorstTickSeconds = tickSeconds;
+
+        const std::chrono::duration<double> interval = now - m_IntervalStart;
+        if (interval >= m_ReportInterval)
+        {
+            p_Report(interval.count());
+            m_IntervalStart = now;
+            p_ResetInterval();
+        }
+    }
+
+    void TickCounter::LogSummary() const
+    {
+        const double elapsed = ElapsedSeconds();
+        const double averageMs = m_TotalTicks ? m_TotalTickSeconds / m_TotalTicks * 1000.0 : 0.0;
+        LOG_INFO("{0}: {1} ticks in {2:.2f}s. {3:.1f} ticks/s, avg tick {4:.3f}ms, worst tick {5:.3f}ms",
+            m_Name, m_TotalTicks, elapsed, elapsed > 0.0 ? m_TotalTicks / elapsed : 0.0, averageMs, m_WorstTickSeconds * 1000.0);
+    }
+
+    double TickCounter::ElapsedSeconds() const
+    {
+        return std::chrono::duration<double>(Clock::now() - m_Start).count();
+    }
+
+    void TickCounter::p_Report(double intervalSeconds)
+    {
+        const double averageMs = m_IntervalTicks ? m_IntervalTickSeconds / m_IntervalTicks * 1000.0 : 0.0;
+        LOG_INFO("{0}: {1:.1f} ticks/s, avg tick {2:.3f}ms, worst tick {3:.3f}ms",
+            m_Name, m_IntervalTicks / intervalSeconds, averageMs, m_IntervalWorstTickSeconds * 1000.0);
+    }
+
+    void TickCounter::p_ResetInterval()
+    {
+        m_IntervalTicks = 0;
+        m_IntervalTickSeconds = 0.0;
+        m_IntervalWorstTickSeconds = 0.0;
+    }
+
+}
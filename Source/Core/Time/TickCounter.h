@@ -0,0 +1,47 @@
+#ifndef _Tick_Counter_H_
+#define _Tick_Counter_H_
+
+// Measures how many simulation ticks run per second and how long each
+// tick took. Logs a line every report interval and a summary on request.
+
+#include <chrono>
+
+namespace QwerkE {
+
+    class TickCounter
+    {
+    public:
+        TickCounter(const char* name, double reportIntervalSeconds = 1.0);
+
+        void BeginTick();
+        void EndTick();
+
+        void LogSummary() const;
+
+        unsigned long long TotalTicks() const { return m_TotalTicks; }
+        double ElapsedSeconds() const;
+
+    private:
+        typedef std::chrono::steady_clock Clock;
+
+        void p_Report(double intervalSeconds);
+        void p_ResetInterval();
+
+        const char* m_Name;
+        std::chrono::duration<double> m_ReportInterval;
+
+        Clock::time_point m_Start;
+        Clock::time_point m_IntervalStart;
+        Clock::time_point m_TickStart;
+
+        unsigned long long m_TotalTicks = 0;
+        double m_TotalTickSeconds = 0.0;
+        double m_WorstTickSeconds = 0.0;
+
+        unsigned int m_IntervalTicks = 0;
+        double m_IntervalTickSeconds = 0.0;
+        double m_IntervalWorstTickSeconds = 0.0;
+    };
+
+}
+#endif // _Tick_Counter_H_
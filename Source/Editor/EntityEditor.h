@@ -4,6 +4,9 @@
 // A window that shows data for an entity and gives a GUI
 //     to allow for data to easily be modified.
 
+#include "../Core/Entities/EntityGuid.h"
+#include "../Core/Entities/ObjectHandles.h"
+
 #include <string>
 
 namespace QwerkE {
@@ -19,12 +22,18 @@ namespace QwerkE {
 
         virtual void Draw();
 
-        void SetCurrentEntity(GameObject* object) { m_CurrentEntity = object; };
+        void SetCurrentEntity(GameObject* object);
 
     private:
         void DrawEntityEditor();
 
-        GameObject* m_CurrentEntity = nullptr;
+        // Null once the selected object leaves the scene. Objects reloaded
+        // with the same GUID stay selected.
+        GameObject* ResolveSelection();
+
+        ObjectHandle m_Selection;
+        EntityGuid m_SelectionGuid = 0;
+        GameObject* m_CurrentEntity = nullptr; // m_Selection, resolved each Draw()
         EditComponent* m_EditComponent = nullptr;
     };
 
@@ -0,0 +1,53 @@
+#ifndef _ProfilerPanel_H_
+#define _ProfilerPanel_H_
+
+#include "../Core/Profiler/ProfilerHistory.h"
+
+#include <vector>
+
+namespace QwerkE {
+
+    // Live view of PROFILE_SCOPE data. Shows recent frame times with
+    // percentiles, and a flame graph per thread for one frame. Freezing
+    // stops collection so a spike frame can be inspected.
+    class ProfilerPanel
+    {
+    public:
+        ProfilerPanel();
+        ~ProfilerPanel();
+
+        // Call every frame. Collection stops while *isOpen is false.
+        void Draw(bool* isOpen);
+
+    private:
+        void StartCollecting();
+        void StopCollecting();
+
+        void SetFrozen(bool frozen);
+        void SelectFrame(unsigned long long frameIndex);
+        void RefreshFrameTimes();
+
+        void DrawFrameGraph();
+        void DrawFlameGraph();
+
+        bool m_Collecting = false;
+        bool m_OwnsTraceSession = false;
+
+        bool m_Frozen = false;
+        bool m_FreezeOnSpike = false;
+        float m_SpikeThresholdMs = 33.3f;
+
+        std::vector<float> m_FrameTimes; // Milliseconds, oldest first
+        unsigned long long m_LastFrameIndex = 0; // Frame of m_FrameTimes.back()
+        unsigned long long m_LastCheckedFrame = 0; // For freeze on spike
+        float m_P50 = 0.0f;
+        float m_P95 = 0.0f;
+        float m_P99 = 0.0f;
+        float m_Worst = 0.0f;
+
+        ProfilerFrame m_Frame;
+        bool m_HasFrame = false;
+    };
+
+}
+#endif // _ProfilerPanel_H_
@@ -1,6 +1,8 @@
 #ifndef _SceneViewer_H_
 #define _SceneViewer_H_
 
+#include "../Core/Scenes/SceneImage.h"
+
 namespace QwerkE {
 
     class FrameBufferObject;
@@ -19,6 +21,9 @@ namespace QwerkE {
         void DrawSceneView();
         void DrawSceneList();
         FrameBufferObject* m_FBO = nullptr;
+
+        // The scene as it was when last set running, for "Reset"
+        SceneImage m_PlayStart;
     };
 
 }
@@ -1,5 +1,8 @@
 #include "../EditComponent.h"
 
+#include "../../Engine.h"
+#include "../../Core/Entities/SceneEntities.h"
+
 #include "../QwerkE_Framework/Source/Utilities/StringHelpers.h"
 #include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
 #include "../QwerkE_Framework/Source/Core/Scenes/Entities/Routines/RenderRoutine.h"
@@ -77,6 +80,7 @@ namespace QwerkE {
                 if (ImGui::Selectable(m_ShaderStrings[i]))
                 {
                     rComp->SetShaderAtIndex(m_RenderableIndex, Resources::GetShaderProgram(m_ShaderStrings[i]));
+                    Engine::GetSceneEntities().MarkChanged(rComp->GetParent());
                 }
             }
             if (ImGui::IsItemClicked(1))
@@ -99,6 +103,7 @@ namespace QwerkE {
                 if (ImGui::Selectable(m_MatStrings[i]))
                 {
                     rComp->SetMaterialAtIndex(m_RenderableIndex, Resources::GetMaterial(m_MatStrings[i]));
+                    Engine::GetSceneEntities().MarkChanged(rComp->GetParent());
                 }
                 if (ImGui::IsItemClicked(1))
                 {
@@ -121,6 +126,7 @@ namespace QwerkE {
                 if (ImGui::Selectable(m_MeshStrings[i]))
                 {
                     rComp->SetMeshAtIndex(m_RenderableIndex, Resources::GetMesh(m_MeshStrings[i]));
+                    Engine::GetSceneEntities().MarkChanged(rComp->GetParent());
                 }
             }
 
@@ -5,6 +5,7 @@
 #include "../SceneViewer.h"
 #include "../SceneGraph.h"
 #include "../EditComponent.h"
+#include "../ProfilerPanel.h"
 
 #include "../QwerkE_Framework/Libraries/imgui/imgui.h"
 #include "../QwerkE_Framework/Source/FileSystem/FileIO/FileUtilities.h"
@@ -14,10 +15,22 @@
 #include "../QwerkE_Framework/Source/Core/Scenes/Scenes.h"
 #include "../QwerkE_Framework/Source/Core/Time/Time.h"
 #include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/FrameBufferObject.h"
-#include "../QwerkE_Framework/Source/Debug/Profiler/Profiler.h"
+
+#include "../../Core/Memory/HeapCounter.h"
+#include "../../Core/Profiler/TraceRecorder.h"
 
 namespace QwerkE {
 
+    // Heap allocations of the last frame, in the main menu bar
+    static void DrawAllocationCount()
+    {
+        static bool showAllocations = true;
+        if (ImGui::Button("Allocs"))
+            showAllocations = !showAllocations;
+        ImGui::SameLine();
+        if (showAllocations) ImGui::Text("%u", HeapCounter::LastFrameAllocations());
+    }
+
     imgui_Editor::imgui_Editor()
     {
         m_EntityEditor = new EntityEditor();
@@ -25,6 +38,7 @@ namespace QwerkE {
         m_ResourceViewer = new ResourceViewer();
         m_ShaderEditor = new ShaderEditor();
         m_SceneViewer = new SceneViewer();
+        m_ProfilerPanel = new ProfilerPanel();
     }
 
     imgui_Editor::~imgui_Editor()
@@ -34,6 +48,7 @@ namespace QwerkE {
         delete m_ResourceViewer;
         delete m_ShaderEditor;
         delete m_SceneViewer;
+        delete m_ProfilerPanel;
     }
 
     void imgui_Editor::NewFrame()
@@ -66,16 +81,13 @@ namespace QwerkE {
 
                 if (ImGui::BeginMenu("Tools"))
                 {
-                    const int size = 1;
-                    static const char* toolsList[size] = { "Shader Editor" };
-                    static bool* toolsStates[size] = { &m_ShowingShaderEditor };
+                    const int size = 2;
+                    static const char* toolsList[size] = { "Shader Editor", "Profiler" };
+                    static bool* toolsStates[size] = { &m_ShowingShaderEditor, &m_ShowingProfiler };
 
                     for (int i = 0; i < size; i++)
                     {
-                        if (ImGui::Checkbox(toolsList[i], toolsStates[i]))
-                        {
-                            m_ShowingShaderEditor = *toolsStates[i];
-                        }
+                        ImGui::Checkbox(toolsList[i], toolsStates[i]);
                     }
                     ImGui::EndMenu();
                 }
@@ -88,6 +100,8 @@ namespace QwerkE {
                 ImGui::SameLine();
                 if (showFPS) ImGui::Text("%4.2f", 1.0 / Time::Delta());
 
+                DrawAllocationCount();
+
                 if (ImGui::BeginMenu("Testing"))
                 {
                     static bool clientServerEnabled = false;
@@ -141,16 +155,13 @@ namespace QwerkE {
 
             if (ImGui::BeginMenu("Tools"))
             {
-                const int size = 1;
-                static const char* toolsList[size] = { "Shader Editor" };
-                static bool* toolsStates[size] = { &m_ShowingShaderEditor };
+                const int size = 2;
+                static const char* toolsList[size] = { "Shader Editor", "Profiler" };
+                static bool* toolsStates[size] = { &m_ShowingShaderEditor, &m_ShowingProfiler };
 
                 for (int i = 0; i < size; i++)
                 {
-                    if (ImGui::Checkbox(toolsList[i], toolsStates[i]))
-                    {
-                        m_ShowingShaderEditor = *toolsStates[i];
-                    }
+                    ImGui::Checkbox(toolsList[i], toolsStates[i]);
                 }
                 ImGui::EndMenu();
             }
@@ -163,6 +174,8 @@ namespace QwerkE {
             ImGui::SameLine();
             if (showFPS) ImGui::Text("%4.2f", 1.0 / Time::Delta());
 
+            DrawAllocationCount();
+
             if (ImGui::BeginMenu("Testing"))
             {
                 static bool clientServerEnabled = false;
@@ -192,6 +205,8 @@ namespace QwerkE {
         if (m_ShowingShaderEditor)
             m_ShaderEditor->Draw(&m_ShowingShaderEditor);
 
+        m_ProfilerPanel->Draw(&m_ShowingProfiler); // Stops collecting when closed
+
         m_ResourceViewer->Draw();
         m_SceneViewer->Draw();
         m_SceneGraph->Draw();
@@ -9,6 +9,7 @@ namespace QwerkE {
     class ShaderEditor;
     class SceneViewer;
     class EntityEditor;
+    class ProfilerPanel;
 
     // TODO: Consider deprecating header to use Editor.h
     class imgui_Editor : Editor
@@ -30,11 +31,13 @@ namespace QwerkE {
 
         bool m_ShowingExampleWindow = false;
         bool m_ShowingShaderEditor = false;
+        bool m_ShowingProfiler = false;
         bool m_ShowingEditorGUI = true;
         ResourceViewer* m_ResourceViewer = nullptr;
         ShaderEditor* m_ShaderEditor = nullptr;
         SceneViewer* m_SceneViewer = nullptr;
         EntityEditor* m_EntityEditor = nullptr;
+        ProfilerPanel* m_ProfilerPanel = nullptr;
     };
 
 }
@@ -2,6 +2,9 @@
 #include "../EditComponent.h"
 #include "../Editor.h"
 
+#include "../../Engine.h"
+#include "../../Core/Entities/SceneEntities.h"
+
 #include "../QwerkE_Framework/Libraries/imgui/imgui.h"
 #include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
 #include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
@@ -29,15 +32,37 @@ namespace QwerkE {
         delete m_EditComponent;
 	}
 
+    void EntityEditor::SetCurrentEntity(GameObject* object)
+    {
+        SceneEntities& sceneEntities = Engine::GetSceneEntities();
+        m_Selection = sceneEntities.GetHandle(object);
+        m_SelectionGuid = sceneEntities.GetGuid(object);
+    }
+
+    GameObject* EntityEditor::ResolveSelection()
+    {
+        SceneEntities& sceneEntities = Engine::GetSceneEntities();
+        if (GameObject* object = sceneEntities.Resolve(m_Selection))
+            return object;
+
+        // Reloads make new objects, which keep their GUIDs
+        GameObject* object = m_SelectionGuid ? sceneEntities.FindByGuid(m_SelectionGuid) : nullptr;
+        if (object)
+            m_Selection = sceneEntities.GetHandle(object);
+        return object;
+    }
+
 	// ImGui styling: https://www.unknowncheats.me/forum/direct3d/189635-imgui-style-settings.html
 	void EntityEditor::Draw()
 	{
+        m_CurrentEntity = ResolveSelection();
 		if (m_CurrentEntity == nullptr)
 		{
-            auto list = Scenes::GetCurrentScene()->GetObjectList();
+            const auto& list = Scenes::GetCurrentScene()->GetObjectList();
             auto begin = list.begin();
             if (begin != list.end())
             {
+                SetCurrentEntity(begin->second);
                 m_CurrentEntity = begin->second;
 			}
 		}
@@ -71,17 +96,45 @@ namespace QwerkE {
             scale[1] = m_CurrentEntity->GetScale().y;
             scale[2] = m_CurrentEntity->GetScale().z;
 
+            SceneEntities& sceneEntities = Engine::GetSceneEntities();
             if (ImGui::InputFloat3("Pos: ", pos))
             {
                 m_CurrentEntity->SetPosition(vec3(pos[0], pos[1], pos[2]));
+                sceneEntities.MarkTransformChanged(m_CurrentEntity);
             }
             if (ImGui::InputFloat3("Rot: ", rot))
             {
                 m_CurrentEntity->SetRotation(vec3(rot[0], rot[1], rot[2]));
+                sceneEntities.MarkTransformChanged(m_CurrentEntity);
             }
             if (ImGui::InputFloat3("Scale: ", scale))
             {
                 m_CurrentEntity->SetScale(vec3(scale[0], scale[1], scale[2]));
+                sceneEntities.MarkTransformChanged(m_CurrentEntity);
+            }
+
+            // Transforms are in world space. Children follow their parent
+            // once the engine syncs the store.
+            GameObject* parent = sceneEntities.GetParent(m_CurrentEntity);
+            if (ImGui::BeginCombo("Parent: ", parent ? parent->GetName().c_str() : "None"))
+            {
+                if (ImGui::Selectable("None", parent == nullptr))
+                {
+                    sceneEntities.SetParent(m_CurrentEntity, nullptr);
+                }
+
+                for (const auto& p : Scenes::GetCurrentScene()->GetObjectList())
+                {
+                    if (p.second == m_CurrentEntity)
+                        continue;
+
+                    // Fails for descendants, which would make a loop
+                    if (ImGui::Selectable(p.first.c_str(), p.second == parent))
+                    {
+                        sceneEntities.SetParent(m_CurrentEntity, p.second);
+                    }
+                }
+                ImGui::EndCombo();
             }
 
             ImGui::Separator();
@@ -108,9 +161,8 @@ namespace QwerkE {
                             renderable.SetMaterial(Resources::GetMaterial(null_material));
                             renderable.SetShader(Resources::GetShaderProgram(null_shader));
                             renderable.SetMesh(Resources::GetMesh(null_mesh));
-                            static int uniqueId = 0; // TODO: Implement GUIDs
-                            // NOTE: Currently if 2 or more renderables have the same name, you will not be able to select any one except the first in editor
-                            renderable.SetRenderableName(std::to_string(uniqueId++));
+                            // Renderables are selected by name, so names must be unique
+                            renderable.SetRenderableName(EntityGuids::ToString(EntityGuids::Create()));
 
                             RenderComponent* rComp = (RenderComponent*)m_CurrentEntity->GetComponent(Component_Render);
 
@@ -147,7 +199,8 @@ namespace QwerkE {
                         }
                         break;
                     }
-
+                    // The store keeps component pointers
+                    sceneEntities.Invalidate();
                     showComponentSelector = false;
                 }
             }
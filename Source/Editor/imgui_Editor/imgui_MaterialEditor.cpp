@@ -29,13 +29,13 @@ namespace QwerkE {
             ImGui::Text(material->GetMaterialName().c_str());
             ImGui::Separator();
             int counter = 0;
-            for (auto p : *textures)
+            for (const auto& p : *textures)
             {
                 if (counter > 0)
                     ImGui::SameLine();
 
                 ImGui::SameLine();
-                ImGui::Text(std::to_string((int)p.first).c_str());
+                ImGui::Text("%i", (int)p.first);
                 ImGui::SameLine();
                 if (m_CurrentMap == p.first)
                 {
@@ -52,7 +52,7 @@ namespace QwerkE {
                 {
                     ImGui::BeginTooltip();
                     ImGui::Text(p.second->s_Name.c_str());
-                    ImGui::Text(std::to_string(p.second->s_Handle).c_str());
+                    ImGui::Text("%u", (unsigned int)p.second->s_Handle);
                     //ImGui::Text("TagName");
                     ImGui::EndTooltip();
                 }
@@ -64,7 +64,7 @@ namespace QwerkE {
 
             ImGui::Separator();
             counter = 0;
-            for (auto p : *m_TextureList)
+            for (const auto& p : *m_TextureList)
             {
                 if (counter % 6)
                     ImGui::SameLine();
@@ -74,7 +74,7 @@ namespace QwerkE {
                 {
                     ImGui::BeginTooltip();
                     ImGui::Text(p.second->s_Name.c_str());
-                    ImGui::Text(std::to_string(p.second->s_Handle).c_str());
+                    ImGui::Text("%u", (unsigned int)p.second->s_Handle);
                     //ImGui::Text("TagName");
                     ImGui::EndTooltip();
                 }
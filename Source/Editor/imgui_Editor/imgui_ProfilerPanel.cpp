@@ -0,0 +1,295 @@
+#include "../ProfilerPanel.h"
+
+#include "../../../QwerkE_Framework/Libraries/imgui/imgui.h"
+
+#include "../../Core/Memory/FrameAllocator.h"
+#include "../../Core/Profiler/TraceRecorder.h"
+
+#include <algorithm>
+
+namespace QwerkE {
+
+    static const float s_LaneRowHeight = 18.0f;
+    static const unsigned int s_MaxDepth = 32;
+
+    static ImU32 ScopeColour(const char* name)
+    {
+        // Same name, same colour, every frame
+        unsigned int hash = 2166136261u;
+        for (const char* c = name; *c; c++)
+        {
+            hash = (hash ^ (unsigned char)*c) * 16777619u;
+        }
+        return IM_COL32(90 + hash % 120, 90 + (hash >> 8) % 120, 90 + (hash >> 16) % 120, 255);
+    }
+
+    static float Percentile(const FrameVector<float>& sortedTimes, float percentile)
+    {
+        if (sortedTimes.empty())
+            return 0.0f;
+
+        return sortedTimes[(size_t)((sortedTimes.size() - 1) * percentile + 0.5f)];
+    }
+
+    ProfilerPanel::ProfilerPanel()
+    {
+    }
+
+    ProfilerPanel::~ProfilerPanel()
+    {
+        StopCollecting();
+    }
+
+    void ProfilerPanel::Draw(bool* isOpen)
+    {
+        if (*isOpen == false)
+        {
+            StopCollecting();
+            return;
+        }
+
+        if (!m_Collecting)
+            StartCollecting();
+
+        if (!m_Frozen)
+            RefreshFrameTimes();
+
+        if (!ImGui::Begin("Profiler", isOpen))
+        {
+            ImGui::End();
+            return;
+        }
+
+        bool frozen = m_Frozen;
+        if (ImGui::Checkbox("Freeze", &frozen))
+            SetFrozen(frozen);
+
+        ImGui::SameLine();
+        ImGui::Checkbox("Freeze on spike", &m_FreezeOnSpike);
+        ImGui::SameLine();
+        ImGui::PushItemWidth(80.0f);
+        ImGui::DragFloat("ms", &m_SpikeThresholdMs, 0.1f, 1.0f, 1000.0f, "%.1f");
+        ImGui::PopItemWidth();
+
+        ImGui::SameLine();
+        if (ImGui::Button("Worst frame") && !m_FrameTimes.empty())
+        {
+            const size_t worst = std::max_element(m_FrameTimes.begin(), m_FrameTimes.end()) - m_FrameTimes.begin();
+            SetFrozen(true);
+            SelectFrame(m_LastFrameIndex - (m_FrameTimes.size() - 1) + worst);
+        }
+
+        ImGui::Text("p50 %.2fms  p95 %.2fms  p99 %.2fms  worst %.2fms  (%u frames)",
+            m_P50, m_P95, m_P99, m_Worst, (unsigned int)m_FrameTimes.size());
+
+        if (!TraceRecorder::IsRecording())
+            ImGui::Text("No trace session is recording");
+
+        DrawFrameGraph();
+
+        ImGui::Separator();
+
+        if (m_HasFrame)
+        {
+            ImGui::Text("Frame %llu  %.3fms", m_Frame.frameIndex, (m_Frame.endTime - m_Frame.startTime) / 1000000.0);
+            DrawFlameGraph();
+        }
+        else
+        {
+            ImGui::Text("Waiting for frame data");
+        }
+
+        ImGui::End();
+    }
+
+    void ProfilerPanel::StartCollecting()
+    {
+        // The panel can run without a trace file. Live only sessions are ended on close.
+        if (!TraceRecorder::IsRecording())
+            m_OwnsTraceSession = TraceRecorder::BeginSession(nullptr);
+
+        ProfilerHistory::SetEnabled(true);
+        m_Collecting = true;
+        m_Frozen = false;
+        m_HasFrame = false;
+        m_LastCheckedFrame = 0;
+    }
+
+    void ProfilerPanel::StopCollecting()
+    {
+        if (!m_Collecting)
+            return;
+
+        ProfilerHistory::SetEnabled(false);
+        if (m_OwnsTraceSession)
+            TraceRecorder::EndSession();
+
+        m_OwnsTraceSession = false;
+        m_Collecting = false;
+    }
+
+    void ProfilerPanel::SetFrozen(bool frozen)
+    {
+        // History stops recording while frozen so every frame in it stays inspectable
+        m_Frozen = frozen;
+        ProfilerHistory::SetEnabled(!frozen);
+
+        if (!frozen)
+        {
+            m_HasFrame = false;
+            m_LastCheckedFrame = 0;
+        }
+    }
+
+    void ProfilerPanel::SelectFrame(unsigned long long frameIndex)
+    {
+        m_HasFrame = ProfilerHistory::CopyFrame(frameIndex, m_Frame);
+    }
+
+    void ProfilerPanel::RefreshFrameTimes()
+    {
+        unsigned long long newestFrame = 0;
+        if (!ProfilerHistory::NewestCompleteFrame(newestFrame))
+            return;
+
+        ProfilerHistory::CopyFrameTimes(newestFrame, m_FrameTimes);
+        m_LastFrameIndex = newestFrame;
+
+        FrameVector<float> sortedTimes(m_FrameTimes.begin(), m_FrameTimes.end());
+        std::sort(sortedTimes.begin(), sortedTimes.end());
+        m_P50 = Percentile(sortedTimes, 0.50f);
+        m_P95 = Percentile(sortedTimes, 0.95f);
+        m_P99 = Percentile(sortedTimes, 0.99f);
+        m_Worst = sortedTimes.empty() ? 0.0f : sortedTimes.back();
+
+        const unsigned long long firstFrame = m_LastFrameIndex - (m_FrameTimes.size() - 1);
+        if (m_FreezeOnSpike)
+        {
+            for (unsigned long long frame = std::max(firstFrame, m_LastCheckedFrame); frame <= m_LastFrameIndex; frame++)
+            {
+                if (m_FrameTimes[(size_t)(frame - firstFrame)] >= m_SpikeThresholdMs)
+                {
+                    SetFrozen(true);
+                    SelectFrame(frame);
+                    return;
+                }
+            }
+        }
+        m_LastCheckedFrame = m_LastFrameIndex + 1;
+
+        SelectFrame(newestFrame);
+    }
+
+    void ProfilerPanel::DrawFrameGraph()
+    {
+        if (m_FrameTimes.empty())
+            return;
+
+        // Fixed scale so spikes stand out instead of rescaling the graph
+        const float scaleMax = std::max(m_SpikeThresholdMs * 1.5f, m_P99 * 1.2f);
+        ImGui::PlotHistogram("##FrameTimes", m_FrameTimes.data(), (int)m_FrameTimes.size(), 0, "Frame time (click to inspect)", 0.0f, scaleMax, ImVec2(-1.0f, 80.0f));
+
+        const ImVec2 min = ImGui::GetItemRectMin();
+        const ImVec2 max = ImGui::GetItemRectMax();
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        // Spike threshold and p95
+        const float thresholdY = max.y - (max.y - min.y) * std::min(m_SpikeThresholdMs / scaleMax, 1.0f);
+        drawList->AddLine(ImVec2(min.x, thresholdY), ImVec2(max.x, thresholdY), IM_COL32(255, 80, 80, 160));
+        const float p95Y = max.y - (max.y - min.y) * std::min(m_P95 / scaleMax, 1.0f);
+        drawList->AddLine(ImVec2(min.x, p95Y), ImVec2(max.x, p95Y), IM_COL32(255, 200, 80, 160));
+
+        const unsigned long long firstFrame = m_LastFrameIndex - (m_FrameTimes.size() - 1);
+        if (m_HasFrame && m_Frame.frameIndex >= firstFrame && m_Frame.frameIndex <= m_LastFrameIndex)
+        {
+            const float barWidth = (max.x - min.x) / m_FrameTimes.size();
+            const float x = min.x + barWidth * (m_Frame.frameIndex - firstFrame);
+            drawList->AddRect(ImVec2(x, min.y), ImVec2(x + barWidth, max.y), IM_COL32(255, 255, 255, 255));
+        }
+
+        if (ImGui::IsItemHovered() && ImGui::IsMouseClicked(0))
+        {
+            const float t = (ImGui::GetIO().MousePos.x - min.x) / (max.x - min.x);
+            const size_t index = std::min((size_t)(t * m_FrameTimes.size()), m_FrameTimes.size() - 1);
+            SetFrozen(true);
+            SelectFrame(firstFrame + index);
+        }
+    }
+
+    void ProfilerPanel::DrawFlameGraph()
+    {
+        ImGui::BeginChild("FlameGraph", ImVec2(0.0f, 0.0f), false, ImGuiWindowFlags_HorizontalScrollbar);
+
+        const double frameDuration = (double)(m_Frame.endTime - m_Frame.startTime);
+        const float width = ImGui::GetContentRegionAvail().x;
+        ImDrawList* drawList = ImGui::GetWindowDrawList();
+
+        const ProfilerEvent* hovered = nullptr;
+        size_t laneStart = 0;
+        while (laneStart < m_Frame.events.size())
+        {
+            // Events are sorted by thread, so each thread is one contiguous lane
+            const unsigned int threadId = m_Frame.events[laneStart].threadId;
+            size_t laneEnd = laneStart;
+            while (laneEnd < m_Frame.events.size() && m_Frame.events[laneEnd].threadId == threadId)
+            {
+                laneEnd++;
+            }
+
+            ImGui::Text("Thread %u", threadId);
+            const ImVec2 origin = ImGui::GetCursorScreenPos();
+
+            unsigned long long openEnds[s_MaxDepth];
+            unsigned int depth = 0;
+            unsigned int maxDepth = 0;
+
+            for (size_t i = laneStart; i < laneEnd; i++)
+            {
+                const ProfilerEvent& event = m_Frame.events[i];
+
+                // Parents start first and are still open while their children run
+                while (depth > 0 && openEnds[depth - 1] <= event.startTime)
+                {
+                    depth--;
+                }
+                if (depth >= s_MaxDepth)
+                    continue;
+
+                openEnds[depth] = event.endTime;
+
+                const unsigned long long start = std::max(event.startTime, m_Frame.startTime);
+                const unsigned long long end = std::min(event.endTime, m_Frame.endTime);
+                const float x0 = origin.x + (float)((start - m_Frame.startTime) / frameDuration) * width;
+                const float x1 = std::max(origin.x + (float)((end - m_Frame.startTime) / frameDuration) * width, x0 + 1.0f);
+                const float y0 = origin.y + depth * s_LaneRowHeight;
+                const ImVec2 rectMin(x0, y0);
+                const ImVec2 rectMax(x1, y0 + s_LaneRowHeight - 1.0f);
+
+                drawList->AddRectFilled(rectMin, rectMax, ScopeColour(event.name));
+                if (ImGui::CalcTextSize(event.name).x < x1 - x0 - 4.0f)
+                    drawList->AddText(ImVec2(x0 + 2.0f, y0 + 2.0f), IM_COL32(0, 0, 0, 255), event.name);
+
+                if (ImGui::IsMouseHoveringRect(rectMin, rectMax))
+                    hovered = &event;
+
+                depth++;
+                maxDepth = std::max(maxDepth, depth);
+            }
+
+            // Reserve the space that was drawn into
+            ImGui::Dummy(ImVec2(width, maxDepth * s_LaneRowHeight));
+            laneStart = laneEnd;
+        }
+
+        if (hovered && ImGui::IsWindowHovered())
+        {
+            ImGui::BeginTooltip();
+            ImGui::Text("%s", hovered->name);
+            ImGui::Text("%.3fms", (hovered->endTime - hovered->startTime) / 1000000.0);
+            ImGui::EndTooltip();
+        }
+
+        ImGui::EndChild();
+    }
+
+}
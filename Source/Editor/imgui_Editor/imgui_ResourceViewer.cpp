@@ -121,7 +121,7 @@ namespace QwerkE {
                         }
 
                         ImGui::Text(p.second->s_Name.c_str());
-                        ImGui::Text(std::to_string(p.second->s_Handle).c_str());
+                        ImGui::Text("%u", (unsigned int)p.second->s_Handle);
                         //ImGui::Text("TagName");
                         ImGui::EndTooltip();
                     }
@@ -141,7 +141,7 @@ namespace QwerkE {
                         ImGui::BeginTooltip();
                         // image name or something might be better. use newly create asset tags
                         ImGui::Text(p.second->GetMaterialName().c_str());
-                        ImGui::Text(std::to_string(p.second->GetMaterialByType(eMaterialMaps::MatMap_Diffuse)->s_Handle).c_str());
+                        ImGui::Text("%u", (unsigned int)p.second->GetMaterialByType(eMaterialMaps::MatMap_Diffuse)->s_Handle);
                         //ImGui::Text("TagName");
                         ImGui::EndTooltip();
                     }
@@ -154,7 +154,7 @@ namespace QwerkE {
                 }
                 break;
             case 2:
-                for (auto p : *m_Shaders)
+                for (const auto& p : *m_Shaders)
                 {
                     if (counter % m_ItemsPerRow)
                         ImGui::SameLine();
@@ -165,7 +165,7 @@ namespace QwerkE {
                     if (ImGui::IsItemHovered())
                     {
                         ImGui::BeginTooltip();
-                        ImGui::Text(std::to_string(p.second->GetProgram()).c_str());
+                        ImGui::Text("%u", (unsigned int)p.second->GetProgram());
                         ImGui::EndTooltip();
                     }
                     counter++;
@@ -189,14 +189,14 @@ namespace QwerkE {
                             ImGui::ImageButton((ImTextureID)m_ModelImageHandles.at(i), ImVec2(256, 256), ImVec2(0.0f, 1.0f), ImVec2(1.0f, 0.0f), 1);
                         }
                         // image name or something might be better. use newly create asset tags
-                        ImGui::Text(std::to_string(m_ModelImageHandles[0]).c_str());
+                        ImGui::Text("%u", (unsigned int)m_ModelImageHandles[0]);
                         ImGui::EndTooltip();
                     }
                     counter++;
                 }
                 break;
             case 5:
-                for (auto p : *m_Sounds)
+                for (const auto& p : *m_Sounds)
                 {
                     if (counter % m_ItemsPerRow)
                         ImGui::SameLine();
@@ -208,7 +208,7 @@ namespace QwerkE {
                     if (ImGui::IsItemHovered())
                     {
                         ImGui::BeginTooltip();
-                        ImGui::Text(std::to_string(p.second).c_str());
+                        ImGui::Text("%u", (unsigned int)p.second);
                         ImGui::EndTooltip();
                     }
                     counter++;
@@ -2,6 +2,9 @@
 #include "../Editor.h"
 #include "../EntityEditor.h"
 
+#include "../../Engine.h"
+#include "../../Core/Entities/SceneEntities.h"
+
 #include "../QwerkE_Framework/Libraries/imgui/imgui.h"
 #include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
 #include "../QwerkE_Framework/Source/Core/Scenes/Entities/GameObject.h"
@@ -98,10 +101,10 @@ namespace QwerkE {
 
 			ImGui::Separator();
 
-			std::map<std::string, GameObject*> entities = currentScene->GetObjectList();
-			std::vector<GameObject*> cameras = currentScene->GetCameraList();
-			std::vector<GameObject*> lights = currentScene->GetLightList();
-			std::map<std::string, GameObject*>::iterator thing;
+			const std::map<std::string, GameObject*>& entities = currentScene->GetObjectList();
+			const std::vector<GameObject*>& cameras = currentScene->GetCameraList();
+			const std::vector<GameObject*>& lights = currentScene->GetLightList();
+			std::map<std::string, GameObject*>::const_iterator thing;
 
 			int itemWidth = 100;
 			int itemsPerRow = (int)ImGui::GetWindowWidth() / itemWidth + 1;
@@ -117,10 +120,13 @@ namespace QwerkE {
 					if (counter % itemsPerRow)
 						ImGui::SameLine();
 
+					// Names can repeat, so IDs come from handles
+					ImGui::PushID((int)Engine::GetSceneEntities().GetHandle(thing->second).value);
 					if (ImGui::Button(thing->second->GetName().c_str()))
 					{
 						m_EntityEditor->SetCurrentEntity(thing->second);
 					}
+					ImGui::PopID();
 					counter++;
 				}
 				break;
@@ -130,10 +136,13 @@ namespace QwerkE {
 					if (counter % itemsPerRow)
 						ImGui::SameLine();
 
+					// Names can repeat, so IDs come from handles
+					ImGui::PushID((int)Engine::GetSceneEntities().GetHandle(cameras[i]).value);
 					if (ImGui::Button(cameras[i]->GetName().c_str()))
 					{
 						m_EntityEditor->SetCurrentEntity(cameras[i]);
 					}
+					ImGui::PopID();
 					counter++;
 				}
 				break;
@@ -143,10 +152,13 @@ namespace QwerkE {
 					if (counter % itemsPerRow)
 						ImGui::SameLine();
 
+					// Names can repeat, so IDs come from handles
+					ImGui::PushID((int)Engine::GetSceneEntities().GetHandle(lights[i]).value);
 					if (ImGui::Button(lights[i]->GetName().c_str()))
 					{
 						m_EntityEditor->SetCurrentEntity(lights[i]);
 					}
+					ImGui::PopID();
 					counter++;
 				}
 				break;
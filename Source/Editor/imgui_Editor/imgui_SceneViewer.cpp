@@ -9,6 +9,12 @@
 #include "../QwerkE_Framework/Source/Core/Graphics/DataTypes/FrameBufferObject.h"
 #include "../QwerkE_Framework/Source/Core/Scenes/Scene.h"
 
+#include "../../Engine.h"
+#include "../../Core/Graphics/CulledSceneDraw.h"
+#include "../../Core/Memory/FrameStrings.h"
+#include "../../Core/Scenes/SceneLoader.h"
+#include "../../Core/Scenes/SceneSaver.h"
+
 namespace QwerkE {
 
     SceneViewer::SceneViewer()
@@ -50,20 +56,42 @@ namespace QwerkE {
             ImGui::PushItemWidth(150);
             if (ImGui::Combo("Scene State", &selection, states, 5))
             {
+                // Remember the scene as it was when set "Running", for "Reset"
+                if (selection == 0 && (char)currentScene->GetState() != 0)
+                    m_PlayStart.Capture(currentScene, Engine::GetSceneEntities());
                 currentScene->SetState((eSceneState)selection);
             }
             ImGui::SameLine();
             ImGui::PopItemWidth();
             ImGui::SameLine();
-            if (ImGui::Button("Save")) currentScene->SaveScene();
+            if (ImGui::Button("Save"))
+            {
+                // Scenes with a known file save changed objects in the background
+                if (const char* sceneFile = SceneLoader::GetSceneFile(currentScene))
+                    SceneSaver::Save(currentScene, sceneFile, Engine::GetSceneEntities());
+                else
+                    currentScene->SaveScene();
+            }
             ImGui::SameLine();
-            if (ImGui::Button("Reload")) currentScene->ReloadScene();
+            if (ImGui::Button("Reload")) SceneLoader::Reload(currentScene, Engine::GetSceneEntities());
+            if (m_PlayStart.GetScene() == currentScene)
+            {
+                // Resets in memory, unlike Reload
+                ImGui::SameLine();
+                if (ImGui::Button("Reset")) m_PlayStart.Restore(currentScene, Engine::GetSceneEntities());
+            }
+            if (SceneSaver::IsSaving())
+            {
+                ImGui::SameLine();
+                ImGui::Text("Saving...");
+            }
 
-            // Render scene to FBO
+            // Render scene to FBO. The engine synced the store for drawing
+            // this frame, so only entities in the camera's frustum are drawn.
             m_FBO->Bind();
             // Renderer::NewFrame();
             glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-            Scenes::DrawCurrentScene();
+            CulledSceneDraw::Draw(currentScene, Engine::GetSceneEntities());
             m_FBO->UnBind();
 
             ImVec2 winSize = ImGui::GetWindowSize();
@@ -104,7 +132,7 @@ namespace QwerkE {
             if (counter % m_ItemsPerRow)
                 ImGui::SameLine();
 
-            if (ImGui::Button(DispStrCombine(std::to_string(counter).c_str(), std::to_string(p.second->GetSceneID()).c_str()).c_str()) || Input::FrameKeyAction((eKeys)(eKeys::eKeys_0 + counter), eKeyState::eKeyState_Press))
+            if (ImGui::Button(FrameCombine(FrameToString(counter), FrameToString((int)p.second->GetSceneID()))) || Input::FrameKeyAction((eKeys)(eKeys::eKeys_0 + counter), eKeyState::eKeyState_Press))
             {
                 Scenes::SetCurrentScene(p.second->GetSceneID());
             }
@@ -52,7 +52,7 @@ namespace QwerkE {
         ImGui::Begin("Shader Editor", isOpen);
         ImGui::Checkbox("ShaderList", &showShaderList);
         if (showShaderList)
-            for (auto p : *m_ShaderList)
+            for (const auto& p : *m_ShaderList)
             {
                 if (ImGui::Button(p.second->GetName().c_str()))
                 {
@@ -6,6 +6,26 @@
 #include "Editor/imgui_Editor/imgui_Editor.h"
 #endif // 0
 
+#include "Core/EngineSettings.h"
+#include "Core/Time/FrameLimiter.h"
+#include "Core/Scenes/TransformInterpolator.h"
+#include "Core/Scenes/SceneCooker.h"
+#include "Core/Scenes/SceneLoader.h"
+#include "Core/Scenes/SceneSaver.h"
+#include "Core/Scenes/SceneUpdater.h"
+#include "Core/Graphics/RenderSnapshot.h"
+#include "Core/Entities/SceneEntities.h"
+#include "Core/Graphics/RenderThread.h"
+#include "Core/Graphics/MeshStreamer.h"
+#include "Core/Graphics/MeshCooker.h"
+#include "Core/Time/TickCounter.h"
+#include "Core/Jobs/TaskScheduler.h"
+#include "Core/Jobs/FrameGraph.h"
+#include "Core/Memory/FrameArena.h"
+#include "Core/Memory/HeapCounter.h"
+#include "Core/Input/InputRecording.h"
+#include "Core/Input/TickInput.h"
+
 // #include "../../QwerkE_Framework/QwerkE.h"
 
 #include "../QwerkE_Framework/Source/Framework.h"
@@ -25,7 +45,8 @@
 #include "../QwerkE_Framework/Source/Core/Graphics/Mesh/MeshFactory.h"
 #include "../QwerkE_Framework/Source/Core/Graphics/Renderer.h"
 
-#include "../QwerkE_Framework/Source/Debug/Profiler/Profiler.h"
+#include "Core/Profiler/TraceRecorder.h"
+#include "Core/Profiler/ProfilerHistory.h"
 #include "../QwerkE_Framework/Source/Debug/Debugger/Debugger.h"
 #include "../QwerkE_Framework/Source/Core/Input/Input.h"
 #include "../QwerkE_Framework/Source/Core/Resources/Resources.h"
@@ -42,6 +63,11 @@
 #include "../QwerkE_Framework/Source/Core/Window/glfw_Window.h"
 #include "../QwerkE_Framework/Source/Core/Time/Time.h"
 
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
 namespace QwerkE {
 
 	namespace Engine
@@ -49,6 +75,191 @@ namespace QwerkE {
         // Private engine variables
         static bool m_IsRunning = false; // TODO: Remove extra variable
         static Editor* m_Editor = nullptr;
+        static EngineSettings m_Settings;
+        static float m_InterpolationAlpha = 0.0f;
+        static double m_Accumulator = 0.0;
+        static double m_FrameDeltaTime = 0.0;
+        static TransformInterpolator m_Interpolator;
+        static SceneUpdater m_SceneUpdater; // A SceneEntities per scene
+
+        static TaskScheduler* m_TaskScheduler = nullptr;
+        static FrameGraph m_FrameGraph;
+
+        static InputRecorder m_InputRecorder;
+        static InputReplayer m_InputReplayer;
+        static TickInput m_TickInput;
+
+        // Set from a signal handler so servers can be shut down cleanly
+        static volatile std::sig_atomic_t m_StopSignalled = 0;
+
+        static void OnStopSignal(int)
+        {
+            m_StopSignalled = 1;
+        }
+
+        // Input callbacks of the window while a replay has them detached
+        struct LiveInputCallbacks
+        {
+            GLFWwindow* window = nullptr;
+            GLFWkeyfun key = nullptr;
+            GLFWcharfun character = nullptr;
+            GLFWmousebuttonfun mouseButton = nullptr;
+            GLFWcursorposfun cursorPos = nullptr;
+            GLFWscrollfun scroll = nullptr;
+        };
+        static LiveInputCallbacks m_LiveInputCallbacks;
+
+        // Replays must only see recorded input. Window events are still
+        // polled, so the window can be moved or closed during a replay.
+        static void DetachLiveInput(GLFWwindow* window)
+        {
+            if (window == nullptr || m_LiveInputCallbacks.window)
+                return;
+
+            m_LiveInputCallbacks.window = window;
+            m_LiveInputCallbacks.key = glfwSetKeyCallback(window, nullptr);
+            m_LiveInputCallbacks.character = glfwSetCharCallback(window, nullptr);
+            m_LiveInputCallbacks.mouseButton = glfwSetMouseButtonCallback(window, nullptr);
+            m_LiveInputCallbacks.cursorPos = glfwSetCursorPosCallback(window, nullptr);
+            m_LiveInputCallbacks.scroll = glfwSetScrollCallback(window, nullptr);
+        }
+
+        static void AttachLiveInput()
+        {
+            GLFWwindow* window = m_LiveInputCallbacks.window;
+            if (window == nullptr)
+                return;
+
+            glfwSetKeyCallback(window, m_LiveInputCallbacks.key);
+            glfwSetCharCallback(window, m_LiveInputCallbacks.character);
+            glfwSetMouseButtonCallback(window, m_LiveInputCallbacks.mouseButton);
+            glfwSetCursorPosCallback(window, m_LiveInputCallbacks.cursorPos);
+            glfwSetScrollCallback(window, m_LiveInputCallbacks.scroll);
+            m_LiveInputCallbacks = LiveInputCallbacks();
+        }
+
+        // Program argument keys are not interned, so compare strings
+        static const char* FindArgument(const std::map<const char*, const char*>& args, const char* key)
+        {
+            for (const auto& p : args)
+            {
+                if (p.first && strcmp(p.first, key) == 0)
+                    return p.second;
+            }
+            return nullptr;
+        }
+
+        static void RunHeadless(unsigned short tickRate, double runSeconds)
+        {
+            LOG_INFO("Running headless. Tick rate: {0}, run time: {1}s", tickRate, runSeconds);
+
+            std::signal(SIGINT, OnStopSignal);
+            std::signal(SIGTERM, OnStopSignal);
+
+            // Ticks always advance by the same amount of simulated time, even
+            // when unthrottled, so runs are comparable between machines.
+            const double timestep = 1.0 / (tickRate ? tickRate : m_Settings.SimulationTickRate);
+
+            FrameLimiter tickLimiter;
+            tickLimiter.SetMaxFPS(tickRate);
+            tickLimiter.SetSpinWindow(m_Settings.FramePacingSpinMicroseconds);
+
+            TickCounter ticks("Headless");
+
+            while (m_IsRunning && !m_StopSignalled)
+            {
+                ticks.BeginTick();
+                Engine::Simulate(timestep);
+                ticks.EndTick();
+
+                if (runSeconds > 0.0 && ticks.ElapsedSeconds() >= runSeconds)
+                    break;
+
+                if (tickRate)
+                    tickLimiter.WaitForNextFrame();
+            }
+
+            ticks.LogSummary();
+        }
+
+        // Steps the simulation for 1 frame worth of time
+        static void SimulateFrame(double deltaTime)
+        {
+            if (!m_Settings.FixedTimestepEnabled)
+            {
+                Engine::Simulate(deltaTime);
+                m_InterpolationAlpha = 0.0f;
+                return;
+            }
+
+            const double timestep = 1.0 / m_Settings.SimulationTickRate;
+            // Dropping time after a long stall (breakpoints, loading) avoids a
+            // spiral where catching up takes longer than the time being caught up.
+            const double maxAccumulatedTime = timestep * m_Settings.MaxSimulationStepsPerFrame;
+
+            m_Accumulator += deltaTime;
+            if (m_Accumulator > maxAccumulatedTime)
+                m_Accumulator = maxAccumulatedTime;
+
+            // Each key press or release reaches 1 tick, however many run
+            m_TickInput.LatchFrameInput();
+
+            while (m_Accumulator >= timestep)
+            {
+                if (m_Settings.RenderInterpolationEnabled)
+                    m_Interpolator.Capture(Scenes::GetCurrentScene());
+
+                m_TickInput.BeginTick();
+                Engine::Simulate(timestep);
+                m_Accumulator -= timestep;
+            }
+            m_InterpolationAlpha = (float)(m_Accumulator / timestep);
+
+            m_TickInput.EndFrame();
+        }
+
+        // Interpolates the current scene's objects and brings the stores of
+        // enabled scenes up to date for drawing. Only touches GameObject
+        // transforms and the stores, so it can run on any thread. Undone by
+        // Restore() after drawing.
+        static void PrepareDraw()
+        {
+            PROFILE_SCOPE("Engine Prepare Draw");
+
+            Scene* scene = Scenes::GetCurrentScene();
+            SceneEntities& sceneEntities = Engine::GetSceneEntities();
+            if (m_Settings.FixedTimestepEnabled && m_Settings.RenderInterpolationEnabled)
+                m_Interpolator.Apply(scene, m_InterpolationAlpha, sceneEntities);
+
+            // The only sync of the frame. The editor resolves handles, and
+            // objects may have left the scene this frame.
+            m_SceneUpdater.Sync();
+            sceneEntities.GetStore().UpdateWorldMatrices();
+        }
+
+        // Per frame systems and the order they need to run in. Nodes without
+        // a path between them may run at the same time. Framework systems
+        // can't be split out of Simulate until Framework::Update is, which
+        // is why FrameGraphEnabled is off by default.
+        static void BuildFrameGraph()
+        {
+            const FrameGraph::NodeId input = m_FrameGraph.AddNode("Input", [] { Engine::PollInput(); }, FrameGraphThread_Main);
+
+            // Framework::Update runs routines that may touch GL or window state
+            const FrameGraph::NodeId simulate = m_FrameGraph.AddNode("Simulate", [] { SimulateFrame(m_FrameDeltaTime); }, FrameGraphThread_Main);
+            m_FrameGraph.AddDependency(simulate, input);
+
+            // Reads input and may stop the engine, so it sees the frame's simulation
+            const FrameGraph::NodeId update = m_FrameGraph.AddNode("Editor Update", [] { Engine::Update(m_FrameDeltaTime); }, FrameGraphThread_Main);
+            m_FrameGraph.AddDependency(update, simulate);
+
+            // Runs on a worker alongside the editor update
+            const FrameGraph::NodeId prepareDraw = m_FrameGraph.AddNode("Prepare Draw", [] { PrepareDraw(); });
+            m_FrameGraph.AddDependency(prepareDraw, simulate);
+
+            if (m_FrameGraph.Compile())
+                m_FrameGraph.LogGraph();
+        }
 
 		void Engine::Run(std::map<const char*, const char*> &args)
         {
@@ -83,8 +294,89 @@ namespace QwerkE {
 
 			m_IsRunning = true;
 
+			m_Settings = EngineSettingsLoader::Load(ConfigsFolderPath("preferences.qpref"));
+
+			const char* convertTrace = FindArgument(args, key_ConvertTrace);
+			if (convertTrace)
+			{
+				// Offline tool mode. Nothing else is run.
+				std::string jsonPath = convertTrace;
+				jsonPath += ".json";
+				TraceRecorder::ConvertToJson(convertTrace, jsonPath.c_str());
+
+				m_IsRunning = false;
+				Instrumentor::Get().EndSession();
+				Framework::TearDown();
+				return;
+			}
+
+			const char* cookScene = FindArgument(args, key_CookScene);
+			if (cookScene)
+			{
+				// Offline tool mode. Nothing else is run.
+				SceneCooker::Cook(cookScene, CookedScene::CookedPath(cookScene).c_str());
+
+				m_IsRunning = false;
+				Instrumentor::Get().EndSession();
+				Framework::TearDown();
+				return;
+			}
+
+			const char* cookMesh = FindArgument(args, key_CookMesh);
+			if (cookMesh)
+			{
+				// Offline tool mode. Nothing else is run.
+				TaskScheduler* scheduler = m_Settings.WorkerThreadCount > 0 ? new TaskScheduler(m_Settings.WorkerThreadCount) : nullptr;
+				MeshCooker::Cook(cookMesh, CookedMesh::CookedPath(cookMesh).c_str(), scheduler, m_Settings.QuantizedMeshesEnabled);
+				delete scheduler;
+
+				m_IsRunning = false;
+				Instrumentor::Get().EndSession();
+				Framework::TearDown();
+				return;
+			}
+
+			// The framework loaded the startup scene from JSON. Reloads take the cooked path.
+			SceneLoader::SetCookedScenesEnabled(m_Settings.CookedScenesEnabled);
+			if (!m_Settings.StartupSceneFile.empty())
+				SceneLoader::SetSceneFile(Scenes::GetCurrentScene(), ScenesFolderPath(m_Settings.StartupSceneFile.c_str()), GetSceneEntities());
+
+			if (m_Settings.TraceRecorderEnabled)
+			{
+				// Startup was profiled by the Instrumentor. Record everything after to the ring buffers.
+				Instrumentor::Get().EndSession();
+				TraceRecorder::BeginSession("trace_log.qtrace");
+			}
+
+			const char* headless = FindArgument(args, key_Headless);
+			if (headless && atoi(headless) != 0)
+			{
+				// No editor, input or drawing. Only scenes are ticked. Framework
+				// startup above has already opened a window and GL context.
+				const char* tickRate = FindArgument(args, key_TickRate);
+				const char* runSeconds = FindArgument(args, key_RunSeconds);
+				RunHeadless(tickRate ? (unsigned short)atoi(tickRate) : m_Settings.SimulationTickRate,
+					runSeconds ? atof(runSeconds) : 0.0);
+
+				m_IsRunning = false;
+				TraceRecorder::EndSession();
+				Instrumentor::Get().EndSession();
+				Framework::TearDown();
+				return;
+			}
+
 			Renderer::Initialize();
 
+			// Editor panels read and write live scene objects, which the render
+			// thread must not see change mid frame, and meshes can't stream
+			// while the render thread owns the GL context. Until both work with
+			// the render thread, frames are not pipelined.
+			if (m_Settings.PipelinedFramesEnabled)
+			{
+				LOG_ERROR("PipelinedFramesEnabled is not supported with the editor or mesh streaming yet. Frames will not be pipelined.");
+				m_Settings.PipelinedFramesEnabled = false;
+			}
+
 			// TODO: Move to editor class
 #ifdef dearimgui
 			m_Editor = (Editor*)new imgui_Editor();
@@ -92,43 +384,142 @@ namespace QwerkE {
 			m_Editor = (Editor*)new ????_Editor();
 #endif // editor
 
-			// TODO: Move this to a window class
-			const unsigned char FPS_MAX = 144;
-			const double FPS_MAX_DELTA = 1.0 / FPS_MAX;
+			FrameLimiter frameLimiter;
+			frameLimiter.SetMaxFPS(m_Settings.FPS_Max);
+			frameLimiter.SetSpinWindow(m_Settings.FramePacingSpinMicroseconds);
+
+			if (m_Settings.WorkerThreadCount > 0)
+				m_TaskScheduler = new TaskScheduler(m_Settings.WorkerThreadCount);
+			m_SceneUpdater.SetParallelEnabled(m_Settings.ParallelSceneUpdatesEnabled);
+
+			// Uploads need the GL context on this thread, which pipelined frames give away
+			MeshStreamer::SetCookedMeshesEnabled(m_Settings.CookedMeshesEnabled);
+			MeshStreamer::SetQuantizedMeshesEnabled(m_Settings.QuantizedMeshesEnabled);
+			if (m_TaskScheduler && m_Settings.AsyncMeshLoadingEnabled && !m_Settings.PipelinedFramesEnabled)
+				MeshStreamer::Initialize(m_TaskScheduler);
+
+			if (m_Settings.FrameGraphEnabled)
+				BuildFrameGraph();
+
+			const char* recordInput = FindArgument(args, key_RecordInput);
+			const char* replayInput = FindArgument(args, key_ReplayInput);
+			if (replayInput)
+			{
+				// Replays run as fast as possible. Recorded frame times drive the
+				// simulation, so pacing would only slow down captures.
+				if (m_InputReplayer.Open(replayInput))
+				{
+					m_Settings.FramePacingEnabled = false;
+					DetachLiveInput(glfwGetCurrentContext());
+				}
+			}
+			else if (recordInput)
+			{
+				m_InputRecorder.Begin(recordInput);
+			}
+
+			RenderThread renderThread;
+			GLFWwindow* window = glfwGetCurrentContext();
+			unsigned long long frameIndex = 0;
+			if (m_Settings.PipelinedFramesEnabled)
+			{
+				glfwMakeContextCurrent(nullptr); // Render thread owns the context
+				renderThread.Start(window);
+			}
 
             /* Application Loop */
 			double deltaTime = 0.0;
-			double elapsedTime = 0.0;
 
 			while (m_IsRunning)
 			{
                 Time::NewFrame();
 
 				deltaTime = Time::Delta();
-				elapsedTime += deltaTime;
-				// if (elapsedTime >= FPS_MAX_DELTA)
+
+				if (m_InputReplayer.IsReplaying())
+				{
+					if (!m_InputReplayer.BeginFrame(deltaTime))
+					{
+						LOG_INFO("Input replay finished. Stopping engine.");
+						m_InputReplayer.Close();
+						AttachLiveInput();
+						Engine::Stop();
+						break;
+					}
+				}
+				else if (m_InputRecorder.IsRecording())
 				{
-					/* New Frame */
-					Engine::NewFrame();
+					m_InputRecorder.BeginFrame(deltaTime);
+				}
+
+				/* New Frame */
+				Engine::NewFrame();
 
+				if (m_Settings.FrameGraphEnabled)
+				{
+					/* Input + Logic */
+					m_FrameDeltaTime = deltaTime;
+					m_FrameGraph.Execute(m_TaskScheduler);
+				}
+				else
+				{
 					/* Input */
 					Engine::PollInput();
 
 					/* Logic */
-					Engine::Update(elapsedTime);
+					SimulateFrame(deltaTime);
+
+					Engine::Update(deltaTime);
 
-					/* Render */
-                    Engine::Draw();
+					PrepareDraw();
+				}
 
-                    elapsedTime = 0.0;
+				/* Render */
+				if (m_Settings.PipelinedFramesEnabled)
+				{
+					// Frame N is drawn on the render thread while the next
+					// loop iteration simulates frame N + 1.
+					RenderSnapshot* snapshot = renderThread.AcquireSnapshot();
+					snapshot->Capture(Scenes::GetCurrentScene(), GetSceneEntities(), frameIndex++);
+					renderThread.Submit(snapshot);
+					ImGui::EndFrame(); // No UI is drawn in pipelined mode
 				}
-				// TODO : Fix yield that broke after deltatime changes
-                // else
-                // {
-                // 	YieldProcessor(); // TODO: Look into proper yield behaviour
-                // }
+				else
+				{
+					MeshStreamer::Update(m_Settings.MeshUploadBudgetMicroseconds);
+					Engine::Draw();
+				}
+
+				// Nothing applied without interpolation
+				m_Interpolator.Restore(GetSceneEntities());
+
+				if (m_Settings.FramePacingEnabled)
+					frameLimiter.WaitForNextFrame();
+			}
+
+			if (renderThread.IsRunning())
+			{
+				renderThread.Stop();
+				glfwMakeContextCurrent(window);
 			}
 
+			m_InputRecorder.End();
+			m_InputReplayer.Close();
+			AttachLiveInput();
+			m_SceneUpdater.Clear();
+
+			SceneSaver::Shutdown(); // Compacts journals so the framework loads every saved change
+
+			delete m_Editor;
+			m_Editor = nullptr;
+
+			if (MeshStreamer::IsEnabled())
+				MeshStreamer::Shutdown();
+
+			delete m_TaskScheduler;
+			m_TaskScheduler = nullptr;
+
+			TraceRecorder::EndSession();
             Instrumentor::Get().EndSession();
 			Framework::TearDown();
 		}
@@ -141,30 +532,51 @@ namespace QwerkE {
 
 		void Engine::NewFrame()
 		{
+			// Previous frame's work is done. Nothing can still be using frame memory.
+			FrameArena::NewFrame();
+			HeapCounter::NewFrame();
+			ProfilerHistory::MarkFrame();
+
 			Framework::NewFrame();
-            m_Editor->NewFrame();
+			if (m_Editor)
+				m_Editor->NewFrame();
 		}
 
 		void Engine::PollInput()
         {
             PROFILE_SCOPE("Engine Input");
+			// Only window events while replaying. Live input callbacks are detached.
 			Framework::PollInput();
+
+			if (m_InputReplayer.IsReplaying())
+				m_InputReplayer.InjectInput();
+			else
+				m_InputRecorder.RecordInput();
+		}
+
+		void Engine::Simulate(double timestep)
+		{
+			PROFILE_SCOPE("Engine Simulate");
+
+			Framework::Update(timestep);
+
+			// Batched routines of every enabled scene, 1 task per scene
+			m_SceneUpdater.Update(timestep, m_TaskScheduler);
 		}
 
 		void Engine::Update(double deltaTime)
         {
             PROFILE_SCOPE("Engine Update");
 
-			Framework::Update(deltaTime);
-
-			m_Editor->Update();
+			if (m_Editor)
+				m_Editor->Update();
 
 			if (Input::FrameKeyAction(eKeys::eKeys_Escape, eKeyState::eKeyState_Press))
 			{
 				Stop();
 			}
 
-			if (Input::FrameKeyAction(eKeys::eKeys_F, eKeyState::eKeyState_Press))
+			if (m_Editor && Input::FrameKeyAction(eKeys::eKeys_F, eKeyState::eKeyState_Press))
 			{
 				m_Editor->ToggleEditorUi();
 			}
@@ -174,7 +586,8 @@ namespace QwerkE {
         {
 			PROFILE_SCOPE("Engine Render");
 
-			m_Editor->Draw();
+			if (m_Editor)
+				m_Editor->Draw();
 
 			Framework::Draw();
 		}
@@ -183,5 +596,25 @@ namespace QwerkE {
 		{
 			return m_IsRunning;
 		}
+
+		float Engine::InterpolationAlpha()
+		{
+			return m_InterpolationAlpha;
+		}
+
+		const EngineSettings& Engine::GetSettings()
+		{
+			return m_Settings;
+		}
+
+		TaskScheduler* Engine::GetTaskScheduler()
+		{
+			return m_TaskScheduler;
+		}
+
+		SceneEntities& Engine::GetSceneEntities()
+		{
+			return m_SceneUpdater.GetEntities(Scenes::GetCurrentScene());
+		}
 	}
 }
@@ -21,7 +21,10 @@
 namespace QwerkE {
 
     class Editor;
+    struct EngineSettings;
+    class TaskScheduler;
     class Scenes;
+    class SceneEntities;
     class Window;
 
 	namespace Engine
@@ -31,10 +34,23 @@ namespace QwerkE {
 
 		void NewFrame();
 		void PollInput();
+		void Simulate(double timestep);
 		void Update(double deltatime);
 		void Draw();
 
 		bool StillRunning();
+
+		// Progress between the last 2 simulation ticks, in [0, 1)
+		float InterpolationAlpha();
+
+		const EngineSettings& GetSettings();
+
+		// Worker pool for engine tasks. Null when multi threading is disabled.
+		TaskScheduler* GetTaskScheduler();
+
+		// Entity arrays mirroring the current scene, used for drawing.
+		// Every scene keeps its own, with its parents and routines.
+		SceneEntities& GetSceneEntities();
 	}
 
 }
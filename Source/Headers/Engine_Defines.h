@@ -9,6 +9,14 @@
 /* Define program arguments */
 #define key_ProjectName "-projectName" // "-projectName" Look in projects folder for a project with the same name.
 // "-projectFilePath" Absolute or relative path to working directory.
+#define key_Headless "-headless" // "-headless 1" Only ticks scenes, with no editor or drawing. Framework startup still opens a window, so a display is required.
+#define key_TickRate "-tickRate" // "-tickRate 60" Headless ticks per second. 0 runs as fast as possible.
+#define key_RunSeconds "-runSeconds" // "-runSeconds 30" Stop a headless run after some time. 0 runs until stopped.
+#define key_RecordInput "-recordInput" // "-recordInput run.qinput" Record per frame input and frame times to a file.
+#define key_ReplayInput "-replayInput" // "-replayInput run.qinput" Replay a recorded input file, then stop.
+#define key_ConvertTrace "-convertTrace" // "-convertTrace trace_log.qtrace" Write a .qtrace file as chrome tracing JSON, then exit.
+#define key_CookScene "-cookScene" // "-cookScene Test.qscene" Write a .qscene file as a cooked binary .qscenec, then exit.
+#define key_CookMesh "-cookMesh" // "-cookMesh Cube.obj" Write a model file as a cooked binary .qmesh, then exit.
 // etc...
 
 /* Define values to be used in other ares of code. */